@@ -6,8 +6,17 @@
 #include <string.h>
 
 static double tab[4] = {0.0, 1.0, 1.0, 2.0};
+static const double tabT[6] = {0.0, 1.0, 2.0, 1.0, 2.0, 4.0};
 
 int usertab(char* tableName, int nipo, int dim[], int* colWise, double** table) {
+    if (0 == strcmp(tableName, "def")) {
+        /* Column-wise table interpolated in place */
+        *table = (double*)tabT;
+        *colWise = 3;
+        dim[0] = 2;
+        dim[1] = 3;
+        return 0; /* OK */
+    }
     *table = tab;
     *colWise = 0;
     dim[0] = 2;
@@ -29,5 +38,14 @@ int main(int argc, char **argv) {
     y = ModelicaStandardTables_CombiTimeTable_getValue(table, 1, 1.5, te, te);
     assert(fabs(y - (1.0 + 2.0)/2) < 1e-6);
     ModelicaStandardTables_CombiTimeTable_close(table);
+    table = ModelicaStandardTables_CombiTable1D_init2("NoName", "def", &dummy, 0, 0, cols, 1, 1, 2, 1);
+    assert(table);
+    tmax = ModelicaStandardTables_CombiTable1D_maximumAbscissa(table);
+    assert(fabs(tmax - 2.0) < 1e-6);
+    y = ModelicaStandardTables_CombiTable1D_getValue(table, 1, 1.5);
+    assert(fabs(y - 3.0) < 1e-6);
+    y = ModelicaStandardTables_CombiTable1D_getInverseValue(table, 1, 1.5);
+    assert(fabs(y - 0.5) < 1e-6);
+    ModelicaStandardTables_CombiTable1D_close(table);
     return 0;
 }
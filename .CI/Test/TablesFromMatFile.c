@@ -1,12 +1,17 @@
 #include "../../Modelica/Resources/C-Sources/ModelicaStandardTables.h"
+#include "../../Modelica/Resources/C-Sources/ModelicaIO.h"
+#include "../../Modelica/Resources/C-Sources/ModelicaMatIO.h"
 #include "Common.c"
 
 #include <assert.h>
 #include <math.h>
+#include <stdio.h>
 #include <string.h>
 
 int main(int argc, char **argv) {
     double dummy = 0.0;
+    double a[6] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+    double aT[6];
     int cols[1] = {2};
     double tmin, tmax, te, y;
     void *table = ModelicaStandardTables_CombiTimeTable_init2("../../Modelica/Resources/Data/Tables/test_v6.mat", "s.tab1", &dummy, 0, 0, 0.0, cols, 1, 1, 3, 0.0, 3, 0);
@@ -19,5 +24,208 @@ int main(int argc, char **argv) {
     y = ModelicaStandardTables_CombiTimeTable_getValue(table, 1, 1.5, te, te);
     assert(fabs(y - (1.0 + 4.0)/2) < 1e-6);
     ModelicaStandardTables_CombiTimeTable_close(table);
+    ModelicaIO_transposeRealMatrix(a, 2, 3, aT);
+    assert(aT[0] == 1.0 && aT[1] == 4.0 && aT[2] == 2.0 && aT[5] == 6.0);
+    ModelicaIO_transposeRealMatrixInPlace(aT, 3, 2);
+    assert(0 == memcmp(a, aT, sizeof(a)));
+    {
+        /* Repeated reads from the same file (cached if MAT_FILE_CACHE) */
+        int i, dim[2];
+        double tab[12];
+        for (i = 0; i < 2; i++) {
+            ModelicaIO_readMatrixSizes("../../Modelica/Resources/Data/Tables/test_v7.mat", "s.tab1", dim);
+            assert(dim[0] == 6 && dim[1] == 2);
+            ModelicaIO_readRealMatrix("../../Modelica/Resources/Data/Tables/test_v7.mat", "s.tab1", tab, 6, 2, 0);
+            assert(fabs(tab[3*2 + 1] - 4.0) < 1e-6);
+        }
+        /* Read rows 2, 4 and 6 of the second column */
+        ModelicaIO_readRealMatrixSlice("../../Modelica/Resources/Data/Tables/test_v6.mat", "s.tab1", 2, 3, 2, 1, 2, tab);
+        assert(fabs(tab[1] - 4.0) < 1e-6);
+        ModelicaIO_readRealMatrixSlice("../../Modelica/Resources/Data/Tables/test_v7.mat", "s.tab1", 4, 2, 2, 1, 1, tab);
+        assert(fabs(tab[0] - 4.0) < 1e-6);
+    }
+    {
+        /* Modify a file, that was read before (cached if MAT_FILE_CACHE),
+           outside of ModelicaIO */
+        const char* fileName = "test_modify.mat";
+        double b[6] = {6.0, 5.0, 4.0, 3.0, 2.0, 1.0};
+        double tab[6];
+        size_t dims[2] = {3, 2};
+        int dim[2];
+        mat_t* mat;
+        matvar_t* matvar;
+        assert(1 == ModelicaIO_writeRealMatrix(fileName, "A", a, 3, 2, 0, "6"));
+        ModelicaIO_readRealMatrix(fileName, "A", tab, 3, 2, 0);
+        assert(0 == memcmp(a, tab, sizeof(a)));
+        mat = Mat_Open(fileName, (int)MAT_ACC_RDWR);
+        assert(mat);
+        matvar = Mat_VarCreate("B", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, b, MAT_F_DONT_COPY_DATA);
+        assert(matvar && 0 == Mat_VarWrite(mat, matvar, MAT_COMPRESSION_NONE));
+        Mat_VarFree(matvar);
+        Mat_Close(mat);
+        ModelicaIO_readMatrixSizes(fileName, "B", dim);
+        assert(dim[0] == 3 && dim[1] == 2);
+        /* Rewrite a variable with the same size */
+        mat = Mat_Open(fileName, (int)MAT_ACC_RDWR);
+        assert(mat && 0 == Mat_VarDelete(mat, "A"));
+        matvar = Mat_VarCreate("A", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, b, MAT_F_DONT_COPY_DATA);
+        assert(matvar && 0 == Mat_VarWrite(mat, matvar, MAT_COMPRESSION_NONE));
+        Mat_VarFree(matvar);
+        Mat_Close(mat);
+        ModelicaIO_readRealMatrix(fileName, "A", tab, 3, 2, 0);
+        assert(tab[0] == 6.0 && tab[1] == 3.0 && tab[4] == 4.0 && tab[5] == 1.0);
+        remove(fileName);
+    }
+    {
+        /* Append rows to a new and to an existing matrix */
+        const char* fileName = "test_append.mat";
+        double rows[4] = {1.0, 2.0, 3.0, 4.0};
+        double tab[6];
+        int dim[2];
+        assert(1 == ModelicaIO_appendRealMatrixRows(fileName, "A", rows, 2, 2, "6"));
+        assert(1 == ModelicaIO_appendRealMatrixRows(fileName, "A", rows, 1, 2, "6"));
+        ModelicaIO_readMatrixSizes(fileName, "A", dim);
+        assert(dim[0] == 3 && dim[1] == 2);
+        ModelicaIO_readRealMatrix(fileName, "A", tab, 3, 2, 0);
+        assert(tab[2] == 3.0 && tab[3] == 4.0 && tab[4] == 1.0 && tab[5] == 2.0);
+        {
+            /* Overwrite the matrix in its own space */
+            FILE* fp;
+            long size, size2;
+            mat_uint32_t tag[4];
+            fp = fopen(fileName, "rb");
+            assert(fp && 0 == fseek(fp, 0, SEEK_END));
+            size = ftell(fp);
+            fclose(fp);
+            assert(1 == ModelicaIO_writeRealMatrix(fileName, "A", a, 3, 2, 1, "6"));
+            ModelicaIO_readRealMatrix(fileName, "A", tab, 3, 2, 0);
+            assert(0 == memcmp(a, tab, sizeof(a)));
+            fp = fopen(fileName, "rb");
+            assert(fp && 0 == fseek(fp, 0, SEEK_END));
+            size2 = ftell(fp);
+            assert(0 == fseek(fp, 128 + 8, SEEK_SET));
+            assert(4 == fread(tag, sizeof(mat_uint32_t), 4, fp));
+            fclose(fp);
+            assert(size2 == size);
+            assert((tag[2] & 0xff) == MAT_C_DOUBLE);
+        }
+        {
+            /* Overwrite the matrix by a smaller one that does not fit into
+               the free space, which is left as an empty matrix without name */
+            FILE* fp;
+            long size, size2;
+            mat_uint32_t tag[14];
+            mat_t* mat;
+            assert(1 == ModelicaIO_writeRealMatrix(fileName, "A", a, 1, 2, 1, "6"));
+            ModelicaIO_readMatrixSizes(fileName, "A", dim);
+            assert(dim[0] == 1 && dim[1] == 2);
+            fp = fopen(fileName, "rb");
+            assert(fp && 0 == fseek(fp, 0, SEEK_END));
+            size = ftell(fp);
+            assert(0 == fseek(fp, 128, SEEK_SET));
+            assert(14 == fread(tag, sizeof(mat_uint32_t), 14, fp));
+            fclose(fp);
+            assert(tag[0] == MAT_T_MATRIX && tag[4] == MAT_C_DOUBLE);
+            assert(tag[8] == 0 && tag[9] == 0 && tag[11] == 0 && tag[13] == 0);
+            mat = Mat_Open(fileName, (int)MAT_ACC_RDWR);
+            assert(mat && 0 == Mat_Compact(mat));
+            Mat_Close(mat);
+            fp = fopen(fileName, "rb");
+            assert(fp && 0 == fseek(fp, 0, SEEK_END));
+            size2 = ftell(fp);
+            fclose(fp);
+            assert(size2 < size);
+            ModelicaIO_readRealMatrix(fileName, "A", tab, 1, 2, 0);
+            assert(tab[0] == 1.0 && tab[1] == 2.0);
+        }
+        remove(fileName);
+    }
+    {
+        /* Append several times to a matrix and add another one on one handle */
+        const enum mat_ft versions[2] = {MAT_FT_MAT4, MAT_FT_MAT5};
+        size_t dims[2] = {1, 2};
+        int i, j;
+        for (i = 0; i < 2; i++) {
+            const char* fileName = "test_append2.mat";
+            mat_t* mat = Mat_CreateVer(fileName, NULL, versions[i]);
+            matvar_t* matvar;
+            assert(mat);
+            for (j = 0; j < 3; j++) {
+                matvar = Mat_VarCreate("X", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, a + 2*j, MAT_F_DONT_COPY_DATA);
+                assert(matvar && 0 == Mat_VarWriteAppend(mat, matvar, MAT_COMPRESSION_NONE, 1));
+                Mat_VarFree(matvar);
+            }
+            matvar = Mat_VarCreate("Y", MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, a, MAT_F_DONT_COPY_DATA);
+            assert(matvar && 0 == Mat_VarWriteAppend(mat, matvar, MAT_COMPRESSION_NONE, 1));
+            Mat_VarFree(matvar);
+            matvar = Mat_VarReadInfo(mat, "X");
+            assert(matvar && matvar->dims[0] == 3 && matvar->dims[1] == 2);
+            Mat_VarFree(matvar);
+            Mat_Close(mat);
+            remove(fileName);
+        }
+    }
+    {
+        /* Write and read a compressed matrix of several deflate blocks */
+        const char* fileName = "test_deflate.mat";
+        const size_t m = 600, n = 500;
+        double* x = (double*)malloc(m*n*sizeof(double));
+        double* y = (double*)malloc(m*n*sizeof(double));
+        size_t i;
+        assert(x && y);
+        for (i = 0; i < m*n; i++) {
+            x[i] = sin(0.001*(double)i) + (double)(i % 7);
+        }
+        assert(1 == ModelicaIO_writeRealMatrix(fileName, "X", x, m, n, 0, "7"));
+        ModelicaIO_readRealMatrix(fileName, "X", y, m, n, 0);
+        assert(0 == memcmp(x, y, m*n*sizeof(double)));
+        free(x);
+        free(y);
+        remove(fileName);
+    }
+    {
+        /* Data that does not compress is written uncompressed */
+        const char* fileName = "test_policy.mat";
+        const size_t m = 200, n = 100;
+        double* x = (double*)malloc(m*n*sizeof(double));
+        double* y = (double*)malloc(m*n*sizeof(double));
+        unsigned long r = 1;
+        FILE* fp;
+        long size;
+        size_t i;
+        assert(x && y);
+        for (i = 0; i < m*n; i++) {
+            r = (r*1103515245UL + 12345UL) & 0xffffffffUL;
+            x[i] = (double)r/4294967296.0;
+            r = (r*1103515245UL + 12345UL) & 0xffffffffUL;
+            x[i] += (double)r/4294967296.0/4294967296.0;
+        }
+        assert(1 == ModelicaIO_writeRealMatrix2(fileName, "X", x, m, n, 0, 1, 3, 0));
+        assert(1 == ModelicaIO_writeRealMatrix2(fileName, "Y", a, 2, 3, 1, 9, 1, 1024));
+        ModelicaIO_readRealMatrix(fileName, "X", y, m, n, 0);
+        assert(0 == memcmp(x, y, m*n*sizeof(double)));
+        ModelicaIO_readRealMatrix(fileName, "Y", y, 2, 3, 0);
+        assert(0 == memcmp(a, y, sizeof(a)));
+        fp = fopen(fileName, "rb");
+        assert(fp && 0 == fseek(fp, 0, SEEK_END));
+        size = ftell(fp);
+        fclose(fp);
+        assert(size > (long)(m*n*sizeof(double)));
+        free(x);
+        free(y);
+        remove(fileName);
+    }
+#if defined(MODELICA_THREAD_LOCAL)
+    {
+        double* tab;
+        size_t m, n;
+        char message[256];
+        tab = ModelicaIO_readRealTableWithErrorReturn("../../Modelica/Resources/Data/Tables/test_v6.mat", "s.tab1", &m, &n, ",", 0, message, sizeof(message));
+        assert(tab && m == 6 && n == 2 && message[0] == '\0');
+        ModelicaIO_freeRealTable(tab);
+        tab = ModelicaIO_readRealTableWithErrorReturn("../../Modelica/Resources/Data/Tables/test_v6.mat", "s.nope", &m, &n, ",", 0, message, sizeof(message));
+        assert(!tab && m == 0 && n == 0 && NULL != strstr(message, "nope"));
+    }
+#endif
     return 0;
 }
@@ -2,13 +2,39 @@
 #include "Common.c"
 
 #include <assert.h>
+#include <float.h>
 #include <math.h>
 #include <string.h>
 
 int main(int argc, char **argv) {
     double tab[4] = {0.0, 1.0, 1.0, 2.0};
+    double tab3[10] = {0.0, 0.0, 1.0, 1.0, 2.0, 1.0, 2.0, 2.0, 3.0, 2.0};
+    double tab1D[6] = {0.0, 0.0, 1.0, 1.0, 2.0, 4.0};
+    double tabA[8] = {0.0, 0.0, 1.0, 1.0, 2.0, 4.0, 3.0, 9.0};
+    double tabB[8] = {0.0, 0.0, 1.0, 1.0, 2.0, 4.0, 3.0, 9.0};
+    /* Different values of equal hash (HASH_JEN on little-endian platforms) */
+    double tabC[4] = {0.0, 20598.0, 1.0, 2.0};
+    double tabD[4] = {0.0, 78400.0, 1.0, 2.0};
+    void *p[32];
+    size_t i;
+    double tab2D[9] = {0.0, 1.0, 2.0, 1.0, 0.0, 1.0, 2.0, 2.0, 3.0};
+    double tabND[19] = {0.0, 1.0, 0.0, 1.0, 3.0, 0.0, 2.0,
+        1.0, 7.0, 3.0, 9.0, 7.0, 13.0, 2.0, 8.0, 4.0, 10.0, 8.0, 14.0};
+    double tabScattered[15] = {0.0, 0.0, 1.0, 2.0, 0.0, 5.0, 0.0, 1.0, 4.0,
+        2.0, 1.0, 8.0, 1.0, 0.5, 4.5};
+    /* Values of y = u1 + 4*u2^2 at the points A, B, C and D, where D is
+       inside the circumcircle of A, B and C, such that the Delaunay
+       triangulation is ACD, BCD (and not ABC, ABD) */
+    double tabDelaunay[12] = {0.0, 0.4, 0.64, 1.0, 0.4, 1.64, 0.5, 0.0, 0.5,
+        0.5, 1.0, 4.5};
+    double u[3] = {0.5, 2.0, 1.0};
+    double der_u[3] = {1.0, 1.0, 1.0};
+    double yv[3];
     int cols[1] = {2};
-    double tmin, tmax, te, y;
+    int dims[3] = {2, 3, 2};
+    double tmin, tmax, te, y, y2;
+    void *table2;
+    void *group;
     void *table = ModelicaStandardTables_CombiTimeTable_init2("NoName", "NoName", tab, 2, 2, 0.0, cols, 1, 1, 3, 0.0, 3, 1);
     assert(table);
     tmin = ModelicaStandardTables_CombiTimeTable_minimumTime(table);
@@ -18,6 +44,139 @@ int main(int argc, char **argv) {
     te = ModelicaStandardTables_CombiTimeTable_nextTimeEvent(table, 1.5);
     y = ModelicaStandardTables_CombiTimeTable_getValue(table, 1, 1.5, te, te);
     assert(fabs(y - (1.0 + 2.0)/2) < 1e-6);
+    y = ModelicaStandardTables_CombiTimeTable_getIntegralValue(table, 1, 0.0, 2.5);
+    assert(fabs(y - (2*1.5 + 0.625)) < 1e-6);
+    y = ModelicaStandardTables_CombiTimeTable_getIntegralValue(table, 1, -1.0, 0.0);
+    assert(fabs(y) < 1e-6);
+    table2 = ModelicaStandardTables_CombiTimeTable_init2("NoName", "NoName", tab, 2, 2, 0.0, cols, 1, 1, 3, 0.0, 3, 1);
+    assert(table2);
     ModelicaStandardTables_CombiTimeTable_close(table);
+    te = ModelicaStandardTables_CombiTimeTable_nextTimeEvent(table2, 1.5);
+    y = ModelicaStandardTables_CombiTimeTable_getValue(table2, 1, 1.5, te, te);
+    assert(fabs(y - (1.0 + 2.0)/2) < 1e-6);
+    ModelicaStandardTables_CombiTimeTable_close(table2);
+    /* Equal table arrays share one copy and its spline coefficients, which
+       outlive the closed table */
+    table = ModelicaStandardTables_CombiTable1D_init2("NoName", "NoName", tabA, 4, 2, cols, 1, 2, 2, 1);
+    assert(table);
+    y = ModelicaStandardTables_CombiTable1D_getValue(table, 1, 1.5);
+    assert(fabs(y - 2.5) > 1e-3);
+    table2 = ModelicaStandardTables_CombiTable1D_init2("NoName", "NoName", tabB, 4, 2, cols, 1, 2, 2, 1);
+    assert(table2);
+    memset(tabA, 0, sizeof(tabA));
+    memset(tabB, 0, sizeof(tabB));
+    ModelicaStandardTables_CombiTable1D_close(table);
+    for (i = 0; i < 32; i++) {
+        /* Reuse the memory of anything freed too early */
+        p[i] = malloc(16*(i + 1));
+        assert(p[i]);
+        memset(p[i], 0xff, 16*(i + 1));
+    }
+    y2 = ModelicaStandardTables_CombiTable1D_getValue(table2, 1, 1.5);
+    assert(y2 == y);
+    y2 = ModelicaStandardTables_CombiTable1D_getValue(table2, 1, 3.0);
+    assert(fabs(y2 - 9.0) < 1e-6);
+    for (i = 0; i < 32; i++) {
+        free(p[i]);
+    }
+    ModelicaStandardTables_CombiTable1D_close(table2);
+    /* Table arrays of equal hash, but different values are not shared */
+    table = ModelicaStandardTables_CombiTable1D_init2("NoName", "NoName", tabC, 2, 2, cols, 1, 1, 2, 1);
+    assert(table);
+    table2 = ModelicaStandardTables_CombiTable1D_init2("NoName", "NoName", tabD, 2, 2, cols, 1, 1, 2, 1);
+    assert(table2);
+    y = ModelicaStandardTables_CombiTable1D_getValue(table, 1, 0.0);
+    assert(fabs(y - 20598.0) < 1e-6);
+    y = ModelicaStandardTables_CombiTable1D_getValue(table2, 1, 0.0);
+    assert(fabs(y - 78400.0) < 1e-6);
+    ModelicaStandardTables_CombiTable1D_close(table);
+    ModelicaStandardTables_CombiTable1D_close(table2);
+    table = ModelicaStandardTables_CombiTimeTable_init2("NoName", "NoName", tab3, 5, 2, 0.0, cols, 1, 1, 1, 0.0, 1, 1);
+    assert(table);
+    te = ModelicaStandardTables_CombiTimeTable_nextTimeEvent(table, 0.5);
+    assert(te == 1.0);
+    te = ModelicaStandardTables_CombiTimeTable_nextTimeEvent(table, 2.5);
+    assert(te == 3.0);
+    te = ModelicaStandardTables_CombiTimeTable_nextTimeEvent(table, 0.5);
+    assert(te == 1.0);
+    table2 = ModelicaStandardTables_CombiTimeTable_init2("NoName", "NoName", tab3, 5, 2, 0.0, cols, 1, 1, 1, 0.5, 1, 1);
+    assert(table2);
+    group = ModelicaStandardTables_group_init();
+    assert(group);
+    ModelicaStandardTables_CombiTimeTable_joinGroup(table, group);
+    ModelicaStandardTables_CombiTimeTable_joinGroup(table2, group);
+    te = ModelicaStandardTables_group_nextTimeEvent(group, 0.0);
+    assert(te == 0.5);
+    te = ModelicaStandardTables_group_nextTimeEvent(group, te);
+    assert(te == 1.0);
+    te = ModelicaStandardTables_group_nextTimeEvent(group, te);
+    assert(te == 1.5);
+    ModelicaStandardTables_CombiTimeTable_close(table);
+    te = ModelicaStandardTables_group_nextTimeEvent(group, te);
+    assert(te == 2.5);
+    ModelicaStandardTables_CombiTimeTable_close(table2);
+    te = ModelicaStandardTables_group_nextTimeEvent(group, te);
+    assert(te == DBL_MAX);
+    ModelicaStandardTables_group_close(group);
+    table = ModelicaStandardTables_CombiTable1D_init2("NoName", "NoName", tab1D, 3, 2, cols, 1, 1, 2, 1);
+    assert(table);
+    y = ModelicaStandardTables_CombiTable1D_getInverseValue(table, 1, 2.5);
+    assert(fabs(y - 1.5) < 1e-6);
+    y = ModelicaStandardTables_CombiTable1D_getInverseValue(table, 1, 7.0);
+    assert(fabs(y - 3.0) < 1e-6);
+    ModelicaStandardTables_CombiTable1D_resample(table, u, 3, yv);
+    assert(fabs(yv[0] - 0.5) < 1e-6 && fabs(yv[1] - 4.0) < 1e-6 && fabs(yv[2] - 1.0) < 1e-6);
+    ModelicaStandardTables_CombiTable1D_close(table);
+    table = ModelicaStandardTables_CombiTable1D_init2("NoName", "NoName", tab1D, 3, 2, cols, 1, 4, 2, 1);
+    assert(table);
+    y = ModelicaStandardTables_CombiTable1D_getInverseValue(table, 1, 2.5);
+    y = ModelicaStandardTables_CombiTable1D_getValue(table, 1, y);
+    assert(fabs(y - 2.5) < 1e-6);
+    ModelicaStandardTables_CombiTable1D_close(table);
+    table = ModelicaStandardTables_CombiTable2D_init2("NoName", "NoName", tab2D, 3, 3, 1, 2, 1);
+    assert(table);
+    y = ModelicaStandardTables_CombiTable2D_getValue(table, 1.5, 1.5);
+    assert(fabs(y - 1.5) < 1e-6);
+    y = ModelicaStandardTables_CombiTable2D_getValue(table, 2.0, 1.0);
+    assert(fabs(y - 2.0) < 1e-6);
+    ModelicaStandardTables_CombiTable2D_close(table);
+    table = ModelicaStandardTables_CombiTableND_init("NoName", "NoName", tabND, 19, dims, 3, 1, 2, 0, ",", 0);
+    assert(table);
+    y = ModelicaStandardTables_CombiTableND_getValue(table, u, 3);
+    assert(fabs(y - 8.5) < 1e-6);
+    y = ModelicaStandardTables_CombiTableND_getDerValue(table, u, der_u, 3);
+    assert(fabs(y - 6.0) < 1e-6);
+    ModelicaStandardTables_CombiTableND_close(table);
+    table = ModelicaStandardTables_CombiTableND_init("NoName", "NoName", tabND, 19, dims, 3, 2, 2, 0, ",", 0);
+    assert(table);
+    y = ModelicaStandardTables_CombiTableND_getValue(table, u, 3);
+    assert(fabs(y - 8.5) < 1e-6);
+    u[0] = 2.0;
+    u[1] = 4.0;
+    u[2] = -1.0;
+    y = ModelicaStandardTables_CombiTableND_getValue(table, u, 3);
+    assert(fabs(y - 8.0) < 1e-6);
+    ModelicaStandardTables_CombiTableND_close(table);
+    table = ModelicaStandardTables_CombiTableScattered2D_init("NoName", "NoName", tabScattered, 5, 3, 1, 2, 0, ",", 0);
+    assert(table);
+    y = ModelicaStandardTables_CombiTableScattered2D_getValue(table, 1, 1.5, 0.25);
+    assert(fabs(y - 4.75) < 1e-6);
+    y = ModelicaStandardTables_CombiTableScattered2D_getDerValue(table, 1, 1.5, 0.25, 1.0, 1.0);
+    assert(fabs(y - 5.0) < 1e-6);
+    y = ModelicaStandardTables_CombiTableScattered2D_getValue(table, 1, 3.0, 2.0);
+    assert(fabs(y - 13.0) < 1e-6);
+    ModelicaStandardTables_CombiTableScattered2D_close(table);
+    table = ModelicaStandardTables_CombiTableScattered2D_init("NoName", "NoName", tabDelaunay, 4, 3, 1, 1, 0, ",", 0);
+    assert(table);
+    /* Triangle ACD, again ACD (last located triangle), BCD, ACD */
+    y = ModelicaStandardTables_CombiTableScattered2D_getValue(table, 1, 0.4, 0.45);
+    assert(fabs(y - 2.008) < 1e-6);
+    y = ModelicaStandardTables_CombiTableScattered2D_getValue(table, 1, 0.45, 0.5);
+    assert(fabs(y - 2.354) < 1e-6);
+    y = ModelicaStandardTables_CombiTableScattered2D_getValue(table, 1, 0.6, 0.45);
+    assert(fabs(y - 2.208) < 1e-6);
+    y = ModelicaStandardTables_CombiTableScattered2D_getValue(table, 1, 0.4, 0.45);
+    assert(fabs(y - 2.008) < 1e-6);
+    ModelicaStandardTables_CombiTableScattered2D_close(table);
     return 0;
 }
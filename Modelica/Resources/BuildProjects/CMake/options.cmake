@@ -4,12 +4,42 @@ option(MODELICA_DEBUG_TIME_EVENTS "Trace time events of CombiTimeTable" OFF)
 # Option to share table arrays
 option(
   MODELICA_SHARE_TABLE_DATA
-  "Store shared table arrays (read from file) in a global hash table" ON
+  "Store shared table arrays (read from file or equal by content) in a global hash table" ON
 )
 
 # Option to deep-copy table arrays
 option(MODELICA_COPY_TABLE_DATA "Deep-copy table arrays (passed as array)" ON)
 
+# Option to calculate spline coefficients in parallel
+option(
+  MODELICA_PARALLEL_SPLINE_INIT
+  "Calculate the spline coefficients of large tables in parallel (requires OpenMP)" OFF
+)
+
+# Option to load table files asynchronously
+option(
+  MODELICA_ASYNC_TABLE_LOAD
+  "Load table files by worker threads at initialization (requires threads)" OFF
+)
+
+# Option to cache opened MAT-files
+option(
+  MODELICA_MAT_FILE_CACHE
+  "Keep MAT-files open for repeated reads in a process-wide cache (thread-safe if threads are available)" OFF
+)
+
+# Option to compress MAT-file variables in parallel
+option(
+  MODELICA_MAT_PARALLEL_DEFLATE
+  "Compress large variables of v7 MAT-files in blocks by worker threads (requires threads)" OFF
+)
+
+# Option to map MAT-files opened for reading into memory
+option(
+  MODELICA_MAT_READ_MMAP
+  "Read MAT-files opened read-only through a memory mapping instead of a read buffer" OFF
+)
+
 # Option to add a dummy function "usertab"
 option(MODELICA_DUMMY_FUNCTION_USERTAB "Add a dummy usertab function" OFF)
 
@@ -98,6 +98,7 @@ set(MATIO_SOURCES
   "${MODELICA_SOURCE_DIR}/safe-math.h"
   "${MODELICA_SOURCE_DIR}/snprintf.c"
   "${MODELICA_SOURCE_DIR}/stdint_msvc.h"
+  "${MODELICA_SOURCE_DIR}/uthash.h"
   "${ZLIB_INCLUDE_DIR}/zlib.h"
   "${MODELICA_UTILITIES_INCLUDE_DIR}/ModelicaUtilities.h"
 )
@@ -106,6 +107,10 @@ set(IO_SOURCES
   "${MODELICA_SOURCE_DIR}/ModelicaIO.c"
   "${MODELICA_SOURCE_DIR}/ModelicaIO.h"
   "${MODELICA_SOURCE_DIR}/ModelicaMatIO.h"
+  "${MODELICA_SOURCE_DIR}/g2constructor.h"
+  "${MODELICA_SOURCE_DIR}/stdint_msvc.h"
+  "${MODELICA_SOURCE_DIR}/stdint_wrap.h"
+  "${MODELICA_SOURCE_DIR}/uthash.h"
   "${MODELICA_UTILITIES_INCLUDE_DIR}/ModelicaUtilities.h"
 )
 
@@ -134,6 +139,28 @@ endif()
 if(NOT MODELICA_COPY_TABLE_DATA)
   target_compile_definitions(ModelicaStandardTables PRIVATE -DNO_TABLE_COPY=1)
 endif()
+if(MODELICA_PARALLEL_SPLINE_INIT)
+  find_package(OpenMP REQUIRED COMPONENTS C)
+  target_link_libraries(ModelicaStandardTables PUBLIC OpenMP::OpenMP_C)
+endif()
+if(MODELICA_ASYNC_TABLE_LOAD)
+  find_package(Threads REQUIRED)
+  target_compile_definitions(ModelicaStandardTables PRIVATE -DTABLE_ASYNC_LOAD=1)
+  target_link_libraries(ModelicaStandardTables PUBLIC Threads::Threads)
+endif()
+if(MODELICA_MAT_FILE_CACHE)
+  find_package(Threads REQUIRED)
+  target_compile_definitions(ModelicaIO PRIVATE -DMAT_FILE_CACHE=1)
+  target_link_libraries(ModelicaIO PUBLIC Threads::Threads)
+endif()
+if(MODELICA_MAT_PARALLEL_DEFLATE)
+  find_package(Threads REQUIRED)
+  target_compile_definitions(ModelicaMatIO PRIVATE -DMAT_PARALLEL_DEFLATE=1)
+  target_link_libraries(ModelicaMatIO PUBLIC Threads::Threads)
+endif()
+if(MODELICA_MAT_READ_MMAP)
+  target_compile_definitions(ModelicaMatIO PRIVATE -DMAT_READ_MMAP=1)
+endif()
 if(MODELICA_DUMMY_FUNCTION_USERTAB OR BUILD_TESTING)
   target_compile_definitions(ModelicaStandardTables PRIVATE -DDUMMY_FUNCTION_USERTAB=1)
 endif()
@@ -37,6 +37,8 @@ if(MODELICA_BUILD_TESTING)
         WORKING_DIRECTORY "${MODELICA_TEST_DIR}"
       )
     endforeach()
+    # Deflate by several worker threads also on runners with one processor
+    set_tests_properties(TestTablesFromMatFile PROPERTIES ENVIRONMENT "MAT_DEFLATE_THREADS=3")
   else()
     message(WARNING
       " Testsuite not found in \"${MODELICA_TEST_DIR}\"."
@@ -135,14 +135,37 @@ void ModelicaIO_readRealMatrix(_In_z_ const char* fileName,
     _In_z_ const char* matrixName, _Out_ double* matrix, size_t m, size_t n,
     int verbose) {
     ModelicaNotExistError("ModelicaIO_readRealMatrix"); }
+void ModelicaIO_readRealMatrixSlice(_In_z_ const char* fileName,
+    _In_z_ const char* matrixName, int rowStart, int rowCount, int colStart,
+    int colCount, int stride, _Out_ double* matrix) {
+    ModelicaNotExistError("ModelicaIO_readRealMatrixSlice"); }
 int ModelicaIO_writeRealMatrix(_In_z_ const char* fileName,
     _In_z_ const char* matrixName, _In_ const double* matrix, size_t m, size_t n,
     int append, _In_z_ const char* version) {
     ModelicaNotExistError("ModelicaIO_writeRealMatrix"); return 0; }
+int ModelicaIO_writeRealMatrix2(_In_z_ const char* fileName,
+    _In_z_ const char* matrixName, _In_ const double* matrix, size_t m, size_t n,
+    int append, int level, int strategy, int minSize) {
+    ModelicaNotExistError("ModelicaIO_writeRealMatrix2"); return 0; }
+int ModelicaIO_appendRealMatrixRows(_In_z_ const char* fileName,
+    _In_z_ const char* matrixName, _In_ const double* matrix, size_t m, size_t n,
+    _In_z_ const char* version) {
+    ModelicaNotExistError("ModelicaIO_appendRealMatrixRows"); return 0; }
 double* ModelicaIO_readRealTable(_In_z_ const char* fileName,
     _In_z_ const char* matrixName, _Out_ size_t* m, _Out_ size_t* n,
     int verbose) {
     ModelicaNotExistError("ModelicaIO_readRealTable"); return NULL; }
+double* ModelicaIO_readRealTableWithErrorReturn(_In_z_ const char* fileName,
+    _In_z_ const char* tableName, _Out_ size_t* m, _Out_ size_t* n,
+    _In_z_ const char* delimiter, int nHeaderLines, _Out_ char* message,
+    size_t messageSize) {
+    strncpy(message, "C-Function \"ModelicaIO_readRealTableWithErrorReturn\" "
+        "is called but is not implemented for the actual environment\n",
+        messageSize - 1);
+    message[messageSize - 1] = '\0';
+    *m = 0;
+    *n = 0;
+    return NULL; }
 #else
 
 #include <stdio.h>
@@ -176,10 +199,79 @@ double* ModelicaIO_readRealTable(_In_z_ const char* fileName,
 #define MATLAB_NAME_LENGTH_MAX (64)
 #endif
 
+#if defined(MAT_FILE_CACHE)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "stdint_wrap.h"
+#define HASH_NO_STDINT 1
+#define HASH_NONFATAL_OOM 1
+#include "uthash.h"
+#include "g2constructor.h"
+
+#if !defined(MAT_FILE_CACHE_SIZE)
+/* Maximum number of MAT-files kept open in the cache */
+#define MAT_FILE_CACHE_SIZE (8)
+#endif
+
+#if defined(_WIN32)
+typedef struct _stat MatFileStat;
+#define statMatFile(fileName, st) _stat((fileName), (st))
+#else
+typedef struct stat MatFileStat;
+#define statMatFile(fileName, st) stat((fileName), (st))
+#endif
+
+/* Nanoseconds of the modification time (if available) */
+#if defined(__APPLE__)
+#define MAT_FILE_MTIME_NSEC(st) ((st).st_mtimespec.tv_nsec)
+#elif defined(_POSIX_VERSION) && _POSIX_VERSION >= 200809L
+#define MAT_FILE_MTIME_NSEC(st) ((st).st_mtim.tv_nsec)
+#else
+#define MAT_FILE_MTIME_NSEC(st) 0
+#endif
+
+typedef struct MatFileVar {
+    char* name; /* Key: Name of the variable */
+    matvar_t* matvar; /* MAT-file variable information (with offset of data) */
+    UT_hash_handle hh; /* Hashable structure */
+} MatFileVar;
+
+typedef struct MatFileEntry {
+    char* fileName; /* Key: Name of the MAT-file */
+    mat_t* mat; /* Pointer to opened MAT-file */
+    MatFileStat st; /* File status when opened */
+    long writeCount; /* Number of MAT-files written by MatIO when opened */
+    int inUse; /* = 1, if checked out by a reader */
+    int stale; /* = 1, if no longer in the cache and to be freed by its reader */
+    MatFileVar* vars; /* Directory of the variables read so far */
+    UT_hash_handle hh; /* Hashable structure (in least recently used order) */
+} MatFileEntry;
+
+static MatFileEntry* matFileCache = NULL;
+#if defined(_POSIX_) && !defined(NO_MUTEX)
+#include <pthread.h>
+static pthread_mutex_t matFileCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+#define CACHE_LOCK() pthread_mutex_lock(&matFileCacheMutex)
+#define CACHE_UNLOCK() pthread_mutex_unlock(&matFileCacheMutex)
+#elif defined(_WIN32)
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+static SRWLOCK matFileCacheLock = SRWLOCK_INIT;
+#define CACHE_LOCK() AcquireSRWLockExclusive(&matFileCacheLock)
+#define CACHE_UNLOCK() ReleaseSRWLockExclusive(&matFileCacheLock)
+#else
+#define CACHE_LOCK()
+#define CACHE_UNLOCK()
+#endif
+#endif
+
 typedef struct MatIO {
     mat_t* mat; /* Pointer to MAT-file */
     matvar_t* matvar; /* Pointer to MAT-file variable for data */
     matvar_t* matvarRoot; /* Pointer to MAT-file variable for free */
+    struct MatFileEntry* entry; /* Checked out cache entry of MAT-file (or NULL) */
 } MatIO;
 
 static double* readMatTable(_In_z_ const char* fileName, _In_z_ const char* tableName,
@@ -197,6 +289,61 @@ static void readRealMatIO(_In_z_ const char* fileName, _In_z_ const char* matrix
                           _Inout_ MatIO* matio);
   /* Read a real variable from a MATLAB MAT-file using MatIO functions */
 
+static void openMatIO(_In_z_ const char* fileName, _Inout_ MatIO* matio);
+  /* Open a MATLAB MAT-file for reading or check out its cached handle
+
+     <- matio->mat: Pointer to MAT-file (NULL, if not possible to open)
+  */
+
+static matvar_t* readMatIOInfo(_In_z_ const char* name, _Inout_ MatIO* matio);
+  /* Read the information of a variable from the opened MATLAB MAT-file
+     or from the directory of its cached handle
+
+     <- RETURN: Pointer to MAT-file variable (NULL, if not found). It is
+                owned by the directory or else by matio->matvarRoot.
+  */
+
+static void closeMatIO(_Inout_ MatIO* matio);
+  /* Free the variable and close the MATLAB MAT-file or release its cached
+     handle, and reset all fields of matio
+  */
+
+static int writeRealMatrix(_In_z_ const char* fileName,
+                           _In_z_ const char* matrixName,
+                           _In_ const double* matrix, size_t m, size_t n,
+                           int append, _In_z_ const char* version, int level,
+                           int strategy, size_t minSize, int sample) MODELICA_NONNULLATTR;
+  /* Write matrix to file with the compression policy of Mat_SetCompression
+     (see ModelicaIO_writeRealMatrix2)
+
+     <- RETURN: = 1: if successful, = 0: otherwise
+  */
+
+static int getMatVersion(_In_z_ const char* version, _Out_ enum mat_ft* matv,
+                         _Out_ enum matio_compression* matc) MODELICA_NONNULLATTR;
+  /* Get MAT-file version and compression of a version string ("4", "6",
+     "7" or "7.3")
+
+     <- RETURN: = 1: if version is valid, = 0: otherwise
+  */
+
+#if defined(MAT_FILE_CACHE)
+static void freeMatFileEntry(_Inout_ MatFileEntry* entry);
+  /* Free the directory and close the MATLAB MAT-file of a cache entry */
+
+static void invalidateMatFileEntry(_In_z_ const char* fileName);
+  /* Remove the cache entry of a MATLAB MAT-file (before it is written) */
+
+static int isMatFileModified(_In_ const MatFileEntry* entry,
+                             _In_ const MatFileStat* st, long writeCount);
+  /* Check if the MATLAB MAT-file of a cache entry was modified since it
+     was opened, that is, if the file status differs or any MAT-file was
+     written by MatIO in the meantime
+
+     <- RETURN: = 1: if modified, = 0: otherwise
+  */
+#endif
+
 static double* readCsvTable(_In_z_ const char* fileName, _In_z_ const char* tableName,
                             _Out_ size_t* m, _Out_ size_t* n, _In_z_ const char* delimiter,
                             int nHeaderLines) MODELICA_NONNULLATTR;
@@ -218,8 +365,20 @@ static int readLine(_In_ char** buf, _In_ int* bufLen, _In_ FILE* fp) MODELICA_N
 static int IsNumber(char* token);
   /*  Check, whether a token represents a floating-point number */
 
-static void transpose(_Inout_ double* table, size_t nRow, size_t nCol) MODELICA_NONNULLATTR;
-  /* Cycle-based in-place array transposition */
+static void reportError(_In_z_ const char* string);
+  /* Report an error by Mat_Critical, which calls ModelicaError unless the
+     messages of the calling thread are redirected by Mat_SetThreadLogBuffer
+  */
+
+static void reportFormatError(_In_z_ const char* format, ...);
+  /* Report an error by Mat_VCritical, which calls ModelicaFormatError unless
+     the messages of the calling thread are redirected by Mat_SetThreadLogBuffer
+  */
+
+static void reportFormatWarning(_In_z_ const char* format, ...);
+  /* Report a warning by Mat_VWarning, which calls ModelicaFormatWarning unless
+     the messages of the calling thread are redirected by Mat_SetThreadLogBuffer
+  */
 
 #if defined(__clang__)
 #pragma clang diagnostic push
@@ -229,7 +388,7 @@ static void transpose(_Inout_ double* table, size_t nRow, size_t nCol) MODELICA_
 void ModelicaIO_readMatrixSizes(_In_z_ const char* fileName,
                                 _In_z_ const char* matrixName,
                                 _Out_ int* dim) {
-    MatIO matio = {NULL, NULL, NULL};
+    MatIO matio = {NULL, NULL, NULL, NULL};
 
     dim[0] = 0;
     dim[1] = 0;
@@ -242,15 +401,14 @@ void ModelicaIO_readMatrixSizes(_In_z_ const char* fileName,
         dim[1] = (int)matvar->dims[1];
     }
 
-    Mat_VarFree(matio.matvarRoot);
-    (void)Mat_Close(matio.mat);
+    closeMatIO(&matio);
 }
 
 void ModelicaIO_readRealMatrix(_In_z_ const char* fileName,
                                _In_z_ const char* matrixName,
                                _Inout_ double* matrix, size_t m, size_t n,
                                int verbose) {
-    MatIO matio = {NULL, NULL, NULL};
+    MatIO matio = {NULL, NULL, NULL, NULL};
     int readError = 0;
 
     if (verbose == 1) {
@@ -265,9 +423,8 @@ void ModelicaIO_readRealMatrix(_In_z_ const char* fileName,
 
         /* Check if number of rows matches */
         if (m != matvar->dims[0]) {
-            Mat_VarFree(matio.matvarRoot);
-            (void)Mat_Close(matio.mat);
-            ModelicaFormatError(
+            closeMatIO(&matio);
+            reportFormatError(
                 "Cannot read %lu rows of array \"%s(%lu,%lu)\" "
                 "from file \"%s\"\n", (unsigned long)m, matrixName,
                 (unsigned long)matvar->dims[0], (unsigned long)matvar->dims[1],
@@ -277,9 +434,8 @@ void ModelicaIO_readRealMatrix(_In_z_ const char* fileName,
 
         /* Check if number of columns matches */
         if (n != matvar->dims[1]) {
-            Mat_VarFree(matio.matvarRoot);
-            (void)Mat_Close(matio.mat);
-            ModelicaFormatError(
+            closeMatIO(&matio);
+            reportFormatError(
                 "Cannot read %lu columns of array \"%s(%lu,%lu)\" "
                 "from file \"%s\"\n", (unsigned long)n, matrixName,
                 (unsigned long)matvar->dims[0], (unsigned long)matvar->dims[1],
@@ -297,26 +453,126 @@ void ModelicaIO_readRealMatrix(_In_z_ const char* fileName,
         }
     }
 
-    Mat_VarFree(matio.matvarRoot);
-    (void)Mat_Close(matio.mat);
+    closeMatIO(&matio);
 
     if (readError == 0 && NULL != matrix) {
         /* Array is stored column-wise -> need to transpose */
-        transpose(matrix, m, n);
+        ModelicaIO_transposeRealMatrixInPlace(matrix, n, m);
     }
     else {
-        ModelicaFormatError(
+        reportFormatError(
             "Error when reading numeric data of matrix \"%s(%lu,%lu)\" "
             "from file \"%s\"\n", matrixName, (unsigned long)m,
             (unsigned long)n, fileName);
     }
 }
 
+void ModelicaIO_readRealMatrixSlice(_In_z_ const char* fileName,
+                                    _In_z_ const char* matrixName,
+                                    int rowStart, int rowCount,
+                                    int colStart, int colCount, int stride,
+                                    _Inout_ double* matrix) {
+    MatIO matio = {NULL, NULL, NULL, NULL};
+    int readError = 0;
+
+    if (rowStart < 1 || rowCount < 0 || colStart < 1 || colCount < 0 || stride < 1) {
+        reportFormatError(
+            "Invalid slice (rowStart = %d, rowCount = %d, colStart = %d, "
+            "colCount = %d, stride = %d) of array \"%s\" from file \"%s\"\n",
+            rowStart, rowCount, colStart, colCount, stride, matrixName, fileName);
+        return;
+    }
+
+    readRealMatIO(fileName, matrixName, &matio);
+    if (NULL != matio.matvar) {
+        matvar_t* matvar = matio.matvar;
+
+        /* Check if the rows are within the matrix */
+        if (rowCount > 0 && (size_t)(rowStart - 1) +
+            (size_t)(rowCount - 1)*(size_t)stride >= matvar->dims[0]) {
+            closeMatIO(&matio);
+            reportFormatError(
+                "Cannot read %d rows from row %d with stride %d of array "
+                "\"%s(%lu,%lu)\" from file \"%s\"\n", rowCount, rowStart, stride,
+                matrixName, (unsigned long)matvar->dims[0],
+                (unsigned long)matvar->dims[1], fileName);
+            return;
+        }
+
+        /* Check if the columns are within the matrix */
+        if (colCount > 0 && (size_t)(colStart - 1) + (size_t)colCount > matvar->dims[1]) {
+            closeMatIO(&matio);
+            reportFormatError(
+                "Cannot read %d columns from column %d of array "
+                "\"%s(%lu,%lu)\" from file \"%s\"\n", colCount, colStart,
+                matrixName, (unsigned long)matvar->dims[0],
+                (unsigned long)matvar->dims[1], fileName);
+            return;
+        }
+
+        if (rowCount > 0 && colCount > 0) {
+            /* Only the requested elements are read (by seeking in an
+               uncompressed file)
+            */
+            int start[2];
+            int stride2[2];
+            int edge[2];
+            start[0] = rowStart - 1;
+            start[1] = colStart - 1;
+            stride2[0] = stride;
+            stride2[1] = 1;
+            edge[0] = rowCount;
+            edge[1] = colCount;
+            readError = Mat_VarReadData(matio.mat, matvar, matrix, start, stride2, edge);
+        }
+    }
+    else {
+        readError = 1;
+    }
+
+    closeMatIO(&matio);
+
+    if (readError == 0) {
+        /* Array is stored column-wise -> need to transpose */
+        ModelicaIO_transposeRealMatrixInPlace(matrix, (size_t)colCount, (size_t)rowCount);
+    }
+    else {
+        reportFormatError(
+            "Error when reading rows %d to %d (stride %d) and columns %d to %d "
+            "of matrix \"%s\" from file \"%s\"\n", rowStart,
+            rowStart + (rowCount - 1)*stride, stride, colStart,
+            colStart + colCount - 1, matrixName, fileName);
+    }
+}
+
 int ModelicaIO_writeRealMatrix(_In_z_ const char* fileName,
                                _In_z_ const char* matrixName,
                                _In_ const double* matrix, size_t m, size_t n,
                                int append,
                                _In_z_ const char* version) {
+    return writeRealMatrix(fileName, matrixName, matrix, m, n, append, version,
+        -1, 0, 0, 0);
+}
+
+int ModelicaIO_writeRealMatrix2(_In_z_ const char* fileName,
+                                _In_z_ const char* matrixName,
+                                _In_ const double* matrix, size_t m, size_t n,
+                                int append, int level, int strategy,
+                                int minSize) {
+    if (level < 0 || level > 9 || strategy < 0 || strategy > 3) {
+        reportFormatError("Invalid compression level %d or strategy %d for "
+            "file \"%s\"\n", level, strategy, fileName);
+        return 0;
+    }
+    return writeRealMatrix(fileName, matrixName, matrix, m, n, append, "7",
+        level, strategy, minSize > 0 ? (size_t)minSize : 0, 1);
+}
+
+static int writeRealMatrix(_In_z_ const char* fileName,
+                           _In_z_ const char* matrixName,
+                           _In_ const double* matrix, size_t m, size_t n,
+                           int append, _In_z_ const char* version, int level,
+                           int strategy, size_t minSize, int sample) {
     int status;
     mat_t* mat;
     matvar_t* matvar;
@@ -325,37 +581,24 @@ int ModelicaIO_writeRealMatrix(_In_z_ const char* fileName,
     enum mat_ft matv;
     enum matio_compression matc;
 
-    if ((0 != strcmp(version, "4")) && (0 != strcmp(version, "6")) && (0 != strcmp(version, "7")) && (0 != strcmp(version, "7.3"))) {
-        ModelicaFormatError("Invalid version %s for file \"%s\"\n", version, fileName);
+    if (0 == getMatVersion(version, &matv, &matc)) {
+        reportFormatError("Invalid version %s for file \"%s\"\n", version, fileName);
         return 0;
     }
-    if (0 == strcmp(version, "4")) {
-        matv = MAT_FT_MAT4;
-        matc = MAT_COMPRESSION_NONE;
-    }
-    else if (0 == strcmp(version, "7.3")) {
-        matv = MAT_FT_MAT73;
-        matc = MAT_COMPRESSION_ZLIB;
-    }
-    else if (0 == strcmp(version, "7")) {
-        matv = MAT_FT_MAT5;
-        matc = MAT_COMPRESSION_ZLIB;
-    }
-    else {
-        matv = MAT_FT_MAT5;
-        matc = MAT_COMPRESSION_NONE;
-    }
 
+#if defined(MAT_FILE_CACHE)
+    invalidateMatFileEntry(fileName);
+#endif
     if (append == 0) {
         mat = Mat_CreateVer(fileName, NULL, matv);
         if (NULL == mat) {
-            ModelicaFormatError("Not possible to newly create file \"%s\"\n(maybe version 7.3 not supported)\n", fileName);
+            reportFormatError("Not possible to newly create file \"%s\"\n(maybe version 7.3 not supported)\n", fileName);
             return 0;
         }
     } else {
         mat = Mat_Open(fileName, (int)MAT_ACC_RDWR | matv);
         if (NULL == mat) {
-            ModelicaFormatError("Not possible to open file \"%s\"\n", fileName);
+            reportFormatError("Not possible to open file \"%s\"\n", fileName);
             return 0;
         }
     }
@@ -364,16 +607,17 @@ int ModelicaIO_writeRealMatrix(_In_z_ const char* fileName,
     aT = (double*)malloc(m*n*sizeof(double));
     if (NULL == aT) {
         (void)Mat_Close(mat);
-        ModelicaError("Memory allocation error\n");
+        reportError("Memory allocation error\n");
         return 0;
     }
-    memcpy(aT, matrix, m*n*sizeof(double));
-    transpose(aT, n, m);
+    ModelicaIO_transposeRealMatrix(matrix, m, n, aT);
 
     if (append != 0) {
         (void)Mat_VarDelete(mat, matrixName);
     }
 
+    (void)Mat_SetCompression(mat, level, (enum matio_deflate_strategy)strategy,
+        minSize, sample);
     dims[0] = m;
     dims[1] = n;
     matvar = Mat_VarCreate(matrixName, MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, aT, MAT_F_DONT_COPY_DATA);
@@ -382,7 +626,70 @@ int ModelicaIO_writeRealMatrix(_In_z_ const char* fileName,
     (void)Mat_Close(mat);
     free(aT);
     if (status != 0) {
-        ModelicaFormatError("Cannot write variable \"%s\" to \"%s\"\n", matrixName, fileName);
+        reportFormatError("Cannot write variable \"%s\" to \"%s\"\n", matrixName, fileName);
+        return 0;
+    }
+    return 1;
+}
+
+int ModelicaIO_appendRealMatrixRows(_In_z_ const char* fileName,
+                                    _In_z_ const char* matrixName,
+                                    _In_ const double* matrix, size_t m, size_t n,
+                                    _In_z_ const char* version) {
+    int status;
+    mat_t* mat;
+    matvar_t* matvar;
+    size_t dims[2];
+    double* aT;
+    enum mat_ft matv;
+    enum matio_compression matc;
+    FILE* fp;
+
+    if (0 == getMatVersion(version, &matv, &matc)) {
+        reportFormatError("Invalid version %s for file \"%s\"\n", version, fileName);
+        return 0;
+    }
+
+#if defined(MAT_FILE_CACHE)
+    invalidateMatFileEntry(fileName);
+#endif
+    fp = fopen(fileName, "rb");
+    if (NULL == fp) {
+        mat = Mat_CreateVer(fileName, NULL, matv);
+        if (NULL == mat) {
+            reportFormatError("Not possible to newly create file \"%s\"\n(maybe version 7.3 not supported)\n", fileName);
+            return 0;
+        }
+    }
+    else {
+        fclose(fp);
+        mat = Mat_Open(fileName, (int)MAT_ACC_RDWR | matv);
+        if (NULL == mat) {
+            reportFormatError("Not possible to open file \"%s\"\n", fileName);
+            return 0;
+        }
+    }
+
+    /* MAT file array is stored column-wise -> need to transpose */
+    aT = (double*)malloc(m*n*sizeof(double));
+    if (NULL == aT) {
+        (void)Mat_Close(mat);
+        reportError("Memory allocation error\n");
+        return 0;
+    }
+    ModelicaIO_transposeRealMatrix(matrix, m, n, aT);
+
+    dims[0] = m;
+    dims[1] = n;
+    matvar = Mat_VarCreate(matrixName, MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dims, aT, MAT_F_DONT_COPY_DATA);
+    status = Mat_VarWriteAppend(mat, matvar, matc, 1);
+    Mat_VarFree(matvar);
+    (void)Mat_Close(mat);
+    free(aT);
+    if (status != 0) {
+        reportFormatError("Cannot append %lu rows with %lu columns to variable "
+            "\"%s\" in \"%s\"\n", (unsigned long)m, (unsigned long)n,
+            matrixName, fileName);
         return 0;
     }
     return 1;
@@ -416,7 +723,7 @@ double* ModelicaIO_readRealTable2(_In_z_ const char* fileName,
             0 == strncmp(ext, ".CSV", 4)) {
             isCsvExt = 1;
             if (strlen(delimiter) != 1) {
-                ModelicaFormatError("Invalid column delimiter \"%s\", must be a single character.\n", delimiter);
+                reportFormatError("Invalid column delimiter \"%s\", must be a single character.\n", delimiter);
                 return NULL;
             }
         }
@@ -444,10 +751,65 @@ void ModelicaIO_freeRealTable(double* table) {
     free(table);
 }
 
+double* ModelicaIO_readRealTableWithErrorReturn(_In_z_ const char* fileName,
+                                                _In_z_ const char* tableName,
+                                                _Out_ size_t* m, _Out_ size_t* n,
+                                                _In_z_ const char* delimiter,
+                                                int nHeaderLines,
+                                                _Out_ char* message,
+                                                size_t messageSize) {
+    double* table;
+    if (0 != Mat_SetThreadLogBuffer(message, messageSize)) {
+        /* No thread-local storage: Errors can only be raised */
+        return ModelicaIO_readRealTable2(fileName, tableName, m, n, 0,
+            delimiter, nHeaderLines);
+    }
+    table = ModelicaIO_readRealTable2(fileName, tableName, m, n, 0,
+        delimiter, nHeaderLines);
+    (void)Mat_SetThreadLogBuffer(NULL, 0);
+    if ('\0' != message[0]) {
+        if (NULL != table) {
+            free(table);
+            table = NULL;
+        }
+        *m = 0;
+        *n = 0;
+    }
+    else if (NULL == table) {
+        strncpy(message, "Error when reading table from file\n", messageSize - 1);
+        message[messageSize - 1] = '\0';
+    }
+    return table;
+}
+
+static int getMatVersion(_In_z_ const char* version, _Out_ enum mat_ft* matv,
+                         _Out_ enum matio_compression* matc) {
+    if (0 == strcmp(version, "4")) {
+        *matv = MAT_FT_MAT4;
+        *matc = MAT_COMPRESSION_NONE;
+    }
+    else if (0 == strcmp(version, "7.3")) {
+        *matv = MAT_FT_MAT73;
+        *matc = MAT_COMPRESSION_ZLIB;
+    }
+    else if (0 == strcmp(version, "7")) {
+        *matv = MAT_FT_MAT5;
+        *matc = MAT_COMPRESSION_ZLIB;
+    }
+    else if (0 == strcmp(version, "6")) {
+        *matv = MAT_FT_MAT5;
+        *matc = MAT_COMPRESSION_NONE;
+    }
+    else {
+        return 0;
+    }
+    return 1;
+}
+
 static double* readMatTable(_In_z_ const char* fileName, _In_z_ const char* tableName,
                             _Out_ size_t* m, _Out_ size_t* n) {
     double* table = NULL;
-    MatIO matio = {NULL, NULL, NULL};
+    MatIO matio = {NULL, NULL, NULL, NULL};
     int readError = 0;
 
     *m = 0;
@@ -459,9 +821,8 @@ static double* readMatTable(_In_z_ const char* fileName, _In_z_ const char* tabl
 
         table = (double*)malloc(matvar->dims[0]*matvar->dims[1]*sizeof(double));
         if (NULL == table) {
-            Mat_VarFree(matio.matvarRoot);
-            (void)Mat_Close(matio.mat);
-            ModelicaError("Memory allocation error\n");
+            closeMatIO(&matio);
+            reportError("Memory allocation error\n");
             return NULL;
         }
 
@@ -477,12 +838,11 @@ static double* readMatTable(_In_z_ const char* fileName, _In_z_ const char* tabl
         }
     }
 
-    Mat_VarFree(matio.matvarRoot);
-    (void)Mat_Close(matio.mat);
+    closeMatIO(&matio);
 
     if (readError == 0 && NULL != table) {
         /* Array is stored column-wise -> need to transpose */
-        transpose(table, *m, *n);
+        ModelicaIO_transposeRealMatrixInPlace(table, *n, *m);
     }
     else {
         size_t dim[2];
@@ -493,7 +853,7 @@ static double* readMatTable(_In_z_ const char* fileName, _In_z_ const char* tabl
         *n = 0;
         free(table);
         table = NULL;
-        ModelicaFormatError(
+        reportFormatError(
             "Error when reading numeric data of matrix \"%s(%lu,%lu)\" "
             "from file \"%s\"\n", tableName, (unsigned long)dim[0],
             (unsigned long)dim[1], fileName);
@@ -514,9 +874,10 @@ static void readMatIO(_In_z_ const char* fileName,
     char* prevToken;
     int err = 0;
 
-    mat = Mat_Open(fileName, (int)MAT_ACC_RDONLY);
+    openMatIO(fileName, matio);
+    mat = matio->mat;
     if (NULL == mat) {
-        ModelicaFormatError("Not possible to open file \"%s\": "
+        reportFormatError("Not possible to open file \"%s\": "
             "No such file or directory\n", fileName);
         return;
     }
@@ -526,18 +887,18 @@ static void readMatIO(_In_z_ const char* fileName,
         strcpy(matrixNameCopy, matrixName);
     }
     else {
-        (void)Mat_Close(mat);
-        ModelicaError("Memory allocation error\n");
+        closeMatIO(matio);
+        reportError("Memory allocation error\n");
         return;
     }
 
     token = strtok_r(matrixNameCopy, ".", &nextToken);
-    matvarRoot = Mat_VarReadInfo(mat, NULL == token ? matrixName : token);
+    matvarRoot = readMatIOInfo(NULL == token ? matrixName : token, matio);
     if (NULL == matvarRoot) {
-        (void)Mat_Close(mat);
+        closeMatIO(matio);
         if (NULL == token) {
             free(matrixNameCopy);
-            ModelicaFormatError(
+            reportFormatError(
                 "Variable \"%s\" not found in file \"%s\".\n",
                 matrixName, fileName);
         }
@@ -554,7 +915,7 @@ static void readMatIO(_In_z_ const char* fileName,
                 dots[0] = '\0';
             }
             free(matrixNameCopy);
-            ModelicaFormatError(
+            reportFormatError(
                 "Variable \"%s%s\" not found in file \"%s\".\n",
                 matrixNameBuf, dots, fileName);
         }
@@ -589,8 +950,7 @@ static void readMatIO(_In_z_ const char* fileName,
     }
 
     if (NULL == matvar) {
-        Mat_VarFree(matvarRoot);
-        (void)Mat_Close(mat);
+        closeMatIO(matio);
         if (NULL != token) {
             char matrixNameBuf[MATLAB_NAME_LENGTH_MAX];
             char dots[4];
@@ -605,24 +965,24 @@ static void readMatIO(_In_z_ const char* fileName,
             }
             free(matrixNameCopy);
             if (1 == err) {
-                ModelicaFormatError(
+                reportFormatError(
                     "Variable \"%s%s\" of \"%s\" is not a struct array.\n",
                     matrixNameBuf, dots, matrixName);
             }
             else if (2 == err) {
-                ModelicaFormatError(
+                reportFormatError(
                     "Variable \"%s%s\" of \"%s\" is not a struct array "
                     "of rank 2.\n",  matrixNameBuf, dots, matrixName);
             }
             else if (3 == err) {
-                ModelicaFormatError(
+                reportFormatError(
                     "Variable \"%s%s\" of \"%s\" is not a 1x1 struct array.\n",
                     matrixNameBuf, dots, matrixName);
             }
         }
         else {
             free(matrixNameCopy);
-            ModelicaFormatError(
+            reportFormatError(
                 "Variable \"%s\" not found in file \"%s\".\n", matrixName, fileName);
         }
         return;
@@ -631,17 +991,14 @@ static void readMatIO(_In_z_ const char* fileName,
 
     /* Check if matvar is a matrix */
     if (matvar->rank != 2) {
-        Mat_VarFree(matvarRoot);
-        (void)Mat_Close(mat);
-        ModelicaFormatError(
+        closeMatIO(matio);
+        reportFormatError(
             "Variable \"%s\" is not of rank 2.\n", matrixName);
         return;
     }
 
-    /* Set output fields for MatIO structure */
-    matio->mat = mat;
+    /* Set output field for MatIO structure */
     matio->matvar = matvar;
-    matio->matvarRoot = matvarRoot;
 }
 
 static void readRealMatIO(_In_z_ const char* fileName,
@@ -656,9 +1013,8 @@ static void readRealMatIO(_In_z_ const char* fileName,
             matvar->class_type != MAT_C_INT16 && matvar->class_type != MAT_C_UINT16 &&
             matvar->class_type != MAT_C_INT32 && matvar->class_type != MAT_C_UINT32 &&
             matvar->class_type != MAT_C_INT64 && matvar->class_type != MAT_C_UINT64) {
-            Mat_VarFree(matio->matvarRoot);
-            (void)Mat_Close(matio->mat);
-            ModelicaFormatError("Matrix \"%s\" is not a "
+            closeMatIO(matio);
+            reportFormatError("Matrix \"%s\" is not a "
                 "numeric array.\n", matrixName);
             return;
         }
@@ -666,15 +1022,260 @@ static void readRealMatIO(_In_z_ const char* fileName,
 
         /* Check if matvar is purely real-valued */
         if (matvar->isComplex) {
-            Mat_VarFree(matio->matvarRoot);
-            (void)Mat_Close(matio->mat);
-            ModelicaFormatError("Matrix \"%s\" must not be complex.\n",
+            closeMatIO(matio);
+            reportFormatError("Matrix \"%s\" must not be complex.\n",
                 matrixName);
             return;
         }
     }
 }
 
+#if defined(MAT_FILE_CACHE)
+static void openMatIO(_In_z_ const char* fileName, _Inout_ MatIO* matio) {
+    MatFileStat st;
+    MatFileEntry* entry = NULL;
+    MatFileEntry* expired = NULL;
+    mat_t* mat;
+    const long writeCount = Mat_GetWriteCount();
+
+    if (0 != statMatFile(fileName, &st)) {
+        /* Let Mat_Open fail */
+        matio->mat = Mat_Open(fileName, (int)MAT_ACC_RDONLY);
+        return;
+    }
+
+    CACHE_LOCK();
+    HASH_FIND_STR(matFileCache, fileName, entry);
+    if (NULL != entry) {
+        if (0 != isMatFileModified(entry, &st, writeCount)) {
+            /* File was modified -> Remove outdated entry */
+            HASH_DEL(matFileCache, entry);
+            if (0 != entry->inUse) {
+                entry->stale = 1;
+            }
+            else {
+                expired = entry;
+            }
+            entry = NULL;
+        }
+        else if (0 != entry->inUse) {
+            /* Checked out by another reader -> Open file uncached */
+            entry = NULL;
+        }
+        else {
+            /* Cache hit -> Check out entry and move it to the end of the
+               least recently used order
+            */
+            entry->inUse = 1;
+            HASH_DEL(matFileCache, entry);
+            HASH_ADD_KEYPTR(hh, matFileCache, entry->fileName,
+                strlen(entry->fileName), entry);
+            if (NULL == entry->hh.tbl) {
+                entry->stale = 1;
+            }
+        }
+    }
+    CACHE_UNLOCK();
+    if (NULL != expired) {
+        freeMatFileEntry(expired);
+        expired = NULL;
+    }
+    if (NULL != entry) {
+        matio->mat = entry->mat;
+        matio->entry = entry;
+        return;
+    }
+
+    mat = Mat_Open(fileName, (int)MAT_ACC_RDONLY);
+    matio->mat = mat;
+    if (NULL == mat) {
+        return;
+    }
+
+    /* Cache miss -> Insert new entry (unless the cache is full of checked
+       out entries)
+    */
+    entry = (MatFileEntry*)calloc(1, sizeof(MatFileEntry));
+    if (NULL == entry) {
+        return;
+    }
+    entry->fileName = (char*)malloc((strlen(fileName) + 1)*sizeof(char));
+    if (NULL == entry->fileName) {
+        free(entry);
+        return;
+    }
+    strcpy(entry->fileName, fileName);
+    entry->mat = mat;
+    entry->st = st;
+    entry->writeCount = writeCount;
+    entry->inUse = 1;
+    entry->stale = 1;
+    CACHE_LOCK();
+    {
+        MatFileEntry* other = NULL;
+        HASH_FIND_STR(matFileCache, fileName, other);
+        if (NULL == other) {
+            if (HASH_COUNT(matFileCache) >= MAT_FILE_CACHE_SIZE) {
+                /* Evict least recently used entry, that is not checked out */
+                MatFileEntry* tmp;
+                HASH_ITER(hh, matFileCache, other, tmp) {
+                    if (0 == other->inUse) {
+                        HASH_DEL(matFileCache, other);
+                        expired = other;
+                        break;
+                    }
+                }
+            }
+            if (HASH_COUNT(matFileCache) < MAT_FILE_CACHE_SIZE) {
+                HASH_ADD_KEYPTR(hh, matFileCache, entry->fileName,
+                    strlen(entry->fileName), entry);
+                if (NULL != entry->hh.tbl) {
+                    entry->stale = 0;
+                }
+            }
+        }
+    }
+    CACHE_UNLOCK();
+    if (NULL != expired) {
+        freeMatFileEntry(expired);
+    }
+    matio->entry = entry;
+}
+
+static matvar_t* readMatIOInfo(_In_z_ const char* name, _Inout_ MatIO* matio) {
+    MatFileEntry* entry = matio->entry;
+    matvar_t* matvar;
+
+    if (NULL != entry) {
+        /* The directory is only accessed by the reader of the entry */
+        MatFileVar* var = NULL;
+        HASH_FIND_STR(entry->vars, name, var);
+        if (NULL != var) {
+            return var->matvar;
+        }
+    }
+
+    matvar = Mat_VarReadInfo(matio->mat, name);
+    if (NULL != matvar && NULL != entry) {
+        /* Insert variable information in directory */
+        MatFileVar* var = (MatFileVar*)malloc(sizeof(MatFileVar));
+        if (NULL != var) {
+            var->name = (char*)malloc((strlen(name) + 1)*sizeof(char));
+            if (NULL != var->name) {
+                strcpy(var->name, name);
+                var->matvar = matvar;
+                HASH_ADD_KEYPTR(hh, entry->vars, var->name,
+                    strlen(var->name), var);
+                if (NULL != var->hh.tbl) {
+                    return matvar;
+                }
+                free(var->name);
+            }
+            free(var);
+        }
+    }
+    matio->matvarRoot = matvar;
+    return matvar;
+}
+
+static void closeMatIO(_Inout_ MatIO* matio) {
+    MatFileEntry* entry = matio->entry;
+
+    Mat_VarFree(matio->matvarRoot);
+    if (NULL != entry) {
+        int stale;
+        CACHE_LOCK();
+        entry->inUse = 0;
+        stale = entry->stale;
+        CACHE_UNLOCK();
+        if (0 != stale) {
+            freeMatFileEntry(entry);
+        }
+    }
+    else {
+        (void)Mat_Close(matio->mat);
+    }
+    matio->mat = NULL;
+    matio->matvar = NULL;
+    matio->matvarRoot = NULL;
+    matio->entry = NULL;
+}
+
+static void freeMatFileEntry(_Inout_ MatFileEntry* entry) {
+    MatFileVar* var;
+    MatFileVar* tmp;
+    HASH_ITER(hh, entry->vars, var, tmp) {
+        HASH_DEL(entry->vars, var);
+        Mat_VarFree(var->matvar);
+        free(var->name);
+        free(var);
+    }
+    (void)Mat_Close(entry->mat);
+    free(entry->fileName);
+    free(entry);
+}
+
+static int isMatFileModified(_In_ const MatFileEntry* entry,
+                             _In_ const MatFileStat* st, long writeCount) {
+    return entry->writeCount != writeCount ||
+        entry->st.st_dev != st->st_dev || entry->st.st_ino != st->st_ino ||
+        entry->st.st_size != st->st_size ||
+        entry->st.st_mtime != st->st_mtime ||
+        MAT_FILE_MTIME_NSEC(entry->st) != MAT_FILE_MTIME_NSEC(*st);
+}
+
+static void invalidateMatFileEntry(_In_z_ const char* fileName) {
+    MatFileEntry* entry = NULL;
+    CACHE_LOCK();
+    HASH_FIND_STR(matFileCache, fileName, entry);
+    if (NULL != entry) {
+        HASH_DEL(matFileCache, entry);
+        if (0 != entry->inUse) {
+            entry->stale = 1;
+            entry = NULL;
+        }
+    }
+    CACHE_UNLOCK();
+    if (NULL != entry) {
+        freeMatFileEntry(entry);
+    }
+}
+
+#if defined(G2_HAS_CONSTRUCTORS)
+#ifdef G2_DEFINE_DESTRUCTOR_NEEDS_PRAGMA
+#pragma G2_DEFINE_DESTRUCTOR_PRAGMA_ARGS(G2_FUNCNAME(ModelicaIO_freeMatFileCache))
+#endif
+G2_DEFINE_DESTRUCTOR(G2_FUNCNAME(ModelicaIO_freeMatFileCache))
+static void G2_FUNCNAME(ModelicaIO_freeMatFileCache)(void) {
+    /* Close the cached MAT-files on unload */
+    MatFileEntry* entry;
+    MatFileEntry* tmp;
+    HASH_ITER(hh, matFileCache, entry, tmp) {
+        HASH_DEL(matFileCache, entry);
+        freeMatFileEntry(entry);
+    }
+}
+#endif
+#else
+static void openMatIO(_In_z_ const char* fileName, _Inout_ MatIO* matio) {
+    matio->mat = Mat_Open(fileName, (int)MAT_ACC_RDONLY);
+}
+
+static matvar_t* readMatIOInfo(_In_z_ const char* name, _Inout_ MatIO* matio) {
+    matio->matvarRoot = Mat_VarReadInfo(matio->mat, name);
+    return matio->matvarRoot;
+}
+
+static void closeMatIO(_Inout_ MatIO* matio) {
+    Mat_VarFree(matio->matvarRoot);
+    (void)Mat_Close(matio->mat);
+    matio->mat = NULL;
+    matio->matvar = NULL;
+    matio->matvarRoot = NULL;
+    matio->entry = NULL;
+}
+#endif
+
 static int IsNumber(char* token) {
     int foundExponentSign = 0;
     int foundExponent = 0;
@@ -745,7 +1346,7 @@ static double* readCsvTable(_In_z_ const char* fileName, _In_z_ const char* tabl
 
     fp = fopen(fileName, "r");
     if (NULL == fp) {
-        ModelicaFormatError("Not possible to open file \"%s\": "
+        reportFormatError("Not possible to open file \"%s\": "
             "No such file or directory\n", fileName);
         return NULL;
     }
@@ -753,7 +1354,7 @@ static double* readCsvTable(_In_z_ const char* fileName, _In_z_ const char* tabl
     buf = (char*)malloc(LINE_BUFFER_LENGTH*sizeof(char));
     if (NULL == buf) {
         fclose(fp);
-        ModelicaError("Memory allocation error\n");
+        reportError("Memory allocation error\n");
         return NULL;
     }
 
@@ -763,7 +1364,7 @@ static double* readCsvTable(_In_z_ const char* fileName, _In_z_ const char* tabl
             free(buf);
             fclose(fp);
             if (readError < 0) {
-                ModelicaFormatError(
+                reportFormatError(
                     "Error reading line %lu from file \"%s\": "
                     "End-Of-File reached.\n", lineNo, fileName);
             }
@@ -821,7 +1422,7 @@ static double* readCsvTable(_In_z_ const char* fileName, _In_z_ const char* tabl
 #elif defined(__GLIBC__) && defined(__GLIBC_MINOR__) && ((__GLIBC__ << 16) + __GLIBC_MINOR__ >= (2 << 16) + 3)
             freelocale(loc);
 #endif
-            ModelicaError("Memory allocation error\n");
+            reportError("Memory allocation error\n");
             return table;
         }
 
@@ -886,7 +1487,7 @@ static double* readCsvTable(_In_z_ const char* fileName, _In_z_ const char* tabl
                         free(buf);
                         fclose(fp);
                         readError = 1;
-                        ModelicaError("Memory allocation error\n");
+                        reportError("Memory allocation error\n");
                         break;
                     }
                 }
@@ -919,7 +1520,7 @@ static double* readCsvTable(_In_z_ const char* fileName, _In_z_ const char* tabl
         table = NULL;
         *m = 0;
         *n = 0;
-        ModelicaFormatError(
+        reportFormatError(
             "Error in line %lu when reading numeric data of matrix "
             "\"%s(%lu,%lu)\" from file \"%s\"\n", lineNo,
             tableName, nRow, nCol, fileName);
@@ -956,7 +1557,7 @@ static double* readTxtTable(_In_z_ const char* fileName, _In_z_ const char* tabl
 
     fp = fopen(fileName, "r");
     if (NULL == fp) {
-        ModelicaFormatError("Not possible to open file \"%s\": "
+        reportFormatError("Not possible to open file \"%s\": "
             "No such file or directory\n", fileName);
         return NULL;
     }
@@ -964,7 +1565,7 @@ static double* readTxtTable(_In_z_ const char* fileName, _In_z_ const char* tabl
     buf = (char*)calloc(LINE_BUFFER_LENGTH, sizeof(char));
     if (NULL == buf) {
         fclose(fp);
-        ModelicaError("Memory allocation error\n");
+        reportError("Memory allocation error\n");
         return NULL;
     }
 
@@ -973,7 +1574,7 @@ static double* readTxtTable(_In_z_ const char* fileName, _In_z_ const char* tabl
         free(buf);
         fclose(fp);
         if (readError < 0) {
-            ModelicaFormatError(
+            reportFormatError(
                 "Error reading first line from file \"%s\": "
                 "End-Of-File reached.\n", fileName);
         }
@@ -993,14 +1594,14 @@ static double* readTxtTable(_In_z_ const char* fileName, _In_z_ const char* tabl
         fclose(fp);
         if (len == 0) {
             free(buf);
-            ModelicaFormatError(
+            reportFormatError(
                 "Error reading format and version information in first "
                 "line of file \"%s\": \"#1\" expected.\n", fileName);
         }
         else if (len == 1) {
             char c0 = header[0];
             free(buf);
-            ModelicaFormatError(
+            reportFormatError(
                 "Error reading format and version information in first "
                 "line of file \"%s\": \"#1\" expected, but \"0x%02x\" found.\n",
                 fileName, (int)(c0 & 0xff));
@@ -1009,7 +1610,7 @@ static double* readTxtTable(_In_z_ const char* fileName, _In_z_ const char* tabl
             char c0 = header[0];
             char c1 = header[1];
             free(buf);
-            ModelicaFormatError(
+            reportFormatError(
                 "Error reading format and version information in first "
                 "line of file \"%s\": \"#1\" expected, but \"0x%02x0x%02x\" "
                 "found.\n", fileName, (int)(c0 & 0xff), (int)(c1 & 0xff));
@@ -1099,7 +1700,7 @@ static double* readTxtTable(_In_z_ const char* fileName, _In_z_ const char* tabl
 #elif defined(__GLIBC__) && defined(__GLIBC_MINOR__) && ((__GLIBC__ << 16) + __GLIBC_MINOR__ >= (2 << 16) + 3)
                 freelocale(loc);
 #endif
-                ModelicaError("Memory allocation error\n");
+                reportError("Memory allocation error\n");
                 return table;
             }
 
@@ -1168,7 +1769,7 @@ static double* readTxtTable(_In_z_ const char* fileName, _In_z_ const char* tabl
                             free(buf);
                             fclose(fp);
                             readError = 1;
-                            ModelicaError("Memory allocation error\n");
+                            reportError("Memory allocation error\n");
                             break;
                         }
                     }
@@ -1227,7 +1828,7 @@ static double* readTxtTable(_In_z_ const char* fileName, _In_z_ const char* tabl
                         break;
                     }
                     if (1 == tableReadPartial) {
-                        ModelicaFormatWarning(
+                        reportFormatWarning(
                             "The table dimensions of matrix \"%s(%lu,%lu)\" from file "
                             "\"%s\" do not match the actual table size (line %lu).\n",
                             tableName, nRow, nCol, fileName, lineNoPartial);
@@ -1248,13 +1849,13 @@ static double* readTxtTable(_In_z_ const char* fileName, _In_z_ const char* tabl
     freelocale(loc);
 #endif
     if (foundTable == 0) {
-        ModelicaFormatError(
+        reportFormatError(
             "Table matrix \"%s\" not found in file \"%s\".\n",
             tableName, fileName);
         return table;
     }
     if (foundDims == 0) {
-        ModelicaFormatError(
+        reportFormatError(
             "Invalid table dimensions of matrix \"%s\" found in file \"%s\".\n",
             tableName, fileName);
         return table;
@@ -1270,19 +1871,19 @@ static double* readTxtTable(_In_z_ const char* fileName, _In_z_ const char* tabl
         *m = 0;
         *n = 0;
         if (readError == EOF) {
-            ModelicaFormatError(
+            reportFormatError(
                 "End-of-file reached when reading numeric data of matrix "
                 "\"%s(%lu,%lu)\" from file \"%s\"\n", tableName, nRow,
                 nCol, fileName);
         }
         else if (readError == 2) {
-            ModelicaFormatError(
+            reportFormatError(
                 "The table dimensions of matrix \"%s(%lu,%lu)\" from file "
                 "\"%s\" do not match the actual table size (line %lu).\n",
                 tableName, nRow, nCol, fileName, lineNo);
         }
         else {
-            ModelicaFormatError(
+            reportFormatError(
                 "Error in line %lu when reading numeric data of matrix "
                 "\"%s(%lu,%lu)\" from file \"%s\"\n", lineNo, tableName,
                 nRow, nCol, fileName);
@@ -1320,9 +1921,10 @@ static int readLine(_In_ char** buf, _In_ int* bufLen, _In_ FILE* fp) {
         *bufLen *= 2;
         tmp = (char*)realloc(*buf, (size_t)*bufLen);
         if (NULL == tmp) {
-            fclose(fp);
-            free(*buf);
-            ModelicaError("Memory allocation error\n");
+            /* The buffer and file are released by the caller, since the
+               error may return (see reportError) */
+            *bufLen = oldBufLen;
+            reportError("Memory allocation error\n");
             return 1;
         }
         *buf = tmp;
@@ -1333,43 +1935,176 @@ static int readLine(_In_ char** buf, _In_ int* bufLen, _In_ FILE* fp) {
     return 0;
 }
 
-static void transpose(_Inout_ double* table, size_t nRow, size_t nCol) {
+static void reportError(_In_z_ const char* string) {
+    Mat_Critical("%s", string);
+}
+
+static void reportFormatError(_In_z_ const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    Mat_VCritical(format, args);
+    va_end(args);
+}
+
+static void reportFormatWarning(_In_z_ const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    Mat_VWarning(format, args);
+    va_end(args);
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
+
+#endif
+
+/* ----- Matrix transposition (also used without file system) ----- */
+
+#if !defined(TRANSPOSE_BLOCK_SIZE)
+#define TRANSPOSE_BLOCK_SIZE (32)
+#endif
+
+static void transposeSquareInPlace(_Inout_ double* matrix, size_t n) MODELICA_NONNULLATTR;
+  /* Blocked in-place transposition of a square matrix */
+
+static void transposeCyclesInPlace(_Inout_ double* matrix, size_t m, size_t n) MODELICA_NONNULLATTR;
+  /* Cycle-based in-place transposition of a non-square matrix */
+
+void ModelicaIO_transposeRealMatrix(_In_ const double* matrix, size_t m, size_t n,
+                                    _Out_ double* matrixT) {
+    size_t i0, j0;
+    if (m == 1 || n == 1) {
+        memcpy(matrixT, matrix, m*n*sizeof(double));
+        return;
+    }
+    /* Tiled transposition: The rows of a tile are read from matrix and the
+       rows of the transposed tile are written to matrixT while both are
+       kept in cache */
+    for (i0 = 0; i0 < m; i0 += TRANSPOSE_BLOCK_SIZE) {
+        const size_t i1 = m - i0 > TRANSPOSE_BLOCK_SIZE ?
+            i0 + TRANSPOSE_BLOCK_SIZE : m;
+        for (j0 = 0; j0 < n; j0 += TRANSPOSE_BLOCK_SIZE) {
+            const size_t j1 = n - j0 > TRANSPOSE_BLOCK_SIZE ?
+                j0 + TRANSPOSE_BLOCK_SIZE : n;
+            size_t i, j;
+            for (j = j0; j < j1; j++) {
+                double* rowT = &matrixT[j*m];
+                const double* col = &matrix[j];
+                for (i = i0; i < i1; i++) {
+                    rowT[i] = col[i*n];
+                }
+            }
+        }
+    }
+}
+
+void ModelicaIO_transposeRealMatrixInPlace(_Inout_ double* matrix, size_t m, size_t n) {
+    double* tmp;
+    if (m < 2 || n < 2) {
+        /* Nothing to do for vectors */
+        return;
+    }
+    if (m == n) {
+        transposeSquareInPlace(matrix, n);
+        return;
+    }
+    tmp = (double*)malloc(m*n*sizeof(double));
+    if (NULL != tmp) {
+        memcpy(tmp, matrix, m*n*sizeof(double));
+        ModelicaIO_transposeRealMatrix(tmp, m, n, matrix);
+        free(tmp);
+    }
+    else {
+        /* Fallback if no memory is available for the copy */
+        transposeCyclesInPlace(matrix, m, n);
+    }
+}
+
+static void transposeSquareInPlace(_Inout_ double* matrix, size_t n) {
+    size_t i0, j0;
+    for (i0 = 0; i0 < n; i0 += TRANSPOSE_BLOCK_SIZE) {
+        const size_t i1 = n - i0 > TRANSPOSE_BLOCK_SIZE ?
+            i0 + TRANSPOSE_BLOCK_SIZE : n;
+        /* Diagonal tile */
+        size_t i, j;
+        for (i = i0; i < i1; i++) {
+            for (j = i + 1; j < i1; j++) {
+                const double tmp = matrix[i*n + j];
+                matrix[i*n + j] = matrix[j*n + i];
+                matrix[j*n + i] = tmp;
+            }
+        }
+        /* Swap of the off-diagonal tiles (i0, j0) and (j0, i0) */
+        for (j0 = i1; j0 < n; j0 += TRANSPOSE_BLOCK_SIZE) {
+            const size_t j1 = n - j0 > TRANSPOSE_BLOCK_SIZE ?
+                j0 + TRANSPOSE_BLOCK_SIZE : n;
+            for (i = i0; i < i1; i++) {
+                for (j = j0; j < j1; j++) {
+                    const double tmp = matrix[i*n + j];
+                    matrix[i*n + j] = matrix[j*n + i];
+                    matrix[j*n + i] = tmp;
+                }
+            }
+        }
+    }
+}
+
+static void transposeCyclesInPlace(_Inout_ double* matrix, size_t m, size_t n) {
   /* Reference:
 
      Cycle-based in-place array transposition
      (http://en.wikipedia.org/wiki/In-place_matrix_transposition#Non-square_matrices:_Following_the_cycles)
+
+     The visited elements are marked in a bit set (of 1/64 of the matrix
+     size) to avoid walking every cycle repeatedly. Without memory for the
+     bit set, a cycle is walked to find out if it was already visited.
   */
 
+    const size_t nElem = m*n;
+    unsigned char* visited = (unsigned char*)calloc(nElem/8 + 1,
+        sizeof(unsigned char));
     size_t i;
-    for (i = 1; i < nRow*nCol - 1; i++) {
-        size_t x = nRow*(i % nCol) + i/nCol; /* predecessor of i in the cycle */
-        /* Continue if cycle is of length one or predecessor already was visited */
-        if (x <= i) {
-            continue;
-        }
-        /* Continue if cycle already was visited */
-        while (x > i) {
-            x = nRow*(x % nCol) + x/nCol;
+    for (i = 1; i < nElem - 1; i++) {
+        size_t x = n*(i % m) + i/m; /* predecessor of i in the cycle */
+        if (NULL != visited) {
+            /* Continue if cycle already was visited */
+            if (visited[i/8] & (1U << (i % 8))) {
+                continue;
+            }
         }
-        if (x < i) {
-            continue;
+        else {
+            /* Continue if cycle is of length one or predecessor already was visited */
+            if (x <= i) {
+                continue;
+            }
+            /* Continue if cycle already was visited */
+            while (x > i) {
+                x = n*(x % m) + x/m;
+            }
+            if (x < i) {
+                continue;
+            }
+            x = n*(i % m) + i/m;
         }
         {
-            double tmp = table[i];
+            double tmp = matrix[i];
             size_t s = i; /* start index in the cycle */
-            x = nRow*(i % nCol) + i/nCol; /* predecessor of i in the cycle */
             while (x != i) {
-                table[s] = table[x];
+                matrix[s] = matrix[x];
+                if (NULL != visited) {
+                    visited[s/8] |= (unsigned char)(1U << (s % 8));
+                }
                 s = x;
-                x = nRow*(x % nCol) + x/nCol;
+                x = n*(x % m) + x/m;
+            }
+            matrix[s] = tmp;
+            if (NULL != visited) {
+                visited[s/8] |= (unsigned char)(1U << (s % 8));
             }
-            table[s] = tmp;
         }
     }
+    if (NULL != visited) {
+        free(visited);
+    }
 }
-
-#if defined(__clang__)
-#pragma clang diagnostic pop
-#endif
-
-#endif
@@ -33,6 +33,12 @@
 
    NO_FILE_SYSTEM : A file system is not present (e.g. on dSPACE or xPC).
    NO_LOCALE      : locale.h is not present (e.g. on AVR).
+   MAT_FILE_CACHE : Keep MATLAB MAT-files open after reading in a process-wide
+                    cache of at most MAT_FILE_CACHE_SIZE (default: 8) files,
+                    together with the information of the variables read. A
+                    cached file is reopened if its modification time or size
+                    changed, such that repeated reads from an unmodified file
+                    neither reopen nor rescan it.
    MODELICA_EXPORT: Prefix used for function calls. If not defined, blank is used
                     Useful definition:
                     - "__declspec(dllexport)" if included in a DLL and the
@@ -75,6 +81,19 @@
 #else
 #define MODELICA_NONNULLATTR
 #endif
+/*
+ * Storage class of variables local to a thread (undefined if not supported)
+ */
+#if !defined(MODELICA_THREAD_LOCAL)
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define MODELICA_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+#define MODELICA_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define MODELICA_THREAD_LOCAL __declspec(thread)
+#endif
+#endif
+
 #if !defined(__ATTR_SAL)
 #undef _In_
 #undef _In_z_
@@ -110,6 +129,23 @@ MODELICA_EXPORT void ModelicaIO_readRealMatrix(_In_z_ const char* fileName,
      -> verbose: Print message that file is loading
   */
 
+MODELICA_EXPORT void ModelicaIO_readRealMatrixSlice(_In_z_ const char* fileName,
+                               _In_z_ const char* matrixName,
+                               int rowStart, int rowCount,
+                               int colStart, int colCount, int stride,
+                               _Inout_ double* matrix) MODELICA_NONNULLATTR;
+  /* Read a block of rows and columns of a matrix from file
+
+     -> fileName: Name of file
+     -> matrixName: Name of matrix
+     -> rowStart: First row to read (1-based)
+     -> rowCount: Number of rows to read
+     -> colStart: First column to read (1-based)
+     -> colCount: Number of columns to read
+     -> stride: Read every stride-th row, starting at rowStart (>= 1)
+     -> matrix: Output array of dimensions rowCount by colCount
+  */
+
 MODELICA_EXPORT int ModelicaIO_writeRealMatrix(_In_z_ const char* fileName,
                                _In_z_ const char* matrixName,
                                _In_ const double* matrix, size_t m, size_t n,
@@ -132,6 +168,52 @@ MODELICA_EXPORT int ModelicaIO_writeRealMatrix(_In_z_ const char* fileName,
                  = "7.3": MATLAB MAT-file of version 7.3
   */
 
+MODELICA_EXPORT int ModelicaIO_writeRealMatrix2(_In_z_ const char* fileName,
+                               _In_z_ const char* matrixName,
+                               _In_ const double* matrix, size_t m, size_t n,
+                               int append,
+                               int level, int strategy,
+                               int minSize) MODELICA_NONNULLATTR;
+  /* Write matrix to file of version "7" with a compression policy. The
+     matrix is written uncompressed if it is smaller than minSize bytes or if
+     a sample of its data does not compress by at least 1/8. If appended to
+     an existing file of version "4", the matrix is written uncompressed in
+     the format of the file.
+
+     -> fileName: Name of file
+     -> matrixName: Name of matrix
+     -> matrix: Input array of dimensions m by n
+     -> m: Number of rows
+     -> n: Number of columns
+     -> append: File append flag (see ModelicaIO_writeRealMatrix)
+     -> level: Compression level
+               = 0: no compression
+               = 1 (fastest) ... 9 (best compression)
+     -> strategy: Compression strategy
+                  = 0: default
+                  = 1: filtered (for numbers with a random distribution)
+                  = 2: Huffman coding only
+                  = 3: run-length encoding
+     -> minSize: Minimum size of the matrix in bytes to compress
+  */
+
+MODELICA_EXPORT int ModelicaIO_appendRealMatrixRows(_In_z_ const char* fileName,
+                               _In_z_ const char* matrixName,
+                               _In_ const double* matrix, size_t m, size_t n,
+                               _In_z_ const char* version) MODELICA_NONNULLATTR;
+  /* Append rows to a matrix in a file. The file and the matrix are created
+     if they do not yet exist. An uncompressed matrix (version "4" or "6")
+     that is the last variable of the file is extended in place, otherwise
+     the matrix is written anew to the end of the file.
+
+     -> fileName: Name of file
+     -> matrixName: Name of matrix
+     -> matrix: Input array of dimensions m by n
+     -> m: Number of rows to append
+     -> n: Number of columns (of the matrix in the file)
+     -> version: File version of a new file (see ModelicaIO_writeRealMatrix)
+  */
+
 MODELICA_EXPORT double* ModelicaIO_readRealTable(_In_z_ const char* fileName,
                                  _In_z_ const char* tableName,
                                  _Out_ size_t* m, _Out_ size_t* n,
@@ -173,4 +255,55 @@ MODELICA_EXPORT void ModelicaIO_freeRealTable(double* table);
      ModelicaIO_readRealTable
   */
 
+MODELICA_EXPORT double* ModelicaIO_readRealTableWithErrorReturn(_In_z_ const char* fileName,
+                                 _In_z_ const char* tableName,
+                                 _Out_ size_t* m, _Out_ size_t* n,
+                                 _In_z_ const char* delimiter,
+                                 int nHeaderLines,
+                                 _Out_ char* message,
+                                 size_t messageSize) MODELICA_NONNULLATTR;
+  /* Read matrix and its dimensions from file without calling ModelicaError
+     (or ModelicaFormatMessage, ModelicaFormatWarning), such that it can be
+     called from worker threads if thread-local storage is supported
+     (MODELICA_THREAD_LOCAL is defined). Otherwise errors are raised.
+     Note: Only called from ModelicaStandardTables, but impossible to be called
+     from a Modelica environment
+
+     -> fileName: Name of file
+     -> matrixName: Name of matrix
+     -> m: Number of rows
+     -> n: Number of columns
+     -> delimiter: Column delimiter character (CSV file only)
+     -> nHeaderLines: Number of header lines to ignore (CSV file only)
+     -> message: Buffer for the error message (empty string on success)
+     -> messageSize: Size of message buffer (> 0)
+     <- RETURN: Array of dimensions m by n or NULL on error
+  */
+
+MODELICA_EXPORT void ModelicaIO_transposeRealMatrix(_In_ const double* matrix,
+                                    size_t m, size_t n,
+                                    _Out_ double* matrixT) MODELICA_NONNULLATTR;
+  /* Transpose matrix (out-of-place, cache-blocked)
+     Note: Only called from ModelicaIO and ModelicaStandardTables, but
+     impossible to be called from a Modelica environment
+
+     -> matrix: Input array of dimensions m by n (row-wise storage)
+     -> m: Number of rows
+     -> n: Number of columns
+     -> matrixT: Output array of dimensions n by m (must not overlap with
+                 matrix)
+  */
+
+MODELICA_EXPORT void ModelicaIO_transposeRealMatrixInPlace(_Inout_ double* matrix,
+                                           size_t m, size_t n) MODELICA_NONNULLATTR;
+  /* Transpose matrix in place (by a temporary copy if memory allows)
+     Note: Only called from ModelicaIO and ModelicaStandardTables, but
+     impossible to be called from a Modelica environment
+
+     -> matrix: Array of dimensions m by n on input and of dimensions
+                n by m on output (row-wise storage)
+     -> m: Number of rows (on input)
+     -> n: Number of columns (on input)
+  */
+
 #endif
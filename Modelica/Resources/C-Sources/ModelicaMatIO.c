@@ -56,6 +56,19 @@
                    The zlib (>= v1.2.3) library is required.
    HAVE_HDF5=1   : Enables the support of v7.3 MAT-files
                    The hdf5 (>= v1.8) library is required.
+   MAT_PARALLEL_DEFLATE: Compress large numeric variables of v7 MAT-files
+                   in blocks of DEFLATE_BLOCK_SIZE (default: 1048576) bytes
+                   by at most MAX_DEFLATE_THREADS (default: 64) worker
+                   threads, one per processor or as many as given by the
+                   environment variable MAT_DEFLATE_THREADS (requires
+                   HAVE_ZLIB=1 and threads).
+   MAT_READ_MMAP : Map v4, v6 and v7 MAT-files opened read-only to memory
+                   (if supported by the system) instead of reading them in
+                   blocks of READ_BUFFER_SIZE (default: 65536) bytes. A
+                   mapped file must not be truncated while it is open.
+   MAT_NO_SIMD   : Do not use the SSE2, AVX2 or NEON instructions enabled by
+                   the compiler to swap the bytes of and to convert numeric
+                   data read from MAT-files.
 */
 
 #if !defined(NO_FILE_SYSTEM)
@@ -301,6 +314,10 @@
 #include <hdf5.h>
 #endif
 
+#define HASH_NO_STDINT 1
+#define HASH_NONFATAL_OOM 1
+#include "uthash.h"
+
 #if ( defined(_WIN64) || defined(_WIN32) ) && !defined(__CYGWIN__)
 #include <io.h>
 #endif
@@ -327,6 +344,100 @@
 #define READ_BLOCK_SIZE (8192)
 #endif
 
+/* Distance in bytes of uncompressed data between two checkpoints of the
+   decompression state of a compressed variable */
+#if !defined(INFLATE_CHECKPOINT_SPAN)
+#define INFLATE_CHECKPOINT_SPAN (1048576)
+#endif
+
+/* Maximum number of checkpoints (of about 40 KiB each) kept per MAT file. The
+   checkpoints of the other variables are dropped first, then every other
+   checkpoint of the variable currently read, doubling its span */
+#if !defined(MAX_INFLATE_CHECKPOINTS)
+#define MAX_INFLATE_CHECKPOINTS (64)
+#endif
+
+/* Size in bytes of the data sample deflated to decide if a variable is
+   worth compressing (Mat_SetCompression), taken in DEFLATE_SAMPLE_PARTS
+   evenly spaced parts */
+#if !defined(DEFLATE_SAMPLE_SIZE)
+#define DEFLATE_SAMPLE_SIZE (65536)
+#endif
+#define DEFLATE_SAMPLE_PARTS (4)
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/* Size in bytes of the buffer of a MAT-file opened read-only */
+#if !defined(READ_BUFFER_SIZE)
+#define READ_BUFFER_SIZE (65536)
+#endif
+
+#if defined(MAT_READ_MMAP)
+#if defined(_WIN32)
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <io.h>
+#define READ_MMAP 1
+#else
+#if defined(__unix__) || defined(__linux__) || defined(__APPLE_CC__)
+#include <unistd.h>
+#endif
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+#include <sys/mman.h>
+#define READ_MMAP 1
+#endif
+#endif
+#endif
+
+#if !defined(MAT_NO_SIMD)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SIMD_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SIMD_SSE2 1
+#elif defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#include <arm_neon.h>
+#define SIMD_NEON 1
+#endif
+#endif
+
+#if defined(MAT_PARALLEL_DEFLATE) && HAVE_ZLIB
+#if defined(_WIN32)
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <io.h>
+#define PARALLEL_DEFLATE 1
+#else
+#if defined(__unix__) || defined(__linux__) || defined(__APPLE_CC__)
+#include <unistd.h>
+#endif
+#if defined(_POSIX_VERSION) && !defined(NO_MUTEX)
+#include <pthread.h>
+#define PARALLEL_DEFLATE 1
+#endif
+#endif
+#endif
+
+#if defined(PARALLEL_DEFLATE)
+/* Size in bytes of the uncompressed data deflated as one block by a worker
+   thread */
+#if !defined(DEFLATE_BLOCK_SIZE)
+#define DEFLATE_BLOCK_SIZE (1048576)
+#endif
+/* Maximum number of worker threads deflating a variable */
+#if !defined(MAX_DEFLATE_THREADS)
+#define MAX_DEFLATE_THREADS (64)
+#endif
+#endif
+
 #define CAT_(X, Y) X##Y
 #define CAT(X, Y) CAT_(X, Y)
 
@@ -351,6 +462,161 @@
 #define MATIO_LE
 #endif
 
+/** @if mat_devman
+ * @brief Index entry of a variable in a version 4 or 5 MAT file
+ *
+ * @ingroup mat_internal
+ * @endif
+ */
+struct mat_index_t
+{
+    char *name;        /**< Name of the variable (key) */
+    mat_off_t offset;  /**< File position of the variable */
+    UT_hash_handle hh; /**< Hashable structure */
+};
+
+/** @if mat_devman
+ * @brief Free space of a deleted variable in a version 5 MAT file
+ *
+ * @ingroup mat_internal
+ * @endif
+ */
+struct mat_free_t
+{
+    mat_off_t offset;  /**< File position of the free space (key) */
+    mat_off_t size;    /**< Size of the free space in bytes */
+    UT_hash_handle hh; /**< Hashable structure */
+};
+
+/** @if mat_devman
+ * @brief Buffered reader of a version 4 or 5 MAT file opened read-only
+ *
+ * Holds the whole file if it is mapped to memory, or else a block of it.
+ * All reads and file positions of the file go through the reader, files
+ * opened for writing are accessed by stdio directly.
+ * @ingroup mat_internal
+ * @endif
+ */
+struct mat_reader_t
+{
+    mat_uint8_t *buf; /**< Mapped file or buffer */
+    size_t buf_size;  /**< Size of the buffer in bytes */
+    mat_off_t start;  /**< File position of the first byte of the buffer */
+    size_t len;       /**< Number of bytes in the buffer */
+    mat_off_t pos;    /**< Current file position */
+    mat_off_t size;   /**< File size in bytes */
+    int eof;          /**< 1 if a read hit the end of the file */
+    int mapped;       /**< 1 if the file is mapped to memory */
+#if defined(READ_MMAP) && defined(_WIN32)
+    HANDLE map; /**< File mapping object */
+#endif
+};
+
+/** @if mat_devman
+ * @brief Compression policy of the variables written to a version 5 MAT file
+ *
+ * @ingroup mat_internal
+ * @endif
+ */
+struct mat_deflate_policy_t
+{
+    int level;       /**< zlib compression level (-1 for the default level) */
+    int strategy;    /**< zlib strategy */
+    size_t min_size; /**< Minimum size in bytes of the data of a variable to compress */
+    int sample;      /**< 1 to write a variable uncompressed if a sample of its data
+                          does not compress, 0 otherwise */
+};
+
+#if HAVE_ZLIB
+/** @if mat_devman
+ * @brief Checkpoint of the decompression state of a compressed variable
+ *
+ * @ingroup mat_internal
+ * @endif
+ */
+struct mat_inflate_point_t
+{
+    z_streamp z;    /**< Copy of the zlib decompression state without pending input */
+    mat_off_t fpos; /**< File position of the next compressed byte */
+};
+
+/** @if mat_devman
+ * @brief Checkpoints of a compressed variable for random access of its data
+ *
+ * @ingroup mat_internal
+ * @endif
+ */
+struct mat_inflate_index_t
+{
+    mat_off_t datapos;                  /**< Data position of the variable (key) */
+    size_t npoints;                     /**< Number of checkpoints */
+    size_t size;                        /**< Number of allocated checkpoints */
+    uLong span;                         /**< Distance in bytes of uncompressed data
+                                             between two checkpoints */
+    struct mat_inflate_point_t *points; /**< Checkpoints in ascending order of
+                                             uncompressed offset (total_out) */
+    UT_hash_handle hh;                  /**< Hashable structure */
+};
+#endif
+
+#if defined(PARALLEL_DEFLATE)
+/** @if mat_devman
+ * @brief Deflated block of the data of a variable
+ *
+ * @ingroup mat_internal
+ * @endif
+ */
+struct mat_deflate_block_t
+{
+    mat_uint8_t *buf; /**< Deflated data */
+    size_t len;       /**< Size of the deflated data in bytes */
+    size_t nBytes;    /**< Size of the uncompressed data in bytes */
+    uLong adler;      /**< Adler-32 checksum of the uncompressed data */
+    int err;          /**< zlib error code */
+};
+
+/** @if mat_devman
+ * @brief Data of a variable deflated in blocks by worker threads
+ *
+ * The data is given as a sequence of segments, e.g., the data tag, the data
+ * and the padding of the real and imaginary part.
+ * @ingroup mat_internal
+ * @endif
+ */
+struct mat_deflate_t
+{
+    const mat_uint8_t *seg[6]; /**< Segments of the uncompressed data */
+    size_t seg_len[6];         /**< Sizes of the segments in bytes */
+    int nseg;                  /**< Number of segments */
+    size_t nBytes;             /**< Size of the uncompressed data in bytes */
+    int level;                 /**< zlib compression level */
+    int strategy;              /**< zlib strategy */
+    size_t nblocks;            /**< Number of blocks */
+    size_t first;              /**< First block of the current round */
+    size_t count;              /**< Number of blocks of the current round */
+    struct mat_deflate_block_t *blocks; /**< Blocks of the current round */
+};
+
+/** @if mat_devman
+ * @brief Worker deflating every stride-th block of a round
+ *
+ * @ingroup mat_internal
+ * @endif
+ */
+struct mat_deflate_worker_t
+{
+    struct mat_deflate_t *job; /**< Data to deflate */
+    size_t index;              /**< First block of the round to deflate */
+    size_t stride;             /**< Number of workers of the round */
+    int started;               /**< 1 if the worker runs in its own thread */
+#if defined(_WIN32)
+    HANDLE thread; /**< Thread of the worker */
+#else
+    pthread_t thread; /**< Thread of the worker */
+#endif
+};
+#endif
+
 /** @if mat_devman
  * @brief Matlab MAT File information
  *
@@ -374,6 +640,19 @@ struct _mat_t
     hid_t refs_id; /**< Id of the /#refs# group in HDF5 */
 #endif
     char **dir; /**< Names of the datasets in the file */
+    struct mat_index_t *index; /**< Index of the variables read so far (version 4 and 5) */
+    mat_off_t index_pos; /**< File position of the next variable to index (0 for bof,
+                              -1 if the index is disabled) */
+    struct mat_free_t *free_space; /**< Free space of the deleted variables found so far
+                                        (version 5) */
+    struct mat_deflate_policy_t deflate; /**< Compression policy (version 5) */
+    struct mat_reader_t *reader; /**< Buffered reader if opened read-only (version 4 and 5) */
+#if HAVE_ZLIB
+    struct mat_inflate_index_t *inflate_index; /**< Checkpoints of the compressed variables
+                                                    read so far (version 5) */
+    struct mat_inflate_index_t *inflate_cur; /**< Checkpoints of the compressed variable
+                                                  currently read by a slab reader */
+#endif
 };
 
 /** @if mat_devman
@@ -399,26 +678,36 @@ struct matvar_internal
 /* snprintf.c */
 #if !HAVE_SNPRINTF
 int rpl_snprintf(char *, size_t, const char *, ...);
+int rpl_vsnprintf(char *, size_t, const char *, va_list);
 #define mat_snprintf rpl_snprintf
+#define mat_vsnprintf rpl_vsnprintf
 #else
 #define mat_snprintf snprintf
+#define mat_vsnprintf vsnprintf
 #endif /* !HAVE_SNPRINTF */
 
+/* io.c */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define MAT_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+#define MAT_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define MAT_THREAD_LOCAL __declspec(thread)
+#endif
+
 /* endian.c */
-static double Mat_doubleSwap(double *a);
-static float Mat_floatSwap(float *a);
-#ifdef HAVE_MATIO_INT64_T
-static mat_int64_t Mat_int64Swap(mat_int64_t *a);
-#endif /* HAVE_MATIO_INT64_T */
-#ifdef HAVE_MATIO_UINT64_T
-static mat_uint64_t Mat_uint64Swap(mat_uint64_t *a);
-#endif /* HAVE_MATIO_UINT64_T */
 static mat_int32_t Mat_int32Swap(mat_int32_t *a);
 static mat_uint32_t Mat_uint32Swap(mat_uint32_t *a);
 static mat_int16_t Mat_int16Swap(mat_int16_t *a);
-static mat_uint16_t Mat_uint16Swap(mat_uint16_t *a);
+static void Mat_SwapArray(void *data, size_t data_size, size_t len);
 
 /* read_data.c */
+static void Mat_floatToDouble(double *out, const float *in, size_t len);
+static void Mat_int32ToDouble(double *out, const mat_int32_t *in, size_t len);
+static void Mat_int16ToDouble(double *out, const mat_int16_t *in, size_t len);
+static void Mat_uint16ToDouble(double *out, const mat_uint16_t *in, size_t len);
+static void Mat_int8ToDouble(double *out, const mat_int8_t *in, size_t len);
+static void Mat_uint8ToDouble(double *out, const mat_uint8_t *in, size_t len);
 static size_t ReadDoubleData(mat_t *mat, double *data, enum matio_types data_type, size_t len);
 static size_t ReadSingleData(mat_t *mat, float *data, enum matio_types data_type, size_t len);
 #ifdef HAVE_MATIO_INT64_T
@@ -486,11 +775,15 @@ static int ReadCompressedDataSlabN(mat_t *mat, z_streamp z, void *data,
 
 /* inflate.c */
 static int InflateSkip(mat_t *mat, z_streamp z, int nBytes, size_t *bytesread);
+static int InflateSkipIndexed(mat_t *mat, z_streamp z, int nBytes);
+static int InflateAddPoint(mat_t *mat, struct mat_inflate_index_t *index, z_streamp z);
+static void InflateFreePoints(struct mat_inflate_index_t *index, int every_other);
 static int InflateSkipData(mat_t *mat, z_streamp z, enum matio_types data_type, int len);
 static int InflateRankDims(mat_t *mat, z_streamp z, void *buf, size_t nBytes, mat_uint32_t **dims,
                            size_t *bytesread);
 static int Inflate(mat_t *mat, z_streamp z, void *buf, unsigned int nBytes, size_t *bytesread);
 static int InflateData(mat_t *mat, z_streamp z, void *buf, unsigned int nBytes);
+static size_t InflateInput(mat_t *mat, z_streamp z, mat_uint8_t *buf, size_t n);
 #endif
 
 /* mat.c */
@@ -500,9 +793,35 @@ static enum matio_types ClassType2DataType(enum matio_classes class_type);
 static int Add(size_t *res, size_t a, size_t b);
 static int Mul(size_t *res, size_t a, size_t b);
 static int Mat_MulDims(const matvar_t *matvar, size_t *nelems);
-static int Read(void *buf, size_t size, size_t count, FILE *fp, size_t *bytesread);
-static int IsEndOfFile(FILE *fp, mat_off_t *fpos);
-static int CheckSeekFile(FILE *fp, mat_off_t offset);
+static int Read(void *buf, size_t size, size_t count, mat_t *mat, size_t *bytesread);
+static int IsEndOfFile(mat_t *mat, mat_off_t *fpos);
+static int CheckSeekFile(mat_t *mat, mat_off_t offset);
+static void Mat_OpenReader(mat_t *mat);
+static void Mat_CloseReader(mat_t *mat);
+static size_t Mat_fread(void *ptr, size_t size, size_t count, mat_t *mat);
+#if HAVE_ZLIB
+static size_t Mat_freadDirect(mat_t *mat, mat_uint8_t **ptr);
+#endif
+static int Mat_fseeko(mat_t *mat, mat_off_t offset, int whence);
+static mat_off_t Mat_ftello(const mat_t *mat);
+static int Mat_feof(const mat_t *mat);
+static matvar_t *Mat_VarReadInfoIndexed(mat_t *mat, const char *name);
+static void Mat_FreeIndex(mat_t *mat);
+static int Mat_VarWriteAppend45(mat_t *mat, const matvar_t *matvar, enum matio_compression compress,
+                                int dim);
+static int Mat_VarWriteAppendInPlace(mat_t *mat, const matvar_t *existing, const matvar_t *matvar,
+                                     int dim);
+static int Mat_VarWriteAppendCopy(mat_t *mat, matvar_t *existing, const matvar_t *matvar,
+                                  enum matio_compression compress, int dim);
+static void AppendData(void *out, const void *data, const void *data2, const size_t *dims,
+                       const size_t *dims2, int dim, size_t data_size);
+static int MoveFileData(FILE *fp, mat_off_t src, mat_off_t dst, mat_off_t nBytes);
+static int Mat_Rewrite(mat_t *mat, const char *name);
+static void Mat_FreeFreeSpace(mat_t *mat);
+#if HAVE_ZLIB
+static struct mat_inflate_index_t *Mat_GetInflateIndex(mat_t *mat, mat_off_t datapos);
+static void Mat_FreeInflateIndex(mat_t *mat);
+#endif
 
 /* io.c */
 #if defined(_WIN32)
@@ -519,60 +838,6 @@ static wchar_t *utf82u(const char *src);
     b ^= a;        \
     a ^= b
 
-#ifdef HAVE_MATIO_INT64_T
-/** @brief swap the bytes of a 64-bit signed integer
- * @ingroup mat_internal
- * @param a pointer to integer to swap
- * @return the swapped integer
- */
-static mat_int64_t
-Mat_int64Swap(mat_int64_t *a)
-{
-    union {
-        mat_int8_t i1[8];
-        mat_int64_t i8;
-    } tmp;
-
-    tmp.i8 = *a;
-
-    swap(tmp.i1[0], tmp.i1[7]);
-    swap(tmp.i1[1], tmp.i1[6]);
-    swap(tmp.i1[2], tmp.i1[5]);
-    swap(tmp.i1[3], tmp.i1[4]);
-
-    *a = tmp.i8;
-
-    return *a;
-}
-#endif /* HAVE_MATIO_INT64_T */
-
-#ifdef HAVE_MATIO_UINT64_T
-/** @brief swap the bytes of a 64-bit unsigned integer
- * @ingroup mat_internal
- * @param a pointer to integer to swap
- * @return the swapped integer
- */
-static mat_uint64_t
-Mat_uint64Swap(mat_uint64_t *a)
-{
-    union {
-        mat_uint8_t i1[8];
-        mat_uint64_t i8;
-    } tmp;
-
-    tmp.i8 = *a;
-
-    swap(tmp.i1[0], tmp.i1[7]);
-    swap(tmp.i1[1], tmp.i1[6]);
-    swap(tmp.i1[2], tmp.i1[5]);
-    swap(tmp.i1[3], tmp.i1[4]);
-
-    *a = tmp.i8;
-
-    return *a;
-}
-#endif /* HAVE_MATIO_UINT64_T */
-
 /** @brief swap the bytes of a 32-bit signed integer
  * @ingroup mat_internal
  * @param a pointer to integer to swap
@@ -640,88 +905,79 @@ Mat_int16Swap(mat_int16_t *a)
     return *a;
 }
 
-/** @brief swap the bytes of a 16-bit unsigned integer
- * @ingroup mat_internal
- * @param a pointer to integer to swap
- * @return the swapped integer
- */
-static mat_uint16_t
-Mat_uint16Swap(mat_uint16_t *a)
-{
-    union {
-        mat_uint8_t i1[2];
-        mat_uint16_t i2;
-    } tmp;
-
-    tmp.i2 = *a;
-
-    swap(tmp.i1[0], tmp.i1[1]);
-
-    *a = tmp.i2;
-    return *a;
-}
-
-/** @brief swap the bytes of a 4 byte single-precision float
+/** @brief swap the bytes of each element of an array
  * @ingroup mat_internal
- * @param a pointer to integer to swap
- * @return the swapped integer
+ * @param data pointer to the array
+ * @param data_size size of an element in bytes
+ * @param len number of elements
  */
-static float
-Mat_floatSwap(float *a)
+static void
+Mat_SwapArray(void *data, size_t data_size, size_t len)
 {
-    union {
-        char i1[4];
-        float r4;
-    } tmp;
-
-    tmp.r4 = *a;
+    mat_uint8_t *p = (mat_uint8_t *)data;
+    const size_t nBytes = data_size * len;
+    size_t i = 0;
 
-    swap(tmp.i1[0], tmp.i1[3]);
-    swap(tmp.i1[1], tmp.i1[2]);
-
-    *a = tmp.r4;
-    return *a;
-}
-
-/** @brief swap the bytes of a 4 or 8 byte double-precision float
- * @ingroup mat_internal
- * @param a pointer to integer to swap
- * @return the swapped integer
- */
-static double
-Mat_doubleSwap(double *a)
-{
-#ifndef SIZEOF_DOUBLE
-#define SIZEOF_DOUBLE 8
+    if ( data_size < 2 )
+        return;
+#if defined(SIMD_AVX2)
+    if ( data_size <= 8 ) {
+        mat_uint8_t m[32];
+        __m256i mask;
+        size_t k;
+        for ( k = 0; k < 32; k++ ) {
+            const size_t b = k & 15;
+            m[k] = (mat_uint8_t)(b - b % data_size + data_size - 1 - b % data_size);
+        }
+        mask = _mm256_loadu_si256((const __m256i *)m);
+        for ( ; i + 32 <= nBytes; i += 32 ) {
+            const __m256i x = _mm256_loadu_si256((const __m256i *)(p + i));
+            _mm256_storeu_si256((__m256i *)(p + i), _mm256_shuffle_epi8(x, mask));
+        }
+    }
+#elif defined(SIMD_SSE2)
+    if ( data_size == 2 ) {
+        for ( ; i + 16 <= nBytes; i += 16 ) {
+            __m128i x = _mm_loadu_si128((const __m128i *)(p + i));
+            x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+            _mm_storeu_si128((__m128i *)(p + i), x);
+        }
+    } else if ( data_size == 4 ) {
+        for ( ; i + 16 <= nBytes; i += 16 ) {
+            __m128i x = _mm_loadu_si128((const __m128i *)(p + i));
+            x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+            x = _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0xb1), 0xb1);
+            _mm_storeu_si128((__m128i *)(p + i), x);
+        }
+    } else if ( data_size == 8 ) {
+        for ( ; i + 16 <= nBytes; i += 16 ) {
+            __m128i x = _mm_loadu_si128((const __m128i *)(p + i));
+            x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+            x = _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0x1b), 0x1b);
+            _mm_storeu_si128((__m128i *)(p + i), x);
+        }
+    }
+#elif defined(SIMD_NEON)
+    if ( data_size == 2 ) {
+        for ( ; i + 16 <= nBytes; i += 16 ) {
+            vst1q_u8(p + i, vrev16q_u8(vld1q_u8(p + i)));
+        }
+    } else if ( data_size == 4 ) {
+        for ( ; i + 16 <= nBytes; i += 16 ) {
+            vst1q_u8(p + i, vrev32q_u8(vld1q_u8(p + i)));
+        }
+    } else if ( data_size == 8 ) {
+        for ( ; i + 16 <= nBytes; i += 16 ) {
+            vst1q_u8(p + i, vrev64q_u8(vld1q_u8(p + i)));
+        }
+    }
 #endif
-
-    union {
-        char a[SIZEOF_DOUBLE];
-        double b;
-    } tmp;
-
-    tmp.b = *a;
-
-#if SIZEOF_DOUBLE == 4
-    swap(tmp.a[0], tmp.a[3]);
-    swap(tmp.a[1], tmp.a[2]);
-#elif SIZEOF_DOUBLE == 8
-    swap(tmp.a[0], tmp.a[7]);
-    swap(tmp.a[1], tmp.a[6]);
-    swap(tmp.a[2], tmp.a[5]);
-    swap(tmp.a[3], tmp.a[4]);
-#elif SIZEOF_DOUBLE == 16
-    swap(tmp.a[0], tmp.a[15]);
-    swap(tmp.a[1], tmp.a[14]);
-    swap(tmp.a[2], tmp.a[13]);
-    swap(tmp.a[3], tmp.a[12]);
-    swap(tmp.a[4], tmp.a[11]);
-    swap(tmp.a[5], tmp.a[10]);
-    swap(tmp.a[6], tmp.a[9]);
-    swap(tmp.a[7], tmp.a[8]);
-#endif
-    *a = tmp.b;
-    return *a;
+    for ( ; i < nBytes; i += data_size ) {
+        size_t j = i, k = i + data_size - 1;
+        for ( ; j < k; j++, k-- ) {
+            swap(p[j], p[k]);
+        }
+    }
 }
 
 /* -------------------------------
@@ -759,15 +1015,13 @@ InflateSkip(mat_t *mat, z_streamp z, int nBytes, size_t *bytesread)
 
     n = nBytes < READ_BLOCK_SIZE ? nBytes : READ_BLOCK_SIZE;
     if ( !z->avail_in ) {
-        size_t nbytes = fread(comp_buf, 1, n, (FILE *)mat->fp);
+        size_t nbytes = InflateInput(mat, z, comp_buf, n);
         if ( 0 == nbytes ) {
             return err;
         }
         if ( NULL != bytesread ) {
             *bytesread += nbytes;
         }
-        z->avail_in = (uInt)nbytes;
-        z->next_in = comp_buf;
     }
     z->avail_out = n;
     z->next_out = uncomp_buf;
@@ -792,15 +1046,13 @@ InflateSkip(mat_t *mat, z_streamp z, int nBytes, size_t *bytesread)
     }
     while ( cnt < nBytes ) {
         if ( !z->avail_in ) {
-            size_t nbytes = fread(comp_buf, 1, n, (FILE *)mat->fp);
+            size_t nbytes = InflateInput(mat, z, comp_buf, n);
             if ( 0 == nbytes ) {
                 break;
             }
             if ( NULL != bytesread ) {
                 *bytesread += nbytes;
             }
-            z->avail_in = (uInt)nbytes;
-            z->next_in = comp_buf;
         }
         err = inflate(z, Z_NO_FLUSH);
         if ( err == Z_STREAM_END ) {
@@ -827,7 +1079,7 @@ InflateSkip(mat_t *mat, z_streamp z, int nBytes, size_t *bytesread)
 
     if ( z->avail_in ) {
         const mat_off_t offset = -(mat_off_t)z->avail_in;
-        (void)fseeko((FILE *)mat->fp, offset, SEEK_CUR);
+        (void)Mat_fseeko(mat, offset, SEEK_CUR);
         if ( NULL != bytesread ) {
             *bytesread -= z->avail_in;
         }
@@ -837,6 +1089,158 @@ InflateSkip(mat_t *mat, z_streamp z, int nBytes, size_t *bytesread)
     return err;
 }
 
+/** @brief Inflate the data until @c nBytes of uncompressed data has been
+ *         inflated, using the checkpoints of the variable currently read
+ *
+ * Resumes the decompression at the last checkpoint before the target
+ * position if that is ahead of the current position of @c z. While skipping,
+ * a checkpoint is saved every INFLATE_CHECKPOINT_SPAN bytes (doubled whenever
+ * the checkpoints are thinned out) of uncompressed data beyond the last
+ * checkpoint, such that later reads of the same variable need not inflate
+ * the data again from the beginning. Without checkpoints
+ * (@c mat->inflate_cur is NULL) this is the same as InflateSkip.
+ * @ingroup mat_internal
+ * @param mat Pointer to the MAT file
+ * @param z zlib compression stream without pending input
+ * @param nBytes Number of uncompressed bytes to skip
+ * @retval 0 on success
+
+ */
+static int
+InflateSkipIndexed(mat_t *mat, z_streamp z, int nBytes)
+{
+    struct mat_inflate_index_t *index = mat->inflate_cur;
+    uLong target;
+    int err = MATIO_E_NO_ERROR;
+
+    if ( NULL == index || z->avail_in || nBytes < 1 )
+        return InflateSkip(mat, z, nBytes, NULL);
+
+    target = z->total_out + (uLong)nBytes;
+    if ( index->npoints > 0 ) {
+        /* Find the last checkpoint before the target by binary search */
+        size_t lo = 0, hi = index->npoints;
+        while ( lo < hi ) {
+            const size_t mid = lo + (hi - lo) / 2;
+            if ( index->points[mid].z->total_out <= target )
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if ( lo > 0 && index->points[lo - 1].z->total_out > z->total_out ) {
+            const struct mat_inflate_point_t *point = index->points + lo - 1;
+            inflateEnd(z);
+            err = inflateCopy(z, point->z);
+            if ( err != Z_OK ) {
+                Mat_Critical("inflateCopy returned error %s", zError(err));
+                return MATIO_E_OUT_OF_MEMORY;
+            }
+            z->avail_in = 0;
+            (void)Mat_fseeko(mat, point->fpos, SEEK_SET);
+        }
+    }
+
+    for ( ;; ) {
+        uLong next = index->span;
+        uLong out = z->total_out;
+        uLong n = target - out;
+        if ( index->npoints > 0 )
+            next += index->points[index->npoints - 1].z->total_out;
+        if ( out >= next && 0 == InflateAddPoint(mat, index, z) )
+            next = out + index->span;
+        if ( out >= target )
+            break;
+        /* Stop at the position of the next checkpoint */
+        if ( next > out && next < target )
+            n = next - out;
+        err = InflateSkip(mat, z, (int)n, NULL);
+        if ( err || z->total_out == out )
+            break;
+    }
+
+    return err;
+}
+
+/** @brief Saves a checkpoint of the decompression state
+ *
+ * If MAX_INFLATE_CHECKPOINTS are kept, the checkpoints of the other variables
+ * are freed first. If the variable holds them all, every other one is freed.
+ * @ingroup mat_internal
+ * @param mat Pointer to the MAT file
+ * @param index Checkpoints of the variable
+ * @param z zlib compression stream without pending input
+ * @retval 0 on success
+
+ */
+static int
+InflateAddPoint(mat_t *mat, struct mat_inflate_index_t *index, z_streamp z)
+{
+    struct mat_inflate_point_t *point;
+    const mat_off_t fpos = Mat_ftello(mat);
+
+    if ( fpos < 0 )
+        return MATIO_E_GENERIC_READ_ERROR;
+    if ( index->npoints >= MAX_INFLATE_CHECKPOINTS ) {
+        InflateFreePoints(index, 1);
+    } else {
+        struct mat_inflate_index_t *other, *tmp;
+        size_t npoints = 0;
+        HASH_ITER(hh, mat->inflate_index, other, tmp) {
+            npoints += other->npoints;
+        }
+        if ( npoints >= MAX_INFLATE_CHECKPOINTS ) {
+            HASH_ITER(hh, mat->inflate_index, other, tmp) {
+                if ( other != index )
+                    InflateFreePoints(other, 0);
+            }
+        }
+    }
+    if ( index->npoints == index->size ) {
+        const size_t size = 0 == index->size ? 16 : 2 * index->size;
+        point = (struct mat_inflate_point_t *)realloc(index->points, size * sizeof(*point));
+        if ( NULL == point )
+            return MATIO_E_OUT_OF_MEMORY;
+        index->points = point;
+        index->size = size;
+    }
+    point = index->points + index->npoints;
+    point->z = (z_streamp)calloc(1, sizeof(z_stream));
+    if ( NULL == point->z )
+        return MATIO_E_OUT_OF_MEMORY;
+    if ( inflateCopy(point->z, z) != Z_OK ) {
+        free(point->z);
+        return MATIO_E_OUT_OF_MEMORY;
+    }
+    point->fpos = fpos;
+    index->npoints++;
+    return MATIO_E_NO_ERROR;
+}
+
+/** @brief Frees the checkpoints of a variable
+ *
+ * @ingroup mat_internal
+ * @param index Checkpoints of the variable
+ * @param every_other Nonzero to free every other checkpoint only and to double
+ * the span of the remaining ones, zero to free all checkpoints
+ */
+static void
+InflateFreePoints(struct mat_inflate_index_t *index, int every_other)
+{
+    size_t i, j = 0;
+
+    for ( i = 0; i < index->npoints; i++ ) {
+        if ( every_other && i % 2 == 1 ) {
+            index->points[j++] = index->points[i];
+        } else {
+            inflateEnd(index->points[i].z);
+            free(index->points[i].z);
+        }
+    }
+    index->npoints = j;
+    if ( every_other )
+        index->span *= 2;
+}
+
 /** @brief Inflate the data until @c len elements of compressed data with data
  *         type @c data_type has been inflated
  *
@@ -863,7 +1267,7 @@ InflateSkipData(mat_t *mat, z_streamp z, enum matio_types data_type, int len)
             break;
     }
 
-    return InflateSkip(mat, z, (unsigned int)Mat_SizeOf(data_type) * len, NULL);
+    return InflateSkipIndexed(mat, z, (unsigned int)Mat_SizeOf(data_type) * len);
 }
 
 /** @brief Inflates the dimensions tag and the dimensions data
@@ -957,22 +1361,21 @@ InflateRankDims(mat_t *mat, z_streamp z, void *buf, size_t nBytes, mat_uint32_t
 static int
 Inflate(mat_t *mat, z_streamp z, void *buf, unsigned int nBytes, size_t *bytesread)
 {
-    mat_uint8_t comp_buf[4];
+    mat_uint8_t comp_buf[READ_BLOCK_SIZE];
+    const size_t n = nBytes < READ_BLOCK_SIZE ? nBytes : READ_BLOCK_SIZE;
     int err = MATIO_E_NO_ERROR;
 
     if ( buf == NULL )
         return MATIO_E_BAD_ARGUMENT;
 
     if ( !z->avail_in ) {
-        size_t nbytes = fread(comp_buf, 1, 1, (FILE *)mat->fp);
+        size_t nbytes = InflateInput(mat, z, comp_buf, n);
         if ( 0 == nbytes ) {
             return err;
         }
         if ( NULL != bytesread ) {
             *bytesread += nbytes;
         }
-        z->avail_in = (uInt)nbytes;
-        z->next_in = comp_buf;
     }
     z->avail_out = nBytes;
     z->next_out = ZLIB_BYTE_PTR(buf);
@@ -985,15 +1388,13 @@ Inflate(mat_t *mat, z_streamp z, void *buf, unsigned int nBytes, size_t *bytesre
         err = MATIO_E_NO_ERROR;
     }
     while ( z->avail_out && !z->avail_in ) {
-        size_t nbytes = fread(comp_buf, 1, 1, (FILE *)mat->fp);
+        size_t nbytes = InflateInput(mat, z, comp_buf, n);
         if ( 0 == nbytes ) {
             break;
         }
         if ( NULL != bytesread ) {
             *bytesread += nbytes;
         }
-        z->avail_in = (uInt)nbytes;
-        z->next_in = comp_buf;
         err = inflate(z, Z_NO_FLUSH);
         if ( err != Z_OK ) {
             Mat_Critical("Inflate: inflate returned %s",
@@ -1006,14 +1407,14 @@ Inflate(mat_t *mat, z_streamp z, void *buf, unsigned int nBytes, size_t *bytesre
 
     if ( z->avail_in ) {
         const mat_off_t offset = -(mat_off_t)z->avail_in;
-        (void)fseeko((FILE *)mat->fp, offset, SEEK_CUR);
+        (void)Mat_fseeko(mat, offset, SEEK_CUR);
         if ( NULL != bytesread ) {
             *bytesread -= z->avail_in;
         }
         z->avail_in = 0;
     }
 
-    if ( z->avail_out && feof((FILE *)mat->fp) ) {
+    if ( z->avail_out && Mat_feof(mat) ) {
         Mat_Warning(
             "Unexpected end-of-file: "
             "Processed %u bytes, expected %u bytes",
@@ -1051,13 +1452,11 @@ InflateData(mat_t *mat, z_streamp z, void *buf, unsigned int nBytes)
 
     n = nBytes < READ_BLOCK_SIZE ? nBytes : READ_BLOCK_SIZE;
     if ( !z->avail_in ) {
-        size_t nbytes = fread(comp_buf, 1, n, (FILE *)mat->fp);
+        size_t nbytes = InflateInput(mat, z, comp_buf, n);
         if ( 0 == nbytes ) {
             return err;
         }
         bytesread += nbytes;
-        z->avail_in = (uInt)nbytes;
-        z->next_in = comp_buf;
     }
     z->avail_out = nBytes;
     z->next_out = ZLIB_BYTE_PTR(buf);
@@ -1073,19 +1472,16 @@ InflateData(mat_t *mat, z_streamp z, void *buf, unsigned int nBytes)
     }
     while ( z->avail_out && !z->avail_in ) {
         size_t nbytes;
-        if ( nBytes > READ_BLOCK_SIZE + bytesread ) {
-            nbytes = fread(comp_buf, 1, READ_BLOCK_SIZE, (FILE *)mat->fp);
-        } else if ( nBytes < 1 + bytesread ) { /* Read a byte at a time */
-            nbytes = fread(comp_buf, 1, 1, (FILE *)mat->fp);
+        if ( nBytes > bytesread && nBytes - bytesread < READ_BLOCK_SIZE ) {
+            n = nBytes - (unsigned int)bytesread;
         } else {
-            nbytes = fread(comp_buf, 1, nBytes - bytesread, (FILE *)mat->fp);
+            n = READ_BLOCK_SIZE;
         }
+        nbytes = InflateInput(mat, z, comp_buf, n);
         if ( 0 == nbytes ) {
             break;
         }
         bytesread += nbytes;
-        z->avail_in = (uInt)nbytes;
-        z->next_in = comp_buf;
         err = inflate(z, Z_NO_FLUSH);
         if ( err == Z_STREAM_END ) {
             err = MATIO_E_NO_ERROR;
@@ -1102,12 +1498,12 @@ InflateData(mat_t *mat, z_streamp z, void *buf, unsigned int nBytes)
 
     if ( z->avail_in ) {
         const mat_off_t offset = -(mat_off_t)z->avail_in;
-        (void)fseeko((FILE *)mat->fp, offset, SEEK_CUR);
+        (void)Mat_fseeko(mat, offset, SEEK_CUR);
         /* bytesread -= z->avail_in; */
         z->avail_in = 0;
     }
 
-    if ( z->avail_out && feof((FILE *)mat->fp) ) {
+    if ( z->avail_out && Mat_feof(mat) ) {
         Mat_Warning("InflateData: Read beyond EOF error: Processed %u bytes, expected %u bytes",
                     nBytes - z->avail_out, nBytes);
         memset(buf, 0, nBytes);
@@ -1116,6 +1512,34 @@ InflateData(mat_t *mat, z_streamp z, void *buf, unsigned int nBytes)
     return err;
 }
 
+/** @brief Provides the next compressed input to a zlib stream
+ *
+ * If the MAT file is opened read-only, the stream reads directly from the
+ * buffer of the reader, otherwise at most @c n bytes are read into @c buf.
+ * Input left unused by the stream must be given back by seeking backwards.
+ * @ingroup mat_internal
+ * @param mat Pointer to the MAT file
+ * @param z zlib compression stream
+ * @param buf Buffer of at least @c n bytes
+ * @param n Number of bytes to read into @c buf
+ * @return Number of bytes of input
+ */
+static size_t
+InflateInput(mat_t *mat, z_streamp z, mat_uint8_t *buf, size_t n)
+{
+    size_t nbytes;
+
+    if ( NULL != mat->reader ) {
+        nbytes = Mat_freadDirect(mat, &buf);
+    } else {
+        nbytes = Mat_fread(buf, 1, n, mat);
+    }
+    z->avail_in = (uInt)nbytes;
+    z->next_in = buf;
+
+    return nbytes;
+}
+
 /** @endcond */
 
 #endif
@@ -1177,6 +1601,69 @@ utf82u(const char *src)
 }
 #endif
 
+#if defined(MAT_THREAD_LOCAL)
+/* Buffer of the calling thread for critical messages */
+static MAT_THREAD_LOCAL char *threadLogBuffer = NULL;
+static MAT_THREAD_LOCAL size_t threadLogBufferSize = 0;
+#endif
+
+/** @brief Redirects the messages of the calling thread to a buffer
+ *
+ * If a buffer is set, the first critical message of the calling thread is
+ * printed to the buffer instead of being reported by ModelicaVFormatError
+ * and warnings are discarded. This allows to use the library from worker
+ * threads, where the Modelica error functions must not be called.
+ * @ingroup mat_util
+ * @param buffer Buffer (set to an empty string) or NULL to reset
+ * @param size Size of the buffer
+ * @retval 0 on success
+ * @retval 1 if thread-local storage is not supported
+ */
+int
+Mat_SetThreadLogBuffer(char *buffer, size_t size)
+{
+#if defined(MAT_THREAD_LOCAL)
+    if ( NULL != buffer && size > 0 ) {
+        buffer[0] = '\0';
+        threadLogBuffer = buffer;
+        threadLogBufferSize = size;
+    } else {
+        threadLogBuffer = NULL;
+        threadLogBufferSize = 0;
+    }
+    return 0;
+#else
+    return 1;
+#endif
+}
+
+/** @brief Logs a Critical message and aborts the program
+ *
+ * Logs an Error message and aborts
+ * @ingroup mat_util
+ * @param format format string identical to printf format
+ * @param ap arguments to the format string
+ */
+void
+Mat_VCritical(const char *format, va_list ap)
+{
+#if defined(MAT_THREAD_LOCAL)
+    if ( NULL != threadLogBuffer ) {
+        if ( '\0' == threadLogBuffer[0] ) {
+            (void)mat_vsnprintf(threadLogBuffer, threadLogBufferSize, format, ap);
+            threadLogBuffer[threadLogBufferSize - 1] = '\0';
+            if ( '\0' == threadLogBuffer[0] ) {
+                /* Mark the empty message as error */
+                (void)mat_snprintf(threadLogBuffer, threadLogBufferSize, "%s",
+                                   "Unknown error");
+            }
+        }
+        return;
+    }
+#endif
+    ModelicaVFormatError(format, ap);
+}
+
 /** @brief Logs a Critical message and aborts the program
  *
  * Logs an Error message and aborts
@@ -1189,7 +1676,7 @@ Mat_Critical(const char *format, ...)
 {
     va_list ap;
     va_start(ap, format);
-    ModelicaVFormatError(format, ap);
+    Mat_VCritical(format, ap);
     va_end(ap);
 }
 
@@ -1205,10 +1692,28 @@ Mat_Warning(const char *format, ...)
 {
     va_list ap;
     va_start(ap, format);
-    ModelicaVFormatWarning(format, ap);
+    Mat_VWarning(format, ap);
     va_end(ap);
 }
 
+/** @brief Prints a warning message
+ *
+ * Logs a warning message then returns
+ * @ingroup mat_util
+ * @param format format string identical to printf format
+ * @param ap arguments to the format string
+ */
+void
+Mat_VWarning(const char *format, va_list ap)
+{
+#if defined(MAT_THREAD_LOCAL)
+    if ( NULL != threadLogBuffer ) {
+        return;
+    }
+#endif
+    ModelicaVFormatWarning(format, ap);
+}
+
 /** @brief Calculate the size of MAT data types
  *
  * @ingroup mat_util
@@ -1231,173 +1736,271 @@ Mat_SizeOf(enum matio_types data_type)
         case MAT_T_UINT64:
             return sizeof(mat_uint64_t);
 #endif
-        case MAT_T_INT32:
-            return sizeof(mat_int32_t);
-        case MAT_T_UINT32:
-            return sizeof(mat_uint32_t);
-        case MAT_T_INT16:
-            return sizeof(mat_int16_t);
-        case MAT_T_UINT16:
-            return sizeof(mat_uint16_t);
-        case MAT_T_INT8:
-            return sizeof(mat_int8_t);
-        case MAT_T_UINT8:
-            return sizeof(mat_uint8_t);
-        case MAT_T_UTF8:
-            return 1;
-        case MAT_T_UTF16:
-            return 2;
-        case MAT_T_UTF32:
-            return 4;
-        default:
-            return 0;
+        case MAT_T_INT32:
+            return sizeof(mat_int32_t);
+        case MAT_T_UINT32:
+            return sizeof(mat_uint32_t);
+        case MAT_T_INT16:
+            return sizeof(mat_int16_t);
+        case MAT_T_UINT16:
+            return sizeof(mat_uint16_t);
+        case MAT_T_INT8:
+            return sizeof(mat_int8_t);
+        case MAT_T_UINT8:
+            return sizeof(mat_uint8_t);
+        case MAT_T_UTF8:
+            return 1;
+        case MAT_T_UTF16:
+            return 2;
+        case MAT_T_UTF32:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+/* -------------------------------
+ * ---------- read_data.c
+ * -------------------------------
+ */
+/** @file read_data.c
+ * Matlab MAT version 5 file functions
+ * @ingroup MAT
+ */
+
+/* FIXME: Implement Unicode support */
+
+#if defined(SIMD_SSE2)
+static void
+Mat_int32x4ToDouble(double *out, __m128i x)
+{
+    _mm_storeu_pd(out, _mm_cvtepi32_pd(x));
+    _mm_storeu_pd(out + 2, _mm_cvtepi32_pd(_mm_srli_si128(x, 8)));
+}
+
+static void
+Mat_int16x8ToDouble(double *out, __m128i x)
+{
+    Mat_int32x4ToDouble(out, _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16));
+    Mat_int32x4ToDouble(out + 4, _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16));
+}
+#elif defined(SIMD_NEON)
+static void
+Mat_int32x4ToDouble(double *out, int32x4_t x)
+{
+    vst1q_f64(out, vcvtq_f64_s64(vmovl_s32(vget_low_s32(x))));
+    vst1q_f64(out + 2, vcvtq_f64_s64(vmovl_high_s32(x)));
+}
+
+static void
+Mat_int16x8ToDouble(double *out, int16x8_t x)
+{
+    Mat_int32x4ToDouble(out, vmovl_s16(vget_low_s16(x)));
+    Mat_int32x4ToDouble(out + 4, vmovl_high_s16(x));
+}
+#endif
+
+/** @brief Converts an array of single-precision floats to doubles
+ * @ingroup mat_internal
+ * @param out Pointer to store the output values
+ * @param in Pointer to the input values
+ * @param len Number of elements to convert
+ */
+static void
+Mat_floatToDouble(double *out, const float *in, size_t len)
+{
+    size_t i = 0;
+#if defined(SIMD_SSE2)
+    for ( ; i + 4 <= len; i += 4 ) {
+        const __m128 x = _mm_loadu_ps(in + i);
+        _mm_storeu_pd(out + i, _mm_cvtps_pd(x));
+        _mm_storeu_pd(out + i + 2, _mm_cvtps_pd(_mm_movehl_ps(x, x)));
+    }
+#elif defined(SIMD_NEON)
+    for ( ; i + 4 <= len; i += 4 ) {
+        const float32x4_t x = vld1q_f32(in + i);
+        vst1q_f64(out + i, vcvt_f64_f32(vget_low_f32(x)));
+        vst1q_f64(out + i + 2, vcvt_high_f64_f32(x));
+    }
+#endif
+    for ( ; i < len; i++ ) {
+        out[i] = (double)in[i];
+    }
+}
+
+/** @brief Converts an array of 32-bit signed integers to doubles
+ * @ingroup mat_internal
+ * @param out Pointer to store the output values
+ * @param in Pointer to the input values
+ * @param len Number of elements to convert
+ */
+static void
+Mat_int32ToDouble(double *out, const mat_int32_t *in, size_t len)
+{
+    size_t i = 0;
+#if defined(SIMD_SSE2)
+    for ( ; i + 4 <= len; i += 4 ) {
+        Mat_int32x4ToDouble(out + i, _mm_loadu_si128((const __m128i *)(in + i)));
+    }
+#elif defined(SIMD_NEON)
+    for ( ; i + 4 <= len; i += 4 ) {
+        Mat_int32x4ToDouble(out + i, vld1q_s32(in + i));
+    }
+#endif
+    for ( ; i < len; i++ ) {
+        out[i] = (double)in[i];
+    }
+}
+
+/** @brief Converts an array of 16-bit signed integers to doubles
+ * @ingroup mat_internal
+ * @param out Pointer to store the output values
+ * @param in Pointer to the input values
+ * @param len Number of elements to convert
+ */
+static void
+Mat_int16ToDouble(double *out, const mat_int16_t *in, size_t len)
+{
+    size_t i = 0;
+#if defined(SIMD_SSE2)
+    for ( ; i + 8 <= len; i += 8 ) {
+        Mat_int16x8ToDouble(out + i, _mm_loadu_si128((const __m128i *)(in + i)));
+    }
+#elif defined(SIMD_NEON)
+    for ( ; i + 8 <= len; i += 8 ) {
+        Mat_int16x8ToDouble(out + i, vld1q_s16(in + i));
+    }
+#endif
+    for ( ; i < len; i++ ) {
+        out[i] = (double)in[i];
     }
 }
 
-/* -------------------------------
- * ---------- read_data.c
- * -------------------------------
+/** @brief Converts an array of 16-bit unsigned integers to doubles
+ * @ingroup mat_internal
+ * @param out Pointer to store the output values
+ * @param in Pointer to the input values
+ * @param len Number of elements to convert
  */
-/** @file read_data.c
- * Matlab MAT version 5 file functions
- * @ingroup MAT
+static void
+Mat_uint16ToDouble(double *out, const mat_uint16_t *in, size_t len)
+{
+    size_t i = 0;
+#if defined(SIMD_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; i + 8 <= len; i += 8 ) {
+        const __m128i x = _mm_loadu_si128((const __m128i *)(in + i));
+        Mat_int32x4ToDouble(out + i, _mm_unpacklo_epi16(x, zero));
+        Mat_int32x4ToDouble(out + i + 4, _mm_unpackhi_epi16(x, zero));
+    }
+#elif defined(SIMD_NEON)
+    for ( ; i + 8 <= len; i += 8 ) {
+        const uint16x8_t x = vld1q_u16(in + i);
+        Mat_int32x4ToDouble(out + i, vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(x))));
+        Mat_int32x4ToDouble(out + i + 4, vreinterpretq_s32_u32(vmovl_high_u16(x)));
+    }
+#endif
+    for ( ; i < len; i++ ) {
+        out[i] = (double)in[i];
+    }
+}
+
+/** @brief Converts an array of 8-bit signed integers to doubles
+ * @ingroup mat_internal
+ * @param out Pointer to store the output values
+ * @param in Pointer to the input values
+ * @param len Number of elements to convert
  */
+static void
+Mat_int8ToDouble(double *out, const mat_int8_t *in, size_t len)
+{
+    size_t i = 0;
+#if defined(SIMD_SSE2)
+    for ( ; i + 16 <= len; i += 16 ) {
+        const __m128i x = _mm_loadu_si128((const __m128i *)(in + i));
+        Mat_int16x8ToDouble(out + i, _mm_srai_epi16(_mm_unpacklo_epi8(x, x), 8));
+        Mat_int16x8ToDouble(out + i + 8, _mm_srai_epi16(_mm_unpackhi_epi8(x, x), 8));
+    }
+#elif defined(SIMD_NEON)
+    for ( ; i + 16 <= len; i += 16 ) {
+        const int8x16_t x = vld1q_s8(in + i);
+        Mat_int16x8ToDouble(out + i, vmovl_s8(vget_low_s8(x)));
+        Mat_int16x8ToDouble(out + i + 8, vmovl_high_s8(x));
+    }
+#endif
+    for ( ; i < len; i++ ) {
+        out[i] = (double)in[i];
+    }
+}
 
-/* FIXME: Implement Unicode support */
+/** @brief Converts an array of 8-bit unsigned integers to doubles
+ * @ingroup mat_internal
+ * @param out Pointer to store the output values
+ * @param in Pointer to the input values
+ * @param len Number of elements to convert
+ */
+static void
+Mat_uint8ToDouble(double *out, const mat_uint8_t *in, size_t len)
+{
+    size_t i = 0;
+#if defined(SIMD_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; i + 16 <= len; i += 16 ) {
+        const __m128i x = _mm_loadu_si128((const __m128i *)(in + i));
+        Mat_int16x8ToDouble(out + i, _mm_unpacklo_epi8(x, zero));
+        Mat_int16x8ToDouble(out + i + 8, _mm_unpackhi_epi8(x, zero));
+    }
+#elif defined(SIMD_NEON)
+    for ( ; i + 16 <= len; i += 16 ) {
+        const uint8x16_t x = vld1q_u8(in + i);
+        Mat_int16x8ToDouble(out + i, vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(x))));
+        Mat_int16x8ToDouble(out + i + 8, vreinterpretq_s16_u16(vmovl_high_u8(x)));
+    }
+#endif
+    for ( ; i < len; i++ ) {
+        out[i] = (double)in[i];
+    }
+}
 
-#define READ_DATA_NOSWAP(T)                                           \
-    do {                                                              \
-        const size_t block_size = READ_BLOCK_SIZE / data_size;        \
-        if ( len <= block_size ) {                                    \
-            readcount = fread(v, data_size, len, (FILE *)mat->fp);    \
-            if ( readcount == len ) {                                 \
-                for ( i = 0; i < len; i++ ) {                         \
-                    data[i] = (T)v[i];                                \
-                }                                                     \
-            }                                                         \
-        } else {                                                      \
-            size_t j;                                                 \
-            int err_ = 0;                                             \
-            readcount = 0;                                            \
-            for ( i = 0; i < len - block_size; i += block_size ) {    \
-                j = fread(v, data_size, block_size, (FILE *)mat->fp); \
-                readcount += j;                                       \
-                if ( j == block_size ) {                              \
-                    for ( j = 0; j < block_size; j++ ) {              \
-                        data[i + j] = (T)v[j];                        \
-                    }                                                 \
-                } else {                                              \
-                    err_ = 1;                                         \
-                    break;                                            \
-                }                                                     \
-            }                                                         \
-            if ( 0 == err_ && len > i ) {                             \
-                j = fread(v, data_size, len - i, (FILE *)mat->fp);    \
-                readcount += j;                                       \
-                if ( j == len - i ) {                                 \
-                    for ( j = 0; j < len - i; j++ ) {                 \
-                        data[i + j] = (T)v[j];                        \
-                    }                                                 \
-                }                                                     \
-            }                                                         \
-        }                                                             \
+/* Converts n elements of in to READ_TYPE's in out */
+#define READ_DATA_CAST(out, in, n)           \
+    do {                                     \
+        size_t k_;                           \
+        for ( k_ = 0; k_ < (n); k_++ ) {     \
+            (out)[k_] = (READ_TYPE)(in)[k_]; \
+        }                                    \
     } while ( 0 )
 
-#define READ_DATA(T, SwapFunc)                                            \
-    do {                                                                  \
-        if ( mat->byteswap ) {                                            \
-            const size_t block_size = READ_BLOCK_SIZE / data_size;        \
-            if ( len <= block_size ) {                                    \
-                readcount = fread(v, data_size, len, (FILE *)mat->fp);    \
-                if ( readcount == len ) {                                 \
-                    for ( i = 0; i < len; i++ ) {                         \
-                        data[i] = (T)SwapFunc(&v[i]);                     \
-                    }                                                     \
-                }                                                         \
-            } else {                                                      \
-                size_t j;                                                 \
-                int err_ = 0;                                             \
-                readcount = 0;                                            \
-                for ( i = 0; i < len - block_size; i += block_size ) {    \
-                    j = fread(v, data_size, block_size, (FILE *)mat->fp); \
-                    readcount += j;                                       \
-                    if ( j == block_size ) {                              \
-                        for ( j = 0; j < block_size; j++ ) {              \
-                            data[i + j] = (T)SwapFunc(&v[j]);             \
-                        }                                                 \
-                    } else {                                              \
-                        err_ = 1;                                         \
-                        break;                                            \
-                    }                                                     \
-                }                                                         \
-                if ( 0 == err_ && len > i ) {                             \
-                    j = fread(v, data_size, len - i, (FILE *)mat->fp);    \
-                    readcount += j;                                       \
-                    if ( j == len - i ) {                                 \
-                        for ( j = 0; j < len - i; j++ ) {                 \
-                            data[i + j] = (T)SwapFunc(&v[j]);             \
-                        }                                                 \
-                    }                                                     \
-                }                                                         \
-            }                                                             \
-        } else {                                                          \
-            READ_DATA_NOSWAP(T);                                          \
-        }                                                                 \
+#define READ_DATA(Convert)                                     \
+    do {                                                       \
+        const size_t block_size = READ_BLOCK_SIZE / data_size; \
+        size_t n_;                                             \
+        readcount = 0;                                         \
+        for ( i = 0; i < len; i += n_ ) {                      \
+            size_t j_;                                         \
+            n_ = len - i < block_size ? len - i : block_size;  \
+            j_ = Mat_fread(v, data_size, n_, mat);             \
+            readcount += j_;                                   \
+            if ( j_ != n_ )                                    \
+                break;                                         \
+            if ( mat->byteswap )                               \
+                Mat_SwapArray(v, data_size, n_);               \
+            Convert(data + i, v, n_);                          \
+        }                                                      \
     } while ( 0 )
 
 #if HAVE_ZLIB
-#define READ_COMPRESSED_DATA_NOSWAP(T)                                          \
-    do {                                                                        \
-        const size_t block_size = READ_BLOCK_SIZE / data_size;                  \
-        if ( len <= block_size ) {                                              \
-            InflateData(mat, z, v, (mat_uint32_t)(len * data_size));            \
-            for ( i = 0; i < len; i++ ) {                                       \
-                data[i] = (T)v[i];                                              \
-            }                                                                   \
-        } else {                                                                \
-            mat_uint32_t j;                                                     \
-            len -= (mat_uint32_t)block_size;                                    \
-            for ( i = 0; i < len; i += (mat_uint32_t)block_size ) {             \
-                InflateData(mat, z, v, (mat_uint32_t)(block_size * data_size)); \
-                for ( j = 0; j < block_size; j++ ) {                            \
-                    data[i + j] = (T)v[j];                                      \
-                }                                                               \
-            }                                                                   \
-            len -= (mat_uint32_t)(i - block_size);                              \
-            InflateData(mat, z, v, (mat_uint32_t)(len * data_size));            \
-            for ( j = 0; j < len; j++ ) {                                       \
-                data[i + j] = (T)v[j];                                          \
-            }                                                                   \
-        }                                                                       \
-    } while ( 0 )
-
-#define READ_COMPRESSED_DATA(T, SwapFunc)                                           \
-    do {                                                                            \
-        if ( mat->byteswap ) {                                                      \
-            const size_t block_size = READ_BLOCK_SIZE / data_size;                  \
-            if ( len <= block_size ) {                                              \
-                InflateData(mat, z, v, (mat_uint32_t)(len * data_size));            \
-                for ( i = 0; i < len; i++ ) {                                       \
-                    data[i] = (T)SwapFunc(&v[i]);                                   \
-                }                                                                   \
-            } else {                                                                \
-                mat_uint32_t j;                                                     \
-                len -= (mat_uint32_t)block_size;                                    \
-                for ( i = 0; i < len; i += (mat_uint32_t)block_size ) {             \
-                    InflateData(mat, z, v, (mat_uint32_t)(block_size * data_size)); \
-                    for ( j = 0; j < block_size; j++ ) {                            \
-                        data[i + j] = (T)SwapFunc(&v[j]);                           \
-                    }                                                               \
-                }                                                                   \
-                len -= (mat_uint32_t)(i - block_size);                              \
-                InflateData(mat, z, v, (mat_uint32_t)(len * data_size));            \
-                for ( j = 0; j < len; j++ ) {                                       \
-                    data[i + j] = (T)SwapFunc(&v[j]);                               \
-                }                                                                   \
-            }                                                                       \
-        } else {                                                                    \
-            READ_COMPRESSED_DATA_NOSWAP(T);                                         \
-        }                                                                           \
+#define READ_COMPRESSED_DATA(Convert)                                                \
+    do {                                                                             \
+        const mat_uint32_t block_size = (mat_uint32_t)(READ_BLOCK_SIZE / data_size); \
+        mat_uint32_t n_;                                                             \
+        for ( i = 0; i < len; i += n_ ) {                                            \
+            n_ = len - i < block_size ? len - i : block_size;                        \
+            InflateData(mat, z, v, (mat_uint32_t)(n_ * data_size));                  \
+            if ( mat->byteswap )                                                     \
+                Mat_SwapArray(v, data_size, n_);                                     \
+            Convert(data + i, v, n_);                                                \
+        }                                                                            \
     } while ( 0 )
 
 #endif
@@ -1562,11 +2165,7 @@ ReadCompressedCharData(mat_t *mat, z_streamp z, void *data, enum matio_types dat
         case MAT_T_UTF16:
             err = InflateData(mat, z, data, (mat_uint32_t)nBytes);
             if ( mat->byteswap ) {
-                mat_uint16_t *ptr = (mat_uint16_t *)data;
-                size_t i;
-                for ( i = 0; i < len; i++ ) {
-                    Mat_uint16Swap(&ptr[i]);
-                }
+                Mat_SwapArray(data, sizeof(mat_uint16_t), len);
             }
             break;
         default:
@@ -1599,16 +2198,15 @@ ReadCharData(mat_t *mat, void *_data, enum matio_types data_type, size_t len)
     switch ( data_type ) {
         case MAT_T_UINT8:
         case MAT_T_UTF8: {
-            err = Read(_data, data_size, len, (FILE *)mat->fp, &nBytes);
+            err = Read(_data, data_size, len, mat, &nBytes);
             break;
         }
         case MAT_T_UINT16:
         case MAT_T_UTF16: {
-            size_t i, readcount;
-            mat_uint16_t *data = (mat_uint16_t *)_data;
-            mat_uint16_t v[READ_BLOCK_SIZE / sizeof(mat_uint16_t)];
-            READ_DATA(mat_uint16_t, Mat_uint16Swap);
-            err = Mul(&nBytes, readcount, data_size);
+            err = Read(_data, data_size, len, mat, &nBytes);
+            if ( 0 == err && mat->byteswap ) {
+                Mat_SwapArray(_data, data_size, len);
+            }
             break;
         }
         default:
@@ -1625,7 +2223,7 @@ ReadCharData(mat_t *mat, void *_data, enum matio_types data_type, size_t len)
 }
 
 #undef READ_DATA
-#undef READ_DATA_NOSWAP
+#undef READ_DATA_CAST
 
 /*
  *-------------------------------------------------------------------
@@ -1640,17 +2238,17 @@ ReadCharData(mat_t *mat, void *_data, enum matio_types data_type, size_t len)
             if ( (cnt[j] % edge[j]) == 0 ) {                                                     \
                 cnt[j] = 0;                                                                      \
                 if ( (I % dimp[j]) != 0 ) {                                                      \
-                    (void)fseek((FILE *)mat->fp,                                                 \
-                                data_size *(dimp[j] - (I % dimp[j]) + dimp[j - 1] * start[j]),   \
-                                SEEK_CUR);                                                       \
+                    (void)Mat_fseeko(mat,                                                        \
+                                    data_size *(dimp[j] - (I % dimp[j]) + dimp[j - 1] * start[j]), \
+                                    SEEK_CUR);                                                   \
                     I += dimp[j] - (I % dimp[j]) + (ptrdiff_t)dimp[j - 1] * start[j];            \
                 } else if ( start[j] ) {                                                         \
-                    (void)fseek((FILE *)mat->fp, data_size *(dimp[j - 1] * start[j]), SEEK_CUR); \
+                    (void)Mat_fseeko(mat, data_size *(dimp[j - 1] * start[j]), SEEK_CUR);        \
                     I += (ptrdiff_t)dimp[j - 1] * start[j];                                      \
                 }                                                                                \
             } else {                                                                             \
                 I += inc[j];                                                                     \
-                (void)fseek((FILE *)mat->fp, data_size *inc[j], SEEK_CUR);                       \
+                (void)Mat_fseeko(mat, data_size *inc[j], SEEK_CUR);                              \
                 break;                                                                           \
             }                                                                                    \
         }                                                                                        \
@@ -1672,33 +2270,33 @@ ReadCharData(mat_t *mat, void *_data, enum matio_types data_type, size_t len)
             N *= edge[i];                                                                          \
             I += (ptrdiff_t)dimp[i - 1] * start[i];                                                \
         }                                                                                          \
-        (void)fseek((FILE *)mat->fp, I *data_size, SEEK_CUR);                                      \
+        (void)Mat_fseeko(mat, I *data_size, SEEK_CUR);                                             \
         if ( stride[0] == 1 ) {                                                                    \
             for ( i = 0; i < N; i += edge[0] ) {                                                   \
                 if ( start[0] ) {                                                                  \
-                    (void)fseek((FILE *)mat->fp, start[0] * data_size, SEEK_CUR);                  \
+                    (void)Mat_fseeko(mat, start[0] * data_size, SEEK_CUR);                         \
                     I += start[0];                                                                 \
                 }                                                                                  \
                 ReadDataFunc(mat, ptr + i, data_type, edge[0]);                                    \
                 I += dims[0] - start[0];                                                           \
-                (void)fseek((FILE *)mat->fp, data_size *(dims[0] - edge[0] - start[0]), SEEK_CUR); \
+                (void)Mat_fseeko(mat, data_size *(dims[0] - edge[0] - start[0]), SEEK_CUR);        \
                 READ_DATA_SLABN_RANK_LOOP;                                                         \
             }                                                                                      \
         } else {                                                                                   \
             for ( i = 0; i < N; i += edge[0] ) {                                                   \
                 if ( start[0] ) {                                                                  \
-                    (void)fseek((FILE *)mat->fp, start[0] * data_size, SEEK_CUR);                  \
+                    (void)Mat_fseeko(mat, start[0] * data_size, SEEK_CUR);                         \
                     I += start[0];                                                                 \
                 }                                                                                  \
                 for ( j = 0; j < edge[0]; j++ ) {                                                  \
                     ReadDataFunc(mat, ptr + i + j, data_type, 1);                                  \
-                    (void)fseek((FILE *)mat->fp, data_size *(stride[0] - 1), SEEK_CUR);            \
+                    (void)Mat_fseeko(mat, data_size *(stride[0] - 1), SEEK_CUR);                   \
                     I += stride[0];                                                                \
                 }                                                                                  \
                 I += dims[0] - (ptrdiff_t)edge[0] * stride[0] - start[0];                          \
-                (void)fseek((FILE *)mat->fp,                                                       \
-                            data_size *(dims[0] - (ptrdiff_t)edge[0] * stride[0] - start[0]),      \
-                            SEEK_CUR);                                                             \
+                (void)Mat_fseeko(mat,                                                              \
+                                data_size *(dims[0] - (ptrdiff_t)edge[0] * stride[0] - start[0]),  \
+                                SEEK_CUR);                                                         \
                 READ_DATA_SLABN_RANK_LOOP;                                                         \
             }                                                                                      \
         }                                                                                          \
@@ -2004,7 +2602,7 @@ ReadCompressedDataSlabN(mat_t *mat, z_streamp z, void *data, enum matio_classes
         } else {                                                       \
             for ( i = 0; i < edge; i++ ) {                             \
                 bytesread += ReadDataFunc(mat, ptr + i, data_type, 1); \
-                (void)fseek((FILE *)mat->fp, stride, SEEK_CUR);        \
+                (void)Mat_fseeko(mat, stride, SEEK_CUR);               \
             }                                                          \
         }                                                              \
     } while ( 0 )
@@ -2031,7 +2629,7 @@ ReadDataSlab1(mat_t *mat, void *data, enum matio_classes class_type, enum matio_
     int bytesread = 0;
 
     data_size = Mat_SizeOf(data_type);
-    (void)fseek((FILE *)mat->fp, start * data_size, SEEK_CUR);
+    (void)Mat_fseeko(mat, start * data_size, SEEK_CUR);
     stride = data_size * (stride - 1);
 
     switch ( class_type ) {
@@ -2098,41 +2696,37 @@ ReadDataSlab1(mat_t *mat, void *data, enum matio_classes class_type, enum matio_
 
 #undef READ_DATA_SLAB1
 
-#define READ_DATA_SLAB2(ReadDataFunc)                                                     \
-    do {                                                                                  \
-        /* If stride[0] is 1 and stride[1] is 1, we are reading all of the */             \
-        /* data so get rid of the loops. */                                               \
-        if ( (stride[0] == 1 && (size_t)edge[0] == dims[0]) && (stride[1] == 1) ) {       \
-            ReadDataFunc(mat, ptr, data_type, (ptrdiff_t)edge[0] * edge[1]);              \
-        } else {                                                                          \
-            row_stride = (long)(stride[0] - 1) * data_size;                               \
-            col_stride = (long)stride[1] * dims[0] * data_size;                           \
-            pos = ftell((FILE *)mat->fp);                                                 \
-            if ( pos == -1L ) {                                                           \
-                Mat_Critical("Couldn't determine file position");                         \
-                return -1;                                                                \
-            }                                                                             \
-            (void)fseek((FILE *)mat->fp, (long)start[1] * dims[0] * data_size, SEEK_CUR); \
-            for ( i = 0; i < edge[1]; i++ ) {                                             \
-                pos = ftell((FILE *)mat->fp);                                             \
-                if ( pos == -1L ) {                                                       \
-                    Mat_Critical("Couldn't determine file position");                     \
-                    return -1;                                                            \
-                }                                                                         \
-                (void)fseek((FILE *)mat->fp, (long)start[0] * data_size, SEEK_CUR);       \
-                for ( j = 0; j < edge[0]; j++ ) {                                         \
-                    ReadDataFunc(mat, ptr++, data_type, 1);                               \
-                    (void)fseek((FILE *)mat->fp, row_stride, SEEK_CUR);                   \
-                }                                                                         \
-                pos2 = ftell((FILE *)mat->fp);                                            \
-                if ( pos2 == -1L ) {                                                      \
-                    Mat_Critical("Couldn't determine file position");                     \
-                    return -1;                                                            \
-                }                                                                         \
-                pos += col_stride - pos2;                                                 \
-                (void)fseek((FILE *)mat->fp, pos, SEEK_CUR);                              \
-            }                                                                             \
-        }                                                                                 \
+#define READ_DATA_SLAB2(ReadDataFunc)                                                                  \
+    do {                                                                                               \
+        /* Seek directly to the first element to read */                                               \
+        (void)Mat_fseeko(mat,                                                                          \
+                         ((mat_off_t)start[1] * dims[0] + start[0]) * data_size, SEEK_CUR);            \
+        /* If stride[0] is 1 and stride[1] is 1, we are reading all of the */                          \
+        /* data so get rid of the loops. If stride[0] is 1, we are reading */                          \
+        /* contiguous parts of the columns, so get rid of the inner loop */                            \
+        if ( (stride[0] == 1 && (size_t)edge[0] == dims[0]) && (stride[1] == 1) ) {                    \
+            ReadDataFunc(mat, ptr, data_type, (ptrdiff_t)edge[0] * edge[1]);                           \
+        } else {                                                                                       \
+            row_stride = (mat_off_t)(stride[0] - 1) * data_size;                                       \
+            col_stride = ((mat_off_t)stride[1] * dims[0] - (mat_off_t)(edge[0] - 1) * stride[0] - 1) * \
+                         data_size;                                                                    \
+            for ( i = 0; i < edge[1]; i++ ) {                                                          \
+                if ( i > 0 ) {                                                                         \
+                    (void)Mat_fseeko(mat, col_stride, SEEK_CUR);                                       \
+                }                                                                                      \
+                if ( stride[0] == 1 ) {                                                                \
+                    ReadDataFunc(mat, ptr, data_type, edge[0]);                                        \
+                    ptr += edge[0];                                                                    \
+                } else {                                                                               \
+                    for ( j = 0; j < edge[0]; j++ ) {                                                  \
+                        if ( j > 0 ) {                                                                 \
+                            (void)Mat_fseeko(mat, row_stride, SEEK_CUR);                               \
+                        }                                                                              \
+                        ReadDataFunc(mat, ptr++, data_type, 1);                                        \
+                    }                                                                                  \
+                }                                                                                      \
+            }                                                                                          \
+        }                                                                                              \
     } while ( 0 )
 
 /** @brief Reads data of type @c data_type by user-defined dimensions for 2-D
@@ -2154,7 +2748,7 @@ ReadDataSlab2(mat_t *mat, void *data, enum matio_classes class_type, enum matio_
               const size_t *dims, const int *start, const int *stride, const int *edge)
 {
     int nBytes = 0, data_size, i, j;
-    long pos, row_stride, col_stride, pos2;
+    mat_off_t row_stride, col_stride;
 
     if ( (mat == NULL) || (data == NULL) || (mat->fp == NULL) || (start == NULL) ||
          (stride == NULL) || (edge == NULL) ) {
@@ -2486,6 +3080,9 @@ ReadCompressedDataSlab2(mat_t *mat, z_streamp z, void *data, enum matio_classes
 #ifndef MAT5_H
 #define MAT5_H
 
+/* Minimal size in bytes of the free space of a deleted variable */
+#define FREE_SPACE_SIZE_MIN (56)
+
 static mat_t *Mat_Create5(const char *matname, const char *hdr_str);
 
 static matvar_t *Mat_VarReadNextInfo5(mat_t *mat);
@@ -2495,6 +3092,12 @@ static int Mat_VarReadData5(mat_t *mat, matvar_t *matvar, void *data, const int
 static int Mat_VarReadDataLinear5(mat_t *mat, matvar_t *matvar, void *data, int start, int stride,
                                   int edge);
 static int Mat_VarWrite5(mat_t *mat, matvar_t *matvar, int compress);
+static int Mat_VarWriteFreeSpace5(mat_t *mat, matvar_t *matvar, int compress);
+static int Mat_VarCompression5(const mat_t *mat, const matvar_t *matvar, int compress);
+static int Mat_VarDelete5(mat_t *mat, const char *name);
+static void Mat_SkipFreeSpace5(mat_t *mat);
+static void Mat_AddFreeSpace5(mat_t *mat, mat_off_t offset, mat_off_t size);
+static int WriteFreeSpace5(mat_t *mat, mat_off_t offset, mat_off_t size);
 
 #endif
 
@@ -2815,14 +3418,14 @@ Add(size_t *res, size_t a, size_t b)
  * @param buf Buffer for reading
  * @param size Element size in bytes
  * @param count Element count
- * @param fp File pointer
+ * @param mat MAT file pointer
  * @param[out] bytesread Number of bytes read from the file
  * @retval 0 on success
  */
 static int
-Read(void *buf, size_t size, size_t count, FILE *fp, size_t *bytesread)
+Read(void *buf, size_t size, size_t count, mat_t *mat, size_t *bytesread)
 {
-    const size_t readcount = fread(buf, size, count, fp);
+    const size_t readcount = Mat_fread(buf, size, count, mat);
     int err = readcount != count;
     if ( NULL != bytesread ) {
         *bytesread += readcount * size;
@@ -2840,16 +3443,20 @@ Read(void *buf, size_t size, size_t count, FILE *fp, size_t *bytesread)
 
 /** @brief Check for End of file
  *
- * @param fp File pointer
+ * @param mat MAT file pointer
  * @param[out] fpos Current file position
  * @retval 0 on success
  */
 static int
-IsEndOfFile(FILE *fp, mat_off_t *fpos)
+IsEndOfFile(mat_t *mat, mat_off_t *fpos)
 {
-    int isEOF = feof(fp);
-    mat_off_t fPos = ftello(fp);
-    if ( !isEOF ) {
+    FILE *fp = (FILE *)mat->fp;
+    int isEOF = Mat_feof(mat);
+    mat_off_t fPos = Mat_ftello(mat);
+    if ( NULL != mat->reader ) {
+        /* The file size is known */
+        isEOF = isEOF || fPos >= mat->reader->size;
+    } else if ( !isEOF ) {
         if ( fPos == -1L ) {
             Mat_Critical("Couldn't determine file position");
         } else {
@@ -2866,14 +3473,178 @@ IsEndOfFile(FILE *fp, mat_off_t *fpos)
     return isEOF;
 }
 
+/** @brief Reads the information of a variable by means of the index
+ *
+ * Looks up the file position of the named variable in the index of the
+ * version 4 or 5 MAT file. If the name is not yet indexed, the variables
+ * following the last indexed one are read and indexed until the name
+ * matches. Thus, every variable of the file is scanned only once.
+ * @ingroup mat_internal
+ * @param mat Pointer to the MAT file
+ * @param name Name of the variable to read
+ * @return Pointer to the @ref matvar_t structure containing the MAT
+ * variable information or NULL if not found
+ */
+static matvar_t *
+Mat_VarReadInfoIndexed(mat_t *mat, const char *name)
+{
+    struct mat_index_t *entry = NULL;
+    matvar_t *matvar = NULL;
+    mat_off_t varpos;
+    int indexing = 1;
+
+    HASH_FIND_STR(mat->index, name, entry);
+    if ( NULL != entry ) {
+        (void)Mat_fseeko(mat, entry->offset, SEEK_SET);
+        return Mat_VarReadNextInfo(mat);
+    }
+
+    (void)Mat_fseeko(mat, 0 == mat->index_pos ? mat->bof : mat->index_pos, SEEK_SET);
+    while ( !IsEndOfFile(mat, &varpos) ) {
+        if ( mat->version == MAT_FT_MAT5 ) {
+            /* Index the variable following the free space of deleted ones */
+            Mat_SkipFreeSpace5(mat);
+            if ( IsEndOfFile(mat, &varpos) )
+                break;
+        }
+        matvar = Mat_VarReadNextInfo(mat);
+        if ( NULL == matvar ) {
+            Mat_Critical("An error occurred in reading the MAT file");
+            break;
+        }
+        if ( indexing ) {
+            mat->index_pos = Mat_ftello(mat);
+            if ( NULL != matvar->name ) {
+                /* Keep the first variable of a name as the linear search does */
+                HASH_FIND_STR(mat->index, matvar->name, entry);
+                if ( NULL == entry ) {
+                    entry = (struct mat_index_t *)malloc(sizeof(*entry));
+                    if ( NULL != entry ) {
+                        entry->name = Mat_strdup(matvar->name);
+                        entry->offset = varpos;
+                        if ( NULL != entry->name ) {
+                            HASH_ADD_KEYPTR(hh, mat->index, entry->name, strlen(entry->name),
+                                            entry);
+                        }
+                        if ( NULL == entry->name || NULL == entry->hh.tbl ) {
+                            free(entry->name);
+                            free(entry);
+                            entry = NULL;
+                        }
+                    }
+                    if ( NULL == entry ) {
+                        /* Out of memory: Continue with linear search */
+                        indexing = 0;
+                    }
+                }
+            }
+        }
+        if ( NULL != matvar->name && 0 == strcmp(matvar->name, name) )
+            break;
+        Mat_VarFree(matvar);
+        matvar = NULL;
+    }
+    if ( !indexing ) {
+        Mat_FreeIndex(mat);
+        mat->index_pos = -1L;
+    }
+
+    return matvar;
+}
+
+/** @brief Frees the index of the variables of a MAT file
+ *
+ * @ingroup mat_internal
+ * @param mat Pointer to the MAT file
+ */
+static void
+Mat_FreeIndex(mat_t *mat)
+{
+    struct mat_index_t *entry, *tmp;
+
+    HASH_ITER(hh, mat->index, entry, tmp) {
+        HASH_DEL(mat->index, entry);
+        free(entry->name);
+        free(entry);
+    }
+    mat->index_pos = 0;
+}
+
+/** @brief Frees the list of the free space of a MAT file
+ *
+ * @ingroup mat_internal
+ * @param mat Pointer to the MAT file
+ */
+static void
+Mat_FreeFreeSpace(mat_t *mat)
+{
+    struct mat_free_t *entry, *tmp;
+
+    HASH_ITER(hh, mat->free_space, entry, tmp) {
+        HASH_DEL(mat->free_space, entry);
+        free(entry);
+    }
+}
+
+#if HAVE_ZLIB
+/** @brief Gets the checkpoints of a compressed variable
+ *
+ * @ingroup mat_internal
+ * @param mat Pointer to the MAT file
+ * @param datapos Data position of the variable
+ * @return Pointer to the (possibly empty) checkpoints of the variable or NULL
+ * if out of memory
+ */
+static struct mat_inflate_index_t *
+Mat_GetInflateIndex(mat_t *mat, mat_off_t datapos)
+{
+    struct mat_inflate_index_t *index = NULL;
+
+    HASH_FIND(hh, mat->inflate_index, &datapos, sizeof(datapos), index);
+    if ( NULL == index ) {
+        index = (struct mat_inflate_index_t *)calloc(1, sizeof(*index));
+        if ( NULL != index ) {
+            index->datapos = datapos;
+            index->span = INFLATE_CHECKPOINT_SPAN;
+            HASH_ADD(hh, mat->inflate_index, datapos, sizeof(index->datapos), index);
+            if ( NULL == index->hh.tbl ) {
+                free(index);
+                index = NULL;
+            }
+        }
+    }
+
+    return index;
+}
+
+/** @brief Frees the checkpoints of the compressed variables of a MAT file
+ *
+ * @ingroup mat_internal
+ * @param mat Pointer to the MAT file
+ */
+static void
+Mat_FreeInflateIndex(mat_t *mat)
+{
+    struct mat_inflate_index_t *index, *tmp;
+
+    HASH_ITER(hh, mat->inflate_index, index, tmp) {
+        HASH_DEL(mat->inflate_index, index);
+        InflateFreePoints(index, 0);
+        free(index->points);
+        free(index);
+    }
+    mat->inflate_cur = NULL;
+}
+#endif
+
 /** @brief Check for End of file
  *
- * @param fp File pointer
+ * @param mat MAT file pointer
  * @param[out] offset Desired offset from current file position
  * @retval 0 on success
  */
 static int
-CheckSeekFile(FILE *fp, mat_off_t offset)
+CheckSeekFile(mat_t *mat, mat_off_t offset)
 {
     int err;
     mat_off_t fPos;
@@ -2883,15 +3654,15 @@ CheckSeekFile(FILE *fp, mat_off_t offset)
         return MATIO_E_NO_ERROR;
     }
 
-    fPos = ftello(fp);
+    fPos = Mat_ftello(mat);
     if ( fPos == -1L ) {
         Mat_Critical("Couldn't determine file position");
         return MATIO_E_GENERIC_READ_ERROR;
     }
 
-    (void)fseeko(fp, offset - 1, SEEK_CUR);
-    err = 1 != fread(&c, 1, 1, fp);
-    (void)fseeko(fp, fPos, SEEK_SET);
+    (void)Mat_fseeko(mat, offset - 1, SEEK_CUR);
+    err = 1 != Mat_fread(&c, 1, 1, mat);
+    (void)Mat_fseeko(mat, fPos, SEEK_SET);
     if ( err ) {
         Mat_Critical("Couldn't set file position");
         return MATIO_E_GENERIC_READ_ERROR;
@@ -2900,12 +3671,277 @@ CheckSeekFile(FILE *fp, mat_off_t offset)
     return MATIO_E_NO_ERROR;
 }
 
+/** @brief Sets up the buffered reader of a MAT file opened read-only
+ *
+ * Maps the file to memory (if MAT_READ_MMAP is defined) or else allocates
+ * a buffer of READ_BUFFER_SIZE bytes. The reader starts at the current file
+ * position. If neither is possible, the file is read by stdio.
+ * @ingroup mat_internal
+ * @param mat Pointer to the MAT file
+ */
+static void
+Mat_OpenReader(mat_t *mat)
+{
+    FILE *fp = (FILE *)mat->fp;
+    struct mat_reader_t *reader;
+    mat_off_t pos, size;
+
+    pos = ftello(fp);
+    if ( pos == -1L || 0 != fseeko(fp, 0, SEEK_END) )
+        return;
+    size = ftello(fp);
+    if ( 0 != fseeko(fp, pos, SEEK_SET) || size == -1L )
+        return;
+
+    reader = (struct mat_reader_t *)calloc(1, sizeof(*reader));
+    if ( NULL == reader )
+        return;
+    reader->pos = pos;
+    reader->size = size;
+#if defined(READ_MMAP)
+    if ( size > 0 && (mat_off_t)(size_t)size == size ) {
+#if defined(_WIN32)
+        HANDLE file = (HANDLE)_get_osfhandle(_fileno(fp));
+        reader->map = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if ( NULL != reader->map ) {
+            reader->buf = (mat_uint8_t *)MapViewOfFile(reader->map, FILE_MAP_READ, 0, 0, 0);
+            if ( NULL == reader->buf )
+                (void)CloseHandle(reader->map);
+        }
+#else
+        void *data = mmap(NULL, (size_t)size, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+        if ( MAP_FAILED != data )
+            reader->buf = (mat_uint8_t *)data;
+#endif
+        if ( NULL != reader->buf ) {
+            reader->mapped = 1;
+            reader->buf_size = (size_t)size;
+            reader->len = (size_t)size;
+        }
+    }
+#endif
+    if ( NULL == reader->buf ) {
+        reader->buf = (mat_uint8_t *)malloc(READ_BUFFER_SIZE);
+        if ( NULL == reader->buf ) {
+            free(reader);
+            return;
+        }
+        reader->buf_size = READ_BUFFER_SIZE;
+    }
+    mat->reader = reader;
+}
+
+/** @brief Frees the buffered reader of a MAT file
+ *
+ * @ingroup mat_internal
+ * @param mat Pointer to the MAT file
+ */
+static void
+Mat_CloseReader(mat_t *mat)
+{
+    struct mat_reader_t *reader = mat->reader;
+
+    if ( NULL == reader )
+        return;
+#if defined(READ_MMAP)
+    if ( reader->mapped ) {
+#if defined(_WIN32)
+        (void)UnmapViewOfFile(reader->buf);
+        (void)CloseHandle(reader->map);
+#else
+        (void)munmap(reader->buf, reader->buf_size);
+#endif
+    } else
+#endif
+    {
+        free(reader->buf);
+    }
+    free(reader);
+    mat->reader = NULL;
+}
+
+/** @brief Reads from a MAT file
+ *
+ * Same as fread, but served from the buffered reader if the file is opened
+ * read-only. Requests of at least the buffer size bypass the buffer.
+ * @ingroup mat_internal
+ * @param ptr Buffer for reading
+ * @param size Element size in bytes
+ * @param count Element count
+ * @param mat Pointer to the MAT file
+ * @return Number of elements read
+ */
+static size_t
+Mat_fread(void *ptr, size_t size, size_t count, mat_t *mat)
+{
+    struct mat_reader_t *reader = mat->reader;
+    size_t nBytes, n = 0;
+
+    if ( NULL == reader )
+        return fread(ptr, size, count, (FILE *)mat->fp);
+    if ( 0 == size || 0 == count )
+        return 0;
+    if ( count > (size_t)-1 / size )
+        count = (size_t)-1 / size;
+    nBytes = size * count;
+
+    while ( n < nBytes ) {
+        if ( reader->pos >= reader->start &&
+             reader->pos < reader->start + (mat_off_t)reader->len ) {
+            size_t len = (size_t)(reader->start + (mat_off_t)reader->len - reader->pos);
+            if ( len > nBytes - n )
+                len = nBytes - n;
+            memcpy((mat_uint8_t *)ptr + n, reader->buf + (size_t)(reader->pos - reader->start), len);
+            n += len;
+            reader->pos += (mat_off_t)len;
+        } else if ( reader->mapped || reader->pos >= reader->size ||
+                    0 != fseeko((FILE *)mat->fp, reader->pos, SEEK_SET) ) {
+            break;
+        } else if ( nBytes - n >= reader->buf_size ) {
+            const size_t len = nBytes - n;
+            const size_t nread = fread((mat_uint8_t *)ptr + n, 1, len, (FILE *)mat->fp);
+            n += nread;
+            reader->pos += (mat_off_t)nread;
+            if ( nread < len )
+                break;
+        } else {
+            reader->start = reader->pos;
+            reader->len = fread(reader->buf, 1, reader->buf_size, (FILE *)mat->fp);
+            if ( 0 == reader->len )
+                break;
+        }
+    }
+    if ( n < nBytes )
+        reader->eof = 1;
+
+    return n / size;
+}
+
+#if HAVE_ZLIB
+/** @brief Reads from a MAT file without copying
+ *
+ * Returns the data of the buffered reader at the current position, refilling
+ * the buffer if it holds no such data, and moves the position past it.
+ * @ingroup mat_internal
+ * @param mat Pointer to the MAT file opened read-only
+ * @param[out] ptr Pointer to the data
+ * @return Number of bytes read, at most READ_BUFFER_SIZE
+ */
+static size_t
+Mat_freadDirect(mat_t *mat, mat_uint8_t **ptr)
+{
+    struct mat_reader_t *reader = mat->reader;
+    size_t len;
+
+    if ( reader->pos < reader->start || reader->pos >= reader->start + (mat_off_t)reader->len ) {
+        if ( reader->mapped || reader->pos >= reader->size ||
+             0 != fseeko((FILE *)mat->fp, reader->pos, SEEK_SET) ) {
+            reader->eof = 1;
+            return 0;
+        }
+        reader->start = reader->pos;
+        reader->len = fread(reader->buf, 1, reader->buf_size, (FILE *)mat->fp);
+        if ( 0 == reader->len ) {
+            reader->eof = 1;
+            return 0;
+        }
+    }
+    len = (size_t)(reader->start + (mat_off_t)reader->len - reader->pos);
+    if ( len > READ_BUFFER_SIZE )
+        len = READ_BUFFER_SIZE;
+    *ptr = reader->buf + (size_t)(reader->pos - reader->start);
+    reader->pos += (mat_off_t)len;
+
+    return len;
+}
+#endif
+
+/** @brief Sets the position of a MAT file
+ *
+ * Same as fseeko, but only moves the position of the buffered reader if the
+ * file is opened read-only.
+ * @ingroup mat_internal
+ * @param mat Pointer to the MAT file
+ * @param offset Offset in bytes
+ * @param whence SEEK_SET, SEEK_CUR or SEEK_END
+ * @retval 0 on success
+ */
+static int
+Mat_fseeko(mat_t *mat, mat_off_t offset, int whence)
+{
+    struct mat_reader_t *reader = mat->reader;
+
+    if ( NULL == reader )
+        return fseeko((FILE *)mat->fp, offset, whence);
+    if ( whence == SEEK_CUR )
+        offset += reader->pos;
+    else if ( whence == SEEK_END )
+        offset += reader->size;
+    else if ( whence != SEEK_SET )
+        return -1;
+    if ( offset < 0 )
+        return -1;
+    reader->pos = offset;
+    reader->eof = 0;
+
+    return 0;
+}
+
+/** @brief Gets the position of a MAT file
+ *
+ * @ingroup mat_internal
+ * @param mat Pointer to the MAT file
+ * @return File position
+ */
+static mat_off_t
+Mat_ftello(const mat_t *mat)
+{
+    if ( NULL == mat->reader )
+        return ftello((FILE *)mat->fp);
+    return mat->reader->pos;
+}
+
+/** @brief Checks if a read hit the end of a MAT file
+ *
+ * @ingroup mat_internal
+ * @param mat Pointer to the MAT file
+ * @return Nonzero if a read hit the end of the file
+ */
+static int
+Mat_feof(const mat_t *mat)
+{
+    if ( NULL == mat->reader )
+        return feof((FILE *)mat->fp);
+    return mat->reader->eof;
+}
+
 /*
  *===================================================================
  *                 Public Functions
  *===================================================================
  */
 
+/* Number of MAT files opened for writing that were closed */
+static volatile long mat_write_count = 0;
+
+/** @brief Gets the number of MAT files written
+ *
+ * Gets the number of MAT files opened for writing that were closed so far by
+ * the process. Readers keeping MAT files open can compare it to detect that a
+ * file may have been modified.
+ * @ingroup MAT
+ * @return Number of closed MAT files opened for writing
+ */
+long
+Mat_GetWriteCount(void)
+{
+#if defined(__GNUC__)
+    return __atomic_load_n(&mat_write_count, __ATOMIC_ACQUIRE);
+#else
+    return mat_write_count;
+#endif
+}
+
 /** @brief Get the version of the library
  *
  * Gets the version number of the library
@@ -3047,6 +4083,18 @@ Mat_Open(const char *matname, int mode)
     mat->refs_id = -1;
 #endif
     mat->dir = NULL;
+    mat->index = NULL;
+    mat->index_pos = 0;
+    mat->free_space = NULL;
+    mat->deflate.level = -1;
+    mat->deflate.strategy = MAT_DEFLATE_DEFAULT;
+    mat->deflate.min_size = 0;
+    mat->deflate.sample = 0;
+    mat->reader = NULL;
+#if HAVE_ZLIB
+    mat->inflate_index = NULL;
+    mat->inflate_cur = NULL;
+#endif
 
     bytesread += fread(mat->header, 1, 116, fp);
     mat->header[116] = '\0';
@@ -3066,7 +4114,7 @@ Mat_Open(const char *matname, int mode)
 
         mat->version = (int)tmp2;
         if ( (mat->version == 0x0100 || mat->version == 0x0200) && -1 != mat->byteswap ) {
-            mat->bof = ftello((FILE *)mat->fp);
+            mat->bof = Mat_ftello(mat);
             if ( mat->bof == -1L ) {
                 free(mat->header);
                 free(mat->subsys_offset);
@@ -3165,6 +4213,8 @@ Mat_Open(const char *matname, int mode)
             "MAT file \"%s\"",
             matname);
 #endif
+    } else if ( (mode & 0x01) == MAT_ACC_RDONLY ) {
+        Mat_OpenReader(mat);
     }
 
     return mat;
@@ -3188,6 +4238,7 @@ Mat_Close(mat_t *mat)
             err = Mat_Close73(mat);
         }
 #endif
+        Mat_CloseReader(mat);
         if ( NULL != mat->fp ) {
             err = fclose((FILE *)mat->fp);
             if ( 0 == err ) {
@@ -3196,6 +4247,15 @@ Mat_Close(mat_t *mat)
                 err = MATIO_E_FILESYSTEM_ERROR_ON_CLOSE;
             }
         }
+        if ( (mat->mode & 0x01) == MAT_ACC_RDWR ) {
+#if defined(__GNUC__)
+            (void)__atomic_add_fetch(&mat_write_count, 1, __ATOMIC_RELEASE);
+#elif defined(_MSC_VER)
+            (void)_InterlockedIncrement(&mat_write_count);
+#else
+            mat_write_count++;
+#endif
+        }
         if ( NULL != mat->header )
             free(mat->header);
         if ( NULL != mat->subsys_offset )
@@ -3210,6 +4270,11 @@ Mat_Close(mat_t *mat)
             }
             free(mat->dir);
         }
+        Mat_FreeIndex(mat);
+        Mat_FreeFreeSpace(mat);
+#if HAVE_ZLIB
+        Mat_FreeInflateIndex(mat);
+#endif
         free(mat);
     } else {
         err = MATIO_E_BAD_ARGUMENT;
@@ -3316,13 +4381,13 @@ Mat_GetDir(mat_t *mat, size_t *n)
 #endif
         } else {
             matvar_t *matvar = NULL;
-            mat_off_t fpos = ftello((FILE *)mat->fp);
+            mat_off_t fpos = Mat_ftello(mat);
             if ( fpos == -1L ) {
                 *n = 0;
                 Mat_Critical("Couldn't determine file position");
                 return dir;
             }
-            (void)fseeko((FILE *)mat->fp, mat->bof, SEEK_SET);
+            (void)Mat_fseeko(mat, mat->bof, SEEK_SET);
             mat->num_datasets = 0;
             do {
                 matvar = Mat_VarReadNextInfo(mat);
@@ -3343,12 +4408,12 @@ Mat_GetDir(mat_t *mat, size_t *n)
                         }
                     }
                     Mat_VarFree(matvar);
-                } else if ( !IsEndOfFile((FILE *)mat->fp, NULL) ) {
+                } else if ( !IsEndOfFile(mat, NULL) ) {
                     Mat_Critical("An error occurred in reading the MAT file");
                     break;
                 }
-            } while ( !IsEndOfFile((FILE *)mat->fp, NULL) );
-            (void)fseeko((FILE *)mat->fp, fpos, SEEK_SET);
+            } while ( !IsEndOfFile(mat, NULL) );
+            (void)Mat_fseeko(mat, fpos, SEEK_SET);
             *n = mat->num_datasets;
         }
     } else {
@@ -3383,7 +4448,7 @@ Mat_Rewind(mat_t *mat)
             break;
         case MAT_FT_MAT4:
         case MAT_FT_MAT5:
-            (void)fseeko((FILE *)mat->fp, mat->bof, SEEK_SET);
+            (void)Mat_fseeko(mat, mat->bof, SEEK_SET);
             break;
         default:
             err = MATIO_E_FAIL_TO_IDENTIFY;
@@ -3829,6 +4894,10 @@ Mat_CopyFile(const char *src, const char *dst)
 
 /** @brief Deletes a variable from a file
  *
+ * In a version 5 MAT file the variable is overwritten in place by an empty
+ * matrix without name, which marks its space as free. The free space is
+ * reused by later calls of Mat_VarWrite and released by Mat_Compact. Other
+ * files are rewritten without the variable.
  * @ingroup MAT
  * @param mat Pointer to the mat_t file structure
  * @param name Name of the variable to delete
@@ -3837,16 +4906,112 @@ Mat_CopyFile(const char *src, const char *dst)
 int
 Mat_VarDelete(mat_t *mat, const char *name)
 {
-    int err = MATIO_E_BAD_ARGUMENT;
-    char path_buf[MAT_MKTEMP_BUF_SIZE];
-    char dir_buf[MAT_MKTEMP_BUF_SIZE];
-
     if ( NULL == mat || NULL == name )
-        return err;
+        return MATIO_E_BAD_ARGUMENT;
+
+    if ( (mat->mode & 0x01) == MAT_ACC_RDONLY )
+        return MATIO_E_OPERATION_PROHIBITED_IN_READ_MODE;
+
+    if ( mat->version == MAT_FT_MAT5 ) {
+        const int err = Mat_VarDelete5(mat, name);
+        if ( MATIO_E_OPERATION_NOT_SUPPORTED != err )
+            return err;
+    }
+
+    if ( mat->version != MAT_FT_MAT73 ) {
+        /* Do not rewrite the file if the variable does not exist */
+        matvar_t *matvar = Mat_VarReadInfo(mat, name);
+        if ( NULL == matvar )
+            return MATIO_E_NO_ERROR;
+        Mat_VarFree(matvar);
+    }
+
+    return Mat_Rewrite(mat, name);
+}
+
+/** @brief Releases the free space of the deleted variables of a file
+ *
+ * Rewrites a version 5 MAT file without the free space left by
+ * Mat_VarDelete. Version 7.3 MAT files are rewritten as well, version 4 MAT
+ * files are left unchanged.
+ * @ingroup MAT
+ * @param mat Pointer to the mat_t file structure
+ * @returns 0 on success
+ */
+int
+Mat_Compact(mat_t *mat)
+{
+    if ( NULL == mat )
+        return MATIO_E_BAD_ARGUMENT;
 
     if ( (mat->mode & 0x01) == MAT_ACC_RDONLY )
         return MATIO_E_OPERATION_PROHIBITED_IN_READ_MODE;
 
+    if ( mat->version == MAT_FT_MAT4 )
+        return MATIO_E_NO_ERROR;
+
+    if ( mat->version == MAT_FT_MAT5 ) {
+        /* Scan the file for free space if not yet done */
+        if ( NULL == mat->dir ) {
+            size_t n = 0;
+            (void)Mat_GetDir(mat, &n);
+        }
+        if ( NULL == mat->free_space )
+            return MATIO_E_NO_ERROR;
+    }
+
+    return Mat_Rewrite(mat, NULL);
+}
+
+/** @brief Sets the compression policy of the variables written to a file
+ *
+ * Applies to the variables with numeric or character data written with
+ * MAT_COMPRESSION_ZLIB to a version 5 MAT file. A variable is written
+ * uncompressed if its data is smaller than min_size bytes or if sample is
+ * nonzero and a sample of DEFLATE_SAMPLE_SIZE bytes of its data does not
+ * compress by at least 1/8. Cell arrays and structures are always compressed.
+ * @ingroup MAT
+ * @param mat Pointer to the mat_t file structure
+ * @param level zlib compression level from 1 (fastest) to 9 (best), 0 for
+ *        no compression or -1 for the default level
+ * @param strategy Deflate strategy
+ * @param min_size Minimum size in bytes of the data of a variable to compress
+ * @param sample Nonzero to write a variable uncompressed if a sample of its
+ *        data does not compress
+ * @returns 0 on success
+ */
+int
+Mat_SetCompression(mat_t *mat, int level, enum matio_deflate_strategy strategy, size_t min_size,
+                   int sample)
+{
+    if ( NULL == mat || level < -1 || level > 9 || (int)strategy < (int)MAT_DEFLATE_DEFAULT ||
+         (int)strategy > (int)MAT_DEFLATE_RLE )
+        return MATIO_E_BAD_ARGUMENT;
+
+    mat->deflate.level = level;
+    mat->deflate.strategy = (int)strategy;
+    mat->deflate.min_size = min_size;
+    mat->deflate.sample = 0 != sample;
+
+    return MATIO_E_NO_ERROR;
+}
+
+/** @brief Rewrites a MAT file
+ *
+ * Copies all variables but the given one to a temporary file, which then
+ * replaces the MAT file.
+ * @ingroup mat_internal
+ * @param mat Pointer to the mat_t file structure
+ * @param name Name of the variable to omit or NULL to copy all variables
+ * @returns 0 on success
+ */
+static int
+Mat_Rewrite(mat_t *mat, const char *name)
+{
+    int err = MATIO_E_BAD_ARGUMENT;
+    char path_buf[MAT_MKTEMP_BUF_SIZE];
+    char dir_buf[MAT_MKTEMP_BUF_SIZE];
+
     if ( NULL != Mat_mktemp(path_buf, dir_buf) ) {
         enum mat_ft mat_file_ver;
         mat_t *tmp;
@@ -3872,9 +5037,11 @@ Mat_VarDelete(mat_t *mat, const char *name)
             char **dir;
             size_t n;
 
+            tmp->deflate = mat->deflate;
+            err = MATIO_E_NO_ERROR;
             Mat_Rewind(mat);
             while ( NULL != (matvar = Mat_VarReadNext(mat)) ) {
-                if ( 0 != strcmp(matvar->name, name) )
+                if ( NULL == name || 0 != strcmp(matvar->name, name) )
                     err = Mat_VarWrite(tmp, matvar, matvar->compression);
                 else
                     err = MATIO_E_NO_ERROR;
@@ -3892,6 +5059,7 @@ Mat_VarDelete(mat_t *mat, const char *name)
                     /* err = */ Mat_Close73(mat);
                 }
 #endif
+                Mat_CloseReader(mat);
                 if ( mat->fp != NULL ) {
                     fclose((FILE *)mat->fp);
                     mat->fp = NULL;
@@ -3946,6 +5114,12 @@ Mat_VarDelete(mat_t *mat, const char *name)
                             }
                             free(mat->dir);
                         }
+                        Mat_FreeIndex(mat);
+                        Mat_FreeFreeSpace(mat);
+#if HAVE_ZLIB
+                        Mat_FreeInflateIndex(mat);
+#endif
+                        tmp->deflate = mat->deflate;
                         memcpy(mat, tmp, sizeof(mat_t));
                         free(tmp);
                         mat->num_datasets = n;
@@ -5149,6 +6323,7 @@ Mat_VarReadNextInfoPredicate(mat_t *mat, mat_iter_pred_t pred, const void *user_
 
     switch ( mat->version ) {
         case MAT_FT_MAT5:
+            Mat_SkipFreeSpace5(mat);
             matvar = Mat_VarReadNextInfo5(mat);
             break;
         case MAT_FT_MAT73:
@@ -5222,9 +6397,12 @@ Mat_VarReadInfo(mat_t *mat, const char *name)
         }
         mat->next_index = fpos;
     } else {
-        mat_off_t fpos = ftello((FILE *)mat->fp);
-        if ( fpos != -1L ) {
-            (void)fseeko((FILE *)mat->fp, mat->bof, SEEK_SET);
+        mat_off_t fpos = Mat_ftello(mat);
+        if ( fpos != -1L && -1L != mat->index_pos ) {
+            matvar = Mat_VarReadInfoIndexed(mat, name);
+            (void)Mat_fseeko(mat, fpos, SEEK_SET);
+        } else if ( fpos != -1L ) {
+            (void)Mat_fseeko(mat, mat->bof, SEEK_SET);
             do {
                 matvar = Mat_VarReadNextInfo(mat);
                 if ( matvar != NULL ) {
@@ -5232,12 +6410,12 @@ Mat_VarReadInfo(mat_t *mat, const char *name)
                         Mat_VarFree(matvar);
                         matvar = NULL;
                     }
-                } else if ( !IsEndOfFile((FILE *)mat->fp, NULL) ) {
+                } else if ( !IsEndOfFile(mat, NULL) ) {
                     Mat_Critical("An error occurred in reading the MAT file");
                     break;
                 }
-            } while ( NULL == matvar && !IsEndOfFile((FILE *)mat->fp, NULL) );
-            (void)fseeko((FILE *)mat->fp, fpos, SEEK_SET);
+            } while ( NULL == matvar && !IsEndOfFile(mat, NULL) );
+            (void)Mat_fseeko(mat, fpos, SEEK_SET);
         } else {
             Mat_Critical("Couldn't determine file position");
         }
@@ -5264,7 +6442,7 @@ Mat_VarRead(mat_t *mat, const char *name)
         return NULL;
 
     if ( MAT_FT_MAT73 != mat->version ) {
-        mat_off_t fpos = ftello((FILE *)mat->fp);
+        mat_off_t fpos = Mat_ftello(mat);
         if ( fpos == -1L ) {
             Mat_Critical("Couldn't determine file position");
             return NULL;
@@ -5277,7 +6455,7 @@ Mat_VarRead(mat_t *mat, const char *name)
                 matvar = NULL;
             }
         }
-        (void)fseeko((FILE *)mat->fp, fpos, SEEK_SET);
+        (void)Mat_fseeko(mat, fpos, SEEK_SET);
     } else {
         size_t fpos = mat->next_index;
         mat->next_index = 0;
@@ -5329,7 +6507,7 @@ Mat_VarReadNextPredicate(mat_t *mat, mat_iter_pred_t pred, const void *user_data
     do {
         Mat_VarFree(matvar);
         if ( mat->version != MAT_FT_MAT73 ) {
-            if ( IsEndOfFile((FILE *)mat->fp, &fpos) )
+            if ( IsEndOfFile(mat, &fpos) )
                 return NULL;
             if ( fpos == -1L ) {
                 return NULL;
@@ -5346,7 +6524,7 @@ Mat_VarReadNextPredicate(mat_t *mat, mat_iter_pred_t pred, const void *user_data
         } else {
             if ( mat->version != MAT_FT_MAT73 ) {
                 /* Reset the file position */
-                (void)fseeko((FILE *)mat->fp, fpos, SEEK_SET);
+                (void)Mat_fseeko(mat, fpos, SEEK_SET);
             }
             break;
         }
@@ -5439,18 +6617,23 @@ Mat_VarWrite(mat_t *mat, matvar_t *matvar, enum matio_compression compress)
         }
     }
 
-    if ( mat->version == MAT_FT_MAT5 )
-        err = Mat_VarWrite5(mat, matvar, compress);
-    else if ( mat->version == MAT_FT_MAT73 )
+    if ( mat->version == MAT_FT_MAT5 ) {
+        compress = (enum matio_compression)Mat_VarCompression5(mat, matvar, compress);
+        if ( NULL != mat->free_space )
+            err = Mat_VarWriteFreeSpace5(mat, matvar, compress);
+        else
+            err = Mat_VarWrite5(mat, matvar, compress);
+    } else if ( mat->version == MAT_FT_MAT73 ) {
 #if HAVE_HDF5
         err = Mat_VarWrite73(mat, matvar, compress);
 #else
         err = MATIO_E_OPERATION_NOT_SUPPORTED;
 #endif
-    else if ( mat->version == MAT_FT_MAT4 )
+    } else if ( mat->version == MAT_FT_MAT4 ) {
         err = Mat_VarWrite4(mat, matvar);
-    else
+    } else {
         err = MATIO_E_FAIL_TO_IDENTIFY;
+    }
 
     if ( err == MATIO_E_NO_ERROR ) {
         /* Update directory */
@@ -5476,77 +6659,415 @@ Mat_VarWrite(mat_t *mat, matvar_t *matvar, enum matio_compression compress)
     return err;
 }
 
-/** @brief Writes/appends the given MAT variable to a version 7.3 MAT file
+/** @brief Writes/appends the given MAT variable to a MAT file
+ *
+ * Writes the numeric data of the MAT variable stored in matvar to the given
+ * MAT file. The variable will be written to the end of the file if it does
+ * not yet exist or appended to the existing variable.
+ *
+ * For version 4 and 5 MAT files only 2-D variables are supported. If the
+ * existing variable is uncompressed and the last one of the file, it is
+ * extended in place. Otherwise it is deleted and written anew, merged with
+ * the appended data, to the end of the file.
+ * @ingroup MAT
+ * @param mat MAT file to write to
+ * @param matvar MAT variable information to write
+ * @param compress Whether or not to compress the data
+ *        (Only valid for version 5 and 7.3 MAT files and variables with numeric data)
+ * @param dim dimension to append data
+ *        (Only valid for variables with numeric data)
+ * @retval 0 on success
+ */
+int
+Mat_VarWriteAppend(mat_t *mat, matvar_t *matvar, enum matio_compression compress, int dim)
+{
+    int err;
+
+    if ( NULL == mat || NULL == matvar )
+        return MATIO_E_BAD_ARGUMENT;
+
+    if ( NULL == mat->dir ) {
+        size_t n = 0;
+        (void)Mat_GetDir(mat, &n);
+    }
+
+    if ( mat->version == MAT_FT_MAT73 ) {
+#if HAVE_HDF5
+        int append = 0;
+        {
+            /* Check if MAT variable already exists in MAT file */
+            size_t i;
+            for ( i = 0; i < mat->num_datasets; i++ ) {
+                if ( NULL != mat->dir[i] && 0 == strcmp(mat->dir[i], matvar->name) ) {
+                    append = 1;
+                    break;
+                }
+            }
+        }
+        err = Mat_VarWriteAppend73(mat, matvar, compress, dim);
+        if ( err == MATIO_E_NO_ERROR && 0 == append ) {
+            /* Update directory */
+            char **dir;
+            if ( NULL == mat->dir ) {
+                dir = (char **)malloc(sizeof(char *));
+            } else {
+                dir = (char **)realloc(mat->dir, (mat->num_datasets + 1) * (sizeof(char *)));
+            }
+            if ( NULL != dir ) {
+                mat->dir = dir;
+                if ( NULL != matvar->name ) {
+                    mat->dir[mat->num_datasets++] = Mat_strdup(matvar->name);
+                } else {
+                    mat->dir[mat->num_datasets++] = NULL;
+                }
+            } else {
+                err = MATIO_E_OUT_OF_MEMORY;
+                Mat_Critical("Couldn't allocate memory for the directory");
+            }
+        }
+#else
+        err = MATIO_E_OPERATION_NOT_SUPPORTED;
+#endif
+    } else if ( mat->version == MAT_FT_MAT4 || mat->version == MAT_FT_MAT5 ) {
+        err = Mat_VarWriteAppend45(mat, matvar, compress, dim);
+    } else {
+        err = MATIO_E_FAIL_TO_IDENTIFY;
+    }
+
+    return err;
+}
+
+/** @brief Writes/appends the given MAT variable to a version 4 or 5 MAT file
+ *
+ * @ingroup mat_internal
+ * @param mat MAT file to write to
+ * @param matvar MAT variable information to write
+ * @param compress Whether or not to compress the data of a new variable
+ * @param dim dimension to append data (1 or 2)
+ * @retval 0 on success
+ */
+static int
+Mat_VarWriteAppend45(mat_t *mat, const matvar_t *matvar, enum matio_compression compress, int dim)
+{
+    matvar_t *existing;
+    int err;
+
+    if ( NULL == matvar->name || matvar->rank != 2 || dim < 1 || dim > 2 )
+        return MATIO_E_OPERATION_NOT_SUPPORTED;
+    switch ( matvar->class_type ) {
+        case MAT_C_DOUBLE:
+        case MAT_C_SINGLE:
+        case MAT_C_INT64:
+        case MAT_C_UINT64:
+        case MAT_C_INT32:
+        case MAT_C_UINT32:
+        case MAT_C_INT16:
+        case MAT_C_UINT16:
+        case MAT_C_INT8:
+        case MAT_C_UINT8:
+            break;
+        default:
+            return MATIO_E_OPERATION_NOT_SUPPORTED;
+    }
+
+    existing = Mat_VarReadInfo(mat, matvar->name);
+    if ( NULL == existing )
+        return Mat_VarWrite(mat, (matvar_t *)matvar, compress);
+
+    if ( existing->rank != 2 || existing->class_type != matvar->class_type ||
+         existing->isComplex != matvar->isComplex ||
+         existing->dims[2 - dim] != matvar->dims[2 - dim] ) {
+        Mat_VarFree(existing);
+        return MATIO_E_BAD_ARGUMENT;
+    }
+    if ( 0 == matvar->dims[dim - 1] ) {
+        Mat_VarFree(existing);
+        return MATIO_E_NO_ERROR;
+    }
+
+    err = Mat_VarWriteAppendInPlace(mat, existing, matvar, dim);
+    if ( MATIO_E_OPERATION_NOT_SUPPORTED == err )
+        err = Mat_VarWriteAppendCopy(mat, existing, matvar, compress, dim);
+    Mat_VarFree(existing);
+
+    return err;
+}
+
+/** @brief Appends data to the last variable of a version 4 or 5 MAT file
+ *
+ * Extends the data of an uncompressed, real variable at the end of the file
+ * and then patches its sizes and dimensions. For appended rows, all columns
+ * but the first are moved to their new position.
+ * @ingroup mat_internal
+ * @param mat MAT file to write to
+ * @param existing MAT variable information of the existing variable
+ * @param matvar MAT variable information to append
+ * @param dim dimension to append data (1 or 2)
+ * @retval 0 on success, MATIO_E_OPERATION_NOT_SUPPORTED if the variable
+ * cannot be extended in place
+ */
+static int
+Mat_VarWriteAppendInPlace(mat_t *mat, const matvar_t *existing, const matvar_t *matvar, int dim)
+{
+    FILE *fp = (FILE *)mat->fp;
+    const struct mat_index_t *entry = NULL;
+    const size_t data_size = Mat_SizeOf(matvar->data_type);
+    const size_t m = existing->dims[0], n = existing->dims[1];
+    const size_t k = matvar->dims[dim - 1];
+    size_t m1 = m, n1 = n, nelems, nBytes, j;
+    mat_off_t start, data, eof;
+    mat_uint32_t tag[2], mat_nbytes = 0;
+    int err;
+
+    if ( mat->byteswap || existing->isComplex || existing->compression != MAT_COMPRESSION_NONE ||
+         0 == data_size )
+        return MATIO_E_OPERATION_NOT_SUPPORTED;
+    HASH_FIND_STR(mat->index, matvar->name, entry);
+    if ( NULL == entry )
+        return MATIO_E_OPERATION_NOT_SUPPORTED;
+    start = entry->offset;
+
+    if ( 1 == dim )
+        m1 += k;
+    else
+        n1 += k;
+    if ( m1 < m || n1 < n || Mul(&nelems, m1, n1) || Mul(&nBytes, nelems, data_size) )
+        return MATIO_E_OPERATION_NOT_SUPPORTED;
+
+    (void)fseeko(fp, 0, SEEK_END);
+    eof = ftello(fp);
+    if ( mat->version == MAT_FT_MAT4 ) {
+        if ( existing->data_type != matvar->data_type || m1 > INT_MAX || n1 > INT_MAX )
+            return MATIO_E_OPERATION_NOT_SUPPORTED;
+        data = existing->internal->datapos;
+        if ( data + (mat_off_t)(m * n * data_size) != eof )
+            return MATIO_E_OPERATION_NOT_SUPPORTED;
+    } else {
+        mat_uint32_t data_nbytes;
+        if ( nBytes > UINT32_MAX - 64 )
+            return MATIO_E_OPERATION_NOT_SUPPORTED;
+        /* Variable tag, must end at the end of the file */
+        (void)fseeko(fp, start, SEEK_SET);
+        if ( 0 != Read(tag, 4, 2, mat, NULL) || tag[0] != MAT_T_MATRIX ||
+             start + 8 + (mat_off_t)tag[1] != eof )
+            return MATIO_E_OPERATION_NOT_SUPPORTED;
+        mat_nbytes = tag[1];
+        /* Dimensions tag after the array flags */
+        (void)fseeko(fp, start + 24, SEEK_SET);
+        if ( 0 != Read(tag, 4, 2, mat, NULL) || tag[0] != MAT_T_INT32 || tag[1] != 8 )
+            return MATIO_E_OPERATION_NOT_SUPPORTED;
+        /* Data tag, not packed */
+        (void)fseeko(fp, existing->internal->datapos, SEEK_SET);
+        if ( 0 != Read(tag, 4, 2, mat, NULL) || tag[0] != (mat_uint32_t)matvar->data_type ||
+             tag[1] != m * n * data_size )
+            return MATIO_E_OPERATION_NOT_SUPPORTED;
+        data_nbytes = tag[1];
+        data = existing->internal->datapos + 8;
+
+        /* New size of the variable */
+        if ( data_nbytes % 8 )
+            data_nbytes += 8 - (data_nbytes % 8);
+        tag[1] = (mat_uint32_t)nBytes;
+        if ( nBytes % 8 )
+            tag[1] += 8 - (mat_uint32_t)(nBytes % 8);
+        mat_nbytes += tag[1] - data_nbytes;
+    }
+
+    /* Data */
+    if ( 1 == dim ) {
+        const char *ptr = (const char *)matvar->data;
+        for ( j = n; j-- > 1; ) {
+            err = MoveFileData(fp, data + (mat_off_t)(j * m * data_size),
+                               data + (mat_off_t)(j * m1 * data_size), (mat_off_t)(m * data_size));
+            if ( err )
+                return err;
+            (void)fseeko(fp, data + (mat_off_t)((j * m1 + m) * data_size), SEEK_SET);
+            if ( k != fwrite(ptr + j * k * data_size, data_size, k, fp) )
+                return MATIO_E_GENERIC_WRITE_ERROR;
+        }
+        (void)fseeko(fp, data + (mat_off_t)(m * data_size), SEEK_SET);
+        if ( k != fwrite(ptr, data_size, k, fp) )
+            return MATIO_E_GENERIC_WRITE_ERROR;
+    } else {
+        (void)fseeko(fp, data + (mat_off_t)(m * n * data_size), SEEK_SET);
+        if ( m * k != fwrite(matvar->data, data_size, m * k, fp) )
+            return MATIO_E_GENERIC_WRITE_ERROR;
+    }
+
+    /* Sizes and dimensions, once the data is complete */
+    if ( mat->version == MAT_FT_MAT4 ) {
+        mat_int32_t dims[2];
+        dims[0] = (mat_int32_t)m1;
+        dims[1] = (mat_int32_t)n1;
+        (void)fseeko(fp, start + 4, SEEK_SET);
+        if ( 2 != fwrite(dims, 4, 2, fp) )
+            return MATIO_E_GENERIC_WRITE_ERROR;
+    } else {
+        mat_uint32_t dims[2];
+        /* Zero padding */
+        if ( nBytes % 8 ) {
+            const mat_uint8_t pad[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+            (void)fseeko(fp, data + (mat_off_t)nBytes, SEEK_SET);
+            if ( 8 - nBytes % 8 != fwrite(pad, 1, 8 - nBytes % 8, fp) )
+                return MATIO_E_GENERIC_WRITE_ERROR;
+        }
+        tag[0] = (mat_uint32_t)nBytes;
+        (void)fseeko(fp, existing->internal->datapos + 4, SEEK_SET);
+        if ( 1 != fwrite(tag, 4, 1, fp) )
+            return MATIO_E_GENERIC_WRITE_ERROR;
+        dims[0] = (mat_uint32_t)m1;
+        dims[1] = (mat_uint32_t)n1;
+        (void)fseeko(fp, start + 32, SEEK_SET);
+        if ( 2 != fwrite(dims, 4, 2, fp) )
+            return MATIO_E_GENERIC_WRITE_ERROR;
+        (void)fseeko(fp, start + 4, SEEK_SET);
+        if ( 1 != fwrite(&mat_nbytes, 4, 1, fp) )
+            return MATIO_E_GENERIC_WRITE_ERROR;
+    }
+    (void)fseeko(fp, 0, SEEK_END);
+
+    /* Continue indexing after the extended variable */
+    if ( mat->index_pos > start )
+        mat->index_pos = ftello(fp);
+
+    return MATIO_E_NO_ERROR;
+}
+
+/** @brief Appends data to a variable of a version 4 or 5 MAT file by copying
+ *
+ * Reads the existing variable, deletes it from the file and writes it,
+ * merged with the appended data, to the end of the file.
+ * @ingroup mat_internal
+ * @param mat MAT file to write to
+ * @param existing MAT variable information of the existing variable
+ * @param matvar MAT variable information to append
+ * @param compress Whether or not to compress the data
+ * @param dim dimension to append data (1 or 2)
+ * @retval 0 on success
+ */
+static int
+Mat_VarWriteAppendCopy(mat_t *mat, matvar_t *existing, const matvar_t *matvar,
+                       enum matio_compression compress, int dim)
+{
+    matvar_t *merged;
+    size_t dims[2], nelems, nBytes;
+    void *re = NULL, *im = NULL;
+    mat_complex_split_t complex_data;
+    int err;
+
+    err = ReadData(mat, existing);
+    if ( err )
+        return err;
+    if ( existing->data_size != matvar->data_size )
+        return MATIO_E_BAD_ARGUMENT;
+
+    dims[0] = existing->dims[0];
+    dims[1] = existing->dims[1];
+    dims[dim - 1] += matvar->dims[dim - 1];
+    if ( Mul(&nelems, dims[0], dims[1]) || Mul(&nBytes, nelems, matvar->data_size) ) {
+        Mat_Critical("Integer multiplication overflow");
+        return MATIO_E_INDEX_TOO_BIG;
+    }
+    re = malloc(nBytes);
+    if ( matvar->isComplex )
+        im = malloc(nBytes);
+    if ( NULL == re || (matvar->isComplex && NULL == im) ) {
+        free(re);
+        free(im);
+        Mat_Critical("Couldn't allocate memory for the data");
+        return MATIO_E_OUT_OF_MEMORY;
+    }
+    if ( matvar->isComplex ) {
+        const mat_complex_split_t *ci = (const mat_complex_split_t *)existing->data;
+        const mat_complex_split_t *ca = (const mat_complex_split_t *)matvar->data;
+        AppendData(re, ci->Re, ca->Re, existing->dims, matvar->dims, dim, matvar->data_size);
+        AppendData(im, ci->Im, ca->Im, existing->dims, matvar->dims, dim, matvar->data_size);
+        complex_data.Re = re;
+        complex_data.Im = im;
+        merged = Mat_VarCreate(matvar->name, matvar->class_type, matvar->data_type, 2, dims,
+                               &complex_data, MAT_F_COMPLEX | MAT_F_DONT_COPY_DATA);
+    } else {
+        AppendData(re, existing->data, matvar->data, existing->dims, matvar->dims, dim,
+                   matvar->data_size);
+        merged = Mat_VarCreate(matvar->name, matvar->class_type, matvar->data_type, 2, dims, re,
+                               MAT_F_DONT_COPY_DATA);
+    }
+
+    if ( NULL != merged ) {
+        err = Mat_VarDelete(mat, matvar->name);
+        if ( MATIO_E_NO_ERROR == err )
+            err = Mat_VarWrite(mat, merged, compress);
+        Mat_VarFree(merged);
+    } else {
+        err = MATIO_E_OUT_OF_MEMORY;
+    }
+    free(re);
+    free(im);
+
+    return err;
+}
+
+/** @brief Concatenates two column-major 2-D arrays along a dimension
  *
- * Writes the numeric data of the MAT variable stored in matvar to the given
- * MAT file. The variable will be written to the end of the file if it does
- * not yet exist or appended to the existing variable.
- * @ingroup MAT
- * @param mat MAT file to write to
- * @param matvar MAT variable information to write
- * @param compress Whether or not to compress the data
- *        (Only valid for version 7.3 MAT files and variables with numeric data)
- * @param dim dimension to append data
- *        (Only valid for version 7.3 MAT files and variables with numeric data)
- * @retval 0 on success
+ * @ingroup mat_internal
+ * @param[out] out Concatenated array
+ * @param data First array
+ * @param data2 Second array
+ * @param dims Dimensions of the first array
+ * @param dims2 Dimensions of the second array
+ * @param dim dimension to concatenate (1 or 2)
+ * @param data_size Size of an element in bytes
  */
-int
-Mat_VarWriteAppend(mat_t *mat, matvar_t *matvar, enum matio_compression compress, int dim)
+static void
+AppendData(void *out, const void *data, const void *data2, const size_t *dims,
+           const size_t *dims2, int dim, size_t data_size)
 {
-    int err;
-
-    if ( NULL == mat || NULL == matvar )
-        return MATIO_E_BAD_ARGUMENT;
-
-    if ( NULL == mat->dir ) {
-        size_t n = 0;
-        (void)Mat_GetDir(mat, &n);
-    }
-
-    if ( mat->version == MAT_FT_MAT73 ) {
-#if HAVE_HDF5
-        int append = 0;
-        {
-            /* Check if MAT variable already exists in MAT file */
-            size_t i;
-            for ( i = 0; i < mat->num_datasets; i++ ) {
-                if ( NULL != mat->dir[i] && 0 == strcmp(mat->dir[i], matvar->name) ) {
-                    append = 1;
-                    break;
-                }
-            }
-        }
-        err = Mat_VarWriteAppend73(mat, matvar, compress, dim);
-        if ( err == MATIO_E_NO_ERROR && 0 == append ) {
-            /* Update directory */
-            char **dir;
-            if ( NULL == mat->dir ) {
-                dir = (char **)malloc(sizeof(char *));
-            } else {
-                dir = (char **)realloc(mat->dir, (mat->num_datasets + 1) * (sizeof(char *)));
-            }
-            if ( NULL != dir ) {
-                mat->dir = dir;
-                if ( NULL != matvar->name ) {
-                    mat->dir[mat->num_datasets++] = Mat_strdup(matvar->name);
-                } else {
-                    mat->dir[mat->num_datasets++] = NULL;
-                }
-            } else {
-                err = MATIO_E_OUT_OF_MEMORY;
-                Mat_Critical("Couldn't allocate memory for the directory");
-            }
+    char *ptr = (char *)out;
+    const size_t nBytes = dims[0] * dims[1] * data_size;
+
+    if ( 1 == dim ) {
+        const size_t col = dims[0] * data_size, col2 = dims2[0] * data_size;
+        size_t j;
+        for ( j = 0; j < dims[1]; j++ ) {
+            memcpy(ptr, (const char *)data + j * col, col);
+            ptr += col;
+            memcpy(ptr, (const char *)data2 + j * col2, col2);
+            ptr += col2;
         }
-#else
-        err = MATIO_E_OPERATION_NOT_SUPPORTED;
-#endif
-    } else if ( mat->version == MAT_FT_MAT4 || mat->version == MAT_FT_MAT5 ) {
-        err = MATIO_E_OPERATION_NOT_SUPPORTED;
     } else {
-        err = MATIO_E_FAIL_TO_IDENTIFY;
+        memcpy(ptr, data, nBytes);
+        memcpy(ptr + nBytes, data2, dims2[0] * dims2[1] * data_size);
     }
+}
 
-    return err;
+/** @brief Moves data within a file to a higher file position
+ *
+ * The source and destination may overlap.
+ * @ingroup mat_internal
+ * @param fp File pointer
+ * @param src File position of the data
+ * @param dst New file position of the data (not less than @c src)
+ * @param nBytes Number of bytes to move
+ * @retval 0 on success
+ */
+static int
+MoveFileData(FILE *fp, mat_off_t src, mat_off_t dst, mat_off_t nBytes)
+{
+    mat_uint8_t buf[READ_BLOCK_SIZE];
+
+    /* Move backwards such that overlapping data is read before overwritten */
+    while ( nBytes > 0 ) {
+        const size_t n = nBytes < READ_BLOCK_SIZE ? (size_t)nBytes : READ_BLOCK_SIZE;
+        nBytes -= n;
+        (void)fseeko(fp, src + nBytes, SEEK_SET);
+        if ( n != fread(buf, 1, n, fp) )
+            return MATIO_E_GENERIC_READ_ERROR;
+        (void)fseeko(fp, dst + nBytes, SEEK_SET);
+        if ( n != fwrite(buf, 1, n, fp) )
+            return MATIO_E_GENERIC_WRITE_ERROR;
+    }
+
+    return MATIO_E_NO_ERROR;
 }
 
 /* -------------------------------
@@ -5609,6 +7130,18 @@ Mat_Create4(const char *matname)
     mat->refs_id = -1;
 #endif
     mat->dir = NULL;
+    mat->index = NULL;
+    mat->index_pos = 0;
+    mat->free_space = NULL;
+    mat->deflate.level = -1;
+    mat->deflate.strategy = MAT_DEFLATE_DEFAULT;
+    mat->deflate.min_size = 0;
+    mat->deflate.sample = 0;
+    mat->reader = NULL;
+#if HAVE_ZLIB
+    mat->inflate_index = NULL;
+    mat->inflate_cur = NULL;
+#endif
 
     Mat_Rewind(mat);
 
@@ -5805,7 +7338,7 @@ Mat_VarRead4(mat_t *mat, matvar_t *matvar)
         return err;
     }
 
-    (void)fseeko((FILE *)mat->fp, matvar->internal->datapos, SEEK_SET);
+    (void)Mat_fseeko(mat, matvar->internal->datapos, SEEK_SET);
 
     switch ( matvar->class_type ) {
         case MAT_C_DOUBLE:
@@ -5936,7 +7469,7 @@ Mat_VarRead4(mat_t *mat, matvar_t *matvar)
                 }
                 matvar->dims[0] = (size_t)tmp;
 
-                fpos = ftello((FILE *)mat->fp);
+                fpos = Mat_ftello(mat);
                 if ( fpos == -1L ) {
                     free(sparse->ir);
                     free(matvar->data);
@@ -5944,7 +7477,7 @@ Mat_VarRead4(mat_t *mat, matvar_t *matvar)
                     Mat_Critical("Couldn't determine file position");
                     return MATIO_E_FILE_FORMAT_VIOLATION;
                 }
-                (void)fseeko((FILE *)mat->fp, sparse->nir * Mat_SizeOf(data_type), SEEK_CUR);
+                (void)Mat_fseeko(mat, sparse->nir * Mat_SizeOf(data_type), SEEK_CUR);
                 readcount = ReadDoubleData(mat, &tmp, data_type, 1);
                 if ( readcount != 1 || tmp > UINT_MAX - 1 || tmp < 0 ) {
                     free(sparse->ir);
@@ -5954,7 +7487,7 @@ Mat_VarRead4(mat_t *mat, matvar_t *matvar)
                     return MATIO_E_FILE_FORMAT_VIOLATION;
                 }
                 matvar->dims[1] = (size_t)tmp;
-                (void)fseeko((FILE *)mat->fp, fpos, SEEK_SET);
+                (void)Mat_fseeko(mat, fpos, SEEK_SET);
                 if ( matvar->dims[1] > UINT_MAX - 1 ) {
                     free(sparse->ir);
                     free(matvar->data);
@@ -6292,7 +7825,7 @@ Mat_VarReadData4(mat_t *mat, const matvar_t *matvar, void *data, const int *star
 {
     int err = MATIO_E_NO_ERROR;
 
-    (void)fseeko((FILE *)mat->fp, matvar->internal->datapos, SEEK_SET);
+    (void)Mat_fseeko(mat, matvar->internal->datapos, SEEK_SET);
 
     switch ( matvar->data_type ) {
         case MAT_T_DOUBLE:
@@ -6311,7 +7844,7 @@ Mat_VarReadData4(mat_t *mat, const matvar_t *matvar, void *data, const int *star
             err = MATIO_E_BAD_ARGUMENT;
         else if ( (size_t)stride[1] * (edge[1] - 1) + start[1] + 1 > matvar->dims[1] )
             err = MATIO_E_BAD_ARGUMENT;
-        if ( matvar->isComplex ) {
+        else if ( matvar->isComplex ) {
             mat_complex_split_t *cdata = (mat_complex_split_t *)data;
             size_t nbytes = Mat_SizeOf(matvar->data_type);
             err = Mat_MulDims(matvar, &nbytes);
@@ -6322,7 +7855,7 @@ Mat_VarReadData4(mat_t *mat, const matvar_t *matvar, void *data, const int *star
 
             ReadDataSlab2(mat, cdata->Re, matvar->class_type, matvar->data_type, matvar->dims,
                           start, stride, edge);
-            (void)fseeko((FILE *)mat->fp, matvar->internal->datapos + nbytes, SEEK_SET);
+            (void)Mat_fseeko(mat, matvar->internal->datapos + nbytes, SEEK_SET);
             ReadDataSlab2(mat, cdata->Im, matvar->class_type, matvar->data_type, matvar->dims,
                           start, stride, edge);
         } else {
@@ -6340,7 +7873,7 @@ Mat_VarReadData4(mat_t *mat, const matvar_t *matvar, void *data, const int *star
 
         ReadDataSlabN(mat, cdata->Re, matvar->class_type, matvar->data_type, matvar->rank,
                       matvar->dims, start, stride, edge);
-        (void)fseeko((FILE *)mat->fp, matvar->internal->datapos + nbytes, SEEK_SET);
+        (void)Mat_fseeko(mat, matvar->internal->datapos + nbytes, SEEK_SET);
         ReadDataSlabN(mat, cdata->Im, matvar->class_type, matvar->data_type, matvar->rank,
                       matvar->dims, start, stride, edge);
     } else {
@@ -6376,7 +7909,7 @@ Mat_VarReadDataLinear4(mat_t *mat, matvar_t *matvar, void *data, int start, int
         return err;
     }
 
-    (void)fseeko((FILE *)mat->fp, matvar->internal->datapos, SEEK_SET);
+    (void)Mat_fseeko(mat, matvar->internal->datapos, SEEK_SET);
 
     matvar->data_size = (int)Mat_SizeOf(matvar->data_type);
 
@@ -6393,7 +7926,7 @@ Mat_VarReadDataLinear4(mat_t *mat, matvar_t *matvar, void *data, int start, int
 
         ReadDataSlab1(mat, complex_data->Re, matvar->class_type, matvar->data_type, start, stride,
                       edge);
-        (void)fseeko((FILE *)mat->fp, matvar->internal->datapos + nelems, SEEK_SET);
+        (void)Mat_fseeko(mat, matvar->internal->datapos + nelems, SEEK_SET);
         ReadDataSlab1(mat, complex_data->Im, matvar->class_type, matvar->data_type, start, stride,
                       edge);
     } else {
@@ -6426,7 +7959,7 @@ Mat_VarReadNextInfo4(mat_t *mat)
     if ( mat == NULL || mat->fp == NULL )
         return NULL;
 
-    if ( IsEndOfFile((FILE *)mat->fp, &fpos) )
+    if ( IsEndOfFile(mat, &fpos) )
         return NULL;
 
     if ( fpos == -1L )
@@ -6434,7 +7967,7 @@ Mat_VarReadNextInfo4(mat_t *mat)
 
     {
         size_t nbytes = 0;
-        int err = Read(&tmp, sizeof(mat_int32_t), 1, (FILE *)mat->fp, &nbytes);
+        int err = Read(&tmp, sizeof(mat_int32_t), 1, mat, &nbytes);
         if ( err || 0 == nbytes )
             return NULL;
     }
@@ -6523,7 +8056,7 @@ Mat_VarReadNextInfo4(mat_t *mat)
         Mat_VarFree(matvar);
         return NULL;
     }
-    if ( 0 != Read(&tmp, sizeof(int), 1, (FILE *)mat->fp, NULL) ) {
+    if ( 0 != Read(&tmp, sizeof(int), 1, mat, NULL) ) {
         Mat_VarFree(matvar);
         return NULL;
     }
@@ -6531,7 +8064,7 @@ Mat_VarReadNextInfo4(mat_t *mat)
         Mat_int32Swap(&tmp);
     matvar->dims[0] = tmp;
 
-    if ( 0 != Read(&tmp, sizeof(int), 1, (FILE *)mat->fp, NULL) ) {
+    if ( 0 != Read(&tmp, sizeof(int), 1, mat, NULL) ) {
         Mat_VarFree(matvar);
         return NULL;
     }
@@ -6539,7 +8072,7 @@ Mat_VarReadNextInfo4(mat_t *mat)
         Mat_int32Swap(&tmp);
     matvar->dims[1] = tmp;
 
-    if ( 0 != Read(&(matvar->isComplex), sizeof(int), 1, (FILE *)mat->fp, NULL) ) {
+    if ( 0 != Read(&(matvar->isComplex), sizeof(int), 1, mat, NULL) ) {
         Mat_VarFree(matvar);
         return NULL;
     }
@@ -6547,7 +8080,7 @@ Mat_VarReadNextInfo4(mat_t *mat)
         Mat_VarFree(matvar);
         return NULL;
     }
-    if ( 0 != Read(&tmp, sizeof(int), 1, (FILE *)mat->fp, NULL) ) {
+    if ( 0 != Read(&tmp, sizeof(int), 1, mat, NULL) ) {
         Mat_VarFree(matvar);
         return NULL;
     }
@@ -6563,14 +8096,14 @@ Mat_VarReadNextInfo4(mat_t *mat)
         Mat_VarFree(matvar);
         return NULL;
     }
-    if ( 0 != Read(matvar->name, sizeof(char), tmp, (FILE *)mat->fp, NULL) ) {
+    if ( 0 != Read(matvar->name, sizeof(char), tmp, mat, NULL) ) {
         Mat_VarFree(matvar);
         return NULL;
     } else {
         matvar->name[tmp - 1] = '\0';
     }
 
-    matvar->internal->datapos = ftello((FILE *)mat->fp);
+    matvar->internal->datapos = Mat_ftello(mat);
     if ( matvar->internal->datapos == -1L ) {
         Mat_VarFree(matvar);
         Mat_Critical("Couldn't determine file position");
@@ -6590,7 +8123,7 @@ Mat_VarReadNextInfo4(mat_t *mat)
 
         nBytes = (mat_off_t)tmp2;
     }
-    (void)fseeko((FILE *)mat->fp, nBytes, SEEK_CUR);
+    (void)Mat_fseeko(mat, nBytes, SEEK_CUR);
 
     return matvar;
 }
@@ -6661,6 +8194,23 @@ static size_t WriteCompressedCellArrayField(mat_t *mat, matvar_t *matvar, z_stre
 static size_t WriteCompressedStructField(mat_t *mat, matvar_t *matvar, z_streamp z);
 static size_t Mat_WriteCompressedEmptyVariable5(mat_t *mat, const char *name, int rank,
                                                 const size_t *dims, z_streamp z);
+static int DeflateSample(const mat_t *mat, const mat_uint8_t *data, size_t nBytes);
+#if defined(PARALLEL_DEFLATE)
+static int WriteCompressedTypeParallel(mat_t *mat, matvar_t *matvar, z_streamp z);
+static void DeflateRound(struct mat_deflate_t *job, struct mat_deflate_worker_t *workers,
+                         size_t nworkers);
+static void DeflateBlocks(struct mat_deflate_worker_t *worker);
+#if defined(_WIN32)
+static DWORD WINAPI DeflateThread(LPVOID arg);
+#else
+static void *DeflateThread(void *arg);
+#endif
+static void DeflateBlock(const struct mat_deflate_t *job, size_t i);
+static const mat_uint8_t *DeflateInput(const struct mat_deflate_t *job, size_t offset,
+                                       size_t *len);
+static size_t DeflateThreads(void);
+static int TruncateFile(mat_t *mat);
+#endif
 #endif
 
 /** @brief determines the number of bytes for a given class type
@@ -7068,7 +8618,7 @@ ReadSparse(mat_t *mat, const matvar_t *matvar, mat_uint32_t *n, mat_uint32_t **v
 #endif
     } else {
         mat_uint32_t tag[2] = {0, 0};
-        if ( 0 != Read(tag, 4, 1, (FILE *)mat->fp, &bytesread) ) {
+        if ( 0 != Read(tag, 4, 1, mat, &bytesread) ) {
             return bytesread;
         }
         if ( mat->byteswap )
@@ -7079,7 +8629,7 @@ ReadSparse(mat_t *mat, const matvar_t *matvar, mat_uint32_t *n, mat_uint32_t **v
             N = (tag[0] & 0xffff0000) >> 16;
         } else {
             data_in_tag = 0;
-            if ( 0 != Read(&N, 4, 1, (FILE *)mat->fp, &bytesread) ) {
+            if ( 0 != Read(&N, 4, 1, mat, &bytesread) ) {
                 return bytesread;
             }
             if ( mat->byteswap )
@@ -7101,7 +8651,7 @@ ReadSparse(mat_t *mat, const matvar_t *matvar, mat_uint32_t *n, mat_uint32_t **v
             if ( data_in_tag )
                 nBytes += 4;
             if ( (nBytes % 8) != 0 )
-                (void)fseeko((FILE *)mat->fp, 8 - (nBytes % 8), SEEK_CUR);
+                (void)Mat_fseeko(mat, 8 - (nBytes % 8), SEEK_CUR);
 #if HAVE_ZLIB
         } else if ( matvar->compression == MAT_COMPRESSION_ZLIB ) {
             int nBytes = ReadCompressedUInt32Data(mat, matvar->internal->z, *v, packed_type, *n);
@@ -7235,6 +8785,18 @@ Mat_Create5(const char *matname, const char *hdr_str)
     mat->refs_id = -1;
 #endif
     mat->dir = NULL;
+    mat->index = NULL;
+    mat->index_pos = 0;
+    mat->free_space = NULL;
+    mat->deflate.level = -1;
+    mat->deflate.strategy = MAT_DEFLATE_DEFAULT;
+    mat->deflate.min_size = 0;
+    mat->deflate.sample = 0;
+    mat->reader = NULL;
+#if HAVE_ZLIB
+    mat->inflate_index = NULL;
+    mat->inflate_cur = NULL;
+#endif
 
     t = time(NULL);
     mat->fp = fp;
@@ -7540,55 +9102,471 @@ WriteData(mat_t *mat, const void *data, size_t N, enum matio_types data_type)
     return nBytes;
 }
 
-#if HAVE_ZLIB
-/* Compresses the data buffer and writes it to the file */
+#if HAVE_ZLIB
+/* Compresses the data buffer and writes it to the file */
+static size_t
+WriteCompressedData(mat_t *mat, z_streamp z, void *data, int N, enum matio_types data_type)
+{
+    int nBytes = 0, data_size, data_tag[2], byteswritten = 0;
+    int buf_size = 1024;
+    mat_uint8_t buf[1024], pad[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+
+    if ( mat == NULL || mat->fp == NULL )
+        return 0;
+
+    data_size = Mat_SizeOf(data_type);
+    data_tag[0] = data_type;
+    data_tag[1] = data_size * N;
+    z->next_in = ZLIB_BYTE_PTR(data_tag);
+    z->avail_in = 8;
+    do {
+        z->next_out = buf;
+        z->avail_out = buf_size;
+        deflate(z, Z_NO_FLUSH);
+        byteswritten += fwrite(buf, 1, buf_size - z->avail_out, (FILE *)mat->fp);
+    } while ( z->avail_out == 0 );
+
+    /* exit early if this is an empty data */
+    if ( NULL == data || N < 1 )
+        return byteswritten;
+
+    z->next_in = (Bytef *)data;
+    z->avail_in = N * data_size;
+    do {
+        z->next_out = buf;
+        z->avail_out = buf_size;
+        deflate(z, Z_NO_FLUSH);
+        byteswritten += fwrite(buf, 1, buf_size - z->avail_out, (FILE *)mat->fp);
+    } while ( z->avail_out == 0 );
+    /* Add/Compress padding to pad to 8-byte boundary */
+    if ( N * data_size % 8 ) {
+        z->next_in = pad;
+        z->avail_in = 8 - (N * data_size % 8);
+        do {
+            z->next_out = buf;
+            z->avail_out = buf_size;
+            deflate(z, Z_NO_FLUSH);
+            byteswritten += fwrite(buf, 1, buf_size - z->avail_out, (FILE *)mat->fp);
+        } while ( z->avail_out == 0 );
+    }
+    nBytes = byteswritten;
+    return nBytes;
+}
+
+/** @brief Checks if a sample of the data of a variable compresses
+ *
+ * Deflates DEFLATE_SAMPLE_SIZE bytes, taken in evenly spaced parts of the
+ * data, with the compression policy of the MAT file.
+ * @ingroup mat_internal
+ * @param mat MAT file pointer
+ * @param data Data
+ * @param nBytes Size of the data in bytes (> DEFLATE_SAMPLE_SIZE)
+ * @retval 1 if the sample compresses by at least 1/8 (or on error), 0 otherwise
+ */
+static int
+DeflateSample(const mat_t *mat, const mat_uint8_t *data, size_t nBytes)
+{
+    const size_t len = DEFLATE_SAMPLE_SIZE / DEFLATE_SAMPLE_PARTS;
+    const size_t step = (nBytes - len) / (DEFLATE_SAMPLE_PARTS - 1);
+    mat_uint8_t buf[4096];
+    z_stream z;
+    size_t i;
+    int err;
+
+    memset(&z, 0, sizeof(z));
+    err = deflateInit2(&z, mat->deflate.level, Z_DEFLATED, MAX_WBITS, 8, mat->deflate.strategy);
+    if ( Z_OK != err )
+        return 1;
+    for ( i = 0; i < DEFLATE_SAMPLE_PARTS; i++ ) {
+        z.next_in = (Bytef *)(data + i * step);
+        z.avail_in = (uInt)len;
+        do {
+            z.next_out = buf;
+            z.avail_out = sizeof(buf);
+            err = deflate(&z, i + 1 < DEFLATE_SAMPLE_PARTS ? Z_NO_FLUSH : Z_FINISH);
+        } while ( Z_OK == err && z.avail_out == 0 );
+    }
+    (void)deflateEnd(&z);
+
+    return Z_STREAM_END != err || z.total_out < DEFLATE_SAMPLE_SIZE - DEFLATE_SAMPLE_SIZE / 8;
+}
+#endif
+
+#if defined(PARALLEL_DEFLATE)
+/** @brief Writes the data of a numeric variable deflated by worker threads
+ *
+ * Flushes the compressed header of the variable and appends the data tags,
+ * data and padding as raw deflate blocks. Each block is deflated with the
+ * preceding 32 KiB as preset dictionary and all but the last one end at a
+ * byte boundary (Z_SYNC_FLUSH), such that their concatenation continues the
+ * zlib stream. The Adler-32 checksum is combined from the ones of the blocks.
+ * @ingroup mat_internal
+ * @param mat MAT file pointer
+ * @param matvar MAT variable
+ * @param z zlib compression stream of the variable (not finished on return)
+ * @retval 0 on success, MATIO_E_OPERATION_NOT_SUPPORTED if the variable is
+ * to be written by WriteCompressedType
+ */
+static int
+WriteCompressedTypeParallel(mat_t *mat, matvar_t *matvar, z_streamp z)
+{
+    static const mat_uint8_t pad[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    struct mat_deflate_t job;
+    struct mat_deflate_worker_t *workers;
+    mat_uint32_t data_tag[2];
+    mat_uint8_t buf[1024], trailer[4];
+    const size_t nparts = matvar->isComplex ? 2 : 1;
+    size_t nelems = 1, nBytes, nthreads, nrounds, i;
+    uLong adler;
+    int err = MATIO_E_NO_ERROR;
+
+    switch ( matvar->class_type ) {
+        case MAT_C_DOUBLE:
+        case MAT_C_SINGLE:
+        case MAT_C_INT64:
+        case MAT_C_UINT64:
+        case MAT_C_INT32:
+        case MAT_C_UINT32:
+        case MAT_C_INT16:
+        case MAT_C_UINT16:
+        case MAT_C_INT8:
+        case MAT_C_UINT8:
+            break;
+        default:
+            return MATIO_E_OPERATION_NOT_SUPPORTED;
+    }
+    if ( NULL == matvar->data || Mat_MulDims(matvar, &nelems) ||
+         Mul(&nBytes, nelems, Mat_SizeOf(matvar->data_type)) || nBytes > UINT32_MAX ||
+         nBytes < 2 * DEFLATE_BLOCK_SIZE )
+        return MATIO_E_OPERATION_NOT_SUPPORTED;
+    nthreads = DeflateThreads();
+    if ( nthreads < 2 )
+        return MATIO_E_OPERATION_NOT_SUPPORTED;
+
+    data_tag[0] = matvar->data_type;
+    data_tag[1] = (mat_uint32_t)nBytes;
+    job.nseg = 0;
+    for ( i = 0; i < nparts; i++ ) {
+        const mat_complex_split_t *complex_data = (const mat_complex_split_t *)matvar->data;
+        job.seg[job.nseg] = (const mat_uint8_t *)data_tag;
+        job.seg_len[job.nseg++] = 8;
+        if ( matvar->isComplex )
+            job.seg[job.nseg] = (const mat_uint8_t *)(0 == i ? complex_data->Re : complex_data->Im);
+        else
+            job.seg[job.nseg] = (const mat_uint8_t *)matvar->data;
+        job.seg_len[job.nseg++] = nBytes;
+        job.seg[job.nseg] = pad;
+        job.seg_len[job.nseg++] = nBytes % 8 ? 8 - nBytes % 8 : 0;
+    }
+    job.level = mat->deflate.level;
+    job.strategy = mat->deflate.strategy;
+    job.nBytes = 0;
+    for ( i = 0; i < (size_t)job.nseg; i++ )
+        job.nBytes += job.seg_len[i];
+    job.nblocks = (job.nBytes + DEFLATE_BLOCK_SIZE - 1) / DEFLATE_BLOCK_SIZE;
+    /* Rounds of a few blocks per worker bound the memory of deflated blocks */
+    nrounds = 4 * nthreads;
+    if ( nrounds > job.nblocks )
+        nrounds = job.nblocks;
+    job.blocks = (struct mat_deflate_block_t *)calloc(nrounds, sizeof(*job.blocks));
+    workers = (struct mat_deflate_worker_t *)calloc(nthreads, sizeof(*workers));
+    if ( NULL == job.blocks || NULL == workers ) {
+        free(job.blocks);
+        free(workers);
+        return MATIO_E_OPERATION_NOT_SUPPORTED;
+    }
+
+    /* Flush the header to a byte boundary */
+    z->next_in = NULL;
+    z->avail_in = 0;
+    do {
+        z->next_out = buf;
+        z->avail_out = sizeof(buf);
+        deflate(z, Z_SYNC_FLUSH);
+        fwrite(buf, 1, sizeof(buf) - z->avail_out, (FILE *)mat->fp);
+    } while ( z->avail_out == 0 );
+    adler = z->adler;
+
+    for ( job.first = 0; job.first < job.nblocks; job.first += job.count ) {
+        job.count = job.nblocks - job.first;
+        if ( job.count > nrounds )
+            job.count = nrounds;
+        DeflateRound(&job, workers, nthreads);
+        for ( i = 0; i < job.count; i++ ) {
+            struct mat_deflate_block_t *block = job.blocks + i;
+            if ( MATIO_E_NO_ERROR == err ) {
+                if ( Z_OK != block->err && Z_STREAM_END != block->err ) {
+                    Mat_Critical("deflate returned %s", zError(block->err));
+                    err = MATIO_E_FILE_FORMAT_VIOLATION;
+                } else if ( block->len != fwrite(block->buf, 1, block->len, (FILE *)mat->fp) ) {
+                    err = MATIO_E_GENERIC_WRITE_ERROR;
+                }
+                adler = adler32_combine(adler, block->adler, (z_off_t)block->nBytes);
+            }
+            free(block->buf);
+            block->buf = NULL;
+        }
+        if ( MATIO_E_NO_ERROR != err )
+            break;
+    }
+    free(job.blocks);
+    free(workers);
+
+    if ( MATIO_E_NO_ERROR == err ) {
+        trailer[0] = (mat_uint8_t)(adler >> 24);
+        trailer[1] = (mat_uint8_t)(adler >> 16);
+        trailer[2] = (mat_uint8_t)(adler >> 8);
+        trailer[3] = (mat_uint8_t)adler;
+        fwrite(trailer, 1, 4, (FILE *)mat->fp);
+    }
+
+    return err;
+}
+
+/** @brief Deflates the blocks of the current round
+ *
+ * The calling thread deflates the blocks of the first worker and of any
+ * worker whose thread could not be started.
+ * @ingroup mat_internal
+ * @param job Data to deflate
+ * @param workers Workers
+ * @param nworkers Number of workers (including the calling thread)
+ */
+static void
+DeflateRound(struct mat_deflate_t *job, struct mat_deflate_worker_t *workers, size_t nworkers)
+{
+    size_t t;
+
+    if ( nworkers > job->count )
+        nworkers = job->count;
+    for ( t = 0; t < nworkers; t++ ) {
+        workers[t].job = job;
+        workers[t].index = t;
+        workers[t].stride = nworkers;
+        workers[t].started = 0;
+    }
+    for ( t = 1; t < nworkers; t++ ) {
+#if defined(_WIN32)
+        workers[t].thread = CreateThread(NULL, 0, DeflateThread, workers + t, 0, NULL);
+        workers[t].started = NULL != workers[t].thread;
+#else
+        workers[t].started =
+            0 == pthread_create(&workers[t].thread, NULL, DeflateThread, workers + t);
+#endif
+    }
+    for ( t = 0; t < nworkers; t++ ) {
+        if ( !workers[t].started )
+            DeflateBlocks(workers + t);
+    }
+    for ( t = 1; t < nworkers; t++ ) {
+        if ( workers[t].started ) {
+#if defined(_WIN32)
+            (void)WaitForSingleObject(workers[t].thread, INFINITE);
+            (void)CloseHandle(workers[t].thread);
+#else
+            (void)pthread_join(workers[t].thread, NULL);
+#endif
+        }
+    }
+}
+
+/** @brief Deflates every stride-th block of the current round
+ *
+ * @ingroup mat_internal
+ * @param worker Worker
+ */
+static void
+DeflateBlocks(struct mat_deflate_worker_t *worker)
+{
+    size_t i;
+
+    for ( i = worker->index; i < worker->job->count; i += worker->stride )
+        DeflateBlock(worker->job, worker->job->first + i);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI
+DeflateThread(LPVOID arg)
+{
+    DeflateBlocks((struct mat_deflate_worker_t *)arg);
+    return 0;
+}
+#else
+static void *
+DeflateThread(void *arg)
+{
+    DeflateBlocks((struct mat_deflate_worker_t *)arg);
+    return NULL;
+}
+#endif
+
+/** @brief Deflates a block of the data of a variable
+ *
+ * Runs in a worker thread and thus must not report errors itself.
+ * @ingroup mat_internal
+ * @param job Data to deflate
+ * @param i Index of the block
+ */
+static void
+DeflateBlock(const struct mat_deflate_t *job, size_t i)
+{
+    struct mat_deflate_block_t *block = job->blocks + (i - job->first);
+    const size_t offset = i * DEFLATE_BLOCK_SIZE;
+    const int last = i + 1 == job->nblocks;
+    mat_uint8_t dict[32768];
+    size_t pos, size;
+    z_stream z;
+
+    block->nBytes = job->nBytes - offset;
+    if ( block->nBytes > DEFLATE_BLOCK_SIZE )
+        block->nBytes = DEFLATE_BLOCK_SIZE;
+    block->adler = adler32(0L, Z_NULL, 0);
+    block->len = 0;
+    memset(&z, 0, sizeof(z));
+    block->err = deflateInit2(&z, job->level, Z_DEFLATED, -MAX_WBITS, 8, job->strategy);
+    if ( Z_OK != block->err )
+        return;
+
+    /* The preceding data as seen by the decompressor */
+    if ( offset > 0 ) {
+        const size_t dict_len = offset < sizeof(dict) ? offset : sizeof(dict);
+        for ( pos = 0; pos < dict_len; pos += size ) {
+            const mat_uint8_t *ptr;
+            size = dict_len - pos;
+            ptr = DeflateInput(job, offset - dict_len + pos, &size);
+            memcpy(dict + pos, ptr, size);
+        }
+        block->err = deflateSetDictionary(&z, dict, (uInt)dict_len);
+    }
+
+    size = deflateBound(&z, (uLong)block->nBytes) + 16;
+    block->buf = (mat_uint8_t *)malloc(size);
+    if ( NULL == block->buf )
+        block->err = Z_MEM_ERROR;
+    for ( pos = 0; Z_OK == block->err && pos < block->nBytes; ) {
+        size_t n = block->nBytes - pos;
+        const mat_uint8_t *ptr = DeflateInput(job, offset + pos, &n);
+        int flush = Z_NO_FLUSH;
+        pos += n;
+        if ( pos == block->nBytes )
+            flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+        block->adler = adler32(block->adler, ptr, (uInt)n);
+        z.next_in = (Bytef *)ptr;
+        z.avail_in = (uInt)n;
+        do {
+            if ( block->len == size ) {
+                mat_uint8_t *buf = (mat_uint8_t *)realloc(block->buf, 2 * size);
+                if ( NULL == buf ) {
+                    block->err = Z_MEM_ERROR;
+                    break;
+                }
+                block->buf = buf;
+                size *= 2;
+            }
+            z.next_out = block->buf + block->len;
+            z.avail_out = (uInt)(size - block->len);
+            block->err = deflate(&z, flush);
+            block->len = size - z.avail_out;
+        } while ( Z_OK == block->err && z.avail_out == 0 );
+        if ( Z_BUF_ERROR == block->err )
+            block->err = Z_OK;
+    }
+    (void)deflateEnd(&z);
+}
+
+/** @brief Gets a contiguous part of the data of a variable
+ *
+ * @ingroup mat_internal
+ * @param job Data to deflate
+ * @param offset Offset of the part in the data
+ * @param[in,out] len Requested size of the part on input, size of the
+ * contiguous part on output
+ * @return Pointer to the part
+ */
+static const mat_uint8_t *
+DeflateInput(const struct mat_deflate_t *job, size_t offset, size_t *len)
+{
+    int k;
+
+    for ( k = 0; k < job->nseg; k++ ) {
+        if ( offset < job->seg_len[k] ) {
+            if ( *len > job->seg_len[k] - offset )
+                *len = job->seg_len[k] - offset;
+            return job->seg[k] + offset;
+        }
+        offset -= job->seg_len[k];
+    }
+    *len = 0;
+    return NULL;
+}
+
+/** @brief Gets the number of worker threads to deflate a variable
+ *
+ * @ingroup mat_internal
+ * @return Value of the environment variable MAT_DEFLATE_THREADS if positive,
+ * number of processors otherwise, at most MAX_DEFLATE_THREADS
+ */
 static size_t
-WriteCompressedData(mat_t *mat, z_streamp z, void *data, int N, enum matio_types data_type)
+DeflateThreads(void)
 {
-    int nBytes = 0, data_size, data_tag[2], byteswritten = 0;
-    int buf_size = 1024;
-    mat_uint8_t buf[1024], pad[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    long n = 0;
+#if defined(_MSC_VER) && _MSC_VER >= 1400
+    char *value = NULL;
+    size_t len = 0;
+#else
+    const char *value;
+#endif
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+#endif
 
-    if ( mat == NULL || mat->fp == NULL )
-        return 0;
+#if defined(_MSC_VER) && _MSC_VER >= 1400
+    if ( 0 == _dupenv_s(&value, &len, "MAT_DEFLATE_THREADS") && NULL != value ) {
+        n = strtol(value, NULL, 10);
+        free(value);
+    }
+#else
+    value = getenv("MAT_DEFLATE_THREADS");
+    if ( NULL != value )
+        n = strtol(value, NULL, 10);
+#endif
+    if ( n < 1 ) {
+#if defined(_WIN32)
+        GetSystemInfo(&info);
+        n = (long)info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+        n = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    }
+    if ( n < 1 )
+        n = 1;
+    else if ( n > MAX_DEFLATE_THREADS )
+        n = MAX_DEFLATE_THREADS;
+    return (size_t)n;
+}
 
-    data_size = Mat_SizeOf(data_type);
-    data_tag[0] = data_type;
-    data_tag[1] = data_size * N;
-    z->next_in = ZLIB_BYTE_PTR(data_tag);
-    z->avail_in = 8;
-    do {
-        z->next_out = buf;
-        z->avail_out = buf_size;
-        deflate(z, Z_NO_FLUSH);
-        byteswritten += fwrite(buf, 1, buf_size - z->avail_out, (FILE *)mat->fp);
-    } while ( z->avail_out == 0 );
+/** @brief Truncates a file at the current file position
+ *
+ * @ingroup mat_internal
+ * @param mat MAT file pointer
+ * @retval 0 on success
+ */
+static int
+TruncateFile(mat_t *mat)
+{
+    FILE *fp = (FILE *)mat->fp;
+    const mat_off_t pos = ftello(fp);
 
-    /* exit early if this is an empty data */
-    if ( NULL == data || N < 1 )
-        return byteswritten;
+    if ( pos == -1L || 0 != fflush(fp) )
+        return MATIO_E_GENERIC_WRITE_ERROR;
+#if defined(_WIN32)
+    if ( 0 != _chsize_s(_fileno(fp), (__int64)pos) )
+#else
+    if ( 0 != ftruncate(fileno(fp), (off_t)pos) )
+#endif
+        return MATIO_E_GENERIC_WRITE_ERROR;
 
-    z->next_in = (Bytef *)data;
-    z->avail_in = N * data_size;
-    do {
-        z->next_out = buf;
-        z->avail_out = buf_size;
-        deflate(z, Z_NO_FLUSH);
-        byteswritten += fwrite(buf, 1, buf_size - z->avail_out, (FILE *)mat->fp);
-    } while ( z->avail_out == 0 );
-    /* Add/Compress padding to pad to 8-byte boundary */
-    if ( N * data_size % 8 ) {
-        z->next_in = pad;
-        z->avail_in = 8 - (N * data_size % 8);
-        do {
-            z->next_out = buf;
-            z->avail_out = buf_size;
-            deflate(z, Z_NO_FLUSH);
-            byteswritten += fwrite(buf, 1, buf_size - z->avail_out, (FILE *)mat->fp);
-        } while ( z->avail_out == 0 );
-    }
-    nBytes = byteswritten;
-    return nBytes;
+    return MATIO_E_NO_ERROR;
 }
 #endif
 
@@ -7812,7 +9790,7 @@ ReadNextCell(mat_t *mat, matvar_t *matvar)
                 if ( cells[i]->internal->z != NULL ) {
                     err = inflateCopy(cells[i]->internal->z, matvar->internal->z);
                     if ( err == Z_OK ) {
-                        cells[i]->internal->datapos = ftello((FILE *)mat->fp);
+                        cells[i]->internal->datapos = Mat_ftello(mat);
                         if ( cells[i]->internal->datapos != -1L ) {
                             cells[i]->internal->datapos -= matvar->internal->z->avail_in;
                             if ( cells[i]->class_type == MAT_C_STRUCT )
@@ -7826,7 +9804,7 @@ ReadNextCell(mat_t *mat, matvar_t *matvar)
                                 cells[i]->internal->data = cells[i]->data;
                                 cells[i]->data = NULL;
                             }
-                            (void)fseeko((FILE *)mat->fp, cells[i]->internal->datapos, SEEK_SET);
+                            (void)Mat_fseeko(mat, cells[i]->internal->datapos, SEEK_SET);
                         } else {
                             Mat_Critical("Couldn't determine file position");
                         }
@@ -7867,7 +9845,7 @@ ReadNextCell(mat_t *mat, matvar_t *matvar)
             }
 
             /* Read variable tag for cell */
-            err = Read(buf, 4, 2, (FILE *)mat->fp, &nbytes);
+            err = Read(buf, 4, 2, mat, &nbytes);
 
             /* Empty cells at the end of a file may cause an EOF */
             if ( 0 == err && 0 == nbytes )
@@ -7893,7 +9871,7 @@ ReadNextCell(mat_t *mat, matvar_t *matvar)
                 cells[i] = NULL;
 #if HAVE_LONG_LONG_INT
                 Mat_Critical("cells[%zu] not MAT_T_MATRIX, fpos = %lld", i,
-                             (long long)ftello((FILE *)mat->fp));
+                             (long long)Mat_ftello(mat));
 #else
                 Mat_Critical("cells[%zu] not MAT_T_MATRIX", i);
 #endif
@@ -7901,7 +9879,7 @@ ReadNextCell(mat_t *mat, matvar_t *matvar)
             }
 
             /* Read array flags and the dimensions tag */
-            err = Read(buf, 4, 6, (FILE *)mat->fp, &bytesread);
+            err = Read(buf, 4, 6, mat, &bytesread);
             if ( err ) {
                 Mat_VarFree(cells[i]);
                 cells[i] = NULL;
@@ -7939,7 +9917,7 @@ ReadNextCell(mat_t *mat, matvar_t *matvar)
                 break;
             }
             /* Variable name tag */
-            if ( 0 != Read(buf, 1, 8, (FILE *)mat->fp, &bytesread) ) {
+            if ( 0 != Read(buf, 1, 8, mat, &bytesread) ) {
                 Mat_VarFree(cells[i]);
                 cells[i] = NULL;
                 break;
@@ -7963,16 +9941,16 @@ ReadNextCell(mat_t *mat, matvar_t *matvar)
                         }
                     }
                     nBytes -= name_len;
-                    (void)fseeko((FILE *)mat->fp, name_len, SEEK_CUR);
+                    (void)Mat_fseeko(mat, name_len, SEEK_CUR);
                 }
             }
-            cells[i]->internal->datapos = ftello((FILE *)mat->fp);
+            cells[i]->internal->datapos = Mat_ftello(mat);
             if ( cells[i]->internal->datapos != -1L ) {
                 if ( cells[i]->class_type == MAT_C_STRUCT )
                     bytesread += ReadNextStructField(mat, cells[i]);
                 if ( cells[i]->class_type == MAT_C_CELL )
                     bytesread += ReadNextCell(mat, cells[i]);
-                (void)fseeko((FILE *)mat->fp, cells[i]->internal->datapos + nBytes, SEEK_SET);
+                (void)Mat_fseeko(mat, cells[i]->internal->datapos + nBytes, SEEK_SET);
             } else {
                 Mat_Critical("Couldn't determine file position");
             }
@@ -8243,7 +10221,7 @@ ReadNextStructField(mat_t *mat, matvar_t *matvar)
                 if ( fields[i]->internal->z != NULL ) {
                     err = inflateCopy(fields[i]->internal->z, matvar->internal->z);
                     if ( err == Z_OK ) {
-                        fields[i]->internal->datapos = ftello((FILE *)mat->fp);
+                        fields[i]->internal->datapos = Mat_ftello(mat);
                         if ( fields[i]->internal->datapos != -1L ) {
                             fields[i]->internal->datapos -= matvar->internal->z->avail_in;
                             if ( fields[i]->class_type == MAT_C_STRUCT )
@@ -8257,7 +10235,7 @@ ReadNextStructField(mat_t *mat, matvar_t *matvar)
                                 fields[i]->internal->data = fields[i]->data;
                                 fields[i]->data = NULL;
                             }
-                            (void)fseeko((FILE *)mat->fp, fields[i]->internal->datapos, SEEK_SET);
+                            (void)Mat_fseeko(mat, fields[i]->internal->datapos, SEEK_SET);
                         } else {
                             Mat_Critical("Couldn't determine file position");
                         }
@@ -8287,7 +10265,7 @@ ReadNextStructField(mat_t *mat, matvar_t *matvar)
         mat_uint32_t buf[6] = {0, 0, 0, 0, 0, 0};
         mat_uint32_t array_flags, len, fieldname_size;
 
-        err = Read(buf, 4, 2, (FILE *)mat->fp, &bytesread);
+        err = Read(buf, 4, 2, mat, &bytesread);
         if ( err ) {
             return bytesread;
         }
@@ -8303,7 +10281,7 @@ ReadNextStructField(mat_t *mat, matvar_t *matvar)
         }
 
         /* Field name tag */
-        err = Read(buf, 4, 2, (FILE *)mat->fp, &bytesread);
+        err = Read(buf, 4, 2, mat, &bytesread);
         if ( err ) {
             return bytesread;
         }
@@ -8319,7 +10297,7 @@ ReadNextStructField(mat_t *mat, matvar_t *matvar)
             if ( nfields ) {
                 char *ptr = (char *)malloc(nfields * fieldname_size);
                 if ( NULL != ptr ) {
-                    err = Read(ptr, 1, nfields * fieldname_size, (FILE *)mat->fp, &bytesread);
+                    err = Read(ptr, 1, nfields * fieldname_size, mat, &bytesread);
                     if ( 0 == err ) {
                         SetFieldNames(matvar, ptr, nfields, fieldname_size);
                     } else {
@@ -8329,7 +10307,7 @@ ReadNextStructField(mat_t *mat, matvar_t *matvar)
                     free(ptr);
                 }
                 if ( (nfields * fieldname_size) % 8 ) {
-                    (void)fseeko((FILE *)mat->fp, 8 - ((nfields * fieldname_size) % 8), SEEK_CUR);
+                    (void)Mat_fseeko(mat, 8 - ((nfields * fieldname_size) % 8), SEEK_CUR);
                     bytesread += 8 - ((nfields * fieldname_size) % 8);
                 }
             } else {
@@ -8384,7 +10362,7 @@ ReadNextStructField(mat_t *mat, matvar_t *matvar)
             }
 
             /* Read variable tag for struct field */
-            err = Read(buf, 4, 2, (FILE *)mat->fp, &bytesread);
+            err = Read(buf, 4, 2, mat, &bytesread);
             if ( err ) {
                 Mat_VarFree(fields[i]);
                 fields[i] = NULL;
@@ -8400,7 +10378,7 @@ ReadNextStructField(mat_t *mat, matvar_t *matvar)
                 fields[i] = NULL;
 #if HAVE_LONG_LONG_INT
                 Mat_Critical("fields[%zu] not MAT_T_MATRIX, fpos = %lld", i,
-                             (long long)ftello((FILE *)mat->fp));
+                             (long long)Mat_ftello(mat));
 #else
                 Mat_Critical("fields[%zu] not MAT_T_MATRIX", i);
 #endif
@@ -8413,7 +10391,7 @@ ReadNextStructField(mat_t *mat, matvar_t *matvar)
             }
 
             /* Read array flags and the dimensions tag */
-            err = Read(buf, 4, 6, (FILE *)mat->fp, &bytesread);
+            err = Read(buf, 4, 6, mat, &bytesread);
             if ( err ) {
                 Mat_VarFree(fields[i]);
                 fields[i] = NULL;
@@ -8453,20 +10431,20 @@ ReadNextStructField(mat_t *mat, matvar_t *matvar)
                 }
             }
             /* Variable name tag */
-            err = Read(buf, 1, 8, (FILE *)mat->fp, &bytesread);
+            err = Read(buf, 1, 8, mat, &bytesread);
             if ( err ) {
                 Mat_VarFree(fields[i]);
                 fields[i] = NULL;
                 break;
             }
             nBytes -= 8;
-            fields[i]->internal->datapos = ftello((FILE *)mat->fp);
+            fields[i]->internal->datapos = Mat_ftello(mat);
             if ( fields[i]->internal->datapos != -1L ) {
                 if ( fields[i]->class_type == MAT_C_STRUCT )
                     bytesread += ReadNextStructField(mat, fields[i]);
                 else if ( fields[i]->class_type == MAT_C_CELL )
                     bytesread += ReadNextCell(mat, fields[i]);
-                (void)fseeko((FILE *)mat->fp, fields[i]->internal->datapos + nBytes, SEEK_SET);
+                (void)Mat_fseeko(mat, fields[i]->internal->datapos + nBytes, SEEK_SET);
             } else {
                 Mat_Critical("Couldn't determine file position");
             }
@@ -8512,7 +10490,7 @@ ReadNextFunctionHandle(mat_t *mat, matvar_t *matvar)
         size_t i;
         matvar_t **functions = (matvar_t **)matvar->data;
         for ( i = 0; i < nelems; i++ ) {
-            functions[i] = Mat_VarReadNextInfo(mat);
+            functions[i] = Mat_VarReadNextInfo5(mat);
             err = NULL == functions[i];
             if ( err )
                 break;
@@ -8559,7 +10537,7 @@ ReadRankDims(mat_t *mat, matvar_t *matvar, enum matio_types data_type, mat_uint3
             mat_uint32_t buf;
 
             for ( i = 0; i < matvar->rank; i++ ) {
-                err = Read(&buf, sizeof(mat_uint32_t), 1, (FILE *)mat->fp, read_bytes);
+                err = Read(&buf, sizeof(mat_uint32_t), 1, mat, read_bytes);
                 if ( MATIO_E_NO_ERROR == err ) {
                     if ( mat->byteswap ) {
                         matvar->dims[i] = Mat_uint32Swap(&buf);
@@ -8575,7 +10553,7 @@ ReadRankDims(mat_t *mat, matvar_t *matvar, enum matio_types data_type, mat_uint3
             }
 
             if ( matvar->rank % 2 != 0 ) {
-                err = Read(&buf, sizeof(mat_uint32_t), 1, (FILE *)mat->fp, read_bytes);
+                err = Read(&buf, sizeof(mat_uint32_t), 1, mat, read_bytes);
                 if ( err ) {
                     free(matvar->dims);
                     matvar->dims = NULL;
@@ -8788,7 +10766,7 @@ WriteCellArrayField(mat_t *mat, matvar_t *matvar)
         /* exit early if this is an empty data */
         return MATIO_E_NO_ERROR;
     }
-    start = ftello((FILE *)mat->fp);
+    start = Mat_ftello(mat);
 
     /* Array Flags */
     array_flags = matvar->class_type & CLASS_TYPE_MASK;
@@ -8843,12 +10821,12 @@ WriteCellArrayField(mat_t *mat, matvar_t *matvar)
     }
 
     WriteType(mat, matvar);
-    end = ftello((FILE *)mat->fp);
+    end = Mat_ftello(mat);
     if ( start != -1L && end != -1L ) {
         nBytes = (int)(end - start);
-        (void)fseeko((FILE *)mat->fp, (mat_off_t) - (nBytes + 4), SEEK_CUR);
+        (void)Mat_fseeko(mat, (mat_off_t) - (nBytes + 4), SEEK_CUR);
         fwrite(&nBytes, 4, 1, (FILE *)mat->fp);
-        (void)fseeko((FILE *)mat->fp, end, SEEK_SET);
+        (void)Mat_fseeko(mat, end, SEEK_SET);
     } else {
         Mat_Critical("Couldn't determine file position");
     }
@@ -8935,7 +10913,7 @@ WriteCompressedTypeArrayFlags(mat_t *mat, matvar_t *matvar, z_streamp z)
             fwrite(comp_buf, 1, buf_size * sizeof(*comp_buf) - z->avail_out, (FILE *)mat->fp);
     } while ( z->avail_out == 0 );
 
-    matvar->internal->datapos = ftello((FILE *)mat->fp);
+    matvar->internal->datapos = Mat_ftello(mat);
     if ( matvar->internal->datapos == -1L ) {
         Mat_Critical("Couldn't determine file position");
     }
@@ -9202,7 +11180,7 @@ WriteStructField(mat_t *mat, matvar_t *matvar)
         /* exit early if this is an empty data */
         return MATIO_E_NO_ERROR;
     }
-    start = ftello((FILE *)mat->fp);
+    start = Mat_ftello(mat);
 
     /* Array Flags */
     array_flags = matvar->class_type & CLASS_TYPE_MASK;
@@ -9238,12 +11216,12 @@ WriteStructField(mat_t *mat, matvar_t *matvar)
     fwrite(&pad4, 4, 1, (FILE *)mat->fp);
 
     WriteType(mat, matvar);
-    end = ftello((FILE *)mat->fp);
+    end = Mat_ftello(mat);
     if ( start != -1L && end != -1L ) {
         nBytes = (int)(end - start);
-        (void)fseeko((FILE *)mat->fp, (mat_off_t) - (nBytes + 4), SEEK_CUR);
+        (void)Mat_fseeko(mat, (mat_off_t) - (nBytes + 4), SEEK_CUR);
         fwrite(&nBytes, 4, 1, (FILE *)mat->fp);
-        (void)fseeko((FILE *)mat->fp, end, SEEK_SET);
+        (void)Mat_fseeko(mat, end, SEEK_SET);
     } else {
         Mat_Critical("Couldn't determine file position");
     }
@@ -9317,7 +11295,7 @@ Mat_WriteEmptyVariable5(mat_t *mat, const char *name, int rank, const size_t *di
 
     fwrite(&matrix_type, 4, 1, (FILE *)mat->fp);
     fwrite(&pad4, 4, 1, (FILE *)mat->fp);
-    start = ftello((FILE *)mat->fp);
+    start = Mat_ftello(mat);
 
     /* Array Flags */
     array_flags = MAT_C_DOUBLE;
@@ -9369,12 +11347,12 @@ Mat_WriteEmptyVariable5(mat_t *mat, const char *name, int rank, const size_t *di
         for ( i = nBytes % 8; i < 8; i++ )
             byteswritten += fwrite(&pad1, 1, 1, (FILE *)mat->fp);
 
-    end = ftello((FILE *)mat->fp);
+    end = Mat_ftello(mat);
     if ( start != -1L && end != -1L ) {
         nBytes = (int)(end - start);
-        (void)fseeko((FILE *)mat->fp, (mat_off_t) - (nBytes + 4), SEEK_CUR);
+        (void)Mat_fseeko(mat, (mat_off_t) - (nBytes + 4), SEEK_CUR);
         fwrite(&nBytes, 4, 1, (FILE *)mat->fp);
-        (void)fseeko((FILE *)mat->fp, end, SEEK_SET);
+        (void)Mat_fseeko(mat, end, SEEK_SET);
     } else {
         Mat_Critical("Couldn't determine file position");
     }
@@ -9547,7 +11525,7 @@ Mat_VarReadNumeric5(mat_t *mat, matvar_t *matvar, void *data, size_t N)
         }
 #endif
     } else {
-        err = Read(tag, 4, 1, (FILE *)mat->fp, NULL);
+        err = Read(tag, 4, 1, mat, NULL);
         if ( err ) {
             return err;
         }
@@ -9559,7 +11537,7 @@ Mat_VarReadNumeric5(mat_t *mat, matvar_t *matvar, void *data, size_t N)
             nBytes = (tag[0] & 0xffff0000) >> 16;
         } else {
             data_in_tag = 0;
-            err = Read(tag + 1, 4, 1, (FILE *)mat->fp, NULL);
+            err = Read(tag + 1, 4, 1, mat, NULL);
             if ( err ) {
                 return err;
             }
@@ -9620,7 +11598,7 @@ Mat_VarReadNumeric5(mat_t *mat, matvar_t *matvar, void *data, size_t N)
         if ( data_in_tag )
             nBytes += 4;
         if ( (nBytes % 8) != 0 )
-            (void)fseeko((FILE *)mat->fp, 8 - (nBytes % 8), SEEK_CUR);
+            (void)Mat_fseeko(mat, 8 - (nBytes % 8), SEEK_CUR);
 #if HAVE_ZLIB
     } else if ( matvar->compression == MAT_COMPRESSION_ZLIB ) {
         switch ( matvar->class_type ) {
@@ -9715,7 +11693,7 @@ Mat_VarRead5(mat_t *mat, matvar_t *matvar)
         return MATIO_E_NO_ERROR;
     }
 #endif
-    fpos = ftello((FILE *)mat->fp);
+    fpos = Mat_ftello(mat);
     if ( fpos == -1L ) {
         Mat_Critical("Couldn't determine file position");
         return MATIO_E_GENERIC_READ_ERROR;
@@ -9738,61 +11716,61 @@ Mat_VarRead5(mat_t *mat, matvar_t *matvar)
             matvar->dims = (size_t *)calloc(matvar->rank, sizeof(*(matvar->dims)));
             break;
         case MAT_C_DOUBLE:
-            (void)fseeko((FILE *)mat->fp, matvar->internal->datapos, SEEK_SET);
+            (void)Mat_fseeko(mat, matvar->internal->datapos, SEEK_SET);
             matvar->data_size = sizeof(double);
             matvar->data_type = MAT_T_DOUBLE;
             break;
         case MAT_C_SINGLE:
-            (void)fseeko((FILE *)mat->fp, matvar->internal->datapos, SEEK_SET);
+            (void)Mat_fseeko(mat, matvar->internal->datapos, SEEK_SET);
             matvar->data_size = sizeof(float);
             matvar->data_type = MAT_T_SINGLE;
             break;
         case MAT_C_INT64:
 #ifdef HAVE_MATIO_INT64_T
-            (void)fseeko((FILE *)mat->fp, matvar->internal->datapos, SEEK_SET);
+            (void)Mat_fseeko(mat, matvar->internal->datapos, SEEK_SET);
             matvar->data_size = sizeof(mat_int64_t);
             matvar->data_type = MAT_T_INT64;
 #endif
             break;
         case MAT_C_UINT64:
 #ifdef HAVE_MATIO_UINT64_T
-            (void)fseeko((FILE *)mat->fp, matvar->internal->datapos, SEEK_SET);
+            (void)Mat_fseeko(mat, matvar->internal->datapos, SEEK_SET);
             matvar->data_size = sizeof(mat_uint64_t);
             matvar->data_type = MAT_T_UINT64;
 #endif
             break;
         case MAT_C_INT32:
-            (void)fseeko((FILE *)mat->fp, matvar->internal->datapos, SEEK_SET);
+            (void)Mat_fseeko(mat, matvar->internal->datapos, SEEK_SET);
             matvar->data_size = sizeof(mat_int32_t);
             matvar->data_type = MAT_T_INT32;
             break;
         case MAT_C_UINT32:
-            (void)fseeko((FILE *)mat->fp, matvar->internal->datapos, SEEK_SET);
+            (void)Mat_fseeko(mat, matvar->internal->datapos, SEEK_SET);
             matvar->data_size = sizeof(mat_uint32_t);
             matvar->data_type = MAT_T_UINT32;
             break;
         case MAT_C_INT16:
-            (void)fseeko((FILE *)mat->fp, matvar->internal->datapos, SEEK_SET);
+            (void)Mat_fseeko(mat, matvar->internal->datapos, SEEK_SET);
             matvar->data_size = sizeof(mat_int16_t);
             matvar->data_type = MAT_T_INT16;
             break;
         case MAT_C_UINT16:
-            (void)fseeko((FILE *)mat->fp, matvar->internal->datapos, SEEK_SET);
+            (void)Mat_fseeko(mat, matvar->internal->datapos, SEEK_SET);
             matvar->data_size = sizeof(mat_uint16_t);
             matvar->data_type = MAT_T_UINT16;
             break;
         case MAT_C_INT8:
-            (void)fseeko((FILE *)mat->fp, matvar->internal->datapos, SEEK_SET);
+            (void)Mat_fseeko(mat, matvar->internal->datapos, SEEK_SET);
             matvar->data_size = sizeof(mat_int8_t);
             matvar->data_type = MAT_T_INT8;
             break;
         case MAT_C_UINT8:
-            (void)fseeko((FILE *)mat->fp, matvar->internal->datapos, SEEK_SET);
+            (void)Mat_fseeko(mat, matvar->internal->datapos, SEEK_SET);
             matvar->data_size = sizeof(mat_uint8_t);
             matvar->data_type = MAT_T_UINT8;
             break;
         case MAT_C_CHAR:
-            (void)fseeko((FILE *)mat->fp, matvar->internal->datapos, SEEK_SET);
+            (void)Mat_fseeko(mat, matvar->internal->datapos, SEEK_SET);
             if ( matvar->compression == MAT_COMPRESSION_ZLIB ) {
 #if HAVE_ZLIB
                 if ( matvar->internal->z == NULL ) {
@@ -9824,7 +11802,7 @@ Mat_VarRead5(mat_t *mat, matvar_t *matvar)
                 matvar->data_size = Mat_SizeOf(matvar->data_type);
                 matvar->nbytes = nBytes;
             } else {
-                err = Read(tag, 4, 1, (FILE *)mat->fp, &bytesread);
+                err = Read(tag, 4, 1, mat, &bytesread);
                 if ( err ) {
                     break;
                 }
@@ -9836,7 +11814,7 @@ Mat_VarRead5(mat_t *mat, matvar_t *matvar)
                     nBytes = (tag[0] & 0xffff0000) >> 16;
                 } else {
                     data_in_tag = 0;
-                    err = Read(tag + 1, 4, 1, (FILE *)mat->fp, &bytesread);
+                    err = Read(tag + 1, 4, 1, mat, &bytesread);
                     if ( err ) {
                         break;
                     }
@@ -9882,7 +11860,7 @@ Mat_VarRead5(mat_t *mat, matvar_t *matvar)
                 if ( data_in_tag )
                     nBytes += 4;
                 if ( (nBytes % 8) != 0 )
-                    (void)fseeko((FILE *)mat->fp, 8 - (nBytes % 8), SEEK_CUR);
+                    (void)Mat_fseeko(mat, 8 - (nBytes % 8), SEEK_CUR);
 #if HAVE_ZLIB
             } else if ( matvar->compression == MAT_COMPRESSION_ZLIB ) {
                 nBytes = ReadCompressedCharData(mat, matvar->internal->z, matvar->data,
@@ -9950,7 +11928,7 @@ Mat_VarRead5(mat_t *mat, matvar_t *matvar)
             }
             sparse = (mat_sparse_t *)matvar->data;
             sparse->nzmax = matvar->nbytes;
-            (void)fseeko((FILE *)mat->fp, matvar->internal->datapos, SEEK_SET);
+            (void)Mat_fseeko(mat, matvar->internal->datapos, SEEK_SET);
             /*  Read ir    */
             bytesread += ReadSparse(mat, matvar, &sparse->nir, &sparse->ir);
             /*  Read jc    */
@@ -9975,7 +11953,7 @@ Mat_VarRead5(mat_t *mat, matvar_t *matvar)
                 }
 #endif
             } else {
-                err = Read(tag, 4, 1, (FILE *)mat->fp, &bytesread);
+                err = Read(tag, 4, 1, mat, &bytesread);
                 if ( err ) {
                     break;
                 }
@@ -9987,7 +11965,7 @@ Mat_VarRead5(mat_t *mat, matvar_t *matvar)
                     N = (tag[0] & 0xffff0000) >> 16;
                 } else {
                     data_in_tag = 0;
-                    err = Read(&N, 4, 1, (FILE *)mat->fp, &bytesread);
+                    err = Read(&N, 4, 1, mat, &bytesread);
                     if ( err ) {
                         break;
                     }
@@ -10084,10 +12062,10 @@ Mat_VarRead5(mat_t *mat, matvar_t *matvar)
                     if ( data_in_tag )
                         nBytes += 4;
                     if ( (nBytes % 8) != 0 )
-                        (void)fseeko((FILE *)mat->fp, 8 - (nBytes % 8), SEEK_CUR);
+                        (void)Mat_fseeko(mat, 8 - (nBytes % 8), SEEK_CUR);
 
                     /* Complex Data Tag */
-                    err = Read(tag, 4, 1, (FILE *)mat->fp, &bytesread);
+                    err = Read(tag, 4, 1, mat, &bytesread);
                     if ( err ) {
                         ComplexFree(complex_data);
                         break;
@@ -10099,7 +12077,7 @@ Mat_VarRead5(mat_t *mat, matvar_t *matvar)
                         data_in_tag = 1;
                     } else {
                         data_in_tag = 0;
-                        err = Read(tag + 1, 4, 1, (FILE *)mat->fp, &bytesread);
+                        err = Read(tag + 1, 4, 1, mat, &bytesread);
                         if ( err ) {
                             ComplexFree(complex_data);
                             break;
@@ -10165,7 +12143,7 @@ Mat_VarRead5(mat_t *mat, matvar_t *matvar)
                     if ( data_in_tag )
                         nBytes += 4;
                     if ( (nBytes % 8) != 0 )
-                        (void)fseeko((FILE *)mat->fp, 8 - (nBytes % 8), SEEK_CUR);
+                        (void)Mat_fseeko(mat, 8 - (nBytes % 8), SEEK_CUR);
 #if HAVE_ZLIB
                 } else if ( matvar->compression == MAT_COMPRESSION_ZLIB ) {
 #if defined(EXTENDED_SPARSE)
@@ -10404,7 +12382,7 @@ Mat_VarRead5(mat_t *mat, matvar_t *matvar)
                     if ( data_in_tag )
                         nBytes += 4;
                     if ( (nBytes % 8) != 0 )
-                        (void)fseeko((FILE *)mat->fp, 8 - (nBytes % 8), SEEK_CUR);
+                        (void)Mat_fseeko(mat, 8 - (nBytes % 8), SEEK_CUR);
 #if HAVE_ZLIB
                 } else if ( matvar->compression == MAT_COMPRESSION_ZLIB && nbytes > 0 ) {
 #if defined(EXTENDED_SPARSE)
@@ -10579,7 +12557,7 @@ Mat_VarRead5(mat_t *mat, matvar_t *matvar)
         default:
             break;
     }
-    (void)fseeko((FILE *)mat->fp, fpos, SEEK_SET);
+    (void)Mat_fseeko(mat, fpos, SEEK_SET);
 
     return err;
 }
@@ -11110,9 +13088,9 @@ Mat_VarReadData5(mat_t *mat, matvar_t *matvar, void *data, const int *start, con
     z_stream z;
 #endif
 
-    (void)fseeko((FILE *)mat->fp, matvar->internal->datapos, SEEK_SET);
+    (void)Mat_fseeko(mat, matvar->internal->datapos, SEEK_SET);
     if ( matvar->compression == MAT_COMPRESSION_NONE ) {
-        err = Read(tag, 4, 2, (FILE *)mat->fp, NULL);
+        err = Read(tag, 4, 2, mat, NULL);
         if ( err ) {
             return err;
         }
@@ -11122,7 +13100,7 @@ Mat_VarReadData5(mat_t *mat, matvar_t *matvar, void *data, const int *start, con
         }
         matvar->data_type = TYPE_FROM_TAG(tag[0]);
         if ( tag[0] & 0xffff0000 ) { /* Data is packed in the tag */
-            (void)fseeko((FILE *)mat->fp, -4, SEEK_CUR);
+            (void)Mat_fseeko(mat, -4, SEEK_CUR);
             real_bytes = 4 + (tag[0] >> 16);
         } else {
             real_bytes = 8 + tag[1];
@@ -11155,6 +13133,7 @@ Mat_VarReadData5(mat_t *mat, matvar_t *matvar, void *data, const int *start, con
             Mat_Critical("inflateCopy returned error %s", zError(err));
             return MATIO_E_FILE_FORMAT_VIOLATION;
         }
+        mat->inflate_cur = Mat_GetInflateIndex(mat, matvar->internal->datapos);
         z.avail_in = 0;
         err = Inflate(mat, &z, tag, 4, NULL);
         if ( err ) {
@@ -11192,8 +13171,8 @@ Mat_VarReadData5(mat_t *mat, matvar_t *matvar, void *data, const int *start, con
 
                 ReadDataSlab2(mat, complex_data->Re, matvar->class_type, matvar->data_type,
                               matvar->dims, start, stride, edge);
-                (void)fseeko((FILE *)mat->fp, matvar->internal->datapos + real_bytes, SEEK_SET);
-                err = Read(tag, 4, 2, (FILE *)mat->fp, NULL);
+                (void)Mat_fseeko(mat, matvar->internal->datapos + real_bytes, SEEK_SET);
+                err = Read(tag, 4, 2, mat, NULL);
                 if ( err ) {
                     return err;
                 }
@@ -11203,7 +13182,7 @@ Mat_VarReadData5(mat_t *mat, matvar_t *matvar, void *data, const int *start, con
                 }
                 matvar->data_type = TYPE_FROM_TAG(tag[0]);
                 if ( tag[0] & 0xffff0000 ) { /* Data is packed in the tag */
-                    (void)fseeko((FILE *)mat->fp, -4, SEEK_CUR);
+                    (void)Mat_fseeko(mat, -4, SEEK_CUR);
                 }
                 ReadDataSlab2(mat, complex_data->Im, matvar->class_type, matvar->data_type,
                               matvar->dims, start, stride, edge);
@@ -11220,7 +13199,7 @@ Mat_VarReadData5(mat_t *mat, matvar_t *matvar, void *data, const int *start, con
                 ReadCompressedDataSlab2(mat, &z, complex_data->Re, matvar->class_type,
                                         matvar->data_type, matvar->dims, start, stride, edge);
 
-                (void)fseeko((FILE *)mat->fp, matvar->internal->datapos, SEEK_SET);
+                (void)Mat_fseeko(mat, matvar->internal->datapos, SEEK_SET);
 
                 /* Reset zlib knowledge to before reading real tag */
                 inflateEnd(&z);
@@ -11229,7 +13208,7 @@ Mat_VarReadData5(mat_t *mat, matvar_t *matvar, void *data, const int *start, con
                     Mat_Critical("inflateCopy returned error %s", zError(err));
                     return MATIO_E_FILE_FORMAT_VIOLATION;
                 }
-                InflateSkip(mat, &z, real_bytes, NULL);
+                InflateSkipIndexed(mat, &z, real_bytes);
                 z.avail_in = 0;
                 err = Inflate(mat, &z, tag, 4, NULL);
                 if ( err ) {
@@ -11259,8 +13238,8 @@ Mat_VarReadData5(mat_t *mat, matvar_t *matvar, void *data, const int *start, con
                 ReadDataSlabN(mat, complex_data->Re, matvar->class_type, matvar->data_type,
                               matvar->rank, matvar->dims, start, stride, edge);
 
-                (void)fseeko((FILE *)mat->fp, matvar->internal->datapos + real_bytes, SEEK_SET);
-                err = Read(tag, 4, 2, (FILE *)mat->fp, NULL);
+                (void)Mat_fseeko(mat, matvar->internal->datapos + real_bytes, SEEK_SET);
+                err = Read(tag, 4, 2, mat, NULL);
                 if ( err ) {
                     return err;
                 }
@@ -11270,7 +13249,7 @@ Mat_VarReadData5(mat_t *mat, matvar_t *matvar, void *data, const int *start, con
                 }
                 matvar->data_type = TYPE_FROM_TAG(tag[0]);
                 if ( tag[0] & 0xffff0000 ) { /* Data is packed in the tag */
-                    (void)fseeko((FILE *)mat->fp, -4, SEEK_CUR);
+                    (void)Mat_fseeko(mat, -4, SEEK_CUR);
                 }
                 ReadDataSlabN(mat, complex_data->Im, matvar->class_type, matvar->data_type,
                               matvar->rank, matvar->dims, start, stride, edge);
@@ -11288,7 +13267,7 @@ Mat_VarReadData5(mat_t *mat, matvar_t *matvar, void *data, const int *start, con
                                         matvar->data_type, matvar->rank, matvar->dims, start,
                                         stride, edge);
 
-                (void)fseeko((FILE *)mat->fp, matvar->internal->datapos, SEEK_SET);
+                (void)Mat_fseeko(mat, matvar->internal->datapos, SEEK_SET);
                 /* Reset zlib knowledge to before reading real tag */
                 inflateEnd(&z);
                 err = inflateCopy(&z, matvar->internal->z);
@@ -11296,7 +13275,7 @@ Mat_VarReadData5(mat_t *mat, matvar_t *matvar, void *data, const int *start, con
                     Mat_Critical("inflateCopy returned error %s", zError(err));
                     return MATIO_E_FILE_FORMAT_VIOLATION;
                 }
-                InflateSkip(mat, &z, real_bytes, NULL);
+                InflateSkipIndexed(mat, &z, real_bytes);
                 z.avail_in = 0;
                 err = Inflate(mat, &z, tag, 4, NULL);
                 if ( err ) {
@@ -11320,6 +13299,9 @@ Mat_VarReadData5(mat_t *mat, matvar_t *matvar, void *data, const int *start, con
         }
 #endif
     }
+#if HAVE_ZLIB
+    mat->inflate_cur = NULL;
+#endif
     if ( err == MATIO_E_NO_ERROR ) {
         matvar->data_type = ClassType2DataType(matvar->class_type);
         matvar->data_size = Mat_SizeOfClass(matvar->class_type);
@@ -11327,6 +13309,63 @@ Mat_VarReadData5(mat_t *mat, matvar_t *matvar, void *data, const int *start, con
     return err;
 }
 
+/** @brief Applies the compression policy of a MAT file to a variable
+ *
+ * Variables with numeric or character data are written uncompressed if the
+ * compression level is 0, their data is smaller than the minimum size or a
+ * sample of their data does not compress.
+ * @ingroup mat_internal
+ * @param mat MAT file pointer
+ * @param matvar MAT variable
+ * @param compress Requested compression
+ * @return Compression to write the variable with
+ */
+static int
+Mat_VarCompression5(const mat_t *mat, const matvar_t *matvar, int compress)
+{
+#if HAVE_ZLIB
+    size_t nelems = 1, nBytes;
+
+    if ( MAT_COMPRESSION_ZLIB != compress )
+        return compress;
+    switch ( matvar->class_type ) {
+        case MAT_C_DOUBLE:
+        case MAT_C_SINGLE:
+        case MAT_C_INT64:
+        case MAT_C_UINT64:
+        case MAT_C_INT32:
+        case MAT_C_UINT32:
+        case MAT_C_INT16:
+        case MAT_C_UINT16:
+        case MAT_C_INT8:
+        case MAT_C_UINT8:
+        case MAT_C_CHAR:
+            break;
+        default:
+            return compress;
+    }
+    if ( 0 == mat->deflate.level )
+        return MAT_COMPRESSION_NONE;
+    if ( NULL == matvar->data || Mat_MulDims(matvar, &nelems) ||
+         Mul(&nBytes, nelems, Mat_SizeOf(matvar->data_type)) )
+        return compress;
+    if ( nBytes < mat->deflate.min_size &&
+         (!matvar->isComplex || nBytes < mat->deflate.min_size - nBytes) )
+        return MAT_COMPRESSION_NONE;
+    if ( mat->deflate.sample && nBytes > DEFLATE_SAMPLE_SIZE ) {
+        const mat_uint8_t *data = (const mat_uint8_t *)matvar->data;
+        if ( matvar->isComplex )
+            data = (const mat_uint8_t *)((const mat_complex_split_t *)matvar->data)->Re;
+        if ( !DeflateSample(mat, data, nBytes) )
+            return MAT_COMPRESSION_NONE;
+    }
+#else
+    (void)mat;
+    (void)matvar;
+#endif
+    return compress;
+}
+
 /** @brief Reads a subset of a MAT variable using a 1-D indexing
  *
  * Reads data from a MAT variable using a linear (1-D) indexing mode. The
@@ -11352,9 +13391,9 @@ Mat_VarReadDataLinear5(mat_t *mat, matvar_t *matvar, void *data, int start, int
 
     if ( mat->version == MAT_FT_MAT4 )
         return -1;
-    (void)fseeko((FILE *)mat->fp, matvar->internal->datapos, SEEK_SET);
+    (void)Mat_fseeko(mat, matvar->internal->datapos, SEEK_SET);
     if ( matvar->compression == MAT_COMPRESSION_NONE ) {
-        err = Read(tag, 4, 2, (FILE *)mat->fp, NULL);
+        err = Read(tag, 4, 2, mat, NULL);
         if ( err ) {
             return err;
         }
@@ -11364,7 +13403,7 @@ Mat_VarReadDataLinear5(mat_t *mat, matvar_t *matvar, void *data, int start, int
         }
         matvar->data_type = (enum matio_types)(tag[0] & 0x000000ff);
         if ( tag[0] & 0xffff0000 ) { /* Data is packed in the tag */
-            (void)fseeko((FILE *)mat->fp, -4, SEEK_CUR);
+            (void)Mat_fseeko(mat, -4, SEEK_CUR);
             real_bytes = 4 + (tag[0] >> 16);
         } else {
             real_bytes = 8 + tag[1];
@@ -11396,6 +13435,7 @@ Mat_VarReadDataLinear5(mat_t *mat, matvar_t *matvar, void *data, int start, int
             Mat_Critical("inflateCopy returned error %s", zError(err));
             return MATIO_E_FILE_FORMAT_VIOLATION;
         }
+        mat->inflate_cur = Mat_GetInflateIndex(mat, matvar->internal->datapos);
         err = Inflate(mat, &z, tag, 4, NULL);
         if ( err ) {
             return err;
@@ -11436,8 +13476,8 @@ Mat_VarReadDataLinear5(mat_t *mat, matvar_t *matvar, void *data, int start, int
 
             ReadDataSlab1(mat, complex_data->Re, matvar->class_type, matvar->data_type, start,
                           stride, edge);
-            (void)fseeko((FILE *)mat->fp, matvar->internal->datapos + real_bytes, SEEK_SET);
-            err = Read(tag, 4, 2, (FILE *)mat->fp, NULL);
+            (void)Mat_fseeko(mat, matvar->internal->datapos + real_bytes, SEEK_SET);
+            err = Read(tag, 4, 2, mat, NULL);
             if ( err ) {
                 return err;
             }
@@ -11447,7 +13487,7 @@ Mat_VarReadDataLinear5(mat_t *mat, matvar_t *matvar, void *data, int start, int
             }
             matvar->data_type = (enum matio_types)(tag[0] & 0x000000ff);
             if ( tag[0] & 0xffff0000 ) { /* Data is packed in the tag */
-                (void)fseeko((FILE *)mat->fp, -4, SEEK_CUR);
+                (void)Mat_fseeko(mat, -4, SEEK_CUR);
             }
             ReadDataSlab1(mat, complex_data->Im, matvar->class_type, matvar->data_type, start,
                           stride, edge);
@@ -11462,7 +13502,7 @@ Mat_VarReadDataLinear5(mat_t *mat, matvar_t *matvar, void *data, int start, int
             ReadCompressedDataSlab1(mat, &z, complex_data->Re, matvar->class_type,
                                     matvar->data_type, start, stride, edge);
 
-            (void)fseeko((FILE *)mat->fp, matvar->internal->datapos, SEEK_SET);
+            (void)Mat_fseeko(mat, matvar->internal->datapos, SEEK_SET);
 
             /* Reset zlib knowledge to before reading real tag */
             inflateEnd(&z);
@@ -11471,7 +13511,7 @@ Mat_VarReadDataLinear5(mat_t *mat, matvar_t *matvar, void *data, int start, int
                 Mat_Critical("inflateCopy returned error %s", zError(err));
                 return MATIO_E_FILE_FORMAT_VIOLATION;
             }
-            InflateSkip(mat, &z, real_bytes, NULL);
+            InflateSkipIndexed(mat, &z, real_bytes);
             z.avail_in = 0;
             err = Inflate(mat, &z, tag, 4, NULL);
             if ( err ) {
@@ -11493,6 +13533,9 @@ Mat_VarReadDataLinear5(mat_t *mat, matvar_t *matvar, void *data, int start, int
         inflateEnd(&z);
 #endif
     }
+#if HAVE_ZLIB
+    mat->inflate_cur = NULL;
+#endif
 
     matvar->data_type = ClassType2DataType(matvar->class_type);
     matvar->data_size = Mat_SizeOfClass(matvar->class_type);
@@ -11527,7 +13570,7 @@ Mat_VarWrite5(mat_t *mat, matvar_t *matvar, int compress)
         return MATIO_E_OUTPUT_BAD_DATA;
 
     /* FIXME: SEEK_END is not Guaranteed by the C standard */
-    (void)fseeko((FILE *)mat->fp, 0, SEEK_END); /* Always write at end of file */
+    (void)Mat_fseeko(mat, 0, SEEK_END); /* Always write at end of file */
 
 #if HAVE_ZLIB
     if ( compress == MAT_COMPRESSION_NONE ) {
@@ -11537,7 +13580,7 @@ Mat_VarWrite5(mat_t *mat, matvar_t *matvar, int compress)
         int i;
         fwrite(&matrix_type, 4, 1, (FILE *)mat->fp);
         fwrite(&pad4, 4, 1, (FILE *)mat->fp);
-        start = ftello((FILE *)mat->fp);
+        start = Mat_ftello(mat);
 
         /* Array Flags */
         array_flags = matvar->class_type & CLASS_TYPE_MASK;
@@ -11589,7 +13632,7 @@ Mat_VarWrite5(mat_t *mat, matvar_t *matvar, int compress)
         }
 
         if ( NULL != matvar->internal ) {
-            matvar->internal->datapos = ftello((FILE *)mat->fp);
+            matvar->internal->datapos = Mat_ftello(mat);
             if ( matvar->internal->datapos == -1L ) {
                 Mat_Critical("Couldn't determine file position");
                 return MATIO_E_GENERIC_READ_ERROR;
@@ -11610,7 +13653,7 @@ Mat_VarWrite5(mat_t *mat, matvar_t *matvar, int compress)
         z = (z_streamp)calloc(1, sizeof(*z));
         if ( z == NULL )
             return MATIO_E_OUT_OF_MEMORY;
-        err = deflateInit(z, Z_DEFAULT_COMPRESSION);
+        err = deflateInit2(z, mat->deflate.level, Z_DEFLATED, MAX_WBITS, 8, mat->deflate.strategy);
         if ( err != Z_OK ) {
             free(z);
             Mat_Critical("deflateInit returned %s", zError(err));
@@ -11620,7 +13663,7 @@ Mat_VarWrite5(mat_t *mat, matvar_t *matvar, int compress)
         matrix_type = MAT_T_COMPRESSED;
         fwrite(&matrix_type, 4, 1, (FILE *)mat->fp);
         fwrite(&pad4, 4, 1, (FILE *)mat->fp);
-        start = ftello((FILE *)mat->fp);
+        start = Mat_ftello(mat);
 
         /* Array Flags */
         array_flags = matvar->class_type & CLASS_TYPE_MASK;
@@ -11718,7 +13761,7 @@ Mat_VarWrite5(mat_t *mat, matvar_t *matvar, int compress)
             } while ( z->avail_out == 0 );
         }
         if ( NULL != matvar->internal ) {
-            matvar->internal->datapos = ftello((FILE *)mat->fp);
+            matvar->internal->datapos = Mat_ftello(mat);
             if ( matvar->internal->datapos == -1L ) {
                 free(z);
                 Mat_Critical("Couldn't determine file position");
@@ -11728,25 +13771,40 @@ Mat_VarWrite5(mat_t *mat, matvar_t *matvar, int compress)
             /* Must be empty */
             matvar->class_type = MAT_C_EMPTY;
         }
-        WriteCompressedType(mat, matvar, z);
-        z->next_in = NULL;
-        z->avail_in = 0;
-        do {
-            z->next_out = ZLIB_BYTE_PTR(comp_buf);
-            z->avail_out = buf_size * sizeof(*comp_buf);
-            err = deflate(z, Z_FINISH);
-            fwrite(comp_buf, 1, buf_size * sizeof(*comp_buf) - z->avail_out, (FILE *)mat->fp);
-        } while ( err != Z_STREAM_END && z->avail_out == 0 );
+#if defined(PARALLEL_DEFLATE)
+        err = WriteCompressedTypeParallel(mat, matvar, z);
+        if ( MATIO_E_NO_ERROR != err && MATIO_E_OPERATION_NOT_SUPPORTED != err ) {
+            (void)deflateEnd(z);
+            free(z);
+            /* Remove the partially written variable including its tag */
+            if ( start != -1L && 0 == Mat_fseeko(mat, start - 8, SEEK_SET) )
+                (void)TruncateFile(mat);
+            return err;
+        }
+        if ( MATIO_E_OPERATION_NOT_SUPPORTED == err )
+#endif
+        {
+            WriteCompressedType(mat, matvar, z);
+            z->next_in = NULL;
+            z->avail_in = 0;
+            do {
+                z->next_out = ZLIB_BYTE_PTR(comp_buf);
+                z->avail_out = buf_size * sizeof(*comp_buf);
+                err = deflate(z, Z_FINISH);
+                fwrite(comp_buf, 1, buf_size * sizeof(*comp_buf) - z->avail_out,
+                       (FILE *)mat->fp);
+            } while ( err != Z_STREAM_END && z->avail_out == 0 );
+        }
         (void)deflateEnd(z);
         free(z);
 #endif
     }
-    end = ftello((FILE *)mat->fp);
+    end = Mat_ftello(mat);
     if ( start != -1L && end != -1L ) {
         const mat_uint32_t _nBytes = (mat_uint32_t)(end - start);
-        (void)fseeko((FILE *)mat->fp, start - 4, SEEK_SET);
+        (void)Mat_fseeko(mat, start - 4, SEEK_SET);
         fwrite(&_nBytes, 4, 1, (FILE *)mat->fp);
-        (void)fseeko((FILE *)mat->fp, end, SEEK_SET);
+        (void)Mat_fseeko(mat, end, SEEK_SET);
     } else {
         Mat_Critical("Couldn't determine file position");
     }
@@ -11773,7 +13831,7 @@ Mat_VarReadNextInfo5(mat_t *mat)
     if ( mat == NULL || mat->fp == NULL )
         return NULL;
 
-    if ( IsEndOfFile((FILE *)mat->fp, &fpos) )
+    if ( IsEndOfFile(mat, &fpos) )
         return NULL;
 
     if ( fpos == -1L )
@@ -11781,11 +13839,11 @@ Mat_VarReadNextInfo5(mat_t *mat)
 
     {
         size_t nbytes = 0;
-        err = Read(&data_type, sizeof(mat_uint32_t), 1, (FILE *)mat->fp, &nbytes);
+        err = Read(&data_type, sizeof(mat_uint32_t), 1, mat, &nbytes);
         if ( err || 0 == nbytes )
             return NULL;
     }
-    err = Read(&nBytes, sizeof(mat_uint32_t), 1, (FILE *)mat->fp, NULL);
+    err = Read(&nBytes, sizeof(mat_uint32_t), 1, mat, NULL);
     if ( err )
         return NULL;
     if ( mat->byteswap ) {
@@ -11829,7 +13887,7 @@ Mat_VarReadNextInfo5(mat_t *mat)
                 (void)Mat_uint32Swap(uncomp_buf + 1);
             }
             if ( uncomp_buf[0] != MAT_T_MATRIX ) {
-                (void)fseeko((FILE *)mat->fp, (mat_off_t)(nBytes - bytesread), SEEK_CUR);
+                (void)Mat_fseeko(mat, (mat_off_t)(nBytes - bytesread), SEEK_CUR);
                 Mat_VarFree(matvar);
                 matvar = NULL;
                 Mat_Critical("Uncompressed type not MAT_T_MATRIX");
@@ -11898,7 +13956,7 @@ Mat_VarReadNextInfo5(mat_t *mat)
                         if ( do_clean ) {
                             free(dims);
                         }
-                        (void)fseeko((FILE *)mat->fp, (mat_off_t)(nBytes - bytesread), SEEK_CUR);
+                        (void)Mat_fseeko(mat, (mat_off_t)(nBytes - bytesread), SEEK_CUR);
                         Mat_VarFree(matvar);
                         matvar = NULL;
                         Mat_Critical("Integer multiplication overflow");
@@ -11908,7 +13966,7 @@ Mat_VarReadNextInfo5(mat_t *mat)
                     if ( NULL == matvar->dims ) {
                         if ( do_clean )
                             free(dims);
-                        (void)fseeko((FILE *)mat->fp, (mat_off_t)(nBytes - bytesread), SEEK_CUR);
+                        (void)Mat_fseeko(mat, (mat_off_t)(nBytes - bytesread), SEEK_CUR);
                         Mat_VarFree(matvar);
                         matvar = NULL;
                         Mat_Critical("Couldn't allocate memory");
@@ -11977,20 +14035,20 @@ Mat_VarReadNextInfo5(mat_t *mat)
                     (void)ReadNextStructField(mat, matvar);
                 else if ( matvar->class_type == MAT_C_CELL )
                     (void)ReadNextCell(mat, matvar);
-                (void)fseeko((FILE *)mat->fp, -(mat_off_t)matvar->internal->z->avail_in, SEEK_CUR);
-                matvar->internal->datapos = ftello((FILE *)mat->fp);
+                (void)Mat_fseeko(mat, -(mat_off_t)matvar->internal->z->avail_in, SEEK_CUR);
+                matvar->internal->datapos = Mat_ftello(mat);
                 if ( matvar->internal->datapos == -1L ) {
                     Mat_Critical("Couldn't determine file position");
                 }
             }
-            (void)fseeko((FILE *)mat->fp, nBytes + 8 + fpos, SEEK_SET);
+            (void)Mat_fseeko(mat, nBytes + 8 + fpos, SEEK_SET);
             break;
 #else
             Mat_Critical(
                 "Compressed variable found in \"%s\", but matio was "
                 "built without zlib support",
                 mat->filename);
-            (void)fseeko((FILE *)mat->fp, nBytes + 8 + fpos, SEEK_SET);
+            (void)Mat_fseeko(mat, nBytes + 8 + fpos, SEEK_SET);
             return NULL;
 #endif
         }
@@ -11998,9 +14056,9 @@ Mat_VarReadNextInfo5(mat_t *mat)
             mat_uint32_t buf[6];
 
             /* Read array flags and the dimensions tag */
-            err = Read(buf, 4, 6, (FILE *)mat->fp, NULL);
+            err = Read(buf, 4, 6, mat, NULL);
             if ( err ) {
-                (void)fseeko((FILE *)mat->fp, fpos, SEEK_SET);
+                (void)Mat_fseeko(mat, fpos, SEEK_SET);
                 break;
             }
             if ( mat->byteswap ) {
@@ -12037,16 +14095,16 @@ Mat_VarReadNextInfo5(mat_t *mat)
                 if ( err ) {
                     Mat_VarFree(matvar);
                     matvar = NULL;
-                    (void)fseeko((FILE *)mat->fp, fpos, SEEK_SET);
+                    (void)Mat_fseeko(mat, fpos, SEEK_SET);
                     break;
                 }
             }
             /* Variable name tag */
-            err = Read(buf, 4, 2, (FILE *)mat->fp, NULL);
+            err = Read(buf, 4, 2, mat, NULL);
             if ( err ) {
                 Mat_VarFree(matvar);
                 matvar = NULL;
-                (void)fseeko((FILE *)mat->fp, fpos, SEEK_SET);
+                (void)Mat_fseeko(mat, fpos, SEEK_SET);
                 break;
             }
             if ( mat->byteswap )
@@ -12065,27 +14123,27 @@ Mat_VarReadNextInfo5(mat_t *mat)
                 else {
                     Mat_VarFree(matvar);
                     matvar = NULL;
-                    (void)fseeko((FILE *)mat->fp, fpos, SEEK_SET);
+                    (void)Mat_fseeko(mat, fpos, SEEK_SET);
                     break;
                 }
                 if ( len_pad > MAX_READ_SIZE_WITHOUT_EOF_CHECK ) {
-                    err = CheckSeekFile((FILE *)mat->fp, (mat_off_t)len_pad);
+                    err = CheckSeekFile(mat, (mat_off_t)len_pad);
                     if ( err ) {
                         Mat_VarFree(matvar);
                         matvar = NULL;
-                        (void)fseeko((FILE *)mat->fp, fpos, SEEK_SET);
+                        (void)Mat_fseeko(mat, fpos, SEEK_SET);
                         break;
                     }
                 }
                 matvar->name = (char *)malloc(len_pad + 1);
                 if ( NULL != matvar->name ) {
-                    err = Read(matvar->name, 1, len_pad, (FILE *)mat->fp, NULL);
+                    err = Read(matvar->name, 1, len_pad, mat, NULL);
                     if ( MATIO_E_NO_ERROR == err ) {
                         matvar->name[len] = '\0';
                     } else {
                         Mat_VarFree(matvar);
                         matvar = NULL;
-                        (void)fseeko((FILE *)mat->fp, fpos, SEEK_SET);
+                        (void)Mat_fseeko(mat, fpos, SEEK_SET);
                         break;
                     }
                 }
@@ -12106,11 +14164,11 @@ Mat_VarReadNextInfo5(mat_t *mat)
                 (void)ReadNextCell(mat, matvar);
             else if ( matvar->class_type == MAT_C_FUNCTION )
                 (void)ReadNextFunctionHandle(mat, matvar);
-            matvar->internal->datapos = ftello((FILE *)mat->fp);
+            matvar->internal->datapos = Mat_ftello(mat);
             if ( matvar->internal->datapos == -1L ) {
                 Mat_Critical("Couldn't determine file position");
             }
-            (void)fseeko((FILE *)mat->fp, nBytes + 8 + fpos, SEEK_SET);
+            (void)Mat_fseeko(mat, nBytes + 8 + fpos, SEEK_SET);
             break;
         }
         default:
@@ -12121,6 +14179,314 @@ Mat_VarReadNextInfo5(mat_t *mat)
     return matvar;
 }
 
+/** @if mat_devman
+ * @brief Writes a matlab variable to the free space of a version 5 matlab file
+ *
+ * The variable is written to a temporary file first and then copied to the
+ * smallest free space it fits in, or to the end of the file otherwise. The
+ * remainder of the free space is marked as free space again.
+ * @ingroup mat_internal
+ * @param mat MAT file pointer
+ * @param matvar pointer to the mat variable
+ * @param compress option to compress the variable
+ *                 (only works for numeric types)
+ * @retval 0 on success
+ * @endif
+ */
+static int
+Mat_VarWriteFreeSpace5(mat_t *mat, matvar_t *matvar, int compress)
+{
+    FILE *fp = (FILE *)mat->fp;
+    FILE *tmp;
+    struct mat_free_t *hole = NULL, *entry, *next;
+    mat_off_t size, offset, largest = 0;
+    mat_uint8_t buf[READ_BLOCK_SIZE];
+    size_t n;
+    int err;
+
+    HASH_ITER(hh, mat->free_space, entry, next) {
+        if ( entry->size > largest )
+            largest = entry->size;
+    }
+    /* Data that does not fit into any free space, if compressed in the worst
+       case */
+    n = Mat_VarGetSize(matvar);
+#if HAVE_ZLIB
+    if ( compress == MAT_COMPRESSION_ZLIB && (mat_off_t)n <= largest && n <= UINT32_MAX / 2 )
+        n = (size_t)compressBound((uLong)n);
+#endif
+    if ( (mat_off_t)n > largest )
+        return Mat_VarWrite5(mat, matvar, compress);
+
+    tmp = tmpfile();
+    if ( NULL == tmp )
+        return Mat_VarWrite5(mat, matvar, compress);
+    mat->fp = tmp;
+    err = Mat_VarWrite5(mat, matvar, compress);
+    mat->fp = fp;
+    size = ftello(tmp);
+    if ( err || size <= 0 ) {
+        fclose(tmp);
+        return err ? err : MATIO_E_GENERIC_WRITE_ERROR;
+    }
+
+    /* Best fit, leaving either no or enough space for the free space marker */
+    HASH_ITER(hh, mat->free_space, entry, next) {
+        if ( (entry->size == size || entry->size - size >= FREE_SPACE_SIZE_MIN) &&
+             (NULL == hole || entry->size < hole->size) )
+            hole = entry;
+    }
+    if ( NULL != hole ) {
+        offset = hole->offset;
+    } else {
+        (void)fseeko(fp, 0, SEEK_END);
+        offset = ftello(fp);
+        if ( offset == -1L ) {
+            fclose(tmp);
+            Mat_Critical("Couldn't determine file position");
+            return MATIO_E_GENERIC_WRITE_ERROR;
+        }
+    }
+
+    rewind(tmp);
+    (void)fseeko(fp, offset, SEEK_SET);
+    while ( (n = fread(buf, 1, sizeof(buf), tmp)) > 0 ) {
+        if ( n != fwrite(buf, 1, n, fp) ) {
+            fclose(tmp);
+            return MATIO_E_GENERIC_WRITE_ERROR;
+        }
+    }
+    fclose(tmp);
+    if ( NULL != matvar->internal )
+        matvar->internal->datapos += offset;
+
+    if ( NULL != hole ) {
+        HASH_DEL(mat->free_space, hole);
+        if ( hole->size > size ) {
+            err = WriteFreeSpace5(mat, offset + size, hole->size - size);
+            Mat_AddFreeSpace5(mat, offset + size, hole->size - size);
+        }
+        free(hole);
+        /* The variable precedes the variables indexed so far */
+        Mat_FreeIndex(mat);
+    }
+    (void)fseeko(fp, 0, SEEK_END);
+
+    return err;
+}
+
+/** @if mat_devman
+ * @brief Deletes a variable from a version 5 MAT file in place
+ *
+ * Marks all variables of the given name as free space without moving any
+ * other variable of the file. Adjacent free space is merged.
+ * @ingroup mat_internal
+ * @param mat MAT file pointer
+ * @param name Name of the variable to delete
+ * @retval 0 on success, MATIO_E_OPERATION_NOT_SUPPORTED if the file needs to
+ * be rewritten
+ * @endif
+ */
+static int
+Mat_VarDelete5(mat_t *mat, const char *name)
+{
+    FILE *fp = (FILE *)mat->fp;
+    const mat_off_t fpos = ftello(fp);
+    matvar_t *matvar;
+    size_t ndeleted = 0;
+    int err = MATIO_E_NO_ERROR;
+
+    if ( fpos == -1L )
+        return MATIO_E_OPERATION_NOT_SUPPORTED;
+
+    while ( MATIO_E_NO_ERROR == err && NULL != (matvar = Mat_VarReadInfo(mat, name)) ) {
+        const struct mat_index_t *index = NULL;
+        struct mat_free_t *hole, *next;
+        mat_uint32_t tag[2];
+        mat_off_t offset, size;
+        int merged;
+
+        Mat_VarFree(matvar);
+        HASH_FIND_STR(mat->index, name, index);
+        if ( NULL == index ) {
+            err = MATIO_E_OPERATION_NOT_SUPPORTED;
+            break;
+        }
+        offset = index->offset;
+        (void)fseeko(fp, offset, SEEK_SET);
+        if ( 0 != Read(tag, 4, 2, mat, NULL) ) {
+            err = MATIO_E_GENERIC_READ_ERROR;
+            break;
+        }
+        if ( mat->byteswap )
+            (void)Mat_uint32Swap(tag + 1);
+        if ( tag[1] < FREE_SPACE_SIZE_MIN - 8 ) {
+            err = MATIO_E_OPERATION_NOT_SUPPORTED;
+            break;
+        }
+        size = 8 + (mat_off_t)tag[1];
+
+        /* Merge with adjacent free space, recording the following one first */
+        (void)fseeko(fp, offset + size, SEEK_SET);
+        Mat_SkipFreeSpace5(mat);
+        do {
+            merged = 0;
+            HASH_ITER(hh, mat->free_space, hole, next) {
+                if ( (hole->offset + hole->size == offset || offset + size == hole->offset) &&
+                     hole->size + size - 8 <= (mat_off_t)UINT32_MAX ) {
+                    if ( hole->offset < offset )
+                        offset = hole->offset;
+                    size += hole->size;
+                    HASH_DEL(mat->free_space, hole);
+                    free(hole);
+                    merged = 1;
+                }
+            }
+        } while ( merged );
+        err = WriteFreeSpace5(mat, offset, size);
+        Mat_AddFreeSpace5(mat, offset, size);
+        /* Search the file for further variables of the same name */
+        Mat_FreeIndex(mat);
+        ndeleted++;
+    }
+
+    if ( ndeleted > 0 ) {
+#if HAVE_ZLIB
+        Mat_FreeInflateIndex(mat);
+#endif
+        if ( NULL != mat->dir ) {
+            size_t i, j = 0;
+            for ( i = 0; i < mat->num_datasets; i++ ) {
+                if ( NULL != mat->dir[i] && 0 == strcmp(mat->dir[i], name) )
+                    free(mat->dir[i]);
+                else
+                    mat->dir[j++] = mat->dir[i];
+            }
+            mat->num_datasets = j;
+        }
+    }
+    (void)fseeko(fp, fpos, SEEK_SET);
+
+    return err;
+}
+
+/** @if mat_devman
+ * @brief Skips the free space of deleted variables
+ *
+ * Skips and records the free space at the current file position.
+ * @ingroup mat_internal
+ * @param mat MAT file pointer
+ * @endif
+ */
+static void
+Mat_SkipFreeSpace5(mat_t *mat)
+{
+    if ( NULL == mat->fp )
+        return;
+
+    for ( ;; ) {
+        mat_uint32_t tag[14];
+        const mat_off_t fpos = Mat_ftello(mat);
+        if ( fpos == -1L )
+            break;
+        if ( 14 != Mat_fread(tag, 4, 14, mat) ) {
+            (void)Mat_fseeko(mat, fpos, SEEK_SET);
+            break;
+        }
+        if ( mat->byteswap ) {
+            int i;
+            for ( i = 0; i < 14; i++ )
+                (void)Mat_uint32Swap(tag + i);
+        }
+        /* Empty double matrix without name, see WriteFreeSpace5 */
+        if ( tag[0] != MAT_T_MATRIX || tag[1] < FREE_SPACE_SIZE_MIN - 8 ||
+             tag[2] != MAT_T_UINT32 || tag[3] != 8 || tag[4] != MAT_C_DOUBLE ||
+             tag[6] != MAT_T_INT32 || tag[7] != 8 || tag[8] != 0 || tag[9] != 0 ||
+             tag[10] != MAT_T_INT8 || tag[11] != 0 || tag[12] != MAT_T_DOUBLE ||
+             tag[13] != 0 ) {
+            (void)Mat_fseeko(mat, fpos, SEEK_SET);
+            break;
+        }
+        Mat_AddFreeSpace5(mat, fpos, 8 + (mat_off_t)tag[1]);
+        (void)Mat_fseeko(mat, fpos + 8 + (mat_off_t)tag[1], SEEK_SET);
+    }
+}
+
+/** @if mat_devman
+ * @brief Records free space of a version 5 MAT file
+ *
+ * @ingroup mat_internal
+ * @param mat MAT file pointer
+ * @param offset File position of the free space
+ * @param size Size of the free space in bytes
+ * @endif
+ */
+static void
+Mat_AddFreeSpace5(mat_t *mat, mat_off_t offset, mat_off_t size)
+{
+    struct mat_free_t *entry = NULL;
+
+    HASH_FIND(hh, mat->free_space, &offset, sizeof(offset), entry);
+    if ( NULL != entry ) {
+        entry->size = size;
+        return;
+    }
+    /* Out of memory: The free space is not reused */
+    entry = (struct mat_free_t *)malloc(sizeof(*entry));
+    if ( NULL != entry ) {
+        entry->offset = offset;
+        entry->size = size;
+        HASH_ADD(hh, mat->free_space, offset, sizeof(entry->offset), entry);
+        if ( NULL == entry->hh.tbl )
+            free(entry);
+    }
+}
+
+/** @if mat_devman
+ * @brief Marks a range of a version 5 MAT file as free space
+ *
+ * Writes an empty double matrix without name, which is a valid variable for
+ * other readers (scipy.io.loadmat reads it as the function workspace) and
+ * which this library skips. Its size covers the whole free space; the
+ * remaining bytes are left unchanged.
+ * @ingroup mat_internal
+ * @param mat MAT file pointer
+ * @param offset File position of the free space
+ * @param size Size of the free space in bytes (at least FREE_SPACE_SIZE_MIN)
+ * @retval 0 on success
+ * @endif
+ */
+static int
+WriteFreeSpace5(mat_t *mat, mat_off_t offset, mat_off_t size)
+{
+    mat_uint32_t tag[14];
+
+    tag[0] = MAT_T_MATRIX;
+    tag[1] = (mat_uint32_t)(size - 8);
+    tag[2] = MAT_T_UINT32;
+    tag[3] = 8;
+    tag[4] = MAT_C_DOUBLE;
+    tag[5] = 0;
+    tag[6] = MAT_T_INT32;
+    tag[7] = 8;
+    tag[8] = 0;
+    tag[9] = 0;
+    tag[10] = MAT_T_INT8;
+    tag[11] = 0;
+    tag[12] = MAT_T_DOUBLE;
+    tag[13] = 0;
+    if ( mat->byteswap ) {
+        int i;
+        for ( i = 0; i < 14; i++ )
+            (void)Mat_uint32Swap(tag + i);
+    }
+    (void)Mat_fseeko(mat, offset, SEEK_SET);
+    if ( 14 != fwrite(tag, 4, 14, (FILE *)mat->fp) )
+        return MATIO_E_GENERIC_WRITE_ERROR;
+
+    return MATIO_E_NO_ERROR;
+}
+
 /* -------------------------------
  * ---------- mat73.c
  * -------------------------------
@@ -14690,6 +17056,18 @@ Mat_Create73(const char *matname, const char *hdr_str)
     mat->num_datasets = 0;
     mat->refs_id = -1;
     mat->dir = NULL;
+    mat->index = NULL;
+    mat->index_pos = 0;
+    mat->free_space = NULL;
+    mat->deflate.level = -1;
+    mat->deflate.strategy = MAT_DEFLATE_DEFAULT;
+    mat->deflate.min_size = 0;
+    mat->deflate.sample = 0;
+    mat->reader = NULL;
+#if HAVE_ZLIB
+    mat->inflate_index = NULL;
+    mat->inflate_cur = NULL;
+#endif
 
     t = time(NULL);
     mat->filename = Mat_strdup(matname);
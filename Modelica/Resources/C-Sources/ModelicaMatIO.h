@@ -284,6 +284,20 @@ enum matio_compression
     MAT_COMPRESSION_ZLIB = 1  /**< @brief zlib compression */
 };
 
+/** @brief MAT file deflate strategies
+ *
+ * Same values as the zlib strategies. This option is only used on version 5
+ * MAT files
+ * @ingroup MAT
+ */
+enum matio_deflate_strategy
+{
+    MAT_DEFLATE_DEFAULT = 0,      /**< @brief Default strategy */
+    MAT_DEFLATE_FILTERED = 1,     /**< @brief Small values with a somewhat random distribution */
+    MAT_DEFLATE_HUFFMAN_ONLY = 2, /**< @brief Huffman coding only (no string matching) */
+    MAT_DEFLATE_RLE = 3           /**< @brief Run-length encoding only */
+};
+
 /** @brief matio lookup type
  *
  * @ingroup MAT
@@ -392,10 +406,14 @@ typedef int (*mat_iter_pred_t)(const char *name, const void *user_data);
 
 /* Library function */
 MATIO_EXTERN void Mat_GetLibraryVersion(int *major, int *minor, int *release);
+MATIO_EXTERN long Mat_GetWriteCount(void);
 
 /* io.c */
+MATIO_EXTERN int Mat_SetThreadLogBuffer(char *buffer, size_t size);
+MATIO_EXTERN void Mat_VCritical(const char *format, va_list ap) MATIO_FORMATATTR_VPRINTF;
 MATIO_EXTERN void Mat_Critical(const char *format, ...) MATIO_FORMATATTR_PRINTF1;
 MATIO_EXTERN void Mat_Warning(const char *format, ...) MATIO_FORMATATTR_PRINTF1;
+MATIO_EXTERN void Mat_VWarning(const char *format, va_list ap) MATIO_FORMATATTR_VPRINTF;
 MATIO_EXTERN size_t Mat_SizeOf(enum matio_types data_type);
 MATIO_EXTERN size_t Mat_SizeOfClass(int class_type);
 
@@ -410,6 +428,9 @@ MATIO_EXTERN const char *Mat_GetHeader(const mat_t *mat);
 MATIO_EXTERN enum mat_ft Mat_GetVersion(const mat_t *mat);
 MATIO_EXTERN char *const *Mat_GetDir(mat_t *mat, size_t *n);
 MATIO_EXTERN int Mat_Rewind(mat_t *mat);
+MATIO_EXTERN int Mat_Compact(mat_t *mat);
+MATIO_EXTERN int Mat_SetCompression(mat_t *mat, int level, enum matio_deflate_strategy strategy,
+                              size_t min_size, int sample);
 
 /* MAT variable functions */
 MATIO_EXTERN matvar_t *Mat_VarCalloc(void);
@@ -198,8 +198,15 @@
 #endif
 #include <assert.h>
 #include <float.h>
+#include <limits.h>
 #include <math.h>
 #include <string.h>
+#if defined(_OPENMP) && _OPENMP >= 200805
+/* Parallel calculation of the spline coefficients by OpenMP (version 3.0 or
+   later is required for loops with unsigned indices) */
+#include <omp.h>
+#define SPLINE_PARALLEL 1
+#endif
 
 #if !defined(NO_FILE_SYSTEM)
 /* The standard way to detect POSIX is to check _POSIX_VERSION,
@@ -275,6 +282,10 @@ typedef struct CombiTimeTable {
     double* table; /* Table values */
     size_t nRow; /* Number of rows of table */
     size_t nCol; /* Number of columns of table */
+    size_t rowStride; /* Row stride of table (nCol if stored row-wise, 1 if
+        stored column-wise) */
+    size_t colStride; /* Column stride of table (1 if stored row-wise, nRow
+        if stored column-wise) */
     size_t last; /* Last accessed row index of table */
     enum Smoothness smoothness; /* Smoothness kind */
     enum Extrapolation extrapolation; /* Extrapolation kind */
@@ -287,6 +298,10 @@ typedef struct CombiTimeTable {
     CubicHermite1D* spline; /* Pre-calculated cubic Hermite spline coefficients,
         only used if smoothness is AKIMA_C1 or MAKIMA_C1 or
         FRITSCH_BUTLAND_MONOTONE_C1 or STEFFEN_MONOTONE_C1 */
+    struct ArrayShare* share; /* Shared table array and spline coefficients,
+        only used if source is TABLESOURCE_MODEL */
+    struct TableLoad* load; /* Pending load of table by a worker thread,
+        only used if source is TABLESOURCE_FILE */
     size_t nEvent; /* Time event counter, discrete */
     double preNextTimeEvent; /* Time of previous time event, discrete */
     double preNextTimeEventCalled; /* Time of previous call of
@@ -295,9 +310,17 @@ typedef struct CombiTimeTable {
     size_t eventInterval; /* Event interval marker, discrete,
         In case of periodic extrapolation this is the current event interval,
         otherwise it is the next event interval. */
-    double tOffset; /* Time offset, calculated by floor function, discrete,
+    double tOffset; /* Time offset, calculated as nPeriod*(tMax - tMin), discrete,
         only used if extrapolation is PERIODIC */
-    Interval* intervals; /* Event interval indices */
+    double nPeriod; /* Number of periods of time offset, calculated by floor
+        function, discrete, only used if extrapolation is PERIODIC */
+    Interval* intervals; /* Event interval indices, sorted by the time of the
+        time event at the end of the interval */
+    struct EventGroup* group; /* Time event group the table is member of */
+    size_t groupIndex; /* Index of table in heap of time event group */
+    double* integral; /* Pre-calculated integrals of the interpolated columns
+        from the minimum abscissa value to the abscissa value of each row
+        (prefix sums of the interval integrals) */
 } CombiTimeTable;
 
 typedef struct CombiTable1D {
@@ -305,6 +328,10 @@ typedef struct CombiTable1D {
     double* table; /* Table values */
     size_t nRow; /* Number of rows of table */
     size_t nCol; /* Number of columns of table */
+    size_t rowStride; /* Row stride of table (nCol if stored row-wise, 1 if
+        stored column-wise) */
+    size_t colStride; /* Column stride of table (1 if stored row-wise, nRow
+        if stored column-wise) */
     size_t last; /* Last accessed row index of table */
     enum Smoothness smoothness; /* Smoothness kind */
     enum Extrapolation extrapolation; /* Extrapolation kind */
@@ -314,6 +341,12 @@ typedef struct CombiTable1D {
     CubicHermite1D* spline; /* Pre-calculated cubic Hermite spline coefficients,
         only used if smoothness is AKIMA_C1 or MAKIMA_C1 or
         FRITSCH_BUTLAND_MONOTONE_C1 or STEFFEN_MONOTONE_C1 */
+    struct ArrayShare* share; /* Shared table array and spline coefficients,
+        only used if source is TABLESOURCE_MODEL */
+    struct TableLoad* load; /* Pending load of table by a worker thread,
+        only used if source is TABLESOURCE_FILE */
+    int* monotone; /* Strict monotonicity of the columns of table to be
+        interpolated (1: increasing, -1: decreasing, 0: not monotonic) */
 } CombiTable1D;
 
 typedef struct CombiTable2D {
@@ -323,13 +356,93 @@ typedef struct CombiTable2D {
     size_t nCol; /* Number of columns of table */
     size_t last1; /* Last accessed row index of table */
     size_t last2; /* Last accessed column index of table */
+    double du1; /* Spacing of the row abscissa values (first column) if they
+        are (nearly) uniform, otherwise 0 */
+    double du2; /* Spacing of the column abscissa values (first row) if they
+        are (nearly) uniform, otherwise 0 */
+    int colWise; /* = 1: Table stored column-wise, i.e., table is the
+        transpose with interchanged abscissa values u1 and u2 */
     enum Smoothness smoothness; /* Smoothness kind */
     enum Extrapolation extrapolation; /* Extrapolation kind */
     enum TableSource source; /* Source kind */
     CubicHermite2D* spline; /* Pre-calculated cubic Hermite spline coefficients,
         only used if smoothness is AKIMA_C1 */
+    struct ArrayShare* share; /* Shared table array and spline coefficients,
+        only used if source is TABLESOURCE_MODEL */
+    struct TableLoad* load; /* Pending load of table by a worker thread,
+        only used if source is TABLESOURCE_FILE */
 } CombiTable2D;
 
+#if !defined(MAX_TABLE_ND_DIMENSIONS)
+/* Maximum number of dimensions of CombiTableND */
+#define MAX_TABLE_ND_DIMENSIONS (6)
+#endif
+
+typedef struct CombiTableND {
+    char* key; /* Key consisting of concatenated names of file and table */
+    double* table; /* Grids of all dimensions followed by the table values
+        (last dimension varying fastest) */
+    size_t nTable; /* Number of elements of table */
+    size_t nDim; /* Number of dimensions */
+    size_t nGrid[MAX_TABLE_ND_DIMENSIONS]; /* Number of grid points per dimension */
+    size_t grid[MAX_TABLE_ND_DIMENSIONS]; /* Offset of grid per dimension in table */
+    size_t stride[MAX_TABLE_ND_DIMENSIONS]; /* Stride of table values per dimension */
+    size_t nValue; /* Number of table values (stored at offset nTable - nValue) */
+    size_t last[MAX_TABLE_ND_DIMENSIONS]; /* Last accessed grid interval per dimension */
+    double dx[MAX_TABLE_ND_DIMENSIONS]; /* Grid spacing per dimension if the grid
+        is (nearly) uniform, otherwise 0 */
+    enum Smoothness smoothness; /* Smoothness kind */
+    enum Extrapolation extrapolation; /* Extrapolation kind */
+    enum TableSource source; /* Source kind */
+    double* slopes; /* Pre-calculated (mixed) partial derivatives at the grid
+        points of the separable cubic Hermite interpolation, 2^nDim - 1 arrays
+        of nValue elements, where bit k of the (1-based) array index marks the
+        differentiation with respect to dimension k, only used if smoothness is
+        AKIMA_C1, MAKIMA_C1, FRITSCH_BUTLAND_MONOTONE_C1 or STEFFEN_MONOTONE_C1 */
+} CombiTableND;
+
+/* Triangle of a triangulation */
+typedef struct Triangle {
+    size_t v[3]; /* Vertex (row) indices in counterclockwise order */
+    size_t n[3]; /* Indices of the neighbour triangles opposite to the
+        vertices, NO_TRIANGLE at the boundary of the triangulation */
+} Triangle;
+
+typedef struct CombiTableScattered2D {
+    char* key; /* Key consisting of concatenated names of file and table */
+    double* table; /* Table values (rows of the abscissa values u1 and u2
+        followed by the ordinate values) */
+    size_t nRow; /* Number of rows of table */
+    size_t nCol; /* Number of columns of table */
+    enum Smoothness smoothness; /* Smoothness kind */
+    enum Extrapolation extrapolation; /* Extrapolation kind */
+    enum TableSource source; /* Source kind */
+    double uMin[2]; /* Minimum abscissa values */
+    double uMax[2]; /* Maximum abscissa values */
+    double* xy; /* Abscissa values scaled to the unit square (per row) */
+    Triangle* triangles; /* Delaunay triangulation of the scaled abscissa values */
+    size_t nTriangle; /* Number of triangles */
+    size_t* hull; /* Boundary edges of the triangulation, where edge
+        3*t + i is the edge of triangle t opposite to its vertex i */
+    size_t nHull; /* Number of boundary edges */
+    size_t last; /* Last located triangle */
+} CombiTableScattered2D;
+
+typedef struct EventGroupMember {
+    double nextTimeEvent; /* Next time event of member table, discrete */
+    CombiTimeTable* tableID; /* Member table */
+} EventGroupMember;
+
+typedef struct EventGroup {
+    size_t refCount; /* Reference counter (of group handle and member tables) */
+    EventGroupMember* heap; /* Binary min-heap of member tables, ordered by
+        their next time events */
+    size_t nMember; /* Number of member tables */
+    size_t maxMember; /* Allocated size of heap */
+    double preNextTimeEventCalled; /* Time of previous call of
+        ModelicaStandardTables_group_nextTimeEvent, discrete */
+} EventGroup;
+
 /* ----- Internal constants ----- */
 
 #if !defined(_EPSILON)
@@ -338,9 +451,36 @@ typedef struct CombiTable2D {
 #if !defined(MAX_TABLE_DIMENSIONS)
 #define MAX_TABLE_DIMENSIONS (3)
 #endif
+#if !defined(SPLINE_COL_BLOCK)
+/* Number of columns of which the 1D spline coefficients are calculated
+   together (row by row) */
+#define SPLINE_COL_BLOCK (8)
+#endif
+#if defined(SPLINE_PARALLEL)
+#if !defined(SPLINE_PARALLEL_MIN_SIZE)
+/* Minimum number of spline intervals for parallel calculation */
+#define SPLINE_PARALLEL_MIN_SIZE (16384)
+#endif
+#define SPLINE_THREADS(nTasks, size) ((nTasks) > 1 && \
+    (size) >= SPLINE_PARALLEL_MIN_SIZE ? (size_t)omp_get_max_threads() : 1)
+#define SPLINE_THREAD_NUM() ((size_t)omp_get_thread_num())
+#else
+#define SPLINE_THREADS(nTasks, size) (1)
+#define SPLINE_THREAD_NUM() (0)
+#endif
+#if !defined(TRIANGULATION_SUPER_SIZE)
+/* Size of the super triangle of the Delaunay triangulation relative to the
+   unit square of the scaled abscissa values */
+#define TRIANGULATION_SUPER_SIZE (1e3)
+#endif
+/* Missing neighbour triangle */
+#define NO_TRIANGLE ((size_t)-1)
 
 /* ----- Internal shortcuts ----- */
 
+/* The table access macros use nCol as row stride. For 1D tables stored
+   column-wise (see usertab) the row stride is 1 and the column indices are
+   multiplied by the column stride nRow. */
 #define IDX(i, j, n) ((i)*(n) + (j))
 #define TABLE(i, j) table[IDX(i, j, nCol)]
 #define TABLE_ROW0(j) table[j]
@@ -428,9 +568,86 @@ typedef struct TableShare {
     UT_hash_handle hh; /* Hashable structure */
 } TableShare;
 
+#if !defined(NO_TABLE_COPY)
+/* Common/shared table arrays passed from the model are identified by their
+   content (dimensions and values) */
+#define ARRAY_SHARE 1
+
+typedef struct SplineShare {
+    int nDim; /* Number of dimensions of spline (1 or 2) */
+    enum Smoothness smoothness; /* Smoothness kind */
+    int* cols; /* Columns of table to be interpolated */
+    size_t nCols; /* Number of columns of table to be interpolated */
+    size_t refCount; /* Reference counter */
+    void* spline; /* Pre-calculated cubic Hermite spline coefficients */
+    struct SplineShare* next; /* Next spline of same table array */
+} SplineShare;
+
+typedef struct ArrayShare {
+    size_t refCount; /* Reference counter */
+    size_t nRow; /* Number of rows of table */
+    size_t nCol; /* Number of columns of table */
+    double* table; /* Table values (also the key of the hash table) */
+    SplineShare* splines; /* Linked list of shared spline coefficients */
+    UT_hash_handle hh; /* Hashable structure */
+} ArrayShare;
+#endif
+#endif
+
+#if defined(TABLE_ASYNC_LOAD) && !defined(NO_FILE_SYSTEM) && \
+    defined(MODELICA_THREAD_LOCAL)
+#if (defined(_POSIX_) && !defined(NO_MUTEX)) || defined(_WIN32)
+/* Tables are loaded from file by worker threads */
+#define ASYNC_LOAD 1
+#endif
+#endif
+
+#if defined(ASYNC_LOAD)
+#if !defined(MAX_TABLE_LOAD_THREADS)
+/* Maximum number of worker threads loading table files */
+#define MAX_TABLE_LOAD_THREADS (4)
+#endif
+#if !defined(TABLE_LOAD_MESSAGE_SIZE)
+/* Size of the error message buffer of a table file load */
+#define TABLE_LOAD_MESSAGE_SIZE (1024)
+#endif
+
+enum TableLoadState {
+    LOAD_QUEUED = 0,
+    LOAD_RUNNING,
+    LOAD_DONE
+};
+
+enum TableLoadThreadState {
+    THREAD_NONE = 0,
+    THREAD_RUNNING,
+    THREAD_FINISHED /* To be joined */
+};
+
+typedef struct TableLoad {
+    char* key; /* Key consisting of concatenated names of file and table,
+        followed by the column delimiter */
+    size_t lenKey; /* Length of key including all terminating zeros */
+    int nHeaderLines; /* Number of header lines to ignore (CSV file only) */
+    enum TableLoadState state; /* Load state */
+    size_t refCount; /* Reference counter (number of table objects waiting
+        for the load) */
+    double* table; /* Table values, NULL on error or if already taken */
+    size_t nRow; /* Number of rows of table */
+    size_t nCol; /* Number of columns of table */
+    char message[TABLE_LOAD_MESSAGE_SIZE]; /* Error message, empty on
+        success */
+    struct TableLoad* next; /* Next table file load */
+} TableLoad;
+#endif
+
 /* ----- Static variables ----- */
 
+#if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
 static TableShare* tableShare = NULL;
+#if defined(ARRAY_SHARE)
+static ArrayShare* arrayShare = NULL;
+#endif
 #if defined(_POSIX_) && !defined(NO_MUTEX)
 #include <pthread.h>
 #if defined(G2_HAS_CONSTRUCTORS)
@@ -478,6 +695,44 @@ static void G2_FUNCNAME(ModelicaStandardTables_deleteCS)(void) {
 #define MUTEX_LOCK()
 #define MUTEX_UNLOCK()
 #endif
+#else
+#define MUTEX_LOCK()
+#define MUTEX_UNLOCK()
+#endif
+#if defined(ASYNC_LOAD)
+static TableLoad* tableLoads = NULL;
+static size_t nLoadThreads = 0;
+static enum TableLoadThreadState loadThreadStates[MAX_TABLE_LOAD_THREADS];
+#if defined(_POSIX_) && !defined(NO_MUTEX)
+#include <pthread.h>
+static pthread_t loadThreads[MAX_TABLE_LOAD_THREADS];
+static pthread_mutex_t loadMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t loadCond = PTHREAD_COND_INITIALIZER;
+#define LOAD_LOCK() pthread_mutex_lock(&loadMutex)
+#define LOAD_UNLOCK() pthread_mutex_unlock(&loadMutex)
+#define LOAD_WAIT() pthread_cond_wait(&loadCond, &loadMutex)
+#define LOAD_BROADCAST() pthread_cond_broadcast(&loadCond)
+#else
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+static HANDLE loadThreads[MAX_TABLE_LOAD_THREADS];
+static SRWLOCK loadLock = SRWLOCK_INIT;
+static CONDITION_VARIABLE loadCond = CONDITION_VARIABLE_INIT;
+#define LOAD_LOCK() AcquireSRWLockExclusive(&loadLock)
+#define LOAD_UNLOCK() ReleaseSRWLockExclusive(&loadLock)
+#define LOAD_WAIT() SleepConditionVariableSRW(&loadCond, &loadLock, INFINITE, 0)
+#define LOAD_BROADCAST() WakeAllConditionVariable(&loadCond)
+#endif
+/* Finish the pending table file load before the first access of a table */
+#define FINISH_LOAD(readFunction, tableID) do { \
+    if (NULL != (tableID)->load) { \
+        (void)readFunction((void*)(tableID), 0, 0); \
+    } \
+} while(0)
+#else
+#define FINISH_LOAD(readFunction, tableID)
 #endif
 
 /* ----- Function declarations ----- */
@@ -494,7 +749,12 @@ extern int usertab(char* tableName, int nipo, int dim[], int* colWise,
      <- dim: Actual values of dimensions
      <- colWise: = 0: table stored row-wise    (row_1, row_2, ..., row_n)
                  = 1: table stored column-wise (column_1, column_2, ...)
-     <- table: Pointer to vector containing a matrix with dimensions "dim"
+                 = 3: table stored column-wise and valid until the table
+                      object is closed (e.g. in read-only memory), such that
+                      it is interpolated in place instead of a transposed copy
+     <- table: Pointer to vector containing a matrix with dimensions "dim".
+               A table stored row-wise is always interpolated in place and
+               needs to be valid until the table object is closed.
      <- RETURN: = 0: No error
                 = 1: An error occurred. An error message is printed from usertab.
   */
@@ -502,6 +762,12 @@ extern int usertab(char* tableName, int nipo, int dim[], int* colWise,
 static int isNearlyEqual(double x, double y);
   /* Compare two floating-point numbers by threshold _EPSILON */
 
+static double wrapPeriodic(double x, double xMin, double xMax);
+  /* Map x to the interval [xMin, xMax] by periodic extrapolation with period
+     xMax - xMin in constant time. The result is in [xMin, xMax) if x < xMin
+     and in (xMin, xMax] if x > xMax.
+  */
+
 static size_t findRowIndex(_In_ const double* table, size_t nRow, size_t nCol,
                            size_t last, double x) MODELICA_NONNULLATTR;
   /* Find the row index i using binary search such that
@@ -510,13 +776,38 @@ static size_t findRowIndex(_In_ const double* table, size_t nRow, size_t nCol,
       * table[(i + 1)*nCol] > x for i + 2 < nRow
   */
 
+static size_t findRowIndexForward(_In_ const double* table, size_t nRow,
+                                  size_t nCol, size_t last,
+                                  double x) MODELICA_NONNULLATTR;
+  /* Same as findRowIndex, but first searching linearly in the rows following
+     row last, which is faster for increasing sequences of x
+  */
+
 static size_t findRowIndex2(_In_ const double* table, size_t nRow, size_t nCol,
                             size_t last, double x, double dx) MODELICA_NONNULLATTR;
   /* Using dx as tie-breaker if table[i*nCol] == x to treat x as x+dx*eps */
 
-static size_t findColIndex(_In_ const double* table, size_t nCol, size_t last,
-                           double x) MODELICA_NONNULLATTR;
-  /* Same as findRowIndex but works on columns */
+static size_t findRowIndexUniform(_In_ const double* table, size_t nRow,
+                                  size_t nCol, size_t last, double x,
+                                  double dx, double du) MODELICA_NONNULLATTR;
+  /* Same as findRowIndex2, but if the abscissa values are (nearly) uniform
+     with spacing du > 0, the start index of the search is calculated instead
+     of using last, such that the row index is found in constant time
+  */
+
+static size_t findColIndexUniform(_In_ const double* table, size_t nCol,
+                                  size_t last, double x, double dx,
+                                  double du) MODELICA_NONNULLATTR;
+  /* Same as findRowIndexUniform but works on columns */
+
+static double uniformSpacing(_In_ const double* x, size_t n,
+                             size_t stride) MODELICA_NONNULLATTR;
+  /* Determine the spacing of n >= 2 strictly increasing values x[i*stride]
+
+     <- RETURN: Spacing if no value deviates by more than half the spacing
+                from the uniform grid (such that a start index calculated
+                from the spacing is off by one at most), otherwise 0
+  */
 
 static size_t findColIndex2(_In_ const double* table, size_t nCol, size_t last,
                            double x, double dx) MODELICA_NONNULLATTR;
@@ -525,6 +816,26 @@ static size_t findColIndex2(_In_ const double* table, size_t nCol, size_t last,
 static int isLessOrEqualWNegativeSlope(double x, double dx, double val);
   /* Check, whether x is less than val, also using dx as tie-breaker */
 
+static Interval* eventIntervalsInit(_In_ const double* table, size_t nRow,
+                                    size_t nCol, enum TimeEvents timeEvents,
+                                    size_t* maxEvents) MODELICA_NONNULLATTR;
+  /* Determine the event intervals (per period/cycle) of a time table in one
+     pass. The time event at the end of event interval i is
+     table[intervals[i][1]*nCol] and strictly increasing with i.
+     <- maxEvents: Number of event intervals
+     <- RETURN: Pointer to array of event intervals, NULL on allocation error
+  */
+
+static size_t findEventInterval(_In_ const double* table, size_t nCol,
+                                _In_ const Interval* intervals, size_t i0,
+                                size_t i1, double t, double tOffset,
+                                double shiftTime) MODELICA_NONNULLATTR;
+  /* Find the event interval index i using binary search such that
+      * i0 <= i <= i1
+      * table[intervals[i][1]*nCol] + tOffset + shiftTime > t for i < i1
+      * table[intervals[j][1]*nCol] + tOffset + shiftTime <= t for i0 <= j < i
+  */
+
 static int isValidName(_In_z_ const char* name) MODELICA_NONNULLATTR;
   /* Check, whether a file or table name is valid */
 
@@ -540,14 +851,45 @@ static int isValidCombiTable2D(CombiTable2D* tableID,
                                _In_z_ const char* tableName, enum CleanUp cleanUp);
   /* Check, whether a CombiTable2D is well parameterized */
 
+static int isValidCombiTableND(CombiTableND* tableID,
+                               _In_z_ const char* tableName, enum CleanUp cleanUp);
+  /* Check, whether a CombiTableND is well parameterized */
+
+static int isValidCombiTableScattered2D(CombiTableScattered2D* tableID,
+                                        _In_z_ const char* tableName,
+                                        enum CleanUp cleanUp);
+  /* Check, whether a CombiTableScattered2D is well parameterized */
+
 static enum TableSource getTableSource(_In_z_ const char* fileName,
                                        _In_z_ const char* tableName) MODELICA_NONNULLATTR;
   /* Determine table source (file, model or "usertab" function) from table
      and file names
   */
 
-static void transpose(_Inout_ double* table, size_t nRow, size_t nCol) MODELICA_NONNULLATTR;
-  /* Cycle-based in-place array transposition */
+static void eventGroupRelease(_Inout_ EventGroup* group) MODELICA_NONNULLATTR;
+  /* Decrement the reference counter of a time event group and free it if
+     unreferenced
+  */
+
+static int eventGroupAdd(_Inout_ EventGroup* group,
+                         _Inout_ CombiTimeTable* tableID) MODELICA_NONNULLATTR;
+  /* Insert table into the heap of a time event group. The table is marked
+     for update of its next time event by the next call of
+     ModelicaStandardTables_group_nextTimeEvent.
+
+     <- RETURN: = 1: Success
+                = 0: Allocation error
+  */
+
+static void eventGroupRemove(_Inout_ EventGroup* group,
+                             _Inout_ CombiTimeTable* tableID) MODELICA_NONNULLATTR;
+  /* Remove table from the heap of a time event group */
+
+static void eventGroupSiftUp(_Inout_ EventGroup* group, size_t i) MODELICA_NONNULLATTR;
+  /* Restore heap order by moving member i towards the root */
+
+static void eventGroupSiftDown(_Inout_ EventGroup* group, size_t i) MODELICA_NONNULLATTR;
+  /* Restore heap order by moving member i towards the leaves */
 
 #if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
 static size_t key_strlen(_In_z_ const char *s);
@@ -569,8 +911,59 @@ static READ_RESULT readTable(_In_z_ const char* fileName, _In_z_ const char* tab
         pointer to array (row-wise storage) of table values
   */
 
+#if defined(ASYNC_LOAD)
+static TableLoad* tableLoadStart(_In_z_ const char* fileName,
+                                 _In_z_ const char* tableName, int verbose,
+                                 _In_z_ const char* delimiter,
+                                 int nHeaderLines) MODELICA_NONNULLATTR;
+  /* Queue a table file for loading by a worker thread or join the pending
+     load of the same table file
+
+     <- RETURN: Pointer to TableLoad structure or NULL if the table is
+                available from the table share or on allocation error, in
+                which case the table is to be read by readTable
+  */
+
+static int tableLoadFinish(_Inout_ TableLoad* load, _Inout_ char** key,
+                           _Inout_ double** table, _Inout_ size_t* nRow,
+                           _Inout_ size_t* nCol) MODELICA_NONNULLATTR;
+  /* Wait for a table file load to finish (or load it in the calling thread
+     if not yet started), take the table and release the load. With
+     TABLE_SHARE the table is inserted into the table share and key is
+     replaced by the key of the table share.
+
+     <- RETURN: = 1: Success
+                = 0: Error (raised by ModelicaFormatError)
+  */
+
+static void tableLoadRelease(_Inout_ TableLoad* load) MODELICA_NONNULLATTR;
+  /* Decrement the reference counter of a table file load and free it if
+     unreferenced (waiting for a running load to finish). If no table file
+     load is left, the worker threads are joined.
+  */
+
+static void tableLoadRun(_Inout_ TableLoad* load) MODELICA_NONNULLATTR;
+  /* Load a queued table file. Must be called with the load lock held, which
+     is released while reading the file.
+  */
+
+static void tableLoadWork(size_t i);
+  /* Load queued table files until the queue is empty (worker thread i) */
+
+static int tableLoadSpawn(size_t i);
+  /* Start worker thread i
+
+     <- RETURN: = 1: Success
+                = 0: Error
+  */
+
+static void tableLoadJoin(size_t i);
+  /* Join finished worker thread i. Must be called with the load lock held. */
+#endif
+
 static CubicHermite1D* akimaSpline1DInit(_In_ const double* table, size_t nRow,
-                                         size_t nCol, _In_ const int* cols,
+                                         size_t nCol, size_t colStride,
+                                         _In_ const int* cols,
                                          size_t nCols) MODELICA_NONNULLATTR;
   /* Calculate the coefficients for univariate cubic Hermite spline
      interpolation with the Akima slope approximation
@@ -579,7 +972,8 @@ static CubicHermite1D* akimaSpline1DInit(_In_ const double* table, size_t nRow,
   */
 
 static CubicHermite1D* makimaSpline1DInit(_In_ const double* table, size_t nRow,
-                                         size_t nCol, _In_ const int* cols,
+                                         size_t nCol, size_t colStride,
+                                         _In_ const int* cols,
                                          size_t nCols) MODELICA_NONNULLATTR;
   /* Calculate the coefficients for univariate cubic Hermite spline
      interpolation with the modified Akima slope approximation
@@ -589,6 +983,7 @@ static CubicHermite1D* makimaSpline1DInit(_In_ const double* table, size_t nRow,
 
 static CubicHermite1D* fritschButlandSpline1DInit(_In_ const double* table,
                                                   size_t nRow, size_t nCol,
+                                                  size_t colStride,
                                                   _In_ const int* cols,
                                                   size_t nCols) MODELICA_NONNULLATTR;
   /* Calculate the coefficients for univariate cubic Hermite spline
@@ -599,6 +994,7 @@ static CubicHermite1D* fritschButlandSpline1DInit(_In_ const double* table,
 
 static CubicHermite1D* steffenSpline1DInit(_In_ const double* table,
                                            size_t nRow, size_t nCol,
+                                           size_t colStride,
                                            _In_ const int* cols,
                                            size_t nCols) MODELICA_NONNULLATTR;
   /* Calculate the coefficients for univariate cubic Hermite spline
@@ -607,9 +1003,77 @@ static CubicHermite1D* steffenSpline1DInit(_In_ const double* table,
      <- RETURN: Pointer to array of coefficients
   */
 
+static CubicHermite1D* spline1DInit(enum Smoothness smoothness,
+                                    _In_ const double* table, size_t nRow,
+                                    size_t nCol, size_t colStride,
+                                    _In_ const int* cols, size_t nCols);
+  /* Calculate the coefficients for univariate cubic Hermite spline
+     interpolation with the slope approximation of the smoothness kind,
+     where nCol and colStride are the row and column strides of the table
+
+     <- RETURN: Pointer to array of coefficients or NULL if smoothness
+        is not a cubic Hermite spline kind
+  */
+
 static void spline1DClose(CubicHermite1D** spline);
   /* Free allocated memory of the 1D cubic Hermite spline coefficients */
 
+static int* monotonicity1DInit(_In_ const double* table, size_t nRow,
+                               size_t nCol, size_t colStride,
+                               _In_ const int* cols,
+                               size_t nCols) MODELICA_NONNULLATTR;
+  /* Determine the strict monotonicity of the columns of a 1D table
+
+     <- RETURN: Pointer to array of monotonicity (1: strictly increasing,
+                -1: strictly decreasing, 0: not strictly monotonic) per column
+  */
+
+static double* integral1DInit(enum Smoothness smoothness,
+                              _In_ const double* table, size_t nRow,
+                              size_t nCol, size_t colStride,
+                              _In_ const int* cols, size_t nCols,
+                              const CubicHermite1D* spline);
+  /* Calculate the integrals of the interpolated columns of a 1D table from
+     the first abscissa value to the abscissa value of each row
+
+     <- RETURN: Pointer to array of integrals (nRow rows, nCols columns)
+  */
+
+static double intervalIntegral1D(enum Smoothness smoothness,
+                                 _In_ const double* table, size_t nCol,
+                                 size_t col, const double* c, size_t i,
+                                 double v);
+  /* Integral of the interpolated column col of a 1D table from the abscissa
+     value of row i to the abscissa value of row i plus v (within interval i),
+     where c are the cubic Hermite spline coefficients of the interval (if
+     smoothness is a cubic Hermite spline kind)
+  */
+
+static double timeTableIntegral(_In_ const CombiTimeTable* tableID, size_t k,
+                                double t) MODELICA_NONNULLATTR;
+  /* Integral of the k-th (0-based) interpolated column of a CombiTimeTable
+     from the minimum abscissa value to the (unshifted) abscissa value t,
+     including extrapolation
+  */
+
+static void interpolate1D(enum Smoothness smoothness,
+                          _In_ const double* table, size_t nCol,
+                          size_t colStride, _In_ const int* cols, size_t nCols,
+                          const CubicHermite1D* spline, size_t last, double u,
+                          double* y);
+  /* Interpolate all columns cols of a 1D table at abscissa value u within
+     row interval last (without extrapolation)
+
+     <- y: Interpolated values (nCols values)
+  */
+
+static double solveCubic(double a, double b, double c, double d);
+  /* Find a root t in [0, 1] of the cubic polynomial ((a*t + b)*t + c)*t + d,
+     which must have values of different sign (or zero) at t = 0 and t = 1.
+     The root is calculated analytically and refined by safeguarded Newton
+     iterations.
+  */
+
 static CubicHermite2D* spline2DInit(_In_ const double* table, size_t nRow,
                                     size_t nCol) MODELICA_NONNULLATTR;
   /* Calculate the coefficients for bivariate cubic Hermite spline
@@ -621,6 +1085,135 @@ static CubicHermite2D* spline2DInit(_In_ const double* table, size_t nRow,
 static void spline2DClose(CubicHermite2D** spline);
   /* Free allocated memory of the 2D cubic Hermite spline coefficients */
 
+static void bicubicHermite2D(_In_ const double* c, double y00, double v1,
+                             double v2, int order,
+                             double* d) MODELICA_NONNULLATTR;
+  /* Evaluate the bicubic Hermite polynomial with coefficients c (and
+     c[15] = y00) at the abscissa values v1 and v2 relative to the lower
+     grid point of the table cell
+
+     -> order: Highest order of the partial derivatives to evaluate (0, 1 or 2)
+     <- d: Polynomial value y (d[0]), first partial derivatives dy/dv1 (d[1])
+           and dy/dv2 (d[2]) if order >= 1, second partial derivatives
+           d2y/dv1^2 (d[3]), d2y/dv1dv2 (d[4]) and d2y/dv2^2 (d[5]) if
+           order >= 2
+  */
+
+static void table2DAxesInit(_Inout_ CombiTable2D* tableID) MODELICA_NONNULLATTR;
+  /* Determine the uniform spacings of the abscissa values of a 2D table and
+     reset the last accessed row and column indices
+  */
+
+static size_t findGridIndex(_In_ const double* x, size_t n, size_t last,
+                            double dx, double u) MODELICA_NONNULLATTR;
+  /* Find the grid interval index i of a grid x with n >= 2 points such that
+      * i + 1 < n
+      * x[i] < u <= x[i + 1], or i = 0 if u <= x[0], or i = n - 2 if u > x[n - 1]
+     starting at interval index last. If the grid spacing dx of a uniform grid
+     is positive the start index is calculated instead.
+  */
+
+static void tableNDGridInit(_Inout_ CombiTableND* tableID) MODELICA_NONNULLATTR;
+  /* Determine the uniform grid spacings of an N-dim. table and reset the
+     last accessed grid intervals
+  */
+
+static double* tableNDSlopesInit(_In_ const CombiTableND* tableID) MODELICA_NONNULLATTR;
+  /* Calculate the (mixed) partial derivatives of the separable cubic Hermite
+     interpolation of an N-dim. table by successive application of the 1D
+     slope estimation (of the smoothness kind) along the dimensions
+     <- RETURN: Pointer to array of 2^nDim - 1 arrays of nValue elements
+  */
+
+static void tableNDSlopes1D(enum Smoothness smoothness, _In_ const double* x,
+                            size_t n, _In_ const double* y, size_t stride,
+                            _Inout_ double* m, _Inout_ double* d) MODELICA_NONNULLATTR;
+  /* Estimate the slopes m[i*stride] at the grid points x[i] of the values
+     y[i*stride] (i = 0, ..., n - 1) using the divided differences buffer d
+     of n + 3 elements
+  */
+
+static double tableNDInterpolate(_Inout_ CombiTableND* tableID,
+                                 _In_ const double* u,
+                                 const double* der_u,
+                                 double* der_y);
+  /* Interpolate in N-dim. table, and calculate the derivative der_y of the
+     interpolated value (with respect to the derivatives der_u of the
+     independent variables) if der_u and der_y are given
+  */
+
+static int tableScattered2DInit(_Inout_ CombiTableScattered2D* tableID,
+                                _In_z_ const char* tableName,
+                                enum CleanUp cleanUp) MODELICA_NONNULLATTR;
+  /* Scale the abscissa values of a scattered 2D table to the unit square and
+     calculate their Delaunay triangulation and its boundary
+     <- RETURN: 0 on error, otherwise 1
+  */
+
+static int delaunayInit(_In_ const double* xy, size_t nPoint,
+                        Triangle** triangles, size_t* nTriangle,
+                        size_t* iPoint) MODELICA_NONNULLATTR;
+  /* Calculate the Delaunay triangulation of nPoint points xy (2 coordinates
+     per point) by incremental insertion (Bowyer-Watson algorithm)
+     <- triangles: Pointer to array of triangles
+     <- nTriangle: Number of triangles (0 if all points are collinear)
+     <- iPoint: Index of the first point that coincides with a previous point
+     <- RETURN: 0 on success, 1 on memory allocation error, 2 if two points
+                coincide
+  */
+
+static size_t locateTriangle(_In_ const Triangle* triangles, size_t nTriangle,
+                             _In_ const double* xy, size_t t, double x,
+                             double y, _Inout_ int* inside) MODELICA_NONNULLATTR;
+  /* Locate the triangle containing the point (x, y) by walking from
+     triangle t through the triangulation
+     <- inside: 0 if the point is outside of the triangulation, otherwise 1
+     <- RETURN: Index of the triangle containing the point, or of the
+                boundary triangle where the walk left the triangulation
+  */
+
+static double orient2D(_In_ const double* a, _In_ const double* b,
+                       _In_ const double* c) MODELICA_NONNULLATTR;
+  /* Twice the signed area of the triangle (a, b, c), positive if the points
+     are in counterclockwise order
+  */
+
+static double tableScattered2DInterpolate(_Inout_ CombiTableScattered2D* tableID,
+                                          size_t col, double u1, double u2,
+                                          const double* der_u,
+                                          double* der_y);
+  /* Interpolate column col (0-based) of scattered 2D table, and calculate the
+     derivative der_y of the interpolated value (with respect to the
+     derivatives der_u of the independent variables) if der_u and der_y are
+     given
+  */
+
+#if defined(ARRAY_SHARE)
+static ArrayShare* arrayShareAcquire(_In_ const double* table, size_t nRow,
+                                     size_t nCol) MODELICA_NONNULLATTR;
+  /* Find a common/shared copy of a table array passed from the model
+     (compared by content) or insert a new one, and increment its reference
+     counter
+
+     <- RETURN: Pointer to ArrayShare structure or NULL if the table array
+        cannot be shared
+  */
+
+static void* splineShareAcquire(_Inout_ ArrayShare* share, int nDim,
+                                enum Smoothness smoothness,
+                                const int* cols, size_t nCols);
+  /* Find the common/shared spline coefficients of a shared table array or
+     calculate and insert new ones, and increment their reference counter
+
+     <- RETURN: Pointer to array of coefficients
+  */
+
+static void arrayShareRelease(_Inout_ ArrayShare* share, void* spline);
+  /* Decrement the reference counters of shared spline coefficients (if not
+     NULL) and of the shared table array and free them if unreferenced
+  */
+#endif
+
 /* ----- Interface functions ----- */
 
 #if defined(__clang__)
@@ -674,6 +1267,9 @@ void* ModelicaStandardTables_CombiTimeTable_init3(_In_z_ const char* fileName,
 #if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
     TableShare* file = NULL;
     char* keyFile = NULL;
+#endif
+#if defined(ASYNC_LOAD)
+    TableLoad* load = NULL;
 #endif
     double* tableFile = NULL;
     size_t nRowFile = 0;
@@ -681,7 +1277,16 @@ void* ModelicaStandardTables_CombiTimeTable_init3(_In_z_ const char* fileName,
     enum TableSource source = getTableSource(fileName, tableName);
 
     /* Read table from file before any other heap allocation */
+#if defined(ASYNC_LOAD)
     if (TABLESOURCE_FILE == source) {
+        /* Queue table file for loading by a worker thread */
+        load = tableLoadStart(fileName, tableName, verbose, delimiter,
+            nHeaderLines);
+    }
+    if (TABLESOURCE_FILE == source && NULL == load) {
+#else
+    if (TABLESOURCE_FILE == source) {
+#endif
 #if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
         file = readTable(fileName, tableName, &nRowFile, &nColFile, verbose, 0, delimiter, nHeaderLines);
         if (NULL != file) {
@@ -716,6 +1321,11 @@ void* ModelicaStandardTables_CombiTimeTable_init3(_In_z_ const char* fileName,
         if (NULL != tableFile) {
             free(tableFile);
         }
+#endif
+#if defined(ASYNC_LOAD)
+        if (NULL != load) {
+            tableLoadRelease(load);
+        }
 #endif
         ModelicaError("Memory allocation error\n");
         return NULL;
@@ -733,6 +1343,23 @@ void* ModelicaStandardTables_CombiTimeTable_init3(_In_z_ const char* fileName,
 
     switch (tableID->source) {
         case TABLESOURCE_FILE:
+#if defined(ASYNC_LOAD)
+            if (NULL != load) {
+                size_t lenFileName = strlen(fileName);
+                tableID->load = load;
+                tableID->key = (char*)malloc((lenFileName + strlen(tableName) + 2)*sizeof(char));
+                if (NULL != tableID->key) {
+                    strcpy(tableID->key, fileName);
+                    strcpy(tableID->key + lenFileName + 1, tableName);
+                }
+                else {
+                    ModelicaStandardTables_CombiTimeTable_close(tableID);
+                    ModelicaError("Memory allocation error\n");
+                    return NULL;
+                }
+                break;
+            }
+#endif
 #if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
             tableID->key = keyFile;
 #else
@@ -756,6 +1383,13 @@ void* ModelicaStandardTables_CombiTimeTable_init3(_In_z_ const char* fileName,
 #if defined(NO_TABLE_COPY)
             tableID->table = table;
 #else
+#if defined(ARRAY_SHARE)
+            tableID->share = arrayShareAcquire(table, nRow, nColumn);
+            if (NULL != tableID->share) {
+                tableID->table = tableID->share->table;
+                break;
+            }
+#endif
             tableID->table = (double*)malloc(nRow*nColumn*sizeof(double));
             if (NULL != tableID->table) {
                 memcpy(tableID->table, table, nRow*nColumn*sizeof(double));
@@ -777,18 +1411,24 @@ void* ModelicaStandardTables_CombiTimeTable_init3(_In_z_ const char* fileName,
                     tableID->nRow = (size_t)dim[0];
                     tableID->nCol = (size_t)dim[1];
                 }
+                else if (3 == colWise) {
+                    /* Interpolate in place with column-wise strides */
+                    tableID->nRow = (size_t)dim[1];
+                    tableID->nCol = (size_t)dim[0];
+                    tableID->rowStride = 1;
+                    tableID->colStride = tableID->nRow;
+                }
                 else {
                     /* Need to transpose */
                     double* tableT = (double*)malloc(
                         (size_t)dim[0]*(size_t)dim[1]*sizeof(double));
                     if (NULL != tableT) {
-                        memcpy(tableT, tableID->table,
-                            (size_t)dim[0]*(size_t)dim[1]*sizeof(double));
+                        ModelicaIO_transposeRealMatrix(tableID->table,
+                            (size_t)dim[0], (size_t)dim[1], tableT);
                         tableID->table = tableT;
                         tableID->nRow = (size_t)dim[1];
                         tableID->nCol = (size_t)dim[0];
                         tableID->source = TABLESOURCE_FUNCTION_TRANSPOSE;
-                        transpose(tableID->table, tableID->nRow, tableID->nCol);
                     }
                     else {
                         ModelicaStandardTables_CombiTimeTable_close(tableID);
@@ -810,6 +1450,12 @@ void* ModelicaStandardTables_CombiTimeTable_init3(_In_z_ const char* fileName,
             return NULL;
     }
 
+    if (0 == tableID->colStride) {
+        /* Table stored row-wise */
+        tableID->rowStride = tableID->nCol;
+        tableID->colStride = 1;
+    }
+
     if (nCols > 0) {
         tableID->cols = (int*)malloc(tableID->nCols*sizeof(int));
         if (NULL != tableID->cols) {
@@ -822,6 +1468,13 @@ void* ModelicaStandardTables_CombiTimeTable_init3(_In_z_ const char* fileName,
         }
     }
 
+#if defined(ASYNC_LOAD)
+    if (NULL != tableID->load) {
+        /* Validation and initialization on first access */
+        return (void*)tableID;
+    }
+#endif
+
     if (isValidCombiTimeTable(tableID, tableName, DO_CLEANUP) == 0) {
         return NULL;
     }
@@ -835,26 +1488,23 @@ void* ModelicaStandardTables_CombiTimeTable_init3(_In_z_ const char* fileName,
         }
     }
     /* Initialization of the cubic Hermite spline coefficients */
-    if (tableID->smoothness == AKIMA_C1) {
-        tableID->spline = akimaSpline1DInit(
-            (const double*)tableID->table, tableID->nRow,
-            tableID->nCol, (const int*)tableID->cols, tableID->nCols);
+#if defined(ARRAY_SHARE)
+    if (NULL != tableID->share) {
+        tableID->spline = (CubicHermite1D*)splineShareAcquire(tableID->share,
+            1, tableID->smoothness, (const int*)tableID->cols, tableID->nCols);
     }
-    else if (tableID->smoothness == MAKIMA_C1) {
-        tableID->spline = makimaSpline1DInit(
-            (const double*)tableID->table, tableID->nRow,
-            tableID->nCol, (const int*)tableID->cols, tableID->nCols);
-    }
-    else if (tableID->smoothness == FRITSCH_BUTLAND_MONOTONE_C1) {
-        tableID->spline = fritschButlandSpline1DInit(
-            (const double*)tableID->table, tableID->nRow,
-            tableID->nCol, (const int*)tableID->cols, tableID->nCols);
-    }
-    else if (tableID->smoothness == STEFFEN_MONOTONE_C1) {
-        tableID->spline = steffenSpline1DInit(
+    else {
+        tableID->spline = spline1DInit(tableID->smoothness,
             (const double*)tableID->table, tableID->nRow,
-            tableID->nCol, (const int*)tableID->cols, tableID->nCols);
+            tableID->rowStride, tableID->colStride,
+            (const int*)tableID->cols, tableID->nCols);
     }
+#else
+    tableID->spline = spline1DInit(tableID->smoothness,
+        (const double*)tableID->table, tableID->nRow,
+        tableID->rowStride, tableID->colStride,
+        (const int*)tableID->cols, tableID->nCols);
+#endif
     if (tableID->smoothness == AKIMA_C1 ||
         tableID->smoothness == MAKIMA_C1 ||
         tableID->smoothness == FRITSCH_BUTLAND_MONOTONE_C1 ||
@@ -865,6 +1515,29 @@ void* ModelicaStandardTables_CombiTimeTable_init3(_In_z_ const char* fileName,
             return NULL;
         }
     }
+    /* Initialization of the event intervals */
+    if (NULL != tableID->table) {
+        tableID->intervals = eventIntervalsInit((const double*)tableID->table,
+            tableID->nRow, tableID->rowStride, tableID->timeEvents,
+            &tableID->maxEvents);
+        if (NULL == tableID->intervals) {
+            ModelicaStandardTables_CombiTimeTable_close(tableID);
+            ModelicaError("Memory allocation error\n");
+            return NULL;
+        }
+    }
+    /* Initialization of the integrals */
+    if (NULL != tableID->table && tableID->nCols > 0) {
+        tableID->integral = integral1DInit(tableID->smoothness,
+            (const double*)tableID->table, tableID->nRow, tableID->rowStride,
+            tableID->colStride, (const int*)tableID->cols, tableID->nCols,
+            (const CubicHermite1D*)tableID->spline);
+        if (NULL == tableID->integral) {
+            ModelicaStandardTables_CombiTimeTable_close(tableID);
+            ModelicaError("Memory allocation error\n");
+            return NULL;
+        }
+    }
 
     return (void*)tableID;
 }
@@ -872,6 +1545,22 @@ void* ModelicaStandardTables_CombiTimeTable_init3(_In_z_ const char* fileName,
 void ModelicaStandardTables_CombiTimeTable_close(void* _tableID) {
     CombiTimeTable* tableID = (CombiTimeTable*)_tableID;
     assert(NULL != tableID);
+#if defined(ASYNC_LOAD)
+    if (NULL != tableID->load) {
+        /* Release pending table file load */
+        tableLoadRelease(tableID->load);
+        tableID->load = NULL;
+    }
+#endif
+#if defined(ARRAY_SHARE)
+    if (NULL != tableID->share) {
+        /* Release shared spline coefficients and table array */
+        arrayShareRelease(tableID->share, (void*)tableID->spline);
+        tableID->share = NULL;
+        tableID->spline = NULL;
+        tableID->table = NULL;
+    }
+#endif
     if (NULL != tableID->table && tableID->source == TABLESOURCE_FILE) {
 #if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
         if (NULL != tableID->key) {
@@ -907,12 +1596,27 @@ void ModelicaStandardTables_CombiTimeTable_close(void* _tableID) {
         tableID->source == TABLESOURCE_FUNCTION_TRANSPOSE)) {
         free(tableID->table);
     }
+#if defined(ASYNC_LOAD)
+    else if (NULL == tableID->table && tableID->source == TABLESOURCE_FILE &&
+        NULL != tableID->key) {
+        /* Table file not loaded */
+        free(tableID->key);
+    }
+#endif
     if (tableID->nCols > 0 && NULL != tableID->cols) {
         free(tableID->cols);
     }
     if (NULL != tableID->intervals) {
         free(tableID->intervals);
     }
+    if (NULL != tableID->integral) {
+        free(tableID->integral);
+    }
+    if (NULL != tableID->group) {
+        EventGroup* group = tableID->group;
+        eventGroupRemove(group, tableID);
+        eventGroupRelease(group);
+    }
     spline1DClose(&tableID->spline);
     free(tableID);
 }
@@ -923,6 +1627,7 @@ double ModelicaStandardTables_CombiTimeTable_getValue(void* _tableID, int iCol,
     double y = 0.;
     CombiTimeTable* tableID = (CombiTimeTable*)_tableID;
     assert(NULL != tableID);
+    FINISH_LOAD(ModelicaStandardTables_CombiTimeTable_read, tableID);
     if (NULL != tableID->table && NULL != tableID->cols &&
         t >= tableID->startTime) {
         if (nextTimeEvent < DBL_MAX && nextTimeEvent == preNextTimeEvent &&
@@ -933,8 +1638,9 @@ double ModelicaStandardTables_CombiTimeTable_getValue(void* _tableID, int iCol,
         else {
             const double* table = tableID->table;
             const size_t nRow = tableID->nRow;
-            const size_t nCol = tableID->nCol;
-            const size_t col = (size_t)tableID->cols[iCol - 1] - 1;
+            const size_t nCol = tableID->rowStride;
+            const size_t col = ((size_t)tableID->cols[iCol - 1] - 1)*
+                tableID->colStride;
 
             if (nRow == 1) {
                 /* Single row */
@@ -951,7 +1657,6 @@ double ModelicaStandardTables_CombiTimeTable_getValue(void* _tableID, int iCol,
 
                 /* Periodic extrapolation */
                 if (tableID->extrapolation == PERIODIC) {
-                    const double T = tMax - tMin;
                     /* Event handling for periodic extrapolation */
                     if (nextTimeEvent == preNextTimeEvent &&
                         tOld >= nextTimeEvent) {
@@ -987,16 +1692,7 @@ double ModelicaStandardTables_CombiTimeTable_getValue(void* _tableID, int iCol,
                             tableID->eventInterval - 1][1];
 
                         t -= tableID->tOffset;
-                        if (t < tMin) {
-                            do {
-                                t += T;
-                            } while (t < tMin);
-                        }
-                        else if (t > tMax) {
-                            do {
-                                t -= T;
-                            } while (t > tMax);
-                        }
+                        t = wrapPeriodic(t, tMin, tMax);
                         last = findRowIndex(table, nRow, nCol, tableID->last, t);
                         tableID->last = last;
                         /* Event interval correction */
@@ -1202,6 +1898,7 @@ double ModelicaStandardTables_CombiTimeTable_getDerValue(void* _tableID, int iCo
     double der_y = 0.;
     CombiTimeTable* tableID = (CombiTimeTable*)_tableID;
     assert(NULL != tableID);
+    FINISH_LOAD(ModelicaStandardTables_CombiTimeTable_read, tableID);
     if (NULL != tableID->table && NULL != tableID->cols &&
         t >= tableID->startTime) {
         if (nextTimeEvent < DBL_MAX && nextTimeEvent == preNextTimeEvent &&
@@ -1212,8 +1909,9 @@ double ModelicaStandardTables_CombiTimeTable_getDerValue(void* _tableID, int iCo
         else {
             const double* table = tableID->table;
             const size_t nRow = tableID->nRow;
-            const size_t nCol = tableID->nCol;
-            const size_t col = (size_t)tableID->cols[iCol - 1] - 1;
+            const size_t nCol = tableID->rowStride;
+            const size_t col = ((size_t)tableID->cols[iCol - 1] - 1)*
+                tableID->colStride;
 
             if (nRow > 1) {
                 enum PointInterval extrapolate = IN_TABLE;
@@ -1227,7 +1925,6 @@ double ModelicaStandardTables_CombiTimeTable_getDerValue(void* _tableID, int iCo
 
                 /* Periodic extrapolation */
                 if (tableID->extrapolation == PERIODIC) {
-                    const double T = tMax - tMin;
                     /* Event handling for periodic extrapolation */
                     if (nextTimeEvent == preNextTimeEvent &&
                         tOld >= nextTimeEvent) {
@@ -1254,16 +1951,7 @@ double ModelicaStandardTables_CombiTimeTable_getDerValue(void* _tableID, int iCo
                             tableID->eventInterval - 1][1];
 
                         t -= tableID->tOffset;
-                        if (t < tMin) {
-                            do {
-                                t += T;
-                            } while (t < tMin);
-                        }
-                        else if (t > tMax) {
-                            do {
-                                t -= T;
-                            } while (t > tMax);
-                        }
+                        t = wrapPeriodic(t, tMin, tMax);
                         last = findRowIndex(
                             table, nRow, nCol, tableID->last, t);
                         tableID->last = last;
@@ -1460,6 +2148,7 @@ double ModelicaStandardTables_CombiTimeTable_getDer2Value(void* _tableID, int iC
     double der2_y = 0.;
     CombiTimeTable* tableID = (CombiTimeTable*)_tableID;
     assert(NULL != tableID);
+    FINISH_LOAD(ModelicaStandardTables_CombiTimeTable_read, tableID);
     if (NULL != tableID->table && NULL != tableID->cols &&
         t >= tableID->startTime) {
         if (nextTimeEvent < DBL_MAX && nextTimeEvent == preNextTimeEvent &&
@@ -1470,8 +2159,9 @@ double ModelicaStandardTables_CombiTimeTable_getDer2Value(void* _tableID, int iC
         else {
             const double* table = tableID->table;
             const size_t nRow = tableID->nRow;
-            const size_t nCol = tableID->nCol;
-            const size_t col = (size_t)tableID->cols[iCol - 1] - 1;
+            const size_t nCol = tableID->rowStride;
+            const size_t col = ((size_t)tableID->cols[iCol - 1] - 1)*
+                tableID->colStride;
 
             if (nRow > 1) {
                 enum PointInterval extrapolate = IN_TABLE;
@@ -1485,7 +2175,6 @@ double ModelicaStandardTables_CombiTimeTable_getDer2Value(void* _tableID, int iC
 
                 /* Periodic extrapolation */
                 if (tableID->extrapolation == PERIODIC) {
-                    const double T = tMax - tMin;
                     /* Event handling for periodic extrapolation */
                     if (nextTimeEvent == preNextTimeEvent &&
                         tOld >= nextTimeEvent) {
@@ -1512,16 +2201,7 @@ double ModelicaStandardTables_CombiTimeTable_getDer2Value(void* _tableID, int iC
                             tableID->eventInterval - 1][1];
 
                         t -= tableID->tOffset;
-                        if (t < tMin) {
-                            do {
-                                t += T;
-                            } while (t < tMin);
-                        }
-                        else if (t > tMax) {
-                            do {
-                                t -= T;
-                            } while (t > tMax);
-                        }
+                        t = wrapPeriodic(t, tMin, tMax);
                         last = findRowIndex(
                             table, nRow, nCol, tableID->last, t);
                         tableID->last = last;
@@ -1710,10 +2390,83 @@ double ModelicaStandardTables_CombiTimeTable_getDer2Value(void* _tableID, int iC
     return der2_y;
 }
 
+double ModelicaStandardTables_CombiTimeTable_getIntegralValue(void* _tableID,
+                                                             int iCol,
+                                                             double t0,
+                                                             double t1) {
+    double F = 0.;
+    CombiTimeTable* tableID = (CombiTimeTable*)_tableID;
+    assert(NULL != tableID);
+    FINISH_LOAD(ModelicaStandardTables_CombiTimeTable_read, tableID);
+    if (NULL != tableID->table && NULL != tableID->cols &&
+        NULL != tableID->integral) {
+        /* Interpolated values are zero before start time */
+        const double ta = t0 > tableID->startTime ? t0 : tableID->startTime;
+        const double tb = t1 > tableID->startTime ? t1 : tableID->startTime;
+        if (ta != tb) {
+            const size_t k = (size_t)(iCol - 1);
+            F = timeTableIntegral(tableID, k, tb - tableID->shiftTime) -
+                timeTableIntegral(tableID, k, ta - tableID->shiftTime);
+        }
+    }
+    return F;
+}
+
+void ModelicaStandardTables_CombiTimeTable_resample(void* _tableID,
+                                                   _In_ const double* t,
+                                                   size_t n, double* y) {
+    CombiTimeTable* tableID = (CombiTimeTable*)_tableID;
+    assert(NULL != tableID);
+    FINISH_LOAD(ModelicaStandardTables_CombiTimeTable_read, tableID);
+    if (NULL != tableID->table && NULL != tableID->cols) {
+        const double* table = tableID->table;
+        const size_t nRow = tableID->nRow;
+        const size_t nCol = tableID->rowStride;
+        const size_t nCols = tableID->nCols;
+        const double tMin = TABLE_ROW0(0);
+        const double tMax = TABLE_COL0(nRow - 1);
+        size_t last = tableID->last;
+        size_t i, k;
+
+        for (i = 0; i < n; i++) {
+            double* yi = &y[IDX(i, 0, nCols)];
+            double ti = t[i] - tableID->shiftTime;
+            if (t[i] < tableID->startTime) {
+                /* Before start time */
+                for (k = 0; k < nCols; k++) {
+                    yi[k] = 0.;
+                }
+            }
+            else if (nRow == 1 || (tableID->extrapolation != PERIODIC &&
+                (ti < tMin || ti > tMax))) {
+                /* Single row or extrapolation (independent of time events) */
+                for (k = 0; k < nCols; k++) {
+                    yi[k] = ModelicaStandardTables_CombiTimeTable_getValue(
+                        tableID, (int)k + 1, t[i], DBL_MAX, DBL_MAX);
+                }
+            }
+            else {
+                if (tableID->extrapolation == PERIODIC) {
+                    ti = wrapPeriodic(ti, tMin, tMax);
+                }
+                last = findRowIndexForward(table, nRow, nCol, last, ti);
+                interpolate1D(tableID->smoothness, table, nCol,
+                    tableID->colStride, (const int*)tableID->cols, nCols,
+                    (const CubicHermite1D*)tableID->spline, last, ti, yi);
+            }
+        }
+        tableID->last = last;
+    }
+    else {
+        memset(y, 0, n*tableID->nCols*sizeof(double));
+    }
+}
+
 double ModelicaStandardTables_CombiTimeTable_minimumTime(void* _tableID) {
     double tMin = 0.;
     CombiTimeTable* tableID = (CombiTimeTable*)_tableID;
     assert(NULL != tableID);
+    FINISH_LOAD(ModelicaStandardTables_CombiTimeTable_read, tableID);
     if (NULL != tableID->table) {
         const double* table = tableID->table;
         tMin = TABLE_ROW0(0);
@@ -1725,9 +2478,10 @@ double ModelicaStandardTables_CombiTimeTable_maximumTime(void* _tableID) {
     double tMax = 0.;
     CombiTimeTable* tableID = (CombiTimeTable*)_tableID;
     assert(NULL != tableID);
+    FINISH_LOAD(ModelicaStandardTables_CombiTimeTable_read, tableID);
     if (NULL != tableID->table) {
         const double* table = tableID->table;
-        const size_t nCol = tableID->nCol;
+        const size_t nCol = tableID->rowStride;
         tMax = TABLE_COL0(tableID->nRow - 1);
     }
     return tMax;
@@ -1738,10 +2492,18 @@ double ModelicaStandardTables_CombiTimeTable_nextTimeEvent(void* _tableID,
     double nextTimeEvent = DBL_MAX;
     CombiTimeTable* tableID = (CombiTimeTable*)_tableID;
     assert(NULL != tableID);
+    FINISH_LOAD(ModelicaStandardTables_CombiTimeTable_read, tableID);
     if (NULL != tableID->table) {
         const double* table = tableID->table;
         const size_t nRow = tableID->nRow;
-        const size_t nCol = tableID->nCol;
+        const size_t nCol = tableID->rowStride;
+
+        if (NULL == tableID->intervals) {
+            /* Should not be possible to get here */
+            ModelicaError(
+                "No event intervals available for detection of time events\n");
+            return nextTimeEvent;
+        }
 
         if (tableID->nEvent > 0) {
             if (t > tableID->preNextTimeEventCalled) {
@@ -1759,85 +2521,6 @@ double ModelicaStandardTables_CombiTimeTable_nextTimeEvent(void* _tableID,
                 return tableID->preNextTimeEvent;
             }
         }
-        else {
-            /* Determine maximum number of time events (per period) */
-            double tEvent = TABLE_ROW0(0);
-            const double tMax = TABLE_COL0(nRow - 1);
-            size_t i, eventInterval;
-
-            /* There is at least one time event at the interval boundaries */
-            tableID->maxEvents = 1;
-            if (tableID->timeEvents == ALWAYS ||
-                tableID->timeEvents == AT_DISCONT) {
-                for (i = 0; i < nRow - 1; i++) {
-                    double t0 = TABLE_COL0(i);
-                    double t1 = TABLE_COL0(i + 1);
-                    if (t1 > tEvent && !isNearlyEqual(t1, tMax)) {
-                        int isEq = isNearlyEqual(t0, t1);
-                        if ((tableID->timeEvents == ALWAYS && !isEq) ||
-                            (tableID->timeEvents == AT_DISCONT && isEq)) {
-                            tEvent = t1;
-                            tableID->maxEvents++;
-                        }
-                    }
-                }
-            }
-            /* Once again with storage of indices of event intervals */
-            tableID->intervals = (Interval*)calloc(tableID->maxEvents,
-                sizeof(Interval));
-            if (NULL == tableID->intervals) {
-                ModelicaError("Memory allocation error\n");
-                return nextTimeEvent;
-            }
-
-            tEvent = TABLE_ROW0(0);
-            eventInterval = 0;
-            if (tableID->timeEvents == ALWAYS ||
-                tableID->timeEvents == AT_DISCONT) {
-                for (i = 0; i < nRow - 1 &&
-                    eventInterval < tableID->maxEvents; i++) {
-                    double t0 = TABLE_COL0(i);
-                    double t1 = TABLE_COL0(i + 1);
-                    if (tableID->timeEvents == ALWAYS) {
-                        if (t1 > tEvent) {
-                            if (!isNearlyEqual(t0, t1)) {
-                                tEvent = t1;
-                                tableID->intervals[eventInterval][0] = i;
-                                tableID->intervals[eventInterval][1] = i + 1;
-                                eventInterval++;
-                            }
-                            else {
-                                tableID->intervals[eventInterval][0] = i + 1;
-                            }
-                        }
-                        else {
-                            tableID->intervals[eventInterval][1] = i + 1;
-                        }
-                    }
-                    else /* if (tableID->timeEvents == AT_DISCONT) */ {
-                        if (t1 > tEvent) {
-                            if (isNearlyEqual(t0, t1)) {
-                                tEvent = t1;
-                                tableID->intervals[eventInterval][1] = i;
-                                eventInterval++;
-                                if (eventInterval < tableID->maxEvents) {
-                                    tableID->intervals[eventInterval][0] = i + 1;
-                                }
-                            }
-                            else {
-                                tableID->intervals[eventInterval][1] = i + 1;
-                            }
-                        }
-                        else {
-                            tableID->intervals[eventInterval][0] = i + 1;
-                        }
-                    }
-                }
-            }
-            else {
-                tableID->intervals[0][1] = nRow - 1;
-            }
-        }
 
         tableID->preNextTimeEventCalled = t;
         if (t < tableID->startTime) {
@@ -1847,18 +2530,28 @@ double ModelicaStandardTables_CombiTimeTable_nextTimeEvent(void* _tableID,
             const double tMin = TABLE_ROW0(0);
             const double tMax = TABLE_COL0(nRow - 1);
             const double T = tMax - tMin;
+            if (tableID->extrapolation == PERIODIC &&
+                tableID->eventInterval > 0 &&
+                t - tableID->preNextTimeEvent > T) {
+                /* Time advanced by more than one period since the previous
+                   time event: Reinitialize instead of stepping through all
+                   intermediate event intervals
+                */
+                tableID->eventInterval = 0;
+            }
             if (tableID->eventInterval == 0) {
                 /* Initialization of event interval */
 #if defined(DEBUG_TIME_EVENTS)
                 const double tOld = t;
 #endif
-                double tEvent = tMin;
-                size_t iStart, iEnd;
+                const size_t maxEvents = tableID->maxEvents;
+                int isInTable = 0;
 
                 t -= tableID->shiftTime;
                 if (tableID->extrapolation == PERIODIC) {
                     /* Initialization of offset time */
-                    tableID->tOffset = floor((t - tMin)/T)*T;
+                    tableID->nPeriod = floor((t - tMin)/T);
+                    tableID->tOffset = tableID->nPeriod*T;
                     t -= tableID->tOffset;
                     if (t < tMin) {
                         t += T;
@@ -1866,73 +2559,43 @@ double ModelicaStandardTables_CombiTimeTable_nextTimeEvent(void* _tableID,
                     else if (t > tMax) {
                         t -= T;
                     }
-                    iStart = findRowIndex(table, nRow, nCol, tableID->last,
-                        t + _EPSILON*T);
-                    nextTimeEvent = tMax;
                     tableID->eventInterval = 1;
-                    iEnd = iStart < (nRow - 1) ? iStart : (nRow - 1);
+                    isInTable = 1;
                 }
                 else if (t >= tMax) {
-                    iStart = nRow - 1;
-                    tableID->eventInterval = tableID->maxEvents + 1;
-                    iEnd = 0;
+                    tableID->eventInterval = maxEvents + 1;
                 }
                 else if (t < tMin) {
-                    iStart = nRow - 1;
                     nextTimeEvent = tMin;
                     tableID->eventInterval = 1;
-                    iEnd = 0;
                 }
                 else if (tableID->smoothness == AKIMA_C1 ||
                     tableID->smoothness == MAKIMA_C1 ||
                     tableID->smoothness == FRITSCH_BUTLAND_MONOTONE_C1 ||
                     tableID->smoothness == STEFFEN_MONOTONE_C1) {
-                    iStart = nRow - 1;
                     nextTimeEvent = tMax;
-                    iEnd = 0;
                 }
                 else {
-                    iStart = findRowIndex(table, nRow, nCol, tableID->last,
-                        t + _EPSILON*T);
-                    nextTimeEvent = tMax;
                     tableID->eventInterval = 2;
-                    iEnd = iStart < (nRow - 1) ? iStart : (nRow - 1);
-                }
-
-                if (tableID->timeEvents == ALWAYS ||
-                    tableID->timeEvents == AT_DISCONT) {
-                    size_t i;
-                    for (i = iStart + 1; i < nRow - 1; i++) {
-                        double t0 = TABLE_COL0(i);
-                        if (t0 > t) {
-                            double t1 = TABLE_COL0(i + 1);
-                            int isEq = isNearlyEqual(t0, t1);
-                            if ((tableID->timeEvents == ALWAYS && !isEq) ||
-                                (tableID->timeEvents == AT_DISCONT && isEq)) {
-                                nextTimeEvent = t0;
-                                break;
-                            }
-                        }
-                    }
+                    isInTable = 1;
+                }
 
-                    for (i = 0; i < iEnd; i++) {
-                        double t0 = TABLE_COL0(i);
-                        double t1 = TABLE_COL0(i + 1);
-                        if (t1 > tEvent && !isNearlyEqual(t1, tMax)) {
-                            int isEq = isNearlyEqual(t0, t1);
-                            if ((tableID->timeEvents == ALWAYS && !isEq) ||
-                                (tableID->timeEvents == AT_DISCONT && isEq)) {
-                                tEvent = t1;
-                                tableID->eventInterval++;
-                            }
-                        }
-                    }
+                if (isInTable) {
+                    /* Binary search for the event interval containing t */
+                    const double tEps = t + _EPSILON*T;
+                    const size_t i = findEventInterval(table, nCol,
+                        (const Interval*)tableID->intervals, 0, maxEvents - 1,
+                        tEps, 0.0, 0.0);
+                    const double tEvent = TABLE_COL0(tableID->intervals[i][1]);
+                    nextTimeEvent = tEvent > tEps ? tEvent : tMax;
+                    tableID->eventInterval += i;
                 }
 
                 if (tableID->extrapolation == PERIODIC) {
                     nextTimeEvent += tableID->tOffset;
-                    if (tableID->eventInterval == tableID->maxEvents) {
-                        tableID->tOffset += T;
+                    if (tableID->eventInterval == maxEvents) {
+                        tableID->nPeriod++;
+                        tableID->tOffset = tableID->nPeriod*T;
                     }
                 }
 #if defined(DEBUG_TIME_EVENTS)
@@ -1942,36 +2605,44 @@ double ModelicaStandardTables_CombiTimeTable_nextTimeEvent(void* _tableID,
                     nextTimeEvent += tableID->shiftTime;
                 }
             }
-            else {
+            else if (tableID->extrapolation == PERIODIC) {
+                const size_t maxEvents = tableID->maxEvents;
                 do {
-                    if (tableID->extrapolation == PERIODIC) {
-                        /* Increment event interval */
-                        tableID->eventInterval =
-                            1 + tableID->eventInterval % tableID->maxEvents;
-                        if (tableID->eventInterval == tableID->maxEvents) {
-                            nextTimeEvent = tMax + tableID->tOffset +
-                                tableID->shiftTime;
-                            tableID->tOffset += T;
-                        }
-                        else {
-                            size_t i = tableID->intervals[
-                                tableID->eventInterval - 1][1];
-                            nextTimeEvent = TABLE_COL0(i) + tableID->tOffset +
-                                tableID->shiftTime;
-                        }
-                    }
-                    else if (tableID->eventInterval <= tableID->maxEvents) {
-                        size_t i = tableID->intervals[
-                            tableID->eventInterval - 1][1];
-                        nextTimeEvent = TABLE_COL0(i) + tableID->shiftTime;
-                        /* Increment event interval */
-                        tableID->eventInterval++;
+                    /* Binary search for the next event interval of the
+                       current period */
+                    const size_t i = findEventInterval(table, nCol,
+                        (const Interval*)tableID->intervals,
+                        tableID->eventInterval % maxEvents, maxEvents - 1, t,
+                        tableID->tOffset, tableID->shiftTime);
+                    if (i < maxEvents - 1) {
+                        tableID->eventInterval = i + 1;
+                        nextTimeEvent = TABLE_COL0(tableID->intervals[i][1]) +
+                            tableID->tOffset + tableID->shiftTime;
                     }
                     else {
-                        nextTimeEvent = DBL_MAX;
+                        tableID->eventInterval = maxEvents;
+                        nextTimeEvent = tMax + tableID->tOffset +
+                            tableID->shiftTime;
+                        tableID->nPeriod++;
+                        tableID->tOffset = tableID->nPeriod*T;
                     }
                 } while (nextTimeEvent <= t);
             }
+            else if (tableID->eventInterval <= tableID->maxEvents) {
+                /* Binary search for the next event interval */
+                const size_t i = findEventInterval(table, nCol,
+                    (const Interval*)tableID->intervals,
+                    tableID->eventInterval - 1, tableID->maxEvents, t, 0.0,
+                    tableID->shiftTime);
+                if (i < tableID->maxEvents) {
+                    nextTimeEvent = TABLE_COL0(tableID->intervals[i][1]) +
+                        tableID->shiftTime;
+                    tableID->eventInterval = i + 2;
+                }
+                else {
+                    tableID->eventInterval = tableID->maxEvents + 1;
+                }
+            }
         }
 
         if (nextTimeEvent > tableID->preNextTimeEvent) {
@@ -2023,25 +2694,43 @@ double ModelicaStandardTables_CombiTimeTable_read(void* _tableID, int force,
         if (force || NULL == tableID->table) {
             const char* fileName = tableID->key;
             const char* tableName = tableID->key + strlen(fileName) + 1;
-#if defined(TABLE_SHARE)
-            TableShare* file = readTable(fileName, tableName, &tableID->nRow,
-                &tableID->nCol, verbose, force, ",", 0);
-            if (NULL != file) {
-                tableID->table = file->table;
+#if defined(ASYNC_LOAD)
+            if (NULL != tableID->load) {
+                /* Take table loaded by a worker thread */
+                TableLoad* load = tableID->load;
+                tableID->load = NULL;
+                if (tableLoadFinish(load, &tableID->key, &tableID->table,
+                    &tableID->nRow, &tableID->nCol) == 0) {
+                    return 0.; /* Error */
+                }
+                tableName = tableID->key + strlen(tableID->key) + 1;
             }
             else {
-                return 0.; /* Error */
-            }
 #else
-            if (NULL != tableID->table) {
-                free(tableID->table);
-            }
-            tableID->table = readTable(fileName, tableName, &tableID->nRow,
-                &tableID->nCol, verbose, force, ",", 0);
+            {
+#endif
+#if defined(TABLE_SHARE)
+                TableShare* file = readTable(fileName, tableName, &tableID->nRow,
+                    &tableID->nCol, verbose, force, ",", 0);
+                if (NULL != file) {
+                    tableID->table = file->table;
+                }
+                else {
+                    return 0.; /* Error */
+                }
+#else
+                if (NULL != tableID->table) {
+                    free(tableID->table);
+                }
+                tableID->table = readTable(fileName, tableName, &tableID->nRow,
+                    &tableID->nCol, verbose, force, ",", 0);
 #endif
+            }
             if (NULL == tableID->table) {
                 return 0.; /* Error */
             }
+            tableID->rowStride = tableID->nCol;
+            tableID->colStride = 1;
             if (isValidCombiTimeTable(tableID, tableName, NO_CLEANUP) == 0) {
                 return 0.; /* Error */
             }
@@ -2054,30 +2743,11 @@ double ModelicaStandardTables_CombiTimeTable_read(void* _tableID, int force,
                 }
             }
             /* Reinitialization of the cubic Hermite spline coefficients */
-            if (tableID->smoothness == AKIMA_C1) {
-                spline1DClose(&tableID->spline);
-                tableID->spline = akimaSpline1DInit(
-                    (const double*)tableID->table, tableID->nRow,
-                    tableID->nCol, (const int*)tableID->cols, tableID->nCols);
-            }
-            else if (tableID->smoothness == MAKIMA_C1) {
-                spline1DClose(&tableID->spline);
-                tableID->spline = makimaSpline1DInit(
-                    (const double*)tableID->table, tableID->nRow,
-                    tableID->nCol, (const int*)tableID->cols, tableID->nCols);
-            }
-            else if (tableID->smoothness == FRITSCH_BUTLAND_MONOTONE_C1) {
-                spline1DClose(&tableID->spline);
-                tableID->spline = fritschButlandSpline1DInit(
-                    (const double*)tableID->table, tableID->nRow,
-                    tableID->nCol, (const int*)tableID->cols, tableID->nCols);
-            }
-            else if (tableID->smoothness == STEFFEN_MONOTONE_C1) {
-                spline1DClose(&tableID->spline);
-                tableID->spline = steffenSpline1DInit(
-                    (const double*)tableID->table, tableID->nRow,
-                    tableID->nCol, (const int*)tableID->cols, tableID->nCols);
-            }
+            spline1DClose(&tableID->spline);
+            tableID->spline = spline1DInit(tableID->smoothness,
+                (const double*)tableID->table, tableID->nRow,
+                tableID->rowStride, tableID->colStride,
+                (const int*)tableID->cols, tableID->nCols);
             if (tableID->smoothness == AKIMA_C1 ||
                 tableID->smoothness == MAKIMA_C1 ||
                 tableID->smoothness == FRITSCH_BUTLAND_MONOTONE_C1 ||
@@ -2087,12 +2757,115 @@ double ModelicaStandardTables_CombiTimeTable_read(void* _tableID, int force,
                     return 0.; /* Error */
                 }
             }
+            /* Reinitialization of the event intervals */
+            if (NULL != tableID->intervals) {
+                free(tableID->intervals);
+            }
+            tableID->intervals = eventIntervalsInit(
+                (const double*)tableID->table, tableID->nRow,
+                tableID->rowStride, tableID->timeEvents, &tableID->maxEvents);
+            if (NULL == tableID->intervals) {
+                ModelicaError("Memory allocation error\n");
+                return 0.; /* Error */
+            }
+            /* Force reinitialization of event interval */
+            tableID->eventInterval = 0;
+            /* Reinitialization of the integrals */
+            if (tableID->nCols > 0) {
+                if (NULL != tableID->integral) {
+                    free(tableID->integral);
+                }
+                tableID->integral = integral1DInit(tableID->smoothness,
+                    (const double*)tableID->table, tableID->nRow,
+                    tableID->rowStride, tableID->colStride,
+                    (const int*)tableID->cols, tableID->nCols,
+                    (const CubicHermite1D*)tableID->spline);
+                if (NULL == tableID->integral) {
+                    ModelicaError("Memory allocation error\n");
+                    return 0.; /* Error */
+                }
+            }
         }
     }
 #endif
     return 1.; /* Success */
 }
 
+void ModelicaStandardTables_CombiTimeTable_joinGroup(void* _tableID,
+                                                     void* _groupID) {
+    CombiTimeTable* tableID = (CombiTimeTable*)_tableID;
+    EventGroup* group = (EventGroup*)_groupID;
+    assert(NULL != tableID);
+    assert(NULL != group);
+    if (group == tableID->group) {
+        /* Already member of group */
+        return;
+    }
+    group->refCount++;
+    if (NULL != tableID->group) {
+        /* Leave previous group */
+        EventGroup* preGroup = tableID->group;
+        eventGroupRemove(preGroup, tableID);
+        eventGroupRelease(preGroup);
+    }
+    if (eventGroupAdd(group, tableID) == 0) {
+        eventGroupRelease(group);
+        ModelicaError("Memory allocation error\n");
+    }
+}
+
+void* ModelicaStandardTables_group_init(void) {
+    EventGroup* group = (EventGroup*)calloc(1, sizeof(EventGroup));
+    if (NULL == group) {
+        ModelicaError("Memory allocation error\n");
+        return NULL;
+    }
+    group->refCount = 1;
+    group->preNextTimeEventCalled = -DBL_MAX;
+    return (void*)group;
+}
+
+void ModelicaStandardTables_group_close(void* _groupID) {
+    EventGroup* group = (EventGroup*)_groupID;
+    assert(NULL != group);
+    eventGroupRelease(group);
+}
+
+double ModelicaStandardTables_group_nextTimeEvent(void* _groupID, double t) {
+    EventGroup* group = (EventGroup*)_groupID;
+    size_t nUpdate;
+    assert(NULL != group);
+    if (0 == group->nMember) {
+        return DBL_MAX;
+    }
+
+    if (t < group->preNextTimeEventCalled) {
+        /* Time went backwards: Reinitialize all member tables and rebuild
+           the heap */
+        size_t i;
+        for (i = 0; i < group->nMember; i++) {
+            group->heap[i].nextTimeEvent =
+                ModelicaStandardTables_CombiTimeTable_nextTimeEvent(
+                group->heap[i].tableID, t);
+        }
+        for (i = group->nMember/2; i > 0; i--) {
+            eventGroupSiftDown(group, i - 1);
+        }
+    }
+    group->preNextTimeEventCalled = t;
+
+    /* Only advance the member tables whose next time event is reached, each
+       at most once per call */
+    for (nUpdate = 0; nUpdate < group->nMember &&
+        group->heap[0].nextTimeEvent <= t; nUpdate++) {
+        group->heap[0].nextTimeEvent =
+            ModelicaStandardTables_CombiTimeTable_nextTimeEvent(
+            group->heap[0].tableID, t);
+        eventGroupSiftDown(group, 0);
+    }
+    return group->heap[0].nextTimeEvent;
+}
+
 void* ModelicaStandardTables_CombiTable1D_init(_In_z_ const char* tableName,
                                                _In_z_ const char* fileName,
                                                _In_ const double* table, size_t nRow,
@@ -2131,6 +2904,9 @@ void* ModelicaStandardTables_CombiTable1D_init3(_In_z_ const char* fileName,
 #if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
     TableShare* file = NULL;
     char* keyFile = NULL;
+#endif
+#if defined(ASYNC_LOAD)
+    TableLoad* load = NULL;
 #endif
     double* tableFile = NULL;
     size_t nRowFile = 0;
@@ -2138,7 +2914,16 @@ void* ModelicaStandardTables_CombiTable1D_init3(_In_z_ const char* fileName,
     enum TableSource source = getTableSource(fileName, tableName);
 
     /* Read table from file before any other heap allocation */
+#if defined(ASYNC_LOAD)
     if (TABLESOURCE_FILE == source) {
+        /* Queue table file for loading by a worker thread */
+        load = tableLoadStart(fileName, tableName, verbose, delimiter,
+            nHeaderLines);
+    }
+    if (TABLESOURCE_FILE == source && NULL == load) {
+#else
+    if (TABLESOURCE_FILE == source) {
+#endif
 #if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
         file = readTable(fileName, tableName, &nRowFile, &nColFile, verbose, 0, delimiter, nHeaderLines);
         if (NULL != file) {
@@ -2173,6 +2958,11 @@ void* ModelicaStandardTables_CombiTable1D_init3(_In_z_ const char* fileName,
         if (NULL != tableFile) {
             free(tableFile);
         }
+#endif
+#if defined(ASYNC_LOAD)
+        if (NULL != load) {
+            tableLoadRelease(load);
+        }
 #endif
         ModelicaError("Memory allocation error\n");
         return NULL;
@@ -2185,6 +2975,23 @@ void* ModelicaStandardTables_CombiTable1D_init3(_In_z_ const char* fileName,
 
     switch (tableID->source) {
         case TABLESOURCE_FILE:
+#if defined(ASYNC_LOAD)
+            if (NULL != load) {
+                size_t lenFileName = strlen(fileName);
+                tableID->load = load;
+                tableID->key = (char*)malloc((lenFileName + strlen(tableName) + 2)*sizeof(char));
+                if (NULL != tableID->key) {
+                    strcpy(tableID->key, fileName);
+                    strcpy(tableID->key + lenFileName + 1, tableName);
+                }
+                else {
+                    ModelicaStandardTables_CombiTable1D_close(tableID);
+                    ModelicaError("Memory allocation error\n");
+                    return NULL;
+                }
+                break;
+            }
+#endif
 #if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
             tableID->key = keyFile;
 #else
@@ -2208,6 +3015,13 @@ void* ModelicaStandardTables_CombiTable1D_init3(_In_z_ const char* fileName,
 #if defined(NO_TABLE_COPY)
             tableID->table = table;
 #else
+#if defined(ARRAY_SHARE)
+            tableID->share = arrayShareAcquire(table, nRow, nColumn);
+            if (NULL != tableID->share) {
+                tableID->table = tableID->share->table;
+                break;
+            }
+#endif
             tableID->table = (double*)malloc(nRow*nColumn*sizeof(double));
             if (NULL != tableID->table) {
                 memcpy(tableID->table, table, nRow*nColumn*sizeof(double));
@@ -2229,18 +3043,24 @@ void* ModelicaStandardTables_CombiTable1D_init3(_In_z_ const char* fileName,
                     tableID->nRow = (size_t)dim[0];
                     tableID->nCol = (size_t)dim[1];
                 }
+                else if (3 == colWise) {
+                    /* Interpolate in place with column-wise strides */
+                    tableID->nRow = (size_t)dim[1];
+                    tableID->nCol = (size_t)dim[0];
+                    tableID->rowStride = 1;
+                    tableID->colStride = tableID->nRow;
+                }
                 else {
                     /* Need to transpose */
                     double* tableT = (double*)malloc(
                         (size_t)dim[0]*(size_t)dim[1]*sizeof(double));
                     if (NULL != tableT) {
-                        memcpy(tableT, tableID->table,
-                            (size_t)dim[0]*(size_t)dim[1]*sizeof(double));
+                        ModelicaIO_transposeRealMatrix(tableID->table,
+                            (size_t)dim[0], (size_t)dim[1], tableT);
                         tableID->table = tableT;
                         tableID->nRow = (size_t)dim[1];
                         tableID->nCol = (size_t)dim[0];
                         tableID->source = TABLESOURCE_FUNCTION_TRANSPOSE;
-                        transpose(tableID->table, tableID->nRow, tableID->nCol);
                     }
                     else {
                         ModelicaStandardTables_CombiTable1D_close(tableID);
@@ -2262,6 +3082,12 @@ void* ModelicaStandardTables_CombiTable1D_init3(_In_z_ const char* fileName,
             return NULL;
     }
 
+    if (0 == tableID->colStride) {
+        /* Table stored row-wise */
+        tableID->rowStride = tableID->nCol;
+        tableID->colStride = 1;
+    }
+
     if (nCols > 0) {
         tableID->cols = (int*)malloc(tableID->nCols*sizeof(int));
         if (NULL != tableID->cols) {
@@ -2274,6 +3100,13 @@ void* ModelicaStandardTables_CombiTable1D_init3(_In_z_ const char* fileName,
         }
     }
 
+#if defined(ASYNC_LOAD)
+    if (NULL != tableID->load) {
+        /* Validation and initialization on first access */
+        return (void*)tableID;
+    }
+#endif
+
     if (isValidCombiTable1D(tableID, tableName, DO_CLEANUP) == 0) {
         return NULL;
     }
@@ -2287,26 +3120,23 @@ void* ModelicaStandardTables_CombiTable1D_init3(_In_z_ const char* fileName,
         }
     }
     /* Initialization of the cubic Hermite spline coefficients */
-    if (tableID->smoothness == AKIMA_C1) {
-        tableID->spline = akimaSpline1DInit(
-            (const double*)tableID->table, tableID->nRow,
-            tableID->nCol, (const int*)tableID->cols, tableID->nCols);
-    }
-    else if (tableID->smoothness == MAKIMA_C1) {
-        tableID->spline = makimaSpline1DInit(
-            (const double*)tableID->table, tableID->nRow,
-            tableID->nCol, (const int*)tableID->cols, tableID->nCols);
-    }
-    else if (tableID->smoothness == FRITSCH_BUTLAND_MONOTONE_C1) {
-        tableID->spline = fritschButlandSpline1DInit(
-            (const double*)tableID->table, tableID->nRow,
-            tableID->nCol, (const int*)tableID->cols, tableID->nCols);
+#if defined(ARRAY_SHARE)
+    if (NULL != tableID->share) {
+        tableID->spline = (CubicHermite1D*)splineShareAcquire(tableID->share,
+            1, tableID->smoothness, (const int*)tableID->cols, tableID->nCols);
     }
-    else if (tableID->smoothness == STEFFEN_MONOTONE_C1) {
-        tableID->spline = steffenSpline1DInit(
+    else {
+        tableID->spline = spline1DInit(tableID->smoothness,
             (const double*)tableID->table, tableID->nRow,
-            tableID->nCol, (const int*)tableID->cols, tableID->nCols);
+            tableID->rowStride, tableID->colStride,
+            (const int*)tableID->cols, tableID->nCols);
     }
+#else
+    tableID->spline = spline1DInit(tableID->smoothness,
+        (const double*)tableID->table, tableID->nRow,
+        tableID->rowStride, tableID->colStride,
+        (const int*)tableID->cols, tableID->nCols);
+#endif
     if (tableID->smoothness == AKIMA_C1 ||
         tableID->smoothness == MAKIMA_C1 ||
         tableID->smoothness == FRITSCH_BUTLAND_MONOTONE_C1 ||
@@ -2317,6 +3147,16 @@ void* ModelicaStandardTables_CombiTable1D_init3(_In_z_ const char* fileName,
             return NULL;
         }
     }
+    if (tableID->nCols > 0) {
+        tableID->monotone = monotonicity1DInit((const double*)tableID->table,
+            tableID->nRow, tableID->rowStride, tableID->colStride,
+            (const int*)tableID->cols, tableID->nCols);
+        if (NULL == tableID->monotone) {
+            ModelicaStandardTables_CombiTable1D_close(tableID);
+            ModelicaError("Memory allocation error\n");
+            return NULL;
+        }
+    }
 
     return (void*)tableID;
 }
@@ -2324,6 +3164,22 @@ void* ModelicaStandardTables_CombiTable1D_init3(_In_z_ const char* fileName,
 void ModelicaStandardTables_CombiTable1D_close(void* _tableID) {
     CombiTable1D* tableID = (CombiTable1D*)_tableID;
     assert(NULL != tableID);
+#if defined(ASYNC_LOAD)
+    if (NULL != tableID->load) {
+        /* Release pending table file load */
+        tableLoadRelease(tableID->load);
+        tableID->load = NULL;
+    }
+#endif
+#if defined(ARRAY_SHARE)
+    if (NULL != tableID->share) {
+        /* Release shared spline coefficients and table array */
+        arrayShareRelease(tableID->share, (void*)tableID->spline);
+        tableID->share = NULL;
+        tableID->spline = NULL;
+        tableID->table = NULL;
+    }
+#endif
     if (NULL != tableID->table && tableID->source == TABLESOURCE_FILE) {
 #if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
         if (NULL != tableID->key) {
@@ -2359,9 +3215,19 @@ void ModelicaStandardTables_CombiTable1D_close(void* _tableID) {
         tableID->source == TABLESOURCE_FUNCTION_TRANSPOSE)) {
         free(tableID->table);
     }
+#if defined(ASYNC_LOAD)
+    else if (NULL == tableID->table && tableID->source == TABLESOURCE_FILE &&
+        NULL != tableID->key) {
+        /* Table file not loaded */
+        free(tableID->key);
+    }
+#endif
     if (tableID->nCols > 0 && NULL != tableID->cols) {
         free(tableID->cols);
     }
+    if (NULL != tableID->monotone) {
+        free(tableID->monotone);
+    }
     spline1DClose(&tableID->spline);
     free(tableID);
 }
@@ -2371,11 +3237,13 @@ double ModelicaStandardTables_CombiTable1D_getValue(void* _tableID, int iCol,
     double y = 0.;
     CombiTable1D* tableID = (CombiTable1D*)_tableID;
     assert(NULL != tableID);
+    FINISH_LOAD(ModelicaStandardTables_CombiTable1D_read, tableID);
     if (NULL != tableID->table && NULL != tableID->cols) {
         const double* table = tableID->table;
         const size_t nRow = tableID->nRow;
-        const size_t nCol = tableID->nCol;
-        const size_t col = (size_t)tableID->cols[iCol - 1] - 1;
+        const size_t nCol = tableID->rowStride;
+        const size_t col = ((size_t)tableID->cols[iCol - 1] - 1)*
+            tableID->colStride;
 
         if (nRow == 1) {
             /* Single row */
@@ -2389,18 +3257,7 @@ double ModelicaStandardTables_CombiTable1D_getValue(void* _tableID, int iCol,
 
             /* Periodic extrapolation */
             if (tableID->extrapolation == PERIODIC) {
-                const double T = uMax - uMin;
-
-                if (u < uMin) {
-                    do {
-                        u += T;
-                    } while (u < uMin);
-                }
-                else if (u > uMax) {
-                    do {
-                        u -= T;
-                    } while (u > uMax);
-                }
+                u = wrapPeriodic(u, uMin, uMax);
                 last = findRowIndex(table, nRow, nCol, tableID->last, u);
                 tableID->last = last;
             }
@@ -2526,11 +3383,13 @@ double ModelicaStandardTables_CombiTable1D_getDerValue(void* _tableID, int iCol,
     double der_y = 0.;
     CombiTable1D* tableID = (CombiTable1D*)_tableID;
     assert(NULL != tableID);
+    FINISH_LOAD(ModelicaStandardTables_CombiTable1D_read, tableID);
     if (NULL != tableID->table && NULL != tableID->cols) {
         const double* table = tableID->table;
         const size_t nRow = tableID->nRow;
-        const size_t nCol = tableID->nCol;
-        const size_t col = (size_t)tableID->cols[iCol - 1] - 1;
+        const size_t nCol = tableID->rowStride;
+        const size_t col = ((size_t)tableID->cols[iCol - 1] - 1)*
+            tableID->colStride;
 
         if (nRow > 1) {
             enum PointInterval extrapolate = IN_TABLE;
@@ -2540,18 +3399,7 @@ double ModelicaStandardTables_CombiTable1D_getDerValue(void* _tableID, int iCol,
 
             /* Periodic extrapolation */
             if (tableID->extrapolation == PERIODIC) {
-                const double T = uMax - uMin;
-
-                if (u < uMin) {
-                    do {
-                        u += T;
-                    } while (u < uMin);
-                }
-                else if (u > uMax) {
-                    do {
-                        u -= T;
-                    } while (u > uMax);
-                }
+                u = wrapPeriodic(u, uMin, uMax);
                 last = findRowIndex(table, nRow, nCol, tableID->last, u);
                 tableID->last = last;
             }
@@ -2669,11 +3517,13 @@ double ModelicaStandardTables_CombiTable1D_getDer2Value(void* _tableID, int iCol
     double der2_y = 0.;
     CombiTable1D* tableID = (CombiTable1D*)_tableID;
     assert(NULL != tableID);
+    FINISH_LOAD(ModelicaStandardTables_CombiTable1D_read, tableID);
     if (NULL != tableID->table && NULL != tableID->cols) {
         const double* table = tableID->table;
         const size_t nRow = tableID->nRow;
-        const size_t nCol = tableID->nCol;
-        const size_t col = (size_t)tableID->cols[iCol - 1] - 1;
+        const size_t nCol = tableID->rowStride;
+        const size_t col = ((size_t)tableID->cols[iCol - 1] - 1)*
+            tableID->colStride;
 
         if (nRow > 1) {
             enum PointInterval extrapolate = IN_TABLE;
@@ -2683,18 +3533,7 @@ double ModelicaStandardTables_CombiTable1D_getDer2Value(void* _tableID, int iCol
 
             /* Periodic extrapolation */
             if (tableID->extrapolation == PERIODIC) {
-                const double T = uMax - uMin;
-
-                if (u < uMin) {
-                    do {
-                        u += T;
-                    } while (u < uMin);
-                }
-                else if (u > uMax) {
-                    do {
-                        u -= T;
-                    } while (u > uMax);
-                }
+                u = wrapPeriodic(u, uMin, uMax);
                 last = findRowIndex(table, nRow, nCol, tableID->last, u);
                 tableID->last = last;
             }
@@ -2807,10 +3646,171 @@ double ModelicaStandardTables_CombiTable1D_getDer2Value(void* _tableID, int iCol
     return der2_y;
 }
 
+double ModelicaStandardTables_CombiTable1D_getInverseValue(void* _tableID,
+                                                           int iCol, double y) {
+    double u = 0.;
+    CombiTable1D* tableID = (CombiTable1D*)_tableID;
+    assert(NULL != tableID);
+    FINISH_LOAD(ModelicaStandardTables_CombiTable1D_read, tableID);
+    if (NULL != tableID->table && NULL != tableID->cols &&
+        NULL != tableID->monotone) {
+        const double* table = tableID->table;
+        const size_t nRow = tableID->nRow;
+        const size_t nCol = tableID->rowStride;
+        const size_t col = ((size_t)tableID->cols[iCol - 1] - 1)*
+            tableID->colStride;
+        /* Sign of monotonicity, such that m*y is increasing with u */
+        const int m = tableID->monotone[iCol - 1];
+        enum PointInterval extrapolate = IN_TABLE;
+        size_t last;
+
+        if (m == 0) {
+            ModelicaFormatError("The values of column %d of the table are "
+                "not strictly monotonic, such that the inverse interpolation "
+                "is not defined.\n", tableID->cols[iCol - 1]);
+            return u;
+        }
+
+        if (m*y < m*TABLE(0, col)) {
+            extrapolate = LEFT;
+            last = 0;
+        }
+        else if (m*y > m*TABLE(nRow - 1, col)) {
+            extrapolate = RIGHT;
+            last = nRow - 2;
+        }
+        else {
+            /* Binary search in column */
+            size_t i0 = 0;
+            size_t i1 = nRow - 1;
+            while (i1 > i0 + 1) {
+                const size_t i = (i0 + i1)/2;
+                if (m*y <= m*TABLE(i, col)) {
+                    i1 = i;
+                }
+                else {
+                    i0 = i;
+                }
+            }
+            last = i0;
+        }
+
+        if (extrapolate != IN_TABLE && tableID->extrapolation != LAST_TWO_POINTS) {
+            const double y0 = TABLE(0, col);
+            const double y1 = TABLE(nRow - 1, col);
+            ModelicaFormatError("Extrapolation error: The value y (=%lf) must "
+                "be in the range [%lf, %lf]\nof the values of column %d "
+                "defined in the table.\n", y, y0 < y1 ? y0 : y1,
+                y0 < y1 ? y1 : y0, tableID->cols[iCol - 1]);
+            return u;
+        }
+
+        switch (tableID->smoothness) {
+            case LINEAR_SEGMENTS: {
+                const double u0 = TABLE_COL0(last);
+                const double u1 = TABLE_COL0(last + 1);
+                const double y0 = TABLE(last, col);
+                const double y1 = TABLE(last + 1, col);
+                u = u0 + (u1 - u0)*(y - y0)/(y1 - y0);
+                break;
+            }
+
+            case CONSTANT_SEGMENTS:
+                ModelicaError("The inverse interpolation is not defined for "
+                    "constant segments.\n");
+                return u;
+
+            case AKIMA_C1:
+            case MAKIMA_C1:
+            case FRITSCH_BUTLAND_MONOTONE_C1:
+            case STEFFEN_MONOTONE_C1:
+                if (NULL != tableID->spline) {
+                    const double* c = tableID->spline[
+                        IDX(last, (size_t)(iCol - 1), tableID->nCols)];
+                    const double u0 = TABLE_COL0(last);
+                    const double dx = TABLE_COL0(last + 1) - u0;
+                    if (extrapolate == IN_TABLE) {
+                        /* Cubic polynomial in normalized abscissa v/dx */
+                        u = u0 + dx*solveCubic(c[0]*dx*dx*dx, c[1]*dx*dx,
+                            c[2]*dx, TABLE(last, col) - y);
+                    }
+                    else {
+                        /* Inverse of linear extrapolation */
+                        const double dy_du = (extrapolate == LEFT) ? c[2] :
+                            (3*c[0]*dx + 2*c[1])*dx + c[2];
+                        const size_t i = (extrapolate == LEFT) ? 0 : nRow - 1;
+                        if (!(m*dy_du > 0)) {
+                            ModelicaFormatError("Extrapolation error: The "
+                                "inverse interpolation of column %d is not "
+                                "defined for y (=%lf), since the linear "
+                                "extrapolation at the %s abscissa value is "
+                                "not strictly monotonic like the column.\n",
+                                tableID->cols[iCol - 1], y,
+                                (extrapolate == LEFT) ? "minimum" : "maximum");
+                            return u;
+                        }
+                        u = TABLE_COL0(i) + (y - TABLE(i, col))/dy_du;
+                    }
+                }
+                break;
+
+            default:
+                ModelicaError("Unknown smoothness kind\n");
+                return u;
+        }
+    }
+    return u;
+}
+
+void ModelicaStandardTables_CombiTable1D_resample(void* _tableID,
+                                                 _In_ const double* u,
+                                                 size_t n, double* y) {
+    CombiTable1D* tableID = (CombiTable1D*)_tableID;
+    assert(NULL != tableID);
+    FINISH_LOAD(ModelicaStandardTables_CombiTable1D_read, tableID);
+    if (NULL != tableID->table && NULL != tableID->cols) {
+        const double* table = tableID->table;
+        const size_t nRow = tableID->nRow;
+        const size_t nCol = tableID->rowStride;
+        const size_t nCols = tableID->nCols;
+        const double uMin = TABLE_ROW0(0);
+        const double uMax = TABLE_COL0(nRow - 1);
+        size_t last = tableID->last;
+        size_t i, k;
+
+        for (i = 0; i < n; i++) {
+            double* yi = &y[IDX(i, 0, nCols)];
+            double ui = u[i];
+            if (nRow == 1 || (tableID->extrapolation != PERIODIC &&
+                (ui < uMin || ui > uMax))) {
+                /* Single row or extrapolation */
+                for (k = 0; k < nCols; k++) {
+                    yi[k] = ModelicaStandardTables_CombiTable1D_getValue(
+                        tableID, (int)k + 1, ui);
+                }
+            }
+            else {
+                if (tableID->extrapolation == PERIODIC) {
+                    ui = wrapPeriodic(ui, uMin, uMax);
+                }
+                last = findRowIndexForward(table, nRow, nCol, last, ui);
+                interpolate1D(tableID->smoothness, table, nCol,
+                    tableID->colStride, (const int*)tableID->cols, nCols,
+                    (const CubicHermite1D*)tableID->spline, last, ui, yi);
+            }
+        }
+        tableID->last = last;
+    }
+    else {
+        memset(y, 0, n*tableID->nCols*sizeof(double));
+    }
+}
+
 double ModelicaStandardTables_CombiTable1D_minimumAbscissa(void* _tableID) {
     double uMin = 0.;
     CombiTable1D* tableID = (CombiTable1D*)_tableID;
     assert(NULL != tableID);
+    FINISH_LOAD(ModelicaStandardTables_CombiTable1D_read, tableID);
     if (NULL != tableID->table) {
         const double* table = tableID->table;
         uMin = TABLE_ROW0(0);
@@ -2822,9 +3822,10 @@ double ModelicaStandardTables_CombiTable1D_maximumAbscissa(void* _tableID) {
     double uMax = 0.;
     CombiTable1D* tableID = (CombiTable1D*)_tableID;
     assert(NULL != tableID);
+    FINISH_LOAD(ModelicaStandardTables_CombiTable1D_read, tableID);
     if (NULL != tableID->table) {
         const double* table = tableID->table;
-        const size_t nCol = tableID->nCol;
+        const size_t nCol = tableID->rowStride;
         uMax = TABLE_COL0(tableID->nRow - 1);
     }
     return uMax;
@@ -2839,25 +3840,43 @@ double ModelicaStandardTables_CombiTable1D_read(void* _tableID, int force,
         if (force || NULL == tableID->table) {
             const char* fileName = tableID->key;
             const char* tableName = tableID->key + strlen(fileName) + 1;
-#if defined(TABLE_SHARE)
-            TableShare* file = readTable(fileName, tableName, &tableID->nRow,
-                &tableID->nCol, verbose, force, ",", 0);
-            if (NULL != file) {
-                tableID->table = file->table;
+#if defined(ASYNC_LOAD)
+            if (NULL != tableID->load) {
+                /* Take table loaded by a worker thread */
+                TableLoad* load = tableID->load;
+                tableID->load = NULL;
+                if (tableLoadFinish(load, &tableID->key, &tableID->table,
+                    &tableID->nRow, &tableID->nCol) == 0) {
+                    return 0.; /* Error */
+                }
+                tableName = tableID->key + strlen(tableID->key) + 1;
             }
             else {
-                return 0.; /* Error */
-            }
 #else
-            if (NULL != tableID->table) {
-                free(tableID->table);
-            }
-            tableID->table = readTable(fileName, tableName, &tableID->nRow,
-                &tableID->nCol, verbose, force, ",", 0);
+            {
+#endif
+#if defined(TABLE_SHARE)
+                TableShare* file = readTable(fileName, tableName, &tableID->nRow,
+                    &tableID->nCol, verbose, force, ",", 0);
+                if (NULL != file) {
+                    tableID->table = file->table;
+                }
+                else {
+                    return 0.; /* Error */
+                }
+#else
+                if (NULL != tableID->table) {
+                    free(tableID->table);
+                }
+                tableID->table = readTable(fileName, tableName, &tableID->nRow,
+                    &tableID->nCol, verbose, force, ",", 0);
 #endif
+            }
             if (NULL == tableID->table) {
                 return 0.; /* Error */
             }
+            tableID->rowStride = tableID->nCol;
+            tableID->colStride = 1;
             if (isValidCombiTable1D(tableID, tableName, NO_CLEANUP) == 0) {
                 return 0.; /* Error */
             }
@@ -2870,30 +3889,11 @@ double ModelicaStandardTables_CombiTable1D_read(void* _tableID, int force,
                 }
             }
             /* Reinitialization of the cubic Hermite spline coefficients */
-            if (tableID->smoothness == AKIMA_C1) {
-                spline1DClose(&tableID->spline);
-                tableID->spline = akimaSpline1DInit(
-                    (const double*)tableID->table, tableID->nRow,
-                    tableID->nCol, (const int*)tableID->cols, tableID->nCols);
-            }
-            else if (tableID->smoothness == MAKIMA_C1) {
-                spline1DClose(&tableID->spline);
-                tableID->spline = makimaSpline1DInit(
-                    (const double*)tableID->table, tableID->nRow,
-                    tableID->nCol, (const int*)tableID->cols, tableID->nCols);
-            }
-            else if (tableID->smoothness == FRITSCH_BUTLAND_MONOTONE_C1) {
-                spline1DClose(&tableID->spline);
-                tableID->spline = fritschButlandSpline1DInit(
-                    (const double*)tableID->table, tableID->nRow,
-                    tableID->nCol, (const int*)tableID->cols, tableID->nCols);
-            }
-            else if (tableID->smoothness == STEFFEN_MONOTONE_C1) {
-                spline1DClose(&tableID->spline);
-                tableID->spline = steffenSpline1DInit(
-                    (const double*)tableID->table, tableID->nRow,
-                    tableID->nCol, (const int*)tableID->cols, tableID->nCols);
-            }
+            spline1DClose(&tableID->spline);
+            tableID->spline = spline1DInit(tableID->smoothness,
+                (const double*)tableID->table, tableID->nRow,
+                tableID->rowStride, tableID->colStride,
+                (const int*)tableID->cols, tableID->nCols);
             if (tableID->smoothness == AKIMA_C1 ||
                 tableID->smoothness == MAKIMA_C1 ||
                 tableID->smoothness == FRITSCH_BUTLAND_MONOTONE_C1 ||
@@ -2903,6 +3903,20 @@ double ModelicaStandardTables_CombiTable1D_read(void* _tableID, int force,
                     return 0.; /* Error */
                 }
             }
+            /* Redetermination of the monotonicity */
+            if (tableID->nCols > 0) {
+                if (NULL != tableID->monotone) {
+                    free(tableID->monotone);
+                }
+                tableID->monotone = monotonicity1DInit(
+                    (const double*)tableID->table, tableID->nRow,
+                    tableID->rowStride, tableID->colStride,
+                    (const int*)tableID->cols, tableID->nCols);
+                if (NULL == tableID->monotone) {
+                    ModelicaError("Memory allocation error\n");
+                    return 0.; /* Error */
+                }
+            }
         }
     }
 #endif
@@ -2939,6 +3953,9 @@ void* ModelicaStandardTables_CombiTable2D_init3(_In_z_ const char* fileName,
 #if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
     TableShare* file = NULL;
     char* keyFile = NULL;
+#endif
+#if defined(ASYNC_LOAD)
+    TableLoad* load = NULL;
 #endif
     double* tableFile = NULL;
     size_t nRowFile = 0;
@@ -2946,7 +3963,16 @@ void* ModelicaStandardTables_CombiTable2D_init3(_In_z_ const char* fileName,
     enum TableSource source = getTableSource(fileName, tableName);
 
     /* Read table from file before any other heap allocation */
+#if defined(ASYNC_LOAD)
+    if (TABLESOURCE_FILE == source) {
+        /* Queue table file for loading by a worker thread */
+        load = tableLoadStart(fileName, tableName, verbose, delimiter,
+            nHeaderLines);
+    }
+    if (TABLESOURCE_FILE == source && NULL == load) {
+#else
     if (TABLESOURCE_FILE == source) {
+#endif
 #if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
         file = readTable(fileName, tableName, &nRowFile, &nColFile, verbose, 0, delimiter, nHeaderLines);
         if (NULL != file) {
@@ -2981,6 +4007,11 @@ void* ModelicaStandardTables_CombiTable2D_init3(_In_z_ const char* fileName,
         if (NULL != tableFile) {
             free(tableFile);
         }
+#endif
+#if defined(ASYNC_LOAD)
+        if (NULL != load) {
+            tableLoadRelease(load);
+        }
 #endif
         ModelicaError("Memory allocation error\n");
         return NULL;
@@ -2992,6 +4023,23 @@ void* ModelicaStandardTables_CombiTable2D_init3(_In_z_ const char* fileName,
 
     switch (tableID->source) {
         case TABLESOURCE_FILE:
+#if defined(ASYNC_LOAD)
+            if (NULL != load) {
+                size_t lenFileName = strlen(fileName);
+                tableID->load = load;
+                tableID->key = (char*)malloc((lenFileName + strlen(tableName) + 2)*sizeof(char));
+                if (NULL != tableID->key) {
+                    strcpy(tableID->key, fileName);
+                    strcpy(tableID->key + lenFileName + 1, tableName);
+                }
+                else {
+                    ModelicaStandardTables_CombiTable2D_close(tableID);
+                    ModelicaError("Memory allocation error\n");
+                    return NULL;
+                }
+                break;
+            }
+#endif
 #if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
             tableID->key = keyFile;
 #else
@@ -3015,6 +4063,13 @@ void* ModelicaStandardTables_CombiTable2D_init3(_In_z_ const char* fileName,
 #if defined(NO_TABLE_COPY)
             tableID->table = table;
 #else
+#if defined(ARRAY_SHARE)
+            tableID->share = arrayShareAcquire(table, nRow, nColumn);
+            if (NULL != tableID->share) {
+                tableID->table = tableID->share->table;
+                break;
+            }
+#endif
             tableID->table = (double*)malloc(nRow*nColumn*sizeof(double));
             if (NULL != tableID->table) {
                 memcpy(tableID->table, table, nRow*nColumn*sizeof(double));
@@ -3036,18 +4091,24 @@ void* ModelicaStandardTables_CombiTable2D_init3(_In_z_ const char* fileName,
                     tableID->nRow = (size_t)dim[0];
                     tableID->nCol = (size_t)dim[1];
                 }
+                else if (3 == colWise) {
+                    /* Interpolate in place with interchanged abscissa
+                       values */
+                    tableID->nRow = (size_t)dim[0];
+                    tableID->nCol = (size_t)dim[1];
+                    tableID->colWise = 1;
+                }
                 else {
                     /* Need to transpose */
                     double* tableT = (double*)malloc(
                         (size_t)dim[0]*(size_t)dim[1]*sizeof(double));
                     if (NULL != tableT) {
-                        memcpy(tableT, tableID->table,
-                            (size_t)dim[0]*(size_t)dim[1]*sizeof(double));
+                        ModelicaIO_transposeRealMatrix(tableID->table,
+                            (size_t)dim[0], (size_t)dim[1], tableT);
                         tableID->table = tableT;
                         tableID->nRow = (size_t)dim[1];
                         tableID->nCol = (size_t)dim[0];
                         tableID->source = TABLESOURCE_FUNCTION_TRANSPOSE;
-                        transpose(tableID->table, tableID->nRow, tableID->nCol);
                     }
                     else {
                         ModelicaStandardTables_CombiTable2D_close(tableID);
@@ -3069,9 +4130,17 @@ void* ModelicaStandardTables_CombiTable2D_init3(_In_z_ const char* fileName,
             return NULL;
     }
 
+#if defined(ASYNC_LOAD)
+    if (NULL != tableID->load) {
+        /* Validation and initialization on first access */
+        return (void*)tableID;
+    }
+#endif
+
     if (isValidCombiTable2D(tableID, tableName, DO_CLEANUP) == 0) {
         return NULL;
     }
+    table2DAxesInit(tableID);
 
     if (tableID->smoothness == AKIMA_C1 &&
         tableID->nRow <= 3 && tableID->nCol <= 3) {
@@ -3079,8 +4148,19 @@ void* ModelicaStandardTables_CombiTable2D_init3(_In_z_ const char* fileName,
     }
     /* Initialization of the Akima-spline coefficients */
     if (tableID->smoothness == AKIMA_C1) {
+#if defined(ARRAY_SHARE)
+        if (NULL != tableID->share) {
+            tableID->spline = (CubicHermite2D*)splineShareAcquire(
+                tableID->share, 2, AKIMA_C1, NULL, 0);
+        }
+        else {
+            tableID->spline = spline2DInit((const double*)tableID->table,
+                tableID->nRow, tableID->nCol);
+        }
+#else
         tableID->spline = spline2DInit((const double*)tableID->table,
             tableID->nRow, tableID->nCol);
+#endif
         if (NULL == tableID->spline) {
             ModelicaStandardTables_CombiTable2D_close(tableID);
             ModelicaError("Memory allocation error\n");
@@ -3094,6 +4174,22 @@ void* ModelicaStandardTables_CombiTable2D_init3(_In_z_ const char* fileName,
 void ModelicaStandardTables_CombiTable2D_close(void* _tableID) {
     CombiTable2D* tableID = (CombiTable2D*)_tableID;
     assert(NULL != tableID);
+#if defined(ASYNC_LOAD)
+    if (NULL != tableID->load) {
+        /* Release pending table file load */
+        tableLoadRelease(tableID->load);
+        tableID->load = NULL;
+    }
+#endif
+#if defined(ARRAY_SHARE)
+    if (NULL != tableID->share) {
+        /* Release shared spline coefficients and table array */
+        arrayShareRelease(tableID->share, (void*)tableID->spline);
+        tableID->share = NULL;
+        tableID->spline = NULL;
+        tableID->table = NULL;
+    }
+#endif
     if (NULL != tableID->table && tableID->source == TABLESOURCE_FILE) {
 #if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
         if (NULL != tableID->key) {
@@ -3129,6 +4225,13 @@ void ModelicaStandardTables_CombiTable2D_close(void* _tableID) {
         tableID->source == TABLESOURCE_FUNCTION_TRANSPOSE)) {
         free(tableID->table);
     }
+#if defined(ASYNC_LOAD)
+    else if (NULL == tableID->table && tableID->source == TABLESOURCE_FILE &&
+        NULL != tableID->key) {
+        /* Table file not loaded */
+        free(tableID->key);
+    }
+#endif
     spline2DClose(&tableID->spline);
     free(tableID);
 }
@@ -3138,6 +4241,13 @@ double ModelicaStandardTables_CombiTable2D_getValue(void* _tableID, double u1,
     double y = 0;
     CombiTable2D* tableID = (CombiTable2D*)_tableID;
     assert(NULL != tableID);
+    FINISH_LOAD(ModelicaStandardTables_CombiTable2D_read, tableID);
+    if (1 == tableID->colWise) {
+        /* Interchange the abscissa values of the table stored column-wise */
+        const double u = u1;
+        u1 = u2;
+        u2 = u;
+    }
     if (NULL != tableID->table) {
         const double* table = tableID->table;
         const size_t nRow = tableID->nRow;
@@ -3158,20 +4268,9 @@ double ModelicaStandardTables_CombiTable2D_getValue(void* _tableID, double u1,
 
                 /* Periodic extrapolation */
                 if (tableID->extrapolation == PERIODIC) {
-                    const double T = u2Max - u2Min;
-
-                    if (u2 < u2Min) {
-                        do {
-                            u2 += T;
-                        } while (u2 < u2Min);
-                    }
-                    else if (u2 > u2Max) {
-                        do {
-                            u2 -= T;
-                        } while (u2 > u2Max);
-                    }
-                    last2 = findColIndex(&TABLE(0, 1), nCol - 1,
-                        tableID->last2, u2);
+                    u2 = wrapPeriodic(u2, u2Min, u2Max);
+                    last2 = findColIndexUniform(&TABLE(0, 1), nCol - 1,
+                        tableID->last2, u2, 0.0, tableID->du2);
                     tableID->last2 = last2;
                 }
                 else if (u2 < u2Min) {
@@ -3183,8 +4282,8 @@ double ModelicaStandardTables_CombiTable2D_getValue(void* _tableID, double u1,
                     last2 = nCol - 3;
                 }
                 else {
-                    last2 = findColIndex(&TABLE(0, 1), nCol - 1,
-                        tableID->last2, u2);
+                    last2 = findColIndexUniform(&TABLE(0, 1), nCol - 1,
+                        tableID->last2, u2, 0.0, tableID->du2);
                     tableID->last2 = last2;
                 }
 
@@ -3309,20 +4408,9 @@ double ModelicaStandardTables_CombiTable2D_getValue(void* _tableID, double u1,
 
             /* Periodic extrapolation */
             if (tableID->extrapolation == PERIODIC) {
-                const double T = u1Max - u1Min;
-
-                if (u1 < u1Min) {
-                    do {
-                        u1 += T;
-                    } while (u1 < u1Min);
-                }
-                else if (u1 > u1Max) {
-                    do {
-                        u1 -= T;
-                    } while (u1 > u1Max);
-                }
-                last1 = findRowIndex(&TABLE(1, 0), nRow - 1, nCol,
-                    tableID->last1, u1);
+                u1 = wrapPeriodic(u1, u1Min, u1Max);
+                last1 = findRowIndexUniform(&TABLE(1, 0), nRow - 1, nCol,
+                    tableID->last1, u1, 0.0, tableID->du1);
                 tableID->last1 = last1;
             }
             else if (u1 < u1Min) {
@@ -3334,8 +4422,8 @@ double ModelicaStandardTables_CombiTable2D_getValue(void* _tableID, double u1,
                 last1 = nRow - 3;
             }
             else {
-                last1 = findRowIndex(&TABLE(1, 0), nRow - 1, nCol,
-                    tableID->last1, u1);
+                last1 = findRowIndexUniform(&TABLE(1, 0), nRow - 1, nCol,
+                    tableID->last1, u1, 0.0, tableID->du1);
                 tableID->last1 = last1;
             }
             if (nCol == 2) {
@@ -3459,20 +4547,9 @@ double ModelicaStandardTables_CombiTable2D_getValue(void* _tableID, double u1,
 
                 /* Periodic extrapolation */
                 if (tableID->extrapolation == PERIODIC) {
-                    const double T = u2Max - u2Min;
-
-                    if (u2 < u2Min) {
-                        do {
-                            u2 += T;
-                        } while (u2 < u2Min);
-                    }
-                    else if (u2 > u2Max) {
-                        do {
-                            u2 -= T;
-                        } while (u2 > u2Max);
-                    }
-                    last2 = findColIndex(&TABLE(0, 1), nCol - 1,
-                        tableID->last2, u2);
+                    u2 = wrapPeriodic(u2, u2Min, u2Max);
+                    last2 = findColIndexUniform(&TABLE(0, 1), nCol - 1,
+                        tableID->last2, u2, 0.0, tableID->du2);
                     tableID->last2 = last2;
                 }
                 else if (u2 < u2Min) {
@@ -3484,8 +4561,8 @@ double ModelicaStandardTables_CombiTable2D_getValue(void* _tableID, double u1,
                     last2 = nCol - 3;
                 }
                 else {
-                    last2 = findColIndex(&TABLE(0, 1), nCol - 1,
-                        tableID->last2, u2);
+                    last2 = findColIndexUniform(&TABLE(0, 1), nCol - 1,
+                        tableID->last2, u2, 0.0, tableID->du2);
                     tableID->last2 = last2;
                 }
 
@@ -3510,15 +4587,12 @@ double ModelicaStandardTables_CombiTable2D_getValue(void* _tableID, double u1,
                                 if (NULL != tableID->spline) {
                                     const double* c = tableID->spline[
                                         IDX(last1, last2, nCol - 2)];
-                                    double p1, p2, p3;
+                                    double d[1];
                                     u1 -= TABLE_COL0(last1 + 1);
                                     u2 -= TABLE_ROW0(last2 + 1);
-                                    p1 = ((c[0]*u2 + c[1])*u2 + c[2])*u2 + c[3];
-                                    p2 = ((c[4]*u2 + c[5])*u2 + c[6])*u2 + c[7];
-                                    p3 = ((c[8]*u2 + c[9])*u2 + c[10])*u2 + c[11];
-                                    y = TABLE(last1 + 1, last2 + 1); /* c[15] = y00 */
-                                    y += ((c[12]*u2 + c[13])*u2 + c[14])*u2; /* p4 */
-                                    y += ((p1*u1 + p2)*u1 + p3)*u1;
+                                    bicubicHermite2D(c, TABLE(last1 + 1, last2 + 1),
+                                        u1, u2, 0, d);
+                                    y = d[0];
                                 }
                                 break;
 
@@ -4241,6 +5315,16 @@ double ModelicaStandardTables_CombiTable2D_getDerValue(void* _tableID, double u1
     double der_y = 0;
     CombiTable2D* tableID = (CombiTable2D*)_tableID;
     assert(NULL != tableID);
+    FINISH_LOAD(ModelicaStandardTables_CombiTable2D_read, tableID);
+    if (1 == tableID->colWise) {
+        /* Interchange the abscissa values of the table stored column-wise */
+        double u = u1;
+        u1 = u2;
+        u2 = u;
+        u = der_u1;
+        der_u1 = der_u2;
+        der_u2 = u;
+    }
     if (NULL != tableID->table) {
         const double* table = tableID->table;
         const size_t nRow = tableID->nRow;
@@ -4257,20 +5341,9 @@ double ModelicaStandardTables_CombiTable2D_getDerValue(void* _tableID, double u1
 
                 /* Periodic extrapolation */
                 if (tableID->extrapolation == PERIODIC) {
-                    const double T = u2Max - u2Min;
-
-                    if (u2 < u2Min) {
-                        do {
-                            u2 += T;
-                        } while (u2 < u2Min);
-                    }
-                    else if (u2 > u2Max) {
-                        do {
-                            u2 -= T;
-                        } while (u2 > u2Max);
-                    }
-                    last2 = findColIndex2(&TABLE(0, 1), nCol - 1,
-                        tableID->last2, u2, der_u2);
+                    u2 = wrapPeriodic(u2, u2Min, u2Max);
+                    last2 = findColIndexUniform(&TABLE(0, 1), nCol - 1,
+                        tableID->last2, u2, der_u2, tableID->du2);
                     tableID->last2 = last2;
                 }
                 else if (isLessOrEqualWNegativeSlope(u2, der_u2, u2Min)) {
@@ -4282,8 +5355,8 @@ double ModelicaStandardTables_CombiTable2D_getDerValue(void* _tableID, double u1
                     last2 = nCol - 3;
                 }
                 else {
-                    last2 = findColIndex2(&TABLE(0, 1), nCol - 1,
-                        tableID->last2, u2, der_u2);
+                    last2 = findColIndexUniform(&TABLE(0, 1), nCol - 1,
+                        tableID->last2, u2, der_u2, tableID->du2);
                     tableID->last2 = last2;
                 }
 
@@ -4399,20 +5472,9 @@ double ModelicaStandardTables_CombiTable2D_getDerValue(void* _tableID, double u1
 
             /* Periodic extrapolation */
             if (tableID->extrapolation == PERIODIC) {
-                const double T = u1Max - u1Min;
-
-                if (u1 < u1Min) {
-                    do {
-                        u1 += T;
-                    } while (u1 < u1Min);
-                }
-                else if (u1 > u1Max) {
-                    do {
-                        u1 -= T;
-                    } while (u1 > u1Max);
-                }
-                last1 = findRowIndex2(&TABLE(1, 0), nRow - 1, nCol,
-                    tableID->last1, u1, der_u1);
+                u1 = wrapPeriodic(u1, u1Min, u1Max);
+                last1 = findRowIndexUniform(&TABLE(1, 0), nRow - 1, nCol,
+                    tableID->last1, u1, der_u1, tableID->du1);
                 tableID->last1 = last1;
             }
             else if (isLessOrEqualWNegativeSlope(u1, der_u1, u1Min)) {
@@ -4424,8 +5486,8 @@ double ModelicaStandardTables_CombiTable2D_getDerValue(void* _tableID, double u1
                 last1 = nRow - 3;
             }
             else {
-                last1 = findRowIndex2(&TABLE(1, 0), nRow - 1, nCol,
-                    tableID->last1, u1, der_u1);
+                last1 = findRowIndexUniform(&TABLE(1, 0), nRow - 1, nCol,
+                    tableID->last1, u1, der_u1, tableID->du1);
                 tableID->last1 = last1;
             }
             if (nCol == 2) {
@@ -4540,20 +5602,9 @@ double ModelicaStandardTables_CombiTable2D_getDerValue(void* _tableID, double u1
 
                 /* Periodic extrapolation */
                 if (tableID->extrapolation == PERIODIC) {
-                    const double T = u2Max - u2Min;
-
-                    if (u2 < u2Min) {
-                        do {
-                            u2 += T;
-                        } while (u2 < u2Min);
-                    }
-                    else if (u2 > u2Max) {
-                        do {
-                            u2 -= T;
-                        } while (u2 > u2Max);
-                    }
-                    last2 = findColIndex2(&TABLE(0, 1), nCol - 1,
-                        tableID->last2, u2, der_u2);
+                    u2 = wrapPeriodic(u2, u2Min, u2Max);
+                    last2 = findColIndexUniform(&TABLE(0, 1), nCol - 1,
+                        tableID->last2, u2, der_u2, tableID->du2);
                     tableID->last2 = last2;
                 }
                 else if (isLessOrEqualWNegativeSlope(u2, der_u2, u2Min)) {
@@ -4565,8 +5616,8 @@ double ModelicaStandardTables_CombiTable2D_getDerValue(void* _tableID, double u1
                     last2 = nCol - 3;
                 }
                 else {
-                    last2 = findColIndex2(&TABLE(0, 1), nCol - 1,
-                        tableID->last2, u2, der_u2);
+                    last2 = findColIndexUniform(&TABLE(0, 1), nCol - 1,
+                        tableID->last2, u2, der_u2, tableID->du2);
                     tableID->last2 = last2;
                 }
 
@@ -4584,21 +5635,12 @@ double ModelicaStandardTables_CombiTable2D_getDerValue(void* _tableID, double u1
                                 if (NULL != tableID->spline) {
                                     const double* c = tableID->spline[
                                         IDX(last1, last2, nCol - 2)];
-                                    double der_y1, der_y2;
-                                    double p1, p2, p3;
-                                    double dp1_u2, dp2_u2, dp3_u2, dp4_u2;
+                                    double d[3];
                                     u1 -= TABLE_COL0(last1 + 1);
                                     u2 -= TABLE_ROW0(last2 + 1);
-                                    p1 = ((c[0]*u2 + c[1])*u2 + c[2])*u2 + c[3];
-                                    p2 = ((c[4]*u2 + c[5])*u2 + c[6])*u2 + c[7];
-                                    p3 = ((c[8]*u2 + c[9])*u2 + c[10])*u2 + c[11];
-                                    dp1_u2 = (3*c[0]*u2 + 2*c[1])*u2 + c[2];
-                                    dp2_u2 = (3*c[4]*u2 + 2*c[5])*u2 + c[6];
-                                    dp3_u2 = (3*c[8]*u2 + 2*c[9])*u2 + c[10];
-                                    dp4_u2 = (3*c[12]*u2 + 2*c[13])*u2 + c[14];
-                                    der_y1 = (3*p1*u1 + 2*p2)*u1 + p3;
-                                    der_y2 = ((dp1_u2*u1 + dp2_u2)*u1 + dp3_u2)*u1 + dp4_u2;
-                                    der_y = der_y1*der_u1 + der_y2*der_u2;
+                                    bicubicHermite2D(c, TABLE(last1 + 1, last2 + 1),
+                                        u1, u2, 1, d);
+                                    der_y = d[1]*der_u1 + d[2]*der_u2;
                                  }
                                  break;
 
@@ -5157,6 +6199,19 @@ double ModelicaStandardTables_CombiTable2D_getDer2Value(void* _tableID, double u
     double der2_y = 0;
     CombiTable2D* tableID = (CombiTable2D*)_tableID;
     assert(NULL != tableID);
+    FINISH_LOAD(ModelicaStandardTables_CombiTable2D_read, tableID);
+    if (1 == tableID->colWise) {
+        /* Interchange the abscissa values of the table stored column-wise */
+        double u = u1;
+        u1 = u2;
+        u2 = u;
+        u = der_u1;
+        der_u1 = der_u2;
+        der_u2 = u;
+        u = der2_u1;
+        der2_u1 = der2_u2;
+        der2_u2 = u;
+    }
     if (NULL != tableID->table) {
         const double* table = tableID->table;
         const size_t nRow = tableID->nRow;
@@ -5173,20 +6228,9 @@ double ModelicaStandardTables_CombiTable2D_getDer2Value(void* _tableID, double u
 
                 /* Periodic extrapolation */
                 if (tableID->extrapolation == PERIODIC) {
-                    const double T = u2Max - u2Min;
-
-                    if (u2 < u2Min) {
-                        do {
-                            u2 += T;
-                        } while (u2 < u2Min);
-                    }
-                    else if (u2 > u2Max) {
-                        do {
-                            u2 -= T;
-                        } while (u2 > u2Max);
-                    }
-                    last2 = findColIndex2(&TABLE(0, 1), nCol - 1,
-                        tableID->last2, u2, der_u2);
+                    u2 = wrapPeriodic(u2, u2Min, u2Max);
+                    last2 = findColIndexUniform(&TABLE(0, 1), nCol - 1,
+                        tableID->last2, u2, der_u2, tableID->du2);
                     tableID->last2 = last2;
                 }
                 else if (isLessOrEqualWNegativeSlope(u2, der_u2, u2Min)) {
@@ -5198,8 +6242,8 @@ double ModelicaStandardTables_CombiTable2D_getDer2Value(void* _tableID, double u
                     last2 = nCol - 3;
                 }
                 else {
-                    last2 = findColIndex2(&TABLE(0, 1), nCol - 1,
-                        tableID->last2, u2, der_u2);
+                    last2 = findColIndexUniform(&TABLE(0, 1), nCol - 1,
+                        tableID->last2, u2, der_u2, tableID->du2);
                     tableID->last2 = last2;
                 }
 
@@ -5316,20 +6360,9 @@ double ModelicaStandardTables_CombiTable2D_getDer2Value(void* _tableID, double u
 
             /* Periodic extrapolation */
             if (tableID->extrapolation == PERIODIC) {
-                const double T = u1Max - u1Min;
-
-                if (u1 < u1Min) {
-                    do {
-                        u1 += T;
-                    } while (u1 < u1Min);
-                }
-                else if (u1 > u1Max) {
-                    do {
-                        u1 -= T;
-                    } while (u1 > u1Max);
-                }
-                last1 = findRowIndex2(&TABLE(1, 0), nRow - 1, nCol,
-                    tableID->last1, u1, der_u1);
+                u1 = wrapPeriodic(u1, u1Min, u1Max);
+                last1 = findRowIndexUniform(&TABLE(1, 0), nRow - 1, nCol,
+                    tableID->last1, u1, der_u1, tableID->du1);
                 tableID->last1 = last1;
             }
             else if (isLessOrEqualWNegativeSlope(u1, der_u1, u1Min)) {
@@ -5341,8 +6374,8 @@ double ModelicaStandardTables_CombiTable2D_getDer2Value(void* _tableID, double u
                 last1 = nRow - 3;
             }
             else {
-                last1 = findRowIndex2(&TABLE(1, 0), nRow - 1, nCol,
-                    tableID->last1, u1, der_u1);
+                last1 = findRowIndexUniform(&TABLE(1, 0), nRow - 1, nCol,
+                    tableID->last1, u1, der_u1, tableID->du1);
                 tableID->last1 = last1;
             }
             if (nCol == 2) {
@@ -5458,20 +6491,9 @@ double ModelicaStandardTables_CombiTable2D_getDer2Value(void* _tableID, double u
 
                 /* Periodic extrapolation */
                 if (tableID->extrapolation == PERIODIC) {
-                    const double T = u2Max - u2Min;
-
-                    if (u2 < u2Min) {
-                        do {
-                            u2 += T;
-                        } while (u2 < u2Min);
-                    }
-                    else if (u2 > u2Max) {
-                        do {
-                            u2 -= T;
-                        } while (u2 > u2Max);
-                    }
-                    last2 = findColIndex2(&TABLE(0, 1), nCol - 1,
-                        tableID->last2, u2, der_u2);
+                    u2 = wrapPeriodic(u2, u2Min, u2Max);
+                    last2 = findColIndexUniform(&TABLE(0, 1), nCol - 1,
+                        tableID->last2, u2, der_u2, tableID->du2);
                     tableID->last2 = last2;
                 }
                 else if (isLessOrEqualWNegativeSlope(u2, der_u2, u2Min)) {
@@ -5483,8 +6505,8 @@ double ModelicaStandardTables_CombiTable2D_getDer2Value(void* _tableID, double u
                     last2 = nCol - 3;
                 }
                 else {
-                    last2 = findColIndex2(&TABLE(0, 1), nCol - 1,
-                        tableID->last2, u2, der_u2);
+                    last2 = findColIndexUniform(&TABLE(0, 1), nCol - 1,
+                        tableID->last2, u2, der_u2, tableID->du2);
                     tableID->last2 = last2;
                 }
 
@@ -5502,30 +6524,14 @@ double ModelicaStandardTables_CombiTable2D_getDer2Value(void* _tableID, double u
                                 if (NULL != tableID->spline) {
                                     const double* c = tableID->spline[
                                         IDX(last1, last2, nCol - 2)];
-                                    double der_y1, der_y2, der2_y1, der2_y2;
-                                    double p1, p2, p3;
-                                    double dp1_u2, dp2_u2, dp3_u2, dp4_u2;
-                                    double d2p1_u2, d2p2_u2, d2p3_u2, d2p4_u2;
+                                    double d[6];
                                     u1 -= TABLE_COL0(last1 + 1);
                                     u2 -= TABLE_ROW0(last2 + 1);
-                                    p1 = ((c[0]*u2 + c[1])*u2 + c[2])*u2 + c[3];
-                                    p2 = ((c[4]*u2 + c[5])*u2 + c[6])*u2 + c[7];
-                                    p3 = ((c[8]*u2 + c[9])*u2 + c[10])*u2 + c[11];
-                                    dp1_u2 = (3*c[0]*u2 + 2*c[1])*u2 + c[2];
-                                    dp2_u2 = (3*c[4]*u2 + 2*c[5])*u2 + c[6];
-                                    dp3_u2 = (3*c[8]*u2 + 2*c[9])*u2 + c[10];
-                                    dp4_u2 = (3*c[12]*u2 + 2*c[13])*u2 + c[14];
-                                    d2p1_u2 = 6*c[0]*u2 + 2*c[1];
-                                    d2p2_u2 = 6*c[4]*u2 + 2*c[5];
-                                    d2p3_u2 = 6*c[8]*u2 + 2*c[9];
-                                    d2p4_u2 = 6*c[12]*u2 + 2*c[13];
-                                    der_y1 = (3*p1*u1 + 2*p2)*u1 + p3;
-                                    der_y2 = ((dp1_u2*u1 + dp2_u2)*u1 + dp3_u2)*u1 + dp4_u2;
-                                    der2_y1 = 6*p1*u1 + 2*p2;
-                                    der2_y2 = ((d2p1_u2*u1 + d2p2_u2)*u1 + d2p3_u2)*u1 + d2p4_u2;
-                                    der2_y = der2_y1*der_u1*der_u1 + der_y1*der2_u1;
-                                    der2_y += ((6*dp1_u2*u1 + 4*dp2_u2)*u1 + 2*dp3_u2)*der_u1*der_u2;
-                                    der2_y += der2_y2*der_u2*der_u2 + der_y2*der2_u2;
+                                    bicubicHermite2D(c, TABLE(last1 + 1, last2 + 1),
+                                        u1, u2, 2, d);
+                                    der2_y = d[3]*der_u1*der_u1 + d[1]*der2_u1;
+                                    der2_y += 2*d[4]*der_u1*der_u2;
+                                    der2_y += d[5]*der_u2*der_u2 + d[2]*der2_u2;
                                  }
                                  break;
 
@@ -5564,7 +6570,7 @@ double ModelicaStandardTables_CombiTable2D_getDer2Value(void* _tableID, double u
                                             der_y1 = (3*c[3]*u1 + 2*c[7])*u1 + c[11];
                                             der_y1 += ((3*c[2]*u1 + 2*c[6])*u1 + c[10])*u2;
                                             der_y2 = ((c[2]*u1 + c[6])*u1 + c[10])*u1 + c[14];
-                                            der2_y1 = 2*(3*c[3]*u1 + c[7] + (3*c[2]*u1 + c[6]))*u2;
+                                            der2_y1 = 2*(3*c[3]*u1 + c[7] + (3*c[2]*u1 + c[6])*u2);
                                             der2_y = der2_y1*der_u1*der_u1 + der_y1*der2_u1;
                                             der2_y += 2*((3*c[2]*u1 + 2*c[6])*u1 + c[10])*der_u1*der_u2;
                                             der2_y += der_y2*der2_u2;
@@ -6095,15 +7101,98 @@ double ModelicaStandardTables_CombiTable2D_getDer2Value(void* _tableID, double u
     return der2_y;
 }
 
+void ModelicaStandardTables_CombiTable2D_resample(void* _tableID,
+                                                 _In_ const double* u1,
+                                                 size_t n1,
+                                                 _In_ const double* u2,
+                                                 size_t n2, double* y) {
+    CombiTable2D* tableID = (CombiTable2D*)_tableID;
+    assert(NULL != tableID);
+    FINISH_LOAD(ModelicaStandardTables_CombiTable2D_read, tableID);
+    if (NULL != tableID->table && 1 == tableID->colWise) {
+        /* Table stored column-wise: Interpolate point by point */
+        size_t i, j;
+        for (i = 0; i < n1; i++) {
+            for (j = 0; j < n2; j++) {
+                y[IDX(i, j, n2)] = ModelicaStandardTables_CombiTable2D_getValue(
+                    tableID, u1[i], u2[j]);
+            }
+        }
+    }
+    else if (NULL != tableID->table) {
+        const double* table = tableID->table;
+        const size_t nRow = tableID->nRow;
+        const size_t nCol = tableID->nCol;
+        const double u1Min = TABLE_COL0(1);
+        const double u1Max = TABLE_COL0(nRow - 1);
+        const double u2Min = TABLE_ROW0(1);
+        const double u2Max = TABLE_ROW0(nCol - 1);
+        size_t* last2 = NULL;
+        size_t last1 = tableID->last1;
+        size_t i, j;
+
+        /* Merge the values of the second independent variable with the
+           column abscissa values once for all values of u1 */
+        if (nCol > 2 && n2 > 0) {
+            size_t last = tableID->last2;
+            last2 = (size_t*)malloc(n2*sizeof(size_t));
+            if (NULL == last2) {
+                ModelicaError("Memory allocation error\n");
+                return;
+            }
+            for (j = 0; j < n2; j++) {
+                double u = u2[j];
+                if (tableID->extrapolation == PERIODIC) {
+                    u = wrapPeriodic(u, u2Min, u2Max);
+                }
+                if (u >= u2Min && u <= u2Max) {
+                    last = findRowIndexForward(&TABLE(0, 1), nCol - 1, 1,
+                        last, u);
+                }
+                last2[j] = last;
+            }
+        }
+
+        for (i = 0; i < n1; i++) {
+            if (nRow > 2) {
+                double u = u1[i];
+                if (tableID->extrapolation == PERIODIC) {
+                    u = wrapPeriodic(u, u1Min, u1Max);
+                }
+                if (u >= u1Min && u <= u1Max) {
+                    last1 = findRowIndexForward(&TABLE(1, 0), nRow - 1, nCol,
+                        last1, u);
+                }
+            }
+            for (j = 0; j < n2; j++) {
+                /* Row and column search of the interpolation succeed at
+                   the first trial */
+                tableID->last1 = last1;
+                if (NULL != last2) {
+                    tableID->last2 = last2[j];
+                }
+                y[IDX(i, j, n2)] = ModelicaStandardTables_CombiTable2D_getValue(
+                    tableID, u1[i], u2[j]);
+            }
+        }
+        free(last2);
+    }
+    else {
+        memset(y, 0, n1*n2*sizeof(double));
+    }
+}
+
 void ModelicaStandardTables_CombiTable2D_minimumAbscissa(void* _tableID,
                                                          _Inout_ double* uMin) {
     CombiTable2D* tableID = (CombiTable2D*)_tableID;
     assert(NULL != tableID);
+    FINISH_LOAD(ModelicaStandardTables_CombiTable2D_read, tableID);
     if (NULL != tableID->table) {
         const double* table = tableID->table;
         const size_t nCol = tableID->nCol;
-        uMin[0] = TABLE_COL0(1);
-        uMin[1] = TABLE_ROW0(1);
+        /* Interchanged abscissa values if table stored column-wise */
+        uMin[tableID->colWise] = TABLE_COL0(1);
+        uMin[1 - tableID->colWise] = TABLE_ROW0(1);
     }
     else {
         uMin[0] = 0.;
@@ -6115,12 +7204,14 @@ void ModelicaStandardTables_CombiTable2D_maximumAbscissa(void* _tableID,
                                                          _Inout_ double* uMax) {
     CombiTable2D* tableID = (CombiTable2D*)_tableID;
     assert(NULL != tableID);
+    FINISH_LOAD(ModelicaStandardTables_CombiTable2D_read, tableID);
     if (NULL != tableID->table) {
         const double* table = tableID->table;
         const size_t nRow = tableID->nRow;
         const size_t nCol = tableID->nCol;
-        uMax[0] = TABLE_COL0(nRow - 1);
-        uMax[1] = TABLE_ROW0(nCol - 1);
+        /* Interchanged abscissa values if table stored column-wise */
+        uMax[tableID->colWise] = TABLE_COL0(nRow - 1);
+        uMax[1 - tableID->colWise] = TABLE_ROW0(nCol - 1);
     }
     else {
         uMax[0] = 0.;
@@ -6137,28 +7228,45 @@ double ModelicaStandardTables_CombiTable2D_read(void* _tableID, int force,
         if (force || NULL == tableID->table) {
             const char* fileName = tableID->key;
             const char* tableName = tableID->key + strlen(fileName) + 1;
-#if defined(TABLE_SHARE)
-            TableShare* file = readTable(fileName, tableName, &tableID->nRow,
-                &tableID->nCol, verbose, force, ",", 0);
-            if (NULL != file) {
-                tableID->table = file->table;
+#if defined(ASYNC_LOAD)
+            if (NULL != tableID->load) {
+                /* Take table loaded by a worker thread */
+                TableLoad* load = tableID->load;
+                tableID->load = NULL;
+                if (tableLoadFinish(load, &tableID->key, &tableID->table,
+                    &tableID->nRow, &tableID->nCol) == 0) {
+                    return 0.; /* Error */
+                }
+                tableName = tableID->key + strlen(tableID->key) + 1;
             }
             else {
-                return 0.; /* Error */
-            }
 #else
-            if (NULL != tableID->table) {
-                free(tableID->table);
-            }
-            tableID->table = readTable(fileName, tableName, &tableID->nRow,
-                &tableID->nCol, verbose, force, ",", 0);
+            {
 #endif
+#if defined(TABLE_SHARE)
+                TableShare* file = readTable(fileName, tableName, &tableID->nRow,
+                    &tableID->nCol, verbose, force, ",", 0);
+                if (NULL != file) {
+                    tableID->table = file->table;
+                }
+                else {
+                    return 0.; /* Error */
+                }
+#else
+                if (NULL != tableID->table) {
+                    free(tableID->table);
+                }
+                tableID->table = readTable(fileName, tableName, &tableID->nRow,
+                    &tableID->nCol, verbose, force, ",", 0);
+#endif
+            }
             if (NULL == tableID->table) {
                 return 0.; /* Error */
             }
             if (isValidCombiTable2D(tableID, tableName, NO_CLEANUP) == 0) {
                 return 0.; /* Error */
             }
+            table2DAxesInit(tableID);
             if (tableID->smoothness == AKIMA_C1 &&
                 tableID->nRow <= 3 && tableID->nCol <= 3) {
                 tableID->smoothness = LINEAR_SEGMENTS;
@@ -6179,92 +7287,905 @@ double ModelicaStandardTables_CombiTable2D_read(void* _tableID, int force,
     return 1.; /* Success */
 }
 
-/* ----- Internal functions ----- */
-
-static int isNearlyEqual(double x, double y) {
-    const double fx = fabs(x);
-    const double fy = fabs(y);
-    double cmp = fx > fy ? fx : fy;
-    if (cmp < _EPSILON) {
-        cmp = _EPSILON;
-    }
-    cmp *= _EPSILON;
-    return fabs(y - x) < cmp;
-}
+void* ModelicaStandardTables_CombiTableND_init(_In_z_ const char* fileName,
+                                               _In_z_ const char* tableName,
+                                               _In_ const double* table, size_t nTable,
+                                               _In_ const int* dims, size_t nDim,
+                                               int smoothness, int extrapolation,
+                                               int verbose,
+                                               _In_z_ const char* delimiter,
+                                               int nHeaderLines) {
+    CombiTableND* tableID;
+#if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
+    TableShare* file = NULL;
+    char* keyFile = NULL;
+#endif
+    double* tableFile = NULL;
+    size_t nRowFile = 0;
+    size_t nColFile = 0;
+    size_t nValue = 1;
+    size_t k;
+    enum TableSource source = getTableSource(fileName, tableName);
 
-static size_t findRowIndex2(_In_ const double* table, size_t nRow, size_t nCol,
-                            size_t last, double x, double dx) {
-    size_t i0 = 0;
-    size_t i1 = nRow - 1;
-    if (isLessOrEqualWNegativeSlope(x, dx, TABLE_COL0(last))) {
-        i1 = last;
-    }
-    else if (!isLessOrEqualWNegativeSlope(x, dx, TABLE_COL0(last + 1))) {
-        i0 = last;
+    /* Check dimensions before any heap allocation */
+    if (nDim < 1 || nDim > MAX_TABLE_ND_DIMENSIONS) {
+        ModelicaFormatError("The number of dimensions (=%lu) of table \"%s\" "
+            "must be between 1 and %d for N-dim. interpolation.\n",
+            (unsigned long)nDim, tableName, MAX_TABLE_ND_DIMENSIONS);
+        return NULL;
     }
-    else {
-        return last;
+    for (k = 0; k < nDim; k++) {
+        if (dims[k] < 2) {
+            ModelicaFormatError("The number of grid points (=%d) of dimension "
+                "%lu of table \"%s\" must be at least 2 for N-dim. "
+                "interpolation.\n", dims[k], (unsigned long)k + 1, tableName);
+            return NULL;
+        }
+        if (nValue > ((size_t)-1)/(size_t)dims[k]) {
+            ModelicaFormatError("The number of table values of table \"%s\" "
+                "is too large for N-dim. interpolation.\n", tableName);
+            return NULL;
+        }
+        nValue *= (size_t)dims[k];
     }
 
-    /* Binary search */
-    while (i1 > i0 + 1) {
-        const size_t i = (i0 + i1)/2;
-        if (isLessOrEqualWNegativeSlope(x, dx, TABLE_COL0(i))) {
-            i1 = i;
+    /* Read table from file before any other heap allocation */
+    if (TABLESOURCE_FILE == source) {
+#if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
+        file = readTable(fileName, tableName, &nRowFile, &nColFile, verbose, 0, delimiter, nHeaderLines);
+        if (NULL != file) {
+            keyFile = file->key;
+            tableFile = file->table;
         }
         else {
-            i0 = i;
+            return NULL;
         }
-    }
-    return i0;
-}
-
-static size_t findRowIndex(_In_ const double* table, size_t nRow, size_t nCol,
-                           size_t last, double x) {
-    return findRowIndex2(table, nRow, nCol, last, x, 0.0);
-}
-
-static size_t findColIndex2(_In_ const double* table, size_t nCol, size_t last,
-                            double x, double dx) {
-    size_t i0 = 0;
-    size_t i1 = nCol - 1;
-    if (isLessOrEqualWNegativeSlope(x, dx, TABLE_ROW0(last))) {
-        i1 = last;
-    }
-    else if (!isLessOrEqualWNegativeSlope(x, dx, TABLE_ROW0(last + 1))) {
-        i0 = last;
-    }
-    else {
-        return last;
+#else
+        tableFile = readTable(fileName, tableName, &nRowFile, &nColFile, verbose, 0, delimiter, nHeaderLines);
+        if (NULL == tableFile) {
+            return NULL;
+        }
+#endif
     }
 
-    /* Binary search */
-    while (i1 > i0 + 1) {
-        const size_t i = (i0 + i1)/2;
-        if (isLessOrEqualWNegativeSlope(x, dx, TABLE_ROW0(i))) {
-            i1 = i;
+    tableID = (CombiTableND*)calloc(1, sizeof(CombiTableND));
+    if (NULL == tableID) {
+#if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
+        if (NULL != file) {
+            MUTEX_LOCK();
+            if (--file->refCount == 0) {
+                ModelicaIO_freeRealTable(file->table);
+                free(file->key);
+                HASH_DEL(tableShare, file);
+                free(file);
+            }
+            MUTEX_UNLOCK();
         }
-        else {
-            i0 = i;
+#else
+        if (NULL != tableFile) {
+            free(tableFile);
         }
+#endif
+        ModelicaError("Memory allocation error\n");
+        return NULL;
     }
-    return i0;
-}
-
-static size_t findColIndex(_In_ const double* table, size_t nCol, size_t last, double x) {
-    return findColIndex2(table, nCol, last, x, 0.0);
-}
 
-/* ----- Internal check functions ----- */
+    tableID->smoothness = (enum Smoothness)smoothness;
+    tableID->extrapolation = (enum Extrapolation)extrapolation;
+    tableID->nDim = nDim;
+    tableID->nValue = nValue;
+    tableID->source = source;
 
-static int isLessOrEqualWNegativeSlope(double x, double dx, double val) {
-    return x < val || (x == val && dx < 0);
-}
+    /* Grid offsets and strides of the table values (last dimension varying
+       fastest) */
+    for (k = 0; k < nDim; k++) {
+        tableID->nGrid[k] = (size_t)dims[k];
+        tableID->grid[k] = k > 0 ? tableID->grid[k - 1] + tableID->nGrid[k - 1] : 0;
+    }
+    tableID->stride[nDim - 1] = 1;
+    for (k = nDim - 1; k > 0; k--) {
+        tableID->stride[k - 1] = tableID->stride[k]*tableID->nGrid[k];
+    }
 
-static int isValidName(_In_z_ const char* name) {
-    int isValid = 0;
-    if (NULL != name) {
-        if (strcmp(name, "NoName") != 0) {
+    switch (tableID->source) {
+        case TABLESOURCE_FILE:
+#if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
+            tableID->key = keyFile;
+#else
+            {
+                size_t lenFileName = strlen(fileName);
+                tableID->key = (char*)malloc((lenFileName + strlen(tableName) + 2)*sizeof(char));
+                if (NULL != tableID->key) {
+                    strcpy(tableID->key, fileName);
+                    strcpy(tableID->key + lenFileName + 1, tableName);
+                }
+            }
+#endif
+            tableID->nTable = nRowFile*nColFile;
+            tableID->table = tableFile;
+            break;
+
+        case TABLESOURCE_MODEL:
+            tableID->nTable = nTable;
+#if defined(NO_TABLE_COPY)
+            tableID->table = (double*)table;
+#else
+            tableID->table = (double*)malloc(nTable*sizeof(double));
+            if (NULL != tableID->table) {
+                memcpy(tableID->table, table, nTable*sizeof(double));
+            }
+            else {
+                ModelicaStandardTables_CombiTableND_close(tableID);
+                ModelicaError("Memory allocation error\n");
+                return NULL;
+            }
+#endif
+            break;
+
+        case TABLESOURCE_FUNCTION:
+            ModelicaStandardTables_CombiTableND_close(tableID);
+            ModelicaFormatError("Table \"%s\" cannot be defined by function "
+                "\"usertab\" for N-dim. interpolation.\n", tableName);
+            return NULL;
+
+        case TABLESOURCE_FUNCTION_TRANSPOSE:
+            /* Should not be possible to get here */
+            break;
+
+        default:
+            ModelicaStandardTables_CombiTableND_close(tableID);
+            ModelicaError("Table source error\n");
+            return NULL;
+    }
+
+    if (isValidCombiTableND(tableID, tableName, DO_CLEANUP) == 0) {
+        return NULL;
+    }
+
+    tableNDGridInit(tableID);
+    /* Initialization of the (mixed) partial derivatives */
+    if (tableID->smoothness == AKIMA_C1 ||
+        tableID->smoothness == MAKIMA_C1 ||
+        tableID->smoothness == FRITSCH_BUTLAND_MONOTONE_C1 ||
+        tableID->smoothness == STEFFEN_MONOTONE_C1) {
+        tableID->slopes = tableNDSlopesInit(tableID);
+        if (NULL == tableID->slopes) {
+            ModelicaStandardTables_CombiTableND_close(tableID);
+            ModelicaError("Memory allocation error\n");
+            return NULL;
+        }
+    }
+
+    return (void*)tableID;
+}
+
+void ModelicaStandardTables_CombiTableND_close(void* _tableID) {
+    CombiTableND* tableID = (CombiTableND*)_tableID;
+    assert(NULL != tableID);
+    if (NULL != tableID->table && tableID->source == TABLESOURCE_FILE) {
+#if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
+        if (NULL != tableID->key) {
+            TableShare* file;
+            MUTEX_LOCK();
+            HASH_FIND_STR(tableShare, tableID->key, file);
+            if (NULL != file) {
+                /* Share hit */
+                if (--file->refCount == 0) {
+                    ModelicaIO_freeRealTable(file->table);
+                    free(file->key);
+                    HASH_DEL(tableShare, file);
+                    free(file);
+                }
+            }
+            MUTEX_UNLOCK();
+        }
+        else {
+            /* Should not be possible to get here */
+            free(tableID->table);
+        }
+#else
+        if (NULL != tableID->key) {
+            free(tableID->key);
+        }
+        free(tableID->table);
+#endif
+    }
+#if !defined(NO_TABLE_COPY)
+    else if (NULL != tableID->table && tableID->source == TABLESOURCE_MODEL) {
+        free(tableID->table);
+    }
+#endif
+    if (NULL != tableID->slopes) {
+        free(tableID->slopes);
+    }
+    free(tableID);
+}
+
+double ModelicaStandardTables_CombiTableND_getValue(void* _tableID,
+                                                    _In_ const double* u,
+                                                    size_t nu) {
+    double y = 0;
+    CombiTableND* tableID = (CombiTableND*)_tableID;
+    assert(NULL != tableID);
+    if (NULL != tableID->table) {
+        if (nu != tableID->nDim) {
+            ModelicaFormatError("The number of independent variables (=%lu) "
+                "does not match the number of dimensions (=%lu) of the table.\n",
+                (unsigned long)nu, (unsigned long)tableID->nDim);
+            return y;
+        }
+        y = tableNDInterpolate(tableID, u, NULL, NULL);
+    }
+    return y;
+}
+
+double ModelicaStandardTables_CombiTableND_getDerValue(void* _tableID,
+                                                       _In_ const double* u,
+                                                       _In_ const double* der_u,
+                                                       size_t nu) {
+    double der_y = 0;
+    CombiTableND* tableID = (CombiTableND*)_tableID;
+    assert(NULL != tableID);
+    if (NULL != tableID->table) {
+        if (nu != tableID->nDim) {
+            ModelicaFormatError("The number of independent variables (=%lu) "
+                "does not match the number of dimensions (=%lu) of the table.\n",
+                (unsigned long)nu, (unsigned long)tableID->nDim);
+            return der_y;
+        }
+        (void)tableNDInterpolate(tableID, u, der_u, &der_y);
+    }
+    return der_y;
+}
+
+void ModelicaStandardTables_CombiTableND_minimumAbscissa(void* _tableID,
+                                                         _Inout_ double* uMin) {
+    CombiTableND* tableID = (CombiTableND*)_tableID;
+    size_t k;
+    assert(NULL != tableID);
+    for (k = 0; k < tableID->nDim; k++) {
+        uMin[k] = NULL != tableID->table ? tableID->table[tableID->grid[k]] : 0.;
+    }
+}
+
+void ModelicaStandardTables_CombiTableND_maximumAbscissa(void* _tableID,
+                                                         _Inout_ double* uMax) {
+    CombiTableND* tableID = (CombiTableND*)_tableID;
+    size_t k;
+    assert(NULL != tableID);
+    for (k = 0; k < tableID->nDim; k++) {
+        uMax[k] = NULL != tableID->table ? tableID->table[tableID->grid[k] +
+            tableID->nGrid[k] - 1] : 0.;
+    }
+}
+
+double ModelicaStandardTables_CombiTableND_read(void* _tableID, int force,
+                                                int verbose) {
+#if !defined(NO_FILE_SYSTEM)
+    CombiTableND* tableID = (CombiTableND*)_tableID;
+    assert(NULL != tableID);
+    if (tableID->source == TABLESOURCE_FILE) {
+        if (force || NULL == tableID->table) {
+            const char* fileName = tableID->key;
+            const char* tableName = tableID->key + strlen(fileName) + 1;
+            size_t nRow = 0;
+            size_t nCol = 0;
+#if defined(TABLE_SHARE)
+            TableShare* file = readTable(fileName, tableName, &nRow, &nCol,
+                verbose, force, ",", 0);
+            if (NULL != file) {
+                tableID->table = file->table;
+            }
+            else {
+                return 0.; /* Error */
+            }
+#else
+            if (NULL != tableID->table) {
+                free(tableID->table);
+            }
+            tableID->table = readTable(fileName, tableName, &nRow, &nCol,
+                verbose, force, ",", 0);
+#endif
+            if (NULL == tableID->table) {
+                return 0.; /* Error */
+            }
+            tableID->nTable = nRow*nCol;
+            if (isValidCombiTableND(tableID, tableName, NO_CLEANUP) == 0) {
+                return 0.; /* Error */
+            }
+            tableNDGridInit(tableID);
+            /* Reinitialization of the (mixed) partial derivatives */
+            if (NULL != tableID->slopes) {
+                free(tableID->slopes);
+                tableID->slopes = tableNDSlopesInit(tableID);
+                if (NULL == tableID->slopes) {
+                    ModelicaError("Memory allocation error\n");
+                    return 0.; /* Error */
+                }
+            }
+        }
+    }
+#endif
+    return 1.; /* Success */
+}
+
+void* ModelicaStandardTables_CombiTableScattered2D_init(_In_z_ const char* fileName,
+                                                        _In_z_ const char* tableName,
+                                                        _In_ const double* table, size_t nRow,
+                                                        size_t nColumn, int smoothness,
+                                                        int extrapolation, int verbose,
+                                                        _In_z_ const char* delimiter,
+                                                        int nHeaderLines) {
+    CombiTableScattered2D* tableID;
+#if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
+    TableShare* file = NULL;
+    char* keyFile = NULL;
+#endif
+    double* tableFile = NULL;
+    size_t nRowFile = 0;
+    size_t nColFile = 0;
+    enum TableSource source = getTableSource(fileName, tableName);
+
+    /* Check interpolation and extrapolation kinds before any heap allocation */
+    if ((enum Smoothness)smoothness != LINEAR_SEGMENTS) {
+        ModelicaFormatError("Scattered data interpolation of table \"%s\" "
+            "is only implemented for linear segments.\n", tableName);
+        return NULL;
+    }
+    if ((enum Extrapolation)extrapolation == PERIODIC) {
+        ModelicaFormatError("Periodic extrapolation of scattered data of "
+            "table \"%s\" is not supported.\n", tableName);
+        return NULL;
+    }
+
+    /* Read table from file before any other heap allocation */
+    if (TABLESOURCE_FILE == source) {
+#if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
+        file = readTable(fileName, tableName, &nRowFile, &nColFile, verbose, 0, delimiter, nHeaderLines);
+        if (NULL != file) {
+            keyFile = file->key;
+            tableFile = file->table;
+        }
+        else {
+            return NULL;
+        }
+#else
+        tableFile = readTable(fileName, tableName, &nRowFile, &nColFile, verbose, 0, delimiter, nHeaderLines);
+        if (NULL == tableFile) {
+            return NULL;
+        }
+#endif
+    }
+
+    tableID = (CombiTableScattered2D*)calloc(1, sizeof(CombiTableScattered2D));
+    if (NULL == tableID) {
+#if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
+        if (NULL != file) {
+            MUTEX_LOCK();
+            if (--file->refCount == 0) {
+                ModelicaIO_freeRealTable(file->table);
+                free(file->key);
+                HASH_DEL(tableShare, file);
+                free(file);
+            }
+            MUTEX_UNLOCK();
+        }
+#else
+        if (NULL != tableFile) {
+            free(tableFile);
+        }
+#endif
+        ModelicaError("Memory allocation error\n");
+        return NULL;
+    }
+
+    tableID->smoothness = (enum Smoothness)smoothness;
+    tableID->extrapolation = (enum Extrapolation)extrapolation;
+    tableID->source = source;
+
+    switch (tableID->source) {
+        case TABLESOURCE_FILE:
+#if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
+            tableID->key = keyFile;
+#else
+            {
+                size_t lenFileName = strlen(fileName);
+                tableID->key = (char*)malloc((lenFileName + strlen(tableName) + 2)*sizeof(char));
+                if (NULL != tableID->key) {
+                    strcpy(tableID->key, fileName);
+                    strcpy(tableID->key + lenFileName + 1, tableName);
+                }
+            }
+#endif
+            tableID->nRow = nRowFile;
+            tableID->nCol = nColFile;
+            tableID->table = tableFile;
+            break;
+
+        case TABLESOURCE_MODEL:
+            tableID->nRow = nRow;
+            tableID->nCol = nColumn;
+#if defined(NO_TABLE_COPY)
+            tableID->table = (double*)table;
+#else
+            tableID->table = (double*)malloc(nRow*nColumn*sizeof(double));
+            if (NULL != tableID->table) {
+                memcpy(tableID->table, table, nRow*nColumn*sizeof(double));
+            }
+            else {
+                ModelicaStandardTables_CombiTableScattered2D_close(tableID);
+                ModelicaError("Memory allocation error\n");
+                return NULL;
+            }
+#endif
+            break;
+
+        case TABLESOURCE_FUNCTION:
+            ModelicaStandardTables_CombiTableScattered2D_close(tableID);
+            ModelicaFormatError("Table \"%s\" cannot be defined by function "
+                "\"usertab\" for scattered data interpolation.\n", tableName);
+            return NULL;
+
+        case TABLESOURCE_FUNCTION_TRANSPOSE:
+            /* Should not be possible to get here */
+            break;
+
+        default:
+            ModelicaStandardTables_CombiTableScattered2D_close(tableID);
+            ModelicaError("Table source error\n");
+            return NULL;
+    }
+
+    if (isValidCombiTableScattered2D(tableID, tableName, DO_CLEANUP) == 0) {
+        return NULL;
+    }
+    if (tableScattered2DInit(tableID, tableName, DO_CLEANUP) == 0) {
+        return NULL;
+    }
+
+    return (void*)tableID;
+}
+
+void ModelicaStandardTables_CombiTableScattered2D_close(void* _tableID) {
+    CombiTableScattered2D* tableID = (CombiTableScattered2D*)_tableID;
+    assert(NULL != tableID);
+    if (NULL != tableID->table && tableID->source == TABLESOURCE_FILE) {
+#if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
+        if (NULL != tableID->key) {
+            TableShare* file;
+            MUTEX_LOCK();
+            HASH_FIND_STR(tableShare, tableID->key, file);
+            if (NULL != file) {
+                /* Share hit */
+                if (--file->refCount == 0) {
+                    ModelicaIO_freeRealTable(file->table);
+                    free(file->key);
+                    HASH_DEL(tableShare, file);
+                    free(file);
+                }
+            }
+            MUTEX_UNLOCK();
+        }
+        else {
+            /* Should not be possible to get here */
+            free(tableID->table);
+        }
+#else
+        if (NULL != tableID->key) {
+            free(tableID->key);
+        }
+        free(tableID->table);
+#endif
+    }
+#if !defined(NO_TABLE_COPY)
+    else if (NULL != tableID->table && tableID->source == TABLESOURCE_MODEL) {
+        free(tableID->table);
+    }
+#endif
+    if (NULL != tableID->xy) {
+        free(tableID->xy);
+    }
+    if (NULL != tableID->triangles) {
+        free(tableID->triangles);
+    }
+    if (NULL != tableID->hull) {
+        free(tableID->hull);
+    }
+    free(tableID);
+}
+
+double ModelicaStandardTables_CombiTableScattered2D_getValue(void* _tableID,
+                                                             int iCol,
+                                                             double u1,
+                                                             double u2) {
+    double y = 0;
+    CombiTableScattered2D* tableID = (CombiTableScattered2D*)_tableID;
+    assert(NULL != tableID);
+    if (NULL != tableID->table && NULL != tableID->triangles) {
+        if (iCol < 1 || (size_t)iCol > tableID->nCol - 2) {
+            ModelicaFormatError("The column index %d is out of range "
+                "for the %lu ordinate columns of the table.\n", iCol,
+                (unsigned long)(tableID->nCol - 2));
+            return y;
+        }
+        y = tableScattered2DInterpolate(tableID, (size_t)iCol + 1, u1, u2,
+            NULL, NULL);
+    }
+    return y;
+}
+
+double ModelicaStandardTables_CombiTableScattered2D_getDerValue(void* _tableID,
+                                                                int iCol,
+                                                                double u1,
+                                                                double u2,
+                                                                double der_u1,
+                                                                double der_u2) {
+    double der_y = 0;
+    CombiTableScattered2D* tableID = (CombiTableScattered2D*)_tableID;
+    assert(NULL != tableID);
+    if (NULL != tableID->table && NULL != tableID->triangles) {
+        double der_u[2];
+        if (iCol < 1 || (size_t)iCol > tableID->nCol - 2) {
+            ModelicaFormatError("The column index %d is out of range "
+                "for the %lu ordinate columns of the table.\n", iCol,
+                (unsigned long)(tableID->nCol - 2));
+            return der_y;
+        }
+        der_u[0] = der_u1;
+        der_u[1] = der_u2;
+        (void)tableScattered2DInterpolate(tableID, (size_t)iCol + 1, u1, u2,
+            der_u, &der_y);
+    }
+    return der_y;
+}
+
+void ModelicaStandardTables_CombiTableScattered2D_minimumAbscissa(void* _tableID,
+                                                                  _Inout_ double* uMin) {
+    CombiTableScattered2D* tableID = (CombiTableScattered2D*)_tableID;
+    assert(NULL != tableID);
+    uMin[0] = NULL != tableID->table ? tableID->uMin[0] : 0.;
+    uMin[1] = NULL != tableID->table ? tableID->uMin[1] : 0.;
+}
+
+void ModelicaStandardTables_CombiTableScattered2D_maximumAbscissa(void* _tableID,
+                                                                  _Inout_ double* uMax) {
+    CombiTableScattered2D* tableID = (CombiTableScattered2D*)_tableID;
+    assert(NULL != tableID);
+    uMax[0] = NULL != tableID->table ? tableID->uMax[0] : 0.;
+    uMax[1] = NULL != tableID->table ? tableID->uMax[1] : 0.;
+}
+
+double ModelicaStandardTables_CombiTableScattered2D_read(void* _tableID, int force,
+                                                         int verbose) {
+#if !defined(NO_FILE_SYSTEM)
+    CombiTableScattered2D* tableID = (CombiTableScattered2D*)_tableID;
+    assert(NULL != tableID);
+    if (tableID->source == TABLESOURCE_FILE) {
+        if (force || NULL == tableID->table) {
+            const char* fileName = tableID->key;
+            const char* tableName = tableID->key + strlen(fileName) + 1;
+#if defined(TABLE_SHARE)
+            TableShare* file = readTable(fileName, tableName, &tableID->nRow,
+                &tableID->nCol, verbose, force, ",", 0);
+            if (NULL != file) {
+                tableID->table = file->table;
+            }
+            else {
+                return 0.; /* Error */
+            }
+#else
+            if (NULL != tableID->table) {
+                free(tableID->table);
+            }
+            tableID->table = readTable(fileName, tableName, &tableID->nRow,
+                &tableID->nCol, verbose, force, ",", 0);
+#endif
+            if (NULL == tableID->table) {
+                return 0.; /* Error */
+            }
+            if (isValidCombiTableScattered2D(tableID, tableName, NO_CLEANUP) == 0) {
+                return 0.; /* Error */
+            }
+            /* Reinitialization of the triangulation */
+            if (tableScattered2DInit(tableID, tableName, NO_CLEANUP) == 0) {
+                return 0.; /* Error */
+            }
+        }
+    }
+#endif
+    return 1.; /* Success */
+}
+
+/* ----- Internal functions ----- */
+
+static int isNearlyEqual(double x, double y) {
+    const double fx = fabs(x);
+    const double fy = fabs(y);
+    double cmp = fx > fy ? fx : fy;
+    if (cmp < _EPSILON) {
+        cmp = _EPSILON;
+    }
+    cmp *= _EPSILON;
+    return fabs(y - x) < cmp;
+}
+
+static double wrapPeriodic(double x, double xMin, double xMax) {
+    const double T = xMax - xMin;
+    if (x < xMin) {
+        /* fmod is exact and r is in (-T, 0] */
+        const double r = fmod(x - xMin, T);
+        x = r < 0 ? xMax + r : xMin;
+    }
+    else if (x > xMax) {
+        /* fmod is exact and r is in [0, T) */
+        const double r = fmod(x - xMin, T);
+        x = r > 0 ? xMin + r : xMax;
+    }
+    return x;
+}
+
+static size_t findRowIndex2(_In_ const double* table, size_t nRow, size_t nCol,
+                            size_t last, double x, double dx) {
+    size_t i0 = 0;
+    size_t i1 = nRow - 1;
+    if (isLessOrEqualWNegativeSlope(x, dx, TABLE_COL0(last))) {
+        i1 = last;
+    }
+    else if (!isLessOrEqualWNegativeSlope(x, dx, TABLE_COL0(last + 1))) {
+        i0 = last;
+    }
+    else {
+        return last;
+    }
+
+    /* Binary search */
+    while (i1 > i0 + 1) {
+        const size_t i = (i0 + i1)/2;
+        if (isLessOrEqualWNegativeSlope(x, dx, TABLE_COL0(i))) {
+            i1 = i;
+        }
+        else {
+            i0 = i;
+        }
+    }
+    return i0;
+}
+
+static size_t findRowIndexForward(_In_ const double* table, size_t nRow,
+                                  size_t nCol, size_t last, double x) {
+    size_t i;
+    for (i = 0; i < 8 && last + 2 < nRow && TABLE_COL0(last + 1) <= x; i++) {
+        last++;
+    }
+    return findRowIndex(table, nRow, nCol, last, x);
+}
+
+static size_t findRowIndex(_In_ const double* table, size_t nRow, size_t nCol,
+                           size_t last, double x) {
+    return findRowIndex2(table, nRow, nCol, last, x, 0.0);
+}
+
+static size_t findColIndex2(_In_ const double* table, size_t nCol, size_t last,
+                            double x, double dx) {
+    size_t i0 = 0;
+    size_t i1 = nCol - 1;
+    if (isLessOrEqualWNegativeSlope(x, dx, TABLE_ROW0(last))) {
+        i1 = last;
+    }
+    else if (!isLessOrEqualWNegativeSlope(x, dx, TABLE_ROW0(last + 1))) {
+        i0 = last;
+    }
+    else {
+        return last;
+    }
+
+    /* Binary search */
+    while (i1 > i0 + 1) {
+        const size_t i = (i0 + i1)/2;
+        if (isLessOrEqualWNegativeSlope(x, dx, TABLE_ROW0(i))) {
+            i1 = i;
+        }
+        else {
+            i0 = i;
+        }
+    }
+    return i0;
+}
+
+static size_t findRowIndexUniform(_In_ const double* table, size_t nRow,
+                                  size_t nCol, size_t last, double x,
+                                  double dx, double du) {
+    if (du > 0) {
+        /* Uniform abscissa values: The calculated start index is off by one
+           at most */
+        const double r = (x - TABLE_COL0(0))/du;
+        last = r > 0 ? (r < (double)(nRow - 2) ? (size_t)r : nRow - 2) : 0;
+        if (last > 0 && isLessOrEqualWNegativeSlope(x, dx, TABLE_COL0(last))) {
+            last--;
+        }
+        else if (last + 2 < nRow &&
+            !isLessOrEqualWNegativeSlope(x, dx, TABLE_COL0(last + 1))) {
+            last++;
+        }
+    }
+    return findRowIndex2(table, nRow, nCol, last, x, dx);
+}
+
+static size_t findColIndexUniform(_In_ const double* table, size_t nCol,
+                                  size_t last, double x, double dx,
+                                  double du) {
+    if (du > 0) {
+        /* Uniform abscissa values: The calculated start index is off by one
+           at most */
+        const double r = (x - TABLE_ROW0(0))/du;
+        last = r > 0 ? (r < (double)(nCol - 2) ? (size_t)r : nCol - 2) : 0;
+        if (last > 0 && isLessOrEqualWNegativeSlope(x, dx, TABLE_ROW0(last))) {
+            last--;
+        }
+        else if (last + 2 < nCol &&
+            !isLessOrEqualWNegativeSlope(x, dx, TABLE_ROW0(last + 1))) {
+            last++;
+        }
+    }
+    return findColIndex2(table, nCol, last, x, dx);
+}
+
+static double uniformSpacing(_In_ const double* x, size_t n, size_t stride) {
+    double dx = (x[(n - 1)*stride] - x[0])/(double)(n - 1);
+    size_t i;
+    for (i = 1; i < n - 1 && dx > 0; i++) {
+        if (fabs(x[i*stride] - (x[0] + (double)i*dx)) > 0.5*dx) {
+            dx = 0.;
+        }
+    }
+    return dx;
+}
+
+static size_t findGridIndex(_In_ const double* x, size_t n, size_t last,
+                            double dx, double u) {
+    size_t i0 = 0;
+    size_t i1 = n - 1;
+    if (dx > 0) {
+        /* Uniform grid: The calculated start index is off by one at most */
+        const double r = (u - x[0])/dx;
+        last = r > 0 ? (r < (double)(n - 2) ? (size_t)r : n - 2) : 0;
+    }
+    if (u <= x[last]) {
+        if (0 == last || u > x[last - 1]) {
+            return 0 == last ? 0 : last - 1;
+        }
+        i1 = last - 1;
+    }
+    else if (u > x[last + 1]) {
+        if (last + 2 == n || u <= x[last + 2]) {
+            return last + 2 == n ? last : last + 1;
+        }
+        i0 = last + 1;
+    }
+    else {
+        return last;
+    }
+
+    /* Binary search */
+    while (i1 > i0 + 1) {
+        const size_t i = (i0 + i1)/2;
+        if (u <= x[i]) {
+            i1 = i;
+        }
+        else {
+            i0 = i;
+        }
+    }
+    return i0;
+}
+
+/* ----- Internal check functions ----- */
+
+static int isLessOrEqualWNegativeSlope(double x, double dx, double val) {
+    return x < val || (x == val && dx < 0);
+}
+
+static Interval* eventIntervalsInit(_In_ const double* table, size_t nRow,
+                                    size_t nCol, enum TimeEvents timeEvents,
+                                    size_t* maxEvents) {
+    /* There are at most nRow event intervals */
+    Interval* intervals = (Interval*)calloc(nRow, sizeof(Interval));
+    size_t eventInterval = 0;
+
+    if (NULL == intervals) {
+        return NULL;
+    }
+
+    if (timeEvents == ALWAYS || timeEvents == AT_DISCONT) {
+        const double tMax = TABLE_COL0(nRow - 1);
+        double tEvent = TABLE_ROW0(0);
+        int isLast = 0;
+        size_t i;
+        for (i = 0; i < nRow - 1 && !isLast; i++) {
+            double t0 = TABLE_COL0(i);
+            double t1 = TABLE_COL0(i + 1);
+            if (timeEvents == ALWAYS) {
+                if (t1 > tEvent) {
+                    if (!isNearlyEqual(t0, t1)) {
+                        tEvent = t1;
+                        intervals[eventInterval][0] = i;
+                        intervals[eventInterval][1] = i + 1;
+                        eventInterval++;
+                        /* The last event interval ends at tMax */
+                        isLast = isNearlyEqual(t1, tMax);
+                    }
+                    else {
+                        intervals[eventInterval][0] = i + 1;
+                    }
+                }
+                else {
+                    intervals[eventInterval][1] = i + 1;
+                }
+            }
+            else /* if (timeEvents == AT_DISCONT) */ {
+                if (t1 > tEvent) {
+                    if (isNearlyEqual(t0, t1)) {
+                        tEvent = t1;
+                        intervals[eventInterval][1] = i;
+                        eventInterval++;
+                        /* The last event interval ends at tMax */
+                        isLast = isNearlyEqual(t1, tMax);
+                        if (!isLast) {
+                            intervals[eventInterval][0] = i + 1;
+                        }
+                    }
+                    else {
+                        intervals[eventInterval][1] = i + 1;
+                    }
+                }
+                else {
+                    intervals[eventInterval][0] = i + 1;
+                }
+            }
+        }
+        if (!isLast) {
+            /* There is at least one time event at the interval boundaries */
+            eventInterval++;
+        }
+    }
+    else {
+        intervals[0][1] = nRow - 1;
+        eventInterval = 1;
+    }
+
+    if (eventInterval < nRow) {
+        /* Release unused memory */
+        Interval* tmp = (Interval*)realloc(intervals,
+            eventInterval*sizeof(Interval));
+        if (NULL != tmp) {
+            intervals = tmp;
+        }
+    }
+    *maxEvents = eventInterval;
+    return intervals;
+}
+
+static size_t findEventInterval(_In_ const double* table, size_t nCol,
+                                _In_ const Interval* intervals, size_t i0,
+                                size_t i1, double t, double tOffset,
+                                double shiftTime) {
+    /* Binary search */
+    while (i1 > i0) {
+        const size_t i = i0 + (i1 - i0)/2;
+        if (TABLE_COL0(intervals[i][1]) + tOffset + shiftTime > t) {
+            i1 = i;
+        }
+        else {
+            i0 = i + 1;
+        }
+    }
+    return i0;
+}
+
+static int isValidName(_In_z_ const char* name) {
+    int isValid = 0;
+    if (NULL != name) {
+        if (strcmp(name, "NoName") != 0) {
             size_t i;
             size_t len = strlen(name);
             for (i = 0; i < len; i++) {
@@ -6316,10 +8237,11 @@ static int isValidCombiTimeTable(CombiTimeTable* tableID,
 
         if (NULL != tableID->table && nRow > 1) {
             const double* table = tableID->table;
+            const size_t rowStride = tableID->rowStride;
             /* Check period */
             if (tableID->extrapolation == PERIODIC) {
                 const double tMin = TABLE_ROW0(0);
-                const double tMax = TABLE_COL0(nRow - 1);
+                const double tMax = table[(nRow - 1)*rowStride];
                 const double T = tMax - tMin;
                 if (T <= 0) {
                     if (DO_CLEANUP == cleanUp) {
@@ -6342,8 +8264,8 @@ static int isValidCombiTimeTable(CombiTimeTable* tableID,
                 tableID->smoothness == STEFFEN_MONOTONE_C1) {
                 size_t i;
                 for (i = 0; i < nRow - 1; i++) {
-                    double t0 = TABLE_COL0(i);
-                    double t1 = TABLE_COL0(i + 1);
+                    double t0 = table[i*rowStride];
+                    double t1 = table[(i + 1)*rowStride];
                     if (t0 >= t1) {
                         if (DO_CLEANUP == cleanUp) {
                             ModelicaStandardTables_CombiTimeTable_close(tableID);
@@ -6362,8 +8284,8 @@ static int isValidCombiTimeTable(CombiTimeTable* tableID,
             else {
                 size_t i;
                 for (i = 0; i < nRow - 1; i++) {
-                    double t0 = TABLE_COL0(i);
-                    double t1 = TABLE_COL0(i + 1);
+                    double t0 = table[i*rowStride];
+                    double t1 = table[(i + 1)*rowStride];
                     if (t0 > t1) {
                         if (DO_CLEANUP == cleanUp) {
                             ModelicaStandardTables_CombiTimeTable_close(tableID);
@@ -6424,11 +8346,12 @@ static int isValidCombiTable1D(CombiTable1D* tableID,
 
         if (NULL != tableID->table) {
             const double* table = tableID->table;
+            const size_t rowStride = tableID->rowStride;
             size_t i;
             /* Check, whether first column values are strictly increasing */
             for (i = 0; i < nRow - 1; i++) {
-                double x0 = TABLE_COL0(i);
-                double x1 = TABLE_COL0(i + 1);
+                double x0 = table[i*rowStride];
+                double x1 = table[(i + 1)*rowStride];
                 if (x0 >= x1) {
                     if (DO_CLEANUP == cleanUp) {
                         ModelicaStandardTables_CombiTable1D_close(tableID);
@@ -6517,6 +8440,90 @@ static int isValidCombiTable2D(CombiTable2D* tableID,
     return isValid;
 }
 
+static int isValidCombiTableND(CombiTableND* tableID,
+                               _In_z_ const char* _tableName, enum CleanUp cleanUp) {
+    int isValid = 1;
+    if (NULL != tableID) {
+        const size_t nDim = tableID->nDim;
+        const size_t nTable = tableID->nTable;
+        const size_t nGridSum = tableID->grid[nDim - 1] + tableID->nGrid[nDim - 1];
+        const size_t nValue = tableID->nValue;
+        const char* tableDummyName = "NoName";
+        const char* tableName = _tableName[0] != '\0' ? _tableName : tableDummyName;
+
+        /* Check dimensions */
+        if (nTable != nGridSum + nValue) {
+            if (DO_CLEANUP == cleanUp) {
+                ModelicaStandardTables_CombiTableND_close(tableID);
+            }
+            ModelicaFormatError(
+                "Table vector \"%s(%lu)\" does not have appropriate "
+                "dimensions for %lu-dim. interpolation with %lu elements "
+                "of the grids and %lu table values.\n", tableName,
+                (unsigned long)nTable, (unsigned long)nDim,
+                (unsigned long)nGridSum, (unsigned long)nValue);
+            isValid = 0;
+            return isValid;
+        }
+
+        if (NULL != tableID->table) {
+            const double* table = tableID->table;
+            size_t i, k;
+            /* Check, whether grid values are strictly increasing */
+            for (k = 0; k < nDim; k++) {
+                const size_t i0 = tableID->grid[k];
+                for (i = i0; i < i0 + tableID->nGrid[k] - 1; i++) {
+                    double x0 = table[i];
+                    double x1 = table[i + 1];
+                    if (x0 >= x1) {
+                        if (DO_CLEANUP == cleanUp) {
+                            ModelicaStandardTables_CombiTableND_close(tableID);
+                        }
+                        ModelicaFormatError(
+                            "The grid values of dimension %lu of table \"%s(%lu)\" "
+                            "are not strictly increasing because %s(%lu) (=%lf) >= "
+                            "%s(%lu) (=%lf).\n", (unsigned long)k + 1, tableName,
+                            (unsigned long)nTable, tableName, (unsigned long)i + 1,
+                            x0, tableName, (unsigned long)i + 2, x1);
+                        isValid = 0;
+                        return isValid;
+                    }
+                }
+            }
+        }
+    }
+
+    return isValid;
+}
+
+static int isValidCombiTableScattered2D(CombiTableScattered2D* tableID,
+                                        _In_z_ const char* _tableName,
+                                        enum CleanUp cleanUp) {
+    int isValid = 1;
+    if (NULL != tableID) {
+        const size_t nRow = tableID->nRow;
+        const size_t nCol = tableID->nCol;
+        const char* tableDummyName = "NoName";
+        const char* tableName = _tableName[0] != '\0' ? _tableName : tableDummyName;
+
+        /* Check dimensions */
+        if (nRow < 3 || nCol < 3) {
+            if (DO_CLEANUP == cleanUp) {
+                ModelicaStandardTables_CombiTableScattered2D_close(tableID);
+            }
+            ModelicaFormatError(
+                "Table matrix \"%s(%lu,%lu)\" does not have appropriate "
+                "dimensions for scattered data interpolation (at least 3 "
+                "rows and 3 columns).\n", tableName, (unsigned long)nRow,
+                (unsigned long)nCol);
+            isValid = 0;
+            return isValid;
+        }
+    }
+
+    return isValid;
+}
+
 static enum TableSource getTableSource(_In_z_ const char* fileName,
                                        _In_z_ const char* tableName) {
     enum TableSource tableSource;
@@ -6555,8 +8562,8 @@ static enum TableSource getTableSource(_In_z_ const char* fileName,
 /* ----- Internal univariate spline functions ---- */
 
 static CubicHermite1D* akimaSpline1DInit(_In_ const double* table, size_t nRow,
-                                         size_t nCol, _In_ const int* cols,
-                                         size_t nCols) {
+                                         size_t nCol, size_t colStride,
+                                         _In_ const int* cols, size_t nCols) {
   /* Reference:
 
      Hiroshi Akima. A new method of interpolation and smooth curve fitting
@@ -6564,9 +8571,13 @@ static CubicHermite1D* akimaSpline1DInit(_In_ const double* table, size_t nRow,
      (https://dx.doi.org/10.1145/321607.321609)
   */
 
+#define D(i) d[IDX(i, k, nk)]
     CubicHermite1D* spline;
-    double* d; /* Divided differences */
-    size_t col;
+    double* dBuf; /* Divided differences (per block of columns and thread) */
+    const size_t nk0 = nCols < SPLINE_COL_BLOCK ? nCols : SPLINE_COL_BLOCK;
+    const size_t nBlocks = (nCols + SPLINE_COL_BLOCK - 1)/SPLINE_COL_BLOCK;
+    const size_t nThreads = SPLINE_THREADS(nBlocks, (nRow - 1)*nCols);
+    size_t iBlock;
 
     /* Actually there is no need for consecutive memory */
     spline = (CubicHermite1D*)malloc((nRow - 1)*nCols*sizeof(CubicHermite1D));
@@ -6574,67 +8585,80 @@ static CubicHermite1D* akimaSpline1DInit(_In_ const double* table, size_t nRow,
         return NULL;
     }
 
-    d = (double*)malloc((nRow + 3)*sizeof(double));
-    if (NULL == d) {
+    dBuf = (double*)malloc(nThreads*(nRow + 3)*nk0*sizeof(double));
+    if (NULL == dBuf) {
         free(spline);
         return NULL;
     }
 
-    for (col = 0; col < nCols; col++) {
-        size_t i;
-        double c2;
+#if defined(SPLINE_PARALLEL)
+#pragma omp parallel for if (nThreads > 1) schedule(static)
+#endif
+    for (iBlock = 0; iBlock < nBlocks; iBlock++) {
+        const size_t col0 = iBlock*SPLINE_COL_BLOCK;
+        const size_t nk = nCols - col0 < nk0 ? nCols - col0 : nk0;
+        double* d = &dBuf[SPLINE_THREAD_NUM()*(nRow + 3)*nk0];
+        double c2[SPLINE_COL_BLOCK];
+        size_t i, k;
 
         /* Calculation of the divided differences */
         for (i = 0; i < nRow - 1; i++) {
-            size_t c = (size_t)(cols[col] - 1);
-            d[i + 2] = (TABLE(i + 1, c) - TABLE(i, c))/
-                (TABLE_COL0(i + 1) - TABLE_COL0(i));
+            const double dx = TABLE_COL0(i + 1) - TABLE_COL0(i);
+            for (k = 0; k < nk; k++) {
+                const size_t c = (size_t)(cols[col0 + k] - 1)*colStride;
+                D(i + 2) = (TABLE(i + 1, c) - TABLE(i, c))/dx;
+            }
         }
 
-        /* Extrapolation using non-periodic boundary conditions */
-        d[0] = 3*d[2] - 2*d[3];
-        d[1] = 2*d[2] - d[3];
-        d[nRow + 1] = 2*d[nRow] - d[nRow - 1];
-        d[nRow + 2] = 3*d[nRow] - 2*d[nRow - 1];
+        for (k = 0; k < nk; k++) {
+            /* Extrapolation using non-periodic boundary conditions */
+            D(0) = 3*D(2) - 2*D(3);
+            D(1) = 2*D(2) - D(3);
+            D(nRow + 1) = 2*D(nRow) - D(nRow - 1);
+            D(nRow + 2) = 3*D(nRow) - 2*D(nRow - 1);
 
-        /* Initialization of the left boundary slope */
-        c2 = fabs(d[3] - d[2]) + fabs(d[1] - d[0]);
-        if (c2 > 0) {
-            const double a = fabs(d[1] - d[0])/c2;
-            c2 = (1 - a)*d[1] + a*d[2];
-        }
-        else {
-            c2 = 0.5*d[1] + 0.5*d[2];
+            /* Initialization of the left boundary slope */
+            c2[k] = fabs(D(3) - D(2)) + fabs(D(1) - D(0));
+            if (c2[k] > 0) {
+                const double a = fabs(D(1) - D(0))/c2[k];
+                c2[k] = (1 - a)*D(1) + a*D(2);
+            }
+            else {
+                c2[k] = 0.5*D(1) + 0.5*D(2);
+            }
         }
 
         /* Calculation of the 3(4) coefficients per interval */
         for (i = 0; i < nRow - 1; i++) {
             const double dx = TABLE_COL0(i + 1) - TABLE_COL0(i);
-            double* c = spline[IDX(i, col, nCols)];
+            for (k = 0; k < nk; k++) {
+                double* c = spline[IDX(i, col0 + k, nCols)];
 
-            c[2] = c2;
-            c2 = fabs(d[i + 4] - d[i + 3]) + fabs(d[i + 2] - d[i + 1]);
-            if (c2 > 0) {
-                const double a = fabs(d[i + 2] - d[i + 1])/c2;
-                c2 = (1 - a)*d[i + 2] + a*d[i + 3];
-            }
-            else {
-                c2 = 0.5*d[i + 2] + 0.5*d[i + 3];
+                c[2] = c2[k];
+                c2[k] = fabs(D(i + 4) - D(i + 3)) + fabs(D(i + 2) - D(i + 1));
+                if (c2[k] > 0) {
+                    const double a = fabs(D(i + 2) - D(i + 1))/c2[k];
+                    c2[k] = (1 - a)*D(i + 2) + a*D(i + 3);
+                }
+                else {
+                    c2[k] = 0.5*D(i + 2) + 0.5*D(i + 3);
+                }
+                c[1] = (3*D(i + 2) - 2*c[2] - c2[k])/dx;
+                c[0] = (c[2] + c2[k] - 2*D(i + 2))/(dx*dx);
+                /* No need to store the absolute term y0 */
+                /* c[3] = TABLE(i, cols[col0 + k] - 1); */
             }
-            c[1] = (3*d[i + 2] - 2*c[2] - c2)/dx;
-            c[0] = (c[2] + c2 - 2*d[i + 2])/(dx*dx);
-            /* No need to store the absolute term y0 */
-            /* c[3] = TABLE(i, cols[col] - 1); */
         }
     }
 
-    free(d);
+    free(dBuf);
     return spline;
+#undef D
 }
 
 static CubicHermite1D* makimaSpline1DInit(_In_ const double* table, size_t nRow,
-                                         size_t nCol, _In_ const int* cols,
-                                         size_t nCols) {
+                                         size_t nCol, size_t colStride,
+                                         _In_ const int* cols, size_t nCols) {
   /* Reference:
      Method description taken from section "Modified Akima formula" of:
 
@@ -6642,9 +8666,13 @@ static CubicHermite1D* makimaSpline1DInit(_In_ const double* table, size_t nRow,
      (https://blogs.mathworks.com/cleve/?p=4707)
   */
 
+#define D(i) d[IDX(i, k, nk)]
     CubicHermite1D* spline;
-    double* d; /* Divided differences */
-    size_t col;
+    double* dBuf; /* Divided differences (per block of columns and thread) */
+    const size_t nk0 = nCols < SPLINE_COL_BLOCK ? nCols : SPLINE_COL_BLOCK;
+    const size_t nBlocks = (nCols + SPLINE_COL_BLOCK - 1)/SPLINE_COL_BLOCK;
+    const size_t nThreads = SPLINE_THREADS(nBlocks, (nRow - 1)*nCols);
+    size_t iBlock;
 
     /* Actually there is no need for consecutive memory */
     spline = (CubicHermite1D*)malloc((nRow - 1)*nCols*sizeof(CubicHermite1D));
@@ -6652,68 +8680,82 @@ static CubicHermite1D* makimaSpline1DInit(_In_ const double* table, size_t nRow,
         return NULL;
     }
 
-    d = (double*)malloc((nRow + 3)*sizeof(double));
-    if (NULL == d) {
+    dBuf = (double*)malloc(nThreads*(nRow + 3)*nk0*sizeof(double));
+    if (NULL == dBuf) {
         free(spline);
         return NULL;
     }
 
-    for (col = 0; col < nCols; col++) {
-        size_t i;
-        double c2;
+#if defined(SPLINE_PARALLEL)
+#pragma omp parallel for if (nThreads > 1) schedule(static)
+#endif
+    for (iBlock = 0; iBlock < nBlocks; iBlock++) {
+        const size_t col0 = iBlock*SPLINE_COL_BLOCK;
+        const size_t nk = nCols - col0 < nk0 ? nCols - col0 : nk0;
+        double* d = &dBuf[SPLINE_THREAD_NUM()*(nRow + 3)*nk0];
+        double c2[SPLINE_COL_BLOCK];
+        size_t i, k;
 
         /* Calculation of the divided differences */
         for (i = 0; i < nRow - 1; i++) {
-            size_t c = (size_t)(cols[col] - 1);
-            d[i + 2] = (TABLE(i + 1, c) - TABLE(i, c))/
-                (TABLE_COL0(i + 1) - TABLE_COL0(i));
+            const double dx = TABLE_COL0(i + 1) - TABLE_COL0(i);
+            for (k = 0; k < nk; k++) {
+                const size_t c = (size_t)(cols[col0 + k] - 1)*colStride;
+                D(i + 2) = (TABLE(i + 1, c) - TABLE(i, c))/dx;
+            }
         }
 
-        /* Extrapolation using non-periodic boundary conditions */
-        d[0] = 3*d[2] - 2*d[3];
-        d[1] = 2*d[2] - d[3];
-        d[nRow + 1] = 2*d[nRow] - d[nRow - 1];
-        d[nRow + 2] = 3*d[nRow] - 2*d[nRow - 1];
+        for (k = 0; k < nk; k++) {
+            /* Extrapolation using non-periodic boundary conditions */
+            D(0) = 3*D(2) - 2*D(3);
+            D(1) = 2*D(2) - D(3);
+            D(nRow + 1) = 2*D(nRow) - D(nRow - 1);
+            D(nRow + 2) = 3*D(nRow) - 2*D(nRow - 1);
 
-        /* Initialization of the left boundary slope */
-        c2 = fabs(d[3] - d[2]) + fabs(d[1] - d[0]);
-        c2 += 0.5*fabs(d[3] + d[2]) + 0.5*fabs(d[1] + d[0]);
-        if (c2 > 0) {
-            const double a = (fabs(d[1] - d[0]) + 0.5*fabs(d[1] + d[0]))/c2;
-            c2 = (1 - a)*d[1] + a*d[2];
-        }
-        else {
-            c2 = 0.0;
+            /* Initialization of the left boundary slope */
+            c2[k] = fabs(D(3) - D(2)) + fabs(D(1) - D(0));
+            c2[k] += 0.5*fabs(D(3) + D(2)) + 0.5*fabs(D(1) + D(0));
+            if (c2[k] > 0) {
+                const double a = (fabs(D(1) - D(0)) + 0.5*fabs(D(1) + D(0)))/c2[k];
+                c2[k] = (1 - a)*D(1) + a*D(2);
+            }
+            else {
+                c2[k] = 0.0;
+            }
         }
 
         /* Calculation of the 3(4) coefficients per interval */
         for (i = 0; i < nRow - 1; i++) {
             const double dx = TABLE_COL0(i + 1) - TABLE_COL0(i);
-            double* c = spline[IDX(i, col, nCols)];
+            for (k = 0; k < nk; k++) {
+                double* c = spline[IDX(i, col0 + k, nCols)];
 
-            c[2] = c2;
-            c2 = fabs(d[i + 4] - d[i + 3]) + fabs(d[i + 2] - d[i + 1]);
-            c2 += 0.5*fabs(d[i + 4] + d[i + 3]) + 0.5*fabs(d[i + 2] + d[i + 1]);
-            if (c2 > 0) {
-                const double a = (fabs(d[i + 2] - d[i + 1]) + 0.5*fabs(d[i + 2] + d[i + 1]))/c2;
-                c2 = (1 - a)*d[i + 2] + a*d[i + 3];
-            }
-            else {
-                c2 = 0;
+                c[2] = c2[k];
+                c2[k] = fabs(D(i + 4) - D(i + 3)) + fabs(D(i + 2) - D(i + 1));
+                c2[k] += 0.5*fabs(D(i + 4) + D(i + 3)) + 0.5*fabs(D(i + 2) + D(i + 1));
+                if (c2[k] > 0) {
+                    const double a = (fabs(D(i + 2) - D(i + 1)) + 0.5*fabs(D(i + 2) + D(i + 1)))/c2[k];
+                    c2[k] = (1 - a)*D(i + 2) + a*D(i + 3);
+                }
+                else {
+                    c2[k] = 0;
+                }
+                c[1] = (3*D(i + 2) - 2*c[2] - c2[k])/dx;
+                c[0] = (c[2] + c2[k] - 2*D(i + 2))/(dx*dx);
+                /* No need to store the absolute term y0 */
+                /* c[3] = TABLE(i, cols[col0 + k] - 1); */
             }
-            c[1] = (3*d[i + 2] - 2*c[2] - c2)/dx;
-            c[0] = (c[2] + c2 - 2*d[i + 2])/(dx*dx);
-            /* No need to store the absolute term y0 */
-            /* c[3] = TABLE(i, cols[col] - 1); */
         }
     }
 
-    free(d);
+    free(dBuf);
     return spline;
+#undef D
 }
 
 static CubicHermite1D* fritschButlandSpline1DInit(_In_ const double* table,
                                                   size_t nRow, size_t nCol,
+                                                  size_t colStride,
                                                   _In_ const int* cols,
                                                   size_t nCols) {
   /* Reference:
@@ -6724,9 +8766,13 @@ static CubicHermite1D* fritschButlandSpline1DInit(_In_ const double* table,
      (https://dx.doi.org/10.1137/0905021)
   */
 
+#define D(i) d[IDX(i, k, nk)]
     CubicHermite1D* spline;
-    double* d; /* Divided differences */
-    size_t col;
+    double* dBuf; /* Divided differences (per block of columns and thread) */
+    const size_t nk0 = nCols < SPLINE_COL_BLOCK ? nCols : SPLINE_COL_BLOCK;
+    const size_t nBlocks = (nCols + SPLINE_COL_BLOCK - 1)/SPLINE_COL_BLOCK;
+    const size_t nThreads = SPLINE_THREADS(nBlocks, (nRow - 1)*nCols);
+    size_t iBlock;
 
     /* Actually there is no need for consecutive memory */
     spline = (CubicHermite1D*)malloc((nRow - 1)*nCols*sizeof(CubicHermite1D));
@@ -6734,135 +8780,531 @@ static CubicHermite1D* fritschButlandSpline1DInit(_In_ const double* table,
         return NULL;
     }
 
-    d = (double*)malloc((nRow - 1)*sizeof(double));
-    if (NULL == d) {
+    dBuf = (double*)malloc(nThreads*(nRow - 1)*nk0*sizeof(double));
+    if (NULL == dBuf) {
+        free(spline);
+        return NULL;
+    }
+
+#if defined(SPLINE_PARALLEL)
+#pragma omp parallel for if (nThreads > 1) schedule(static)
+#endif
+    for (iBlock = 0; iBlock < nBlocks; iBlock++) {
+        const size_t col0 = iBlock*SPLINE_COL_BLOCK;
+        const size_t nk = nCols - col0 < nk0 ? nCols - col0 : nk0;
+        double* d = &dBuf[SPLINE_THREAD_NUM()*(nRow - 1)*nk0];
+        double c2[SPLINE_COL_BLOCK];
+        size_t i, k;
+
+        /* Calculation of the divided differences */
+        for (i = 0; i < nRow - 1; i++) {
+            const double dx = TABLE_COL0(i + 1) - TABLE_COL0(i);
+            for (k = 0; k < nk; k++) {
+                const size_t c = (size_t)(cols[col0 + k] - 1)*colStride;
+                D(i) = (TABLE(i + 1, c) - TABLE(i, c))/dx;
+            }
+        }
+
+        /* Initialization of the left boundary slope */
+        for (k = 0; k < nk; k++) {
+            c2[k] = D(0);
+        }
+
+        /* Calculation of the 3(4) coefficients per interval */
+        for (i = 0; i < nRow - 1; i++) {
+            const double dx = TABLE_COL0(i + 1) - TABLE_COL0(i);
+            for (k = 0; k < nk; k++) {
+                double* c = spline[IDX(i, col0 + k, nCols)];
+
+                c[2] = c2[k];
+                if (i == nRow - 2) {
+                    c2[k] = D(nRow - 2);
+                }
+                else if (D(i) == 0 || D(i + 1) == 0 ||
+                    (D(i) < 0 && D(i + 1) > 0) || (D(i) > 0 && D(i + 1) < 0)) {
+                    c2[k] = 0;
+                }
+                else {
+                    const double dx_ = TABLE_COL0(i + 2) - TABLE_COL0(i + 1);
+                    c2[k] = 3*(dx + dx_)/((dx + 2*dx_)/D(i) + (dx_ + 2*dx)/D(i + 1));
+                }
+                c[1] = (3*D(i) - 2*c[2] - c2[k])/dx;
+                c[0] = (c[2] + c2[k] - 2*D(i))/(dx*dx);
+                /* No need to store the absolute term y0 */
+                /* c[3] = TABLE(i, cols[col0 + k] - 1); */
+            }
+        }
+    }
+
+    free(dBuf);
+    return spline;
+#undef D
+}
+
+static CubicHermite1D* steffenSpline1DInit(_In_ const double* table,
+                                           size_t nRow, size_t nCol,
+                                           size_t colStride,
+                                           _In_ const int* cols,
+                                           size_t nCols) {
+  /* Reference:
+
+     Matthias Steffen. A simple method for monotonic interpolation in one
+     dimension. Astronomy and Astrophysics, 239, 443-450, Nov. 1990.
+     (https://ui.adsabs.harvard.edu/#abs/1990A&A...239..443S)
+  */
+
+#define D(i) d[IDX(i, k, nk)]
+    CubicHermite1D* spline;
+    double* dBuf; /* Divided differences (per block of columns and thread) */
+    const size_t nk0 = nCols < SPLINE_COL_BLOCK ? nCols : SPLINE_COL_BLOCK;
+    const size_t nBlocks = (nCols + SPLINE_COL_BLOCK - 1)/SPLINE_COL_BLOCK;
+    const size_t nThreads = SPLINE_THREADS(nBlocks, (nRow - 1)*nCols);
+    size_t iBlock;
+
+    /* Actually there is no need for consecutive memory */
+    spline = (CubicHermite1D*)malloc((nRow - 1)*nCols*sizeof(CubicHermite1D));
+    if (NULL == spline) {
+        return NULL;
+    }
+
+    dBuf = (double*)malloc(nThreads*(nRow - 1)*nk0*sizeof(double));
+    if (NULL == dBuf) {
         free(spline);
         return NULL;
     }
 
-    for (col = 0; col < nCols; col++) {
-        size_t i;
-        double c2;
-
-        /* Calculation of the divided differences */
-        for (i = 0; i < nRow - 1; i++) {
-            size_t c = (size_t)(cols[col] - 1);
-            d[i] = (TABLE(i + 1, c) - TABLE(i, c))/
-                (TABLE_COL0(i + 1) - TABLE_COL0(i));
+#if defined(SPLINE_PARALLEL)
+#pragma omp parallel for if (nThreads > 1) schedule(static)
+#endif
+    for (iBlock = 0; iBlock < nBlocks; iBlock++) {
+        const size_t col0 = iBlock*SPLINE_COL_BLOCK;
+        const size_t nk = nCols - col0 < nk0 ? nCols - col0 : nk0;
+        double* d = &dBuf[SPLINE_THREAD_NUM()*(nRow - 1)*nk0];
+        double c2[SPLINE_COL_BLOCK];
+        size_t i, k;
+
+        /* Calculation of the divided differences */
+        for (i = 0; i < nRow - 1; i++) {
+            const double dx = TABLE_COL0(i + 1) - TABLE_COL0(i);
+            for (k = 0; k < nk; k++) {
+                const size_t c = (size_t)(cols[col0 + k] - 1)*colStride;
+                D(i) = (TABLE(i + 1, c) - TABLE(i, c))/dx;
+            }
+        }
+
+        /* Initialization of the left boundary slope */
+        for (k = 0; k < nk; k++) {
+            c2[k] = D(0);
+        }
+
+        /* Calculation of the 3(4) coefficients per interval */
+        for (i = 0; i < nRow - 1; i++) {
+            const double dx = TABLE_COL0(i + 1) - TABLE_COL0(i);
+            for (k = 0; k < nk; k++) {
+                double* c = spline[IDX(i, col0 + k, nCols)];
+
+                c[2] = c2[k];
+                if (i == nRow - 2) {
+                    c2[k] = D(nRow - 2);
+                }
+                else if (D(i) == 0 || D(i + 1) == 0 ||
+                    (D(i) < 0 && D(i + 1) > 0) || (D(i) > 0 && D(i + 1) < 0)) {
+                    c2[k] = 0;
+                }
+                else {
+                    const double dx_ = TABLE_COL0(i + 2) - TABLE_COL0(i + 1);
+                    double half_abs_c2, abs_di, abs_di1;
+                    c2[k] = (D(i)*dx_ + D(i + 1)*dx)/(dx + dx_);
+                    half_abs_c2 = 0.5*fabs(c2[k]);
+                    abs_di = fabs(D(i));
+                    abs_di1 = fabs(D(i + 1));
+                    if (half_abs_c2 > abs_di || half_abs_c2 > abs_di1) {
+                        const double two_a = D(i) > 0 ? 2 : -2;
+                        c2[k] = two_a*(abs_di < abs_di1 ? abs_di : abs_di1);
+                    }
+                }
+                c[1] = (3*D(i) - 2*c[2] - c2[k])/dx;
+                c[0] = (c[2] + c2[k] - 2*D(i))/(dx*dx);
+                /* No need to store the absolute term y0 */
+                /* c[3] = TABLE(i, cols[col0 + k] - 1); */
+            }
+        }
+    }
+
+    free(dBuf);
+    return spline;
+#undef D
+}
+
+static CubicHermite1D* spline1DInit(enum Smoothness smoothness,
+                                    _In_ const double* table, size_t nRow,
+                                    size_t nCol, size_t colStride,
+                                    _In_ const int* cols, size_t nCols) {
+    switch (smoothness) {
+        case AKIMA_C1:
+            return akimaSpline1DInit(table, nRow, nCol, colStride, cols, nCols);
+
+        case MAKIMA_C1:
+            return makimaSpline1DInit(table, nRow, nCol, colStride, cols, nCols);
+
+        case FRITSCH_BUTLAND_MONOTONE_C1:
+            return fritschButlandSpline1DInit(table, nRow, nCol, colStride, cols,
+                nCols);
+
+        case STEFFEN_MONOTONE_C1:
+            return steffenSpline1DInit(table, nRow, nCol, colStride, cols, nCols);
+
+        default:
+            return NULL;
+    }
+}
+
+static void spline1DClose(CubicHermite1D** spline) {
+    if (NULL != spline && NULL != *spline) {
+        free(*spline);
+        *spline = NULL;
+    }
+}
+
+static int* monotonicity1DInit(_In_ const double* table, size_t nRow,
+                               size_t nCol, size_t colStride,
+                               _In_ const int* cols, size_t nCols) {
+    int* monotone = (int*)malloc(nCols*sizeof(int));
+    if (NULL != monotone) {
+        size_t i, k;
+        for (k = 0; k < nCols; k++) {
+            const size_t col = (size_t)(cols[k] - 1)*colStride;
+            int m = 0;
+            if (nRow > 1) {
+                m = TABLE(1, col) > TABLE(0, col) ? 1 : -1;
+            }
+            for (i = 0; i < nRow - 1 && m != 0; i++) {
+                if (!(m*(TABLE(i + 1, col) - TABLE(i, col)) > 0)) {
+                    m = 0;
+                }
+            }
+            monotone[k] = m;
+        }
+    }
+    return monotone;
+}
+
+static double solveCubic(double a, double b, double c, double d) {
+    const double scale = fabs(a) + fabs(b) + fabs(c);
+    double t0 = 0.; /* Lower bound of the root */
+    double t1 = 1.; /* Upper bound of the root */
+    double tRoot[3];
+    size_t nRoot = 0;
+    double t = 0.5;
+    size_t i;
+
+    if (d == 0) {
+        return 0.;
+    }
+    if (a + b + c + d == 0) {
+        return 1.;
+    }
+
+    /* Real roots */
+    if (fabs(a) <= DBL_EPSILON*scale) {
+        if (fabs(b) <= DBL_EPSILON*scale) {
+            /* Linear */
+            if (c != 0) {
+                tRoot[nRoot++] = -d/c;
+            }
+        }
+        else {
+            /* Quadratic */
+            const double disc = c*c - 4*b*d;
+            if (disc >= 0) {
+                const double q = -0.5*(c + (c >= 0 ? sqrt(disc) : -sqrt(disc)));
+                tRoot[nRoot++] = q/b;
+                if (q != 0) {
+                    tRoot[nRoot++] = d/q;
+                }
+            }
+        }
+    }
+    else {
+        /* Cubic */
+        const double a2 = b/a;
+        const double a1 = c/a;
+        const double a0 = d/a;
+        const double Q = (a2*a2 - 3*a1)/9;
+        const double R = (2*a2*a2*a2 - 9*a2*a1 + 27*a0)/54;
+        if (R*R < Q*Q*Q) {
+            /* Three real roots */
+            const double twoPiThird = 2.0943951023931955;
+            const double phi = acos(R/sqrt(Q*Q*Q))/3;
+            const double r = -2*sqrt(Q);
+            tRoot[nRoot++] = r*cos(phi) - a2/3;
+            tRoot[nRoot++] = r*cos(phi + twoPiThird) - a2/3;
+            tRoot[nRoot++] = r*cos(phi - twoPiThird) - a2/3;
+        }
+        else {
+            /* One real root */
+            double A = pow(fabs(R) + sqrt(R*R - Q*Q*Q), 1./3.);
+            if (R > 0) {
+                A = -A;
+            }
+            tRoot[nRoot++] = A + (A != 0 ? Q/A : 0.) - a2/3;
+        }
+    }
+    for (i = 0; i < nRoot; i++) {
+        if (tRoot[i] >= 0 && tRoot[i] <= 1) {
+            t = tRoot[i];
+            break;
+        }
+    }
+
+    /* Refinement by Newton iterations, safeguarded by bisection */
+    for (i = 0; i < 100; i++) {
+        const double p = ((a*t + b)*t + c)*t + d;
+        const double dp = (3*a*t + 2*b)*t + c;
+        double tNew;
+        if (p == 0) {
+            break;
         }
+        if ((p < 0) == (d < 0)) {
+            t0 = t;
+        }
+        else {
+            t1 = t;
+        }
+        tNew = dp != 0 ? t - p/dp : t0;
+        if (!(tNew > t0 && tNew < t1)) {
+            tNew = 0.5*(t0 + t1);
+        }
+        if (fabs(tNew - t) <= DBL_EPSILON) {
+            t = tNew;
+            break;
+        }
+        t = tNew;
+    }
+    return t;
+}
 
-        /* Initialization of the left boundary slope */
-        c2 = d[0];
-
-        /* Calculation of the 3(4) coefficients per interval */
+static double* integral1DInit(enum Smoothness smoothness,
+                              _In_ const double* table, size_t nRow,
+                              size_t nCol, size_t colStride,
+                              _In_ const int* cols, size_t nCols,
+                              const CubicHermite1D* spline) {
+    double* integral = (double*)malloc(nRow*nCols*sizeof(double));
+    if (NULL != integral) {
+        size_t i, k;
+        for (k = 0; k < nCols; k++) {
+            integral[k] = 0.;
+        }
         for (i = 0; i < nRow - 1; i++) {
-            const double dx = TABLE_COL0(i + 1) - TABLE_COL0(i);
-            double* c = spline[IDX(i, col, nCols)];
-
-            c[2] = c2;
-            if (i == nRow - 2) {
-                c2 = d[nRow - 2];
-            }
-            else if (d[i] == 0 || d[i + 1] == 0 ||
-                (d[i] < 0 && d[i + 1] > 0) || (d[i] > 0 && d[i + 1] < 0)) {
-                c2 = 0;
+            const double dt = TABLE_COL0(i + 1) - TABLE_COL0(i);
+            for (k = 0; k < nCols; k++) {
+                const size_t col = (size_t)(cols[k] - 1)*colStride;
+                const double* c = NULL != spline ? spline[IDX(i, k, nCols)] : NULL;
+                integral[IDX(i + 1, k, nCols)] = integral[IDX(i, k, nCols)] +
+                    intervalIntegral1D(smoothness, table, nCol, col, c, i, dt);
             }
-            else {
-                const double dx_ = TABLE_COL0(i + 2) - TABLE_COL0(i + 1);
-                c2 = 3*(dx + dx_)/((dx + 2*dx_)/d[i] + (dx_ + 2*dx)/d[i + 1]);
-            }
-            c[1] = (3*d[i] - 2*c[2] - c2)/dx;
-            c[0] = (c[2] + c2 - 2*d[i])/(dx*dx);
-            /* No need to store the absolute term y0 */
-            /* c[3] = TABLE(i, cols[col] - 1); */
         }
     }
-
-    free(d);
-    return spline;
+    return integral;
 }
 
-static CubicHermite1D* steffenSpline1DInit(_In_ const double* table,
-                                           size_t nRow, size_t nCol,
-                                           _In_ const int* cols,
-                                           size_t nCols) {
-  /* Reference:
+static double intervalIntegral1D(enum Smoothness smoothness,
+                                 _In_ const double* table, size_t nCol,
+                                 size_t col, const double* c, size_t i,
+                                 double v) {
+    const double y0 = TABLE(i, col);
+    double F = 0.;
+    switch (smoothness) {
+        case LINEAR_SEGMENTS: {
+            const double t0 = TABLE_COL0(i);
+            const double t1 = TABLE_COL0(i + 1);
+            const double y1 = TABLE(i + 1, col);
+            if (isNearlyEqual(t0, t1)) {
+                F = y1*v;
+            }
+            else {
+                F = (y0 + 0.5*(y1 - y0)/(t1 - t0)*v)*v;
+            }
+            break;
+        }
 
-     Matthias Steffen. A simple method for monotonic interpolation in one
-     dimension. Astronomy and Astrophysics, 239, 443-450, Nov. 1990.
-     (https://ui.adsabs.harvard.edu/#abs/1990A&A...239..443S)
-  */
+        case CONSTANT_SEGMENTS:
+            F = y0*v;
+            break;
 
-    CubicHermite1D* spline;
-    double* d; /* Divided differences */
-    size_t col;
+        case AKIMA_C1:
+        case MAKIMA_C1:
+        case FRITSCH_BUTLAND_MONOTONE_C1:
+        case STEFFEN_MONOTONE_C1:
+            if (NULL != c) {
+                F = (((0.25*c[0]*v + c[1]/3)*v + 0.5*c[2])*v + y0)*v;
+            }
+            break;
 
-    /* Actually there is no need for consecutive memory */
-    spline = (CubicHermite1D*)malloc((nRow - 1)*nCols*sizeof(CubicHermite1D));
-    if (NULL == spline) {
-        return NULL;
+        default:
+            break;
     }
+    return F;
+}
 
-    d = (double*)malloc((nRow - 1)*sizeof(double));
-    if (NULL == d) {
-        free(spline);
-        return NULL;
+static double timeTableIntegral(_In_ const CombiTimeTable* tableID, size_t k,
+                                double t) {
+    const double* table = tableID->table;
+    const double* integral = tableID->integral;
+    const size_t nRow = tableID->nRow;
+    const size_t nCol = tableID->rowStride;
+    const size_t nCols = tableID->nCols;
+    const size_t col = ((size_t)tableID->cols[k] - 1)*tableID->colStride;
+    const double tMin = TABLE_ROW0(0);
+    const double tMax = TABLE_COL0(nRow - 1);
+    double F = 0.;
+
+    if (nRow == 1) {
+        /* Single row */
+        F = (t - tMin)*TABLE_ROW0(col);
     }
+    else {
+        enum PointInterval extrapolate = IN_TABLE;
+
+        /* Periodic extrapolation */
+        if (tableID->extrapolation == PERIODIC && (t < tMin || t > tMax)) {
+            const double tWrap = wrapPeriodic(t, tMin, tMax);
+            const double nPeriod = floor((t - tWrap)/(tMax - tMin) + 0.5);
+            F = nPeriod*integral[IDX(nRow - 1, k, nCols)];
+            t = tWrap;
+        }
+        else if (t < tMin) {
+            extrapolate = LEFT;
+        }
+        else if (t > tMax) {
+            extrapolate = RIGHT;
+        }
 
-    for (col = 0; col < nCols; col++) {
-        size_t i;
-        double c2;
-
-        /* Calculation of the divided differences */
-        for (i = 0; i < nRow - 1; i++) {
-            size_t c = (size_t)(cols[col] - 1);
-            d[i] = (TABLE(i + 1, c) - TABLE(i, c))/
-                (TABLE_COL0(i + 1) - TABLE_COL0(i));
+        if (extrapolate == IN_TABLE) {
+            const size_t last = findRowIndex(table, nRow, nCol, tableID->last, t);
+            const double* c = NULL != tableID->spline ?
+                tableID->spline[IDX(last, k, nCols)] : NULL;
+            F += integral[IDX(last, k, nCols)] + intervalIntegral1D(
+                tableID->smoothness, table, nCol, col, c, last,
+                t - TABLE_COL0(last));
         }
+        else {
+            /* Integral of the constant or linear extrapolation from the
+               boundary abscissa value */
+            const size_t last = (extrapolate == RIGHT) ? nRow - 2 : 0;
+            const size_t i = (extrapolate == RIGHT) ? nRow - 1 : 0;
+            const double dt = t - TABLE_COL0(i);
+            double dy_dt = 0.;
+            switch (tableID->extrapolation) {
+                case LAST_TWO_POINTS:
+                    switch (tableID->smoothness) {
+                        case LINEAR_SEGMENTS:
+                        case CONSTANT_SEGMENTS: {
+                            const double t0 = TABLE_COL0(last);
+                            const double t1 = TABLE_COL0(last + 1);
+                            if (!isNearlyEqual(t0, t1)) {
+                                dy_dt = (TABLE(last + 1, col) -
+                                    TABLE(last, col))/(t1 - t0);
+                            }
+                            break;
+                        }
 
-        /* Initialization of the left boundary slope */
-        c2 = d[0];
+                        case AKIMA_C1:
+                        case MAKIMA_C1:
+                        case FRITSCH_BUTLAND_MONOTONE_C1:
+                        case STEFFEN_MONOTONE_C1:
+                            if (NULL != tableID->spline) {
+                                const double* c = tableID->spline[
+                                    IDX(last, k, nCols)];
+                                if (extrapolate == LEFT) {
+                                    dy_dt = c[2];
+                                }
+                                else /* if (extrapolate == RIGHT) */ {
+                                    const double v = tMax - TABLE_COL0(nRow - 2);
+                                    dy_dt = (3*c[0]*v + 2*c[1])*v + c[2];
+                                }
+                            }
+                            break;
 
-        /* Calculation of the 3(4) coefficients per interval */
-        for (i = 0; i < nRow - 1; i++) {
-            const double dx = TABLE_COL0(i + 1) - TABLE_COL0(i);
-            double* c = spline[IDX(i, col, nCols)];
+                        default:
+                            ModelicaError("Unknown smoothness kind\n");
+                            return F;
+                    }
+                    break;
+
+                case HOLD_LAST_POINT:
+                    break;
+
+                case NO_EXTRAPOLATION:
+                    ModelicaFormatError("Extrapolation error: Time must be "
+                        "%s or equal\nthan the shifted %s abscissa "
+                        "value defined in the table.\n",
+                        (extrapolate == LEFT) ? "greater" : "less",
+                        (extrapolate == LEFT) ? "minimum" : "maximum");
+                    return F;
 
-            c[2] = c2;
-            if (i == nRow - 2) {
-                c2 = d[nRow - 2];
+                default:
+                    ModelicaError("Unknown extrapolation kind\n");
+                    return F;
             }
-            else if (d[i] == 0 || d[i + 1] == 0 ||
-                (d[i] < 0 && d[i + 1] > 0) || (d[i] > 0 && d[i + 1] < 0)) {
-                c2 = 0;
+            F = integral[IDX(i, k, nCols)] + (TABLE(i, col) + 0.5*dy_dt*dt)*dt;
+        }
+    }
+    return F;
+}
+
+static void interpolate1D(enum Smoothness smoothness,
+                          _In_ const double* table, size_t nCol,
+                          size_t colStride, _In_ const int* cols, size_t nCols,
+                          const CubicHermite1D* spline, size_t last, double u,
+                          double* y) {
+    size_t k;
+    switch (smoothness) {
+        case LINEAR_SEGMENTS: {
+            const double u0 = TABLE_COL0(last);
+            const double u1 = TABLE_COL0(last + 1);
+            if (isNearlyEqual(u0, u1)) {
+                for (k = 0; k < nCols; k++) {
+                    y[k] = TABLE(last + 1, (size_t)(cols[k] - 1)*colStride);
+                }
             }
             else {
-                const double dx_ = TABLE_COL0(i + 2) - TABLE_COL0(i + 1);
-                double half_abs_c2, abs_di, abs_di1;
-                c2 = (d[i]*dx_ + d[i + 1]*dx)/(dx + dx_);
-                half_abs_c2 = 0.5*fabs(c2);
-                abs_di = fabs(d[i]);
-                abs_di1 = fabs(d[i + 1]);
-                if (half_abs_c2 > abs_di || half_abs_c2 > abs_di1) {
-                    const double two_a = d[i] > 0 ? 2 : -2;
-                    c2 = two_a*(abs_di < abs_di1 ? abs_di : abs_di1);
+                const double t = (u - u0)/(u1 - u0);
+                for (k = 0; k < nCols; k++) {
+                    const size_t col = (size_t)(cols[k] - 1)*colStride;
+                    const double y0 = TABLE(last, col);
+                    y[k] = y0 + (TABLE(last + 1, col) - y0)*t;
                 }
             }
-            c[1] = (3*d[i] - 2*c[2] - c2)/dx;
-            c[0] = (c[2] + c2 - 2*d[i])/(dx*dx);
-            /* No need to store the absolute term y0 */
-            /* c[3] = TABLE(i, cols[col] - 1); */
+            break;
         }
-    }
 
-    free(d);
-    return spline;
-}
+        case CONSTANT_SEGMENTS:
+            if (u >= TABLE_COL0(last + 1)) {
+                last++;
+            }
+            for (k = 0; k < nCols; k++) {
+                y[k] = TABLE(last, (size_t)(cols[k] - 1)*colStride);
+            }
+            break;
 
-static void spline1DClose(CubicHermite1D** spline) {
-    if (NULL != spline && NULL != *spline) {
-        free(*spline);
-        *spline = NULL;
+        case AKIMA_C1:
+        case MAKIMA_C1:
+        case FRITSCH_BUTLAND_MONOTONE_C1:
+        case STEFFEN_MONOTONE_C1:
+            if (NULL != spline) {
+                const double v = u - TABLE_COL0(last);
+                for (k = 0; k < nCols; k++) {
+                    const double* c = spline[IDX(last, k, nCols)];
+                    y[k] = TABLE(last, (size_t)(cols[k] - 1)*colStride) +
+                        ((c[0]*v + c[1])*v + c[2])*v;
+                }
+            }
+            break;
+
+        default:
+            ModelicaError("Unknown smoothness kind\n");
+            return;
     }
 }
 
@@ -6924,25 +9366,14 @@ static CubicHermite2D* spline2DInit(_In_ const double* table, size_t nRow,
         size_t j;
         int cols = 2;
 
-        /* Need to transpose */
-        double* tableT = (double*)malloc(2*(nCol - 1)*sizeof(double));
-        if (NULL == tableT) {
-            return NULL;
-        }
-
         spline = (CubicHermite2D*)malloc((nCol - 2)*sizeof(CubicHermite2D));
         if (NULL == spline) {
-            free(tableT);
             return NULL;
         }
 
-        for (j = 1; j < nCol; j++) {
-            tableT[IDX(j - 1, 0, 2)] = TABLE_ROW0(j);
-            tableT[IDX(j - 1, 1, 2)] = TABLE(1, j);
-        }
-
-        spline1D = akimaSpline1DInit(tableT, nCol - 1, 2, &cols, 1);
-        free(tableT);
+        /* Interpolate the second row in place with column-wise strides */
+        spline1D = akimaSpline1DInit(&TABLE_ROW0(1), nCol - 1, 1, nCol, &cols,
+            1);
         if (NULL == spline1D) {
             free(spline);
             return NULL;
@@ -6967,7 +9398,7 @@ static CubicHermite2D* spline2DInit(_In_ const double* table, size_t nRow,
             return NULL;
         }
 
-        spline1D = akimaSpline1DInit(&table[2], nRow - 1, 2, &cols, 1);
+        spline1D = akimaSpline1DInit(&table[2], nRow - 1, 2, 1, &cols, 1);
         if (NULL == spline1D) {
             free(spline);
             return NULL;
@@ -6990,6 +9421,10 @@ static CubicHermite2D* spline2DInit(_In_ const double* table, size_t nRow,
         double* tableEx;
         double* x;
         double* y;
+#if defined(SPLINE_PARALLEL)
+        const int isParallel =
+            SPLINE_THREADS(nRow - 2, (nRow - 1)*(nCol - 1)) > 1;
+#endif
 
         /* This is not the most memory efficient implementation since the table
            memory is temporarily doubled for the sake of a clean calculation of
@@ -7128,6 +9563,9 @@ static CubicHermite2D* spline2DInit(_In_ const double* table, size_t nRow,
         }
 
         /* Calculation of the partial derivatives */
+#if defined(SPLINE_PARALLEL)
+#pragma omp parallel for private(j) if (isParallel) schedule(static)
+#endif
         for (i = 2; i < nRow + 1; i++) {
             for (j = 2; j < nCol + 1; j++) {
                 /* Divided differences */
@@ -7218,6 +9656,9 @@ static CubicHermite2D* spline2DInit(_In_ const double* table, size_t nRow,
         }
 
         /* Calculation of the 15(16) coefficients per grid */
+#if defined(SPLINE_PARALLEL)
+#pragma omp parallel for private(j) if (isParallel) schedule(static)
+#endif
         for (i = 0; i < nRow - 2; i++) {
             const double dx = TABLE_COL0(i + 2) - TABLE_COL0(i + 1);
             const double dx_2 = dx*dx;
@@ -7285,54 +9726,868 @@ static CubicHermite2D* spline2DInit(_In_ const double* table, size_t nRow,
             }
         }
 
-        free(dz_dx);
-        free(dz_dy);
-        free(d2z_dxdy);
+        free(dz_dx);
+        free(dz_dy);
+        free(d2z_dxdy);
+    }
+    return spline;
+#undef TABLE_EX
+}
+
+static void spline2DClose(CubicHermite2D** spline) {
+    if (NULL != spline && NULL != *spline) {
+        free(*spline);
+        *spline = NULL;
+    }
+}
+
+static void bicubicHermite2D(_In_ const double* c, double y00, double v1,
+                             double v2, int order, double* d) {
+    /* The polynomial is y = ((p1*v1 + p2)*v1 + p3)*v1 + p4 with the cubic
+       polynomials p1, ..., p4 in v2. Their evaluation by Horner's method
+       consists of four independent chains of multiply-add operations that
+       can be executed in parallel (and fused). */
+    double p[4];
+    double dp[4];
+    double d2p[4];
+    size_t k;
+    for (k = 0; k < 4; k++) {
+        const double* ck = &c[4*k];
+        p[k] = ((ck[0]*v2 + ck[1])*v2 + ck[2])*v2;
+    }
+    p[0] += c[3];
+    p[1] += c[7];
+    p[2] += c[11];
+    p[3] += y00; /* c[15] = y00 */
+    d[0] = ((p[0]*v1 + p[1])*v1 + p[2])*v1 + p[3];
+    if (order >= 1) {
+        for (k = 0; k < 4; k++) {
+            const double* ck = &c[4*k];
+            dp[k] = (3*ck[0]*v2 + 2*ck[1])*v2 + ck[2];
+        }
+        d[1] = (3*p[0]*v1 + 2*p[1])*v1 + p[2];
+        d[2] = ((dp[0]*v1 + dp[1])*v1 + dp[2])*v1 + dp[3];
+        if (order >= 2) {
+            for (k = 0; k < 4; k++) {
+                const double* ck = &c[4*k];
+                d2p[k] = 6*ck[0]*v2 + 2*ck[1];
+            }
+            d[3] = 6*p[0]*v1 + 2*p[1];
+            d[4] = (3*dp[0]*v1 + 2*dp[1])*v1 + dp[2];
+            d[5] = ((d2p[0]*v1 + d2p[1])*v1 + d2p[2])*v1 + d2p[3];
+        }
+    }
+}
+
+static void table2DAxesInit(_Inout_ CombiTable2D* tableID) {
+    const double* table = tableID->table;
+    const size_t nRow = tableID->nRow;
+    const size_t nCol = tableID->nCol;
+    tableID->du1 = nRow > 2 ? uniformSpacing(&TABLE(1, 0), nRow - 1, nCol) : 0.;
+    tableID->du2 = nCol > 2 ? uniformSpacing(&TABLE(0, 1), nCol - 1, 1) : 0.;
+    tableID->last1 = 0;
+    tableID->last2 = 0;
+}
+
+static void tableNDGridInit(_Inout_ CombiTableND* tableID) {
+    size_t k;
+    for (k = 0; k < tableID->nDim; k++) {
+        tableID->dx[k] = uniformSpacing(&tableID->table[tableID->grid[k]],
+            tableID->nGrid[k], 1);
+        tableID->last[k] = 0;
+    }
+}
+
+static double* tableNDSlopesInit(_In_ const CombiTableND* tableID) {
+    const double* table = tableID->table;
+    const double* values = &table[tableID->nTable - tableID->nValue];
+    const size_t nValue = tableID->nValue;
+    const size_t nMask = ((size_t)1 << tableID->nDim) - 1;
+    double* slopes;
+    double* d; /* Divided differences */
+    size_t nMax = 0;
+    size_t k, mask;
+
+    if (nValue > ((size_t)-1)/sizeof(double)/nMask) {
+        return NULL;
+    }
+    slopes = (double*)malloc(nMask*nValue*sizeof(double));
+    if (NULL == slopes) {
+        return NULL;
+    }
+
+    for (k = 0; k < tableID->nDim; k++) {
+        if (tableID->nGrid[k] > nMax) {
+            nMax = tableID->nGrid[k];
+        }
+    }
+    d = (double*)malloc((nMax + 3)*sizeof(double));
+    if (NULL == d) {
+        free(slopes);
+        return NULL;
+    }
+
+    /* The mixed partial derivative with respect to the dimensions of the
+       bit mask is the partial derivative with respect to its lowest
+       dimension of the (already calculated) mixed partial derivative with
+       respect to its remaining dimensions */
+    for (mask = 1; mask <= nMask; mask++) {
+        const size_t base = mask & (mask - 1);
+        const double* y = 0 == base ? values : &slopes[(base - 1)*nValue];
+        double* m = &slopes[(mask - 1)*nValue];
+        size_t n, stride, i0, i;
+        k = 0;
+        while (0 == (mask & ((size_t)1 << k))) {
+            k++;
+        }
+        n = tableID->nGrid[k];
+        stride = tableID->stride[k];
+        /* All grid lines along dimension k */
+        for (i0 = 0; i0 < nValue; i0 += n*stride) {
+            for (i = i0; i < i0 + stride; i++) {
+                tableNDSlopes1D(tableID->smoothness, &table[tableID->grid[k]],
+                    n, &y[i], stride, &m[i], d);
+            }
+        }
+    }
+
+    free(d);
+    return slopes;
+}
+
+static void tableNDSlopes1D(enum Smoothness smoothness, _In_ const double* x,
+                            size_t n, _In_ const double* y, size_t stride,
+                            _Inout_ double* m, _Inout_ double* d) {
+  /* The slopes are the same as of the 1D cubic Hermite splines of
+     akimaSpline1DInit, makimaSpline1DInit, fritschButlandSpline1DInit and
+     steffenSpline1DInit
+  */
+
+#define Y(i) y[(i)*stride]
+#define M(i) m[(i)*stride]
+    size_t i;
+
+    /* Calculation of the divided differences (with offset 2) */
+    for (i = 0; i < n - 1; i++) {
+        d[i + 2] = (Y(i + 1) - Y(i))/(x[i + 1] - x[i]);
+    }
+
+    if (n == 2) {
+        /* Linear */
+        M(0) = d[2];
+        M(1) = d[2];
+    }
+    else if (smoothness == AKIMA_C1 || smoothness == MAKIMA_C1) {
+        /* Extrapolation using non-periodic boundary conditions */
+        d[0] = 3*d[2] - 2*d[3];
+        d[1] = 2*d[2] - d[3];
+        d[n + 1] = 2*d[n] - d[n - 1];
+        d[n + 2] = 3*d[n] - 2*d[n - 1];
+
+        for (i = 0; i < n; i++) {
+            double a = fabs(d[i + 1] - d[i]);
+            double c = fabs(d[i + 3] - d[i + 2]) + a;
+            if (smoothness == MAKIMA_C1) {
+                a += 0.5*fabs(d[i + 1] + d[i]);
+                c += 0.5*fabs(d[i + 3] + d[i + 2]) + 0.5*fabs(d[i + 1] + d[i]);
+            }
+            if (c > 0) {
+                a /= c;
+                M(i) = (1 - a)*d[i + 1] + a*d[i + 2];
+            }
+            else {
+                M(i) = smoothness == MAKIMA_C1 ? 0.0 : 0.5*d[i + 1] + 0.5*d[i + 2];
+            }
+        }
+    }
+    else {
+        /* Fritsch-Butland or Steffen */
+        M(0) = d[2];
+        M(n - 1) = d[n];
+        for (i = 1; i < n - 1; i++) {
+            const double d0 = d[i + 1];
+            const double d1 = d[i + 2];
+            if (d0 == 0 || d1 == 0 || (d0 < 0 && d1 > 0) || (d0 > 0 && d1 < 0)) {
+                M(i) = 0;
+            }
+            else {
+                const double dx = x[i] - x[i - 1];
+                const double dx_ = x[i + 1] - x[i];
+                if (smoothness == FRITSCH_BUTLAND_MONOTONE_C1) {
+                    M(i) = 3*(dx + dx_)/((dx + 2*dx_)/d0 + (dx_ + 2*dx)/d1);
+                }
+                else {
+                    const double c = (d0*dx_ + d1*dx)/(dx + dx_);
+                    const double abs_d0 = fabs(d0);
+                    const double abs_d1 = fabs(d1);
+                    if (0.5*fabs(c) > abs_d0 || 0.5*fabs(c) > abs_d1) {
+                        const double two_a = d0 > 0 ? 2 : -2;
+                        M(i) = two_a*(abs_d0 < abs_d1 ? abs_d0 : abs_d1);
+                    }
+                    else {
+                        M(i) = c;
+                    }
+                }
+            }
+        }
+    }
+#undef Y
+#undef M
+}
+
+static double tableNDInterpolate(_Inout_ CombiTableND* tableID,
+                                 _In_ const double* u,
+                                 const double* der_u,
+                                 double* der_y) {
+    /* Per dimension there are up to four terms: The table values at the
+       lower and upper grid points and, for cubic Hermite interpolation,
+       the partial derivatives at the lower and upper grid points. Each
+       term consists of the offset of the grid point, the bit mask of the
+       partial derivative, the weight and the derivative of the weight. */
+    size_t nTerm[MAX_TABLE_ND_DIMENSIONS];
+    size_t offset[MAX_TABLE_ND_DIMENSIONS][4];
+    size_t mask[MAX_TABLE_ND_DIMENSIONS][4];
+    double w[MAX_TABLE_ND_DIMENSIONS][4];
+    double dw[MAX_TABLE_ND_DIMENSIONS][4];
+    /* Partial sums and products of the terms of the first k dimensions */
+    size_t term[MAX_TABLE_ND_DIMENSIONS];
+    size_t offsetSum[MAX_TABLE_ND_DIMENSIONS + 1];
+    size_t maskSum[MAX_TABLE_ND_DIMENSIONS + 1];
+    double wProd[MAX_TABLE_ND_DIMENSIONS + 1];
+    double dwProd[MAX_TABLE_ND_DIMENSIONS + 1];
+    const double* table = tableID->table;
+    const double* values = &table[tableID->nTable - tableID->nValue];
+    const size_t nDim = tableID->nDim;
+    double y = 0;
+    double dy = 0;
+    size_t k;
+
+    for (k = 0; k < nDim; k++) {
+        const double* x = &table[tableID->grid[k]];
+        const size_t n = tableID->nGrid[k];
+        const size_t stride = tableID->stride[k];
+        const size_t bit = (size_t)1 << k;
+        double uk = u[k];
+        double du = NULL != der_u ? der_u[k] : 0.;
+        enum PointInterval extrapolate = IN_TABLE;
+        size_t i;
+
+        if (uk < x[0]) {
+            extrapolate = LEFT;
+        }
+        else if (uk > x[n - 1]) {
+            extrapolate = RIGHT;
+        }
+        if (extrapolate != IN_TABLE) {
+            switch (tableID->extrapolation) {
+                case LAST_TWO_POINTS:
+                    break;
+
+                case HOLD_LAST_POINT:
+                    uk = (extrapolate == RIGHT) ? x[n - 1] : x[0];
+                    du = 0.;
+                    extrapolate = IN_TABLE;
+                    break;
+
+                case PERIODIC:
+                    uk = wrapPeriodic(uk, x[0], x[n - 1]);
+                    extrapolate = IN_TABLE;
+                    break;
+
+                case NO_EXTRAPOLATION:
+                    ModelicaFormatError("Extrapolation error: The value u[%lu] "
+                        "(=%lf) must be %s or equal\nthan the %s abscissa "
+                        "value (=%lf) of dimension %lu defined in the table.\n",
+                        (unsigned long)k + 1, uk,
+                        (extrapolate == LEFT) ? "greater" : "less",
+                        (extrapolate == LEFT) ? "minimum" : "maximum",
+                        (extrapolate == LEFT) ? x[0] : x[n - 1],
+                        (unsigned long)k + 1);
+                    return y;
+
+                default:
+                    ModelicaError("Unknown extrapolation kind\n");
+                    return y;
+            }
+        }
+
+        i = findGridIndex(x, n, tableID->last[k], tableID->dx[k], uk);
+        tableID->last[k] = i;
+        {
+            const size_t o0 = i*stride;
+            const size_t o1 = o0 + stride;
+            const double dx = x[i + 1] - x[i];
+            const double t = (uk - x[i])/dx;
+            if (extrapolate != IN_TABLE && NULL != tableID->slopes) {
+                /* Linear extrapolation by the partial derivative at the
+                   boundary grid point */
+                const size_t o = (extrapolate == LEFT) ? o0 : o1;
+                nTerm[k] = 2;
+                offset[k][0] = o;
+                mask[k][0] = 0;
+                w[k][0] = 1.;
+                dw[k][0] = 0.;
+                offset[k][1] = o;
+                mask[k][1] = bit;
+                w[k][1] = (extrapolate == LEFT) ? uk - x[0] : uk - x[n - 1];
+                dw[k][1] = du;
+            }
+            else if (extrapolate != IN_TABLE ||
+                tableID->smoothness == LINEAR_SEGMENTS) {
+                nTerm[k] = 2;
+                offset[k][0] = o0;
+                mask[k][0] = 0;
+                w[k][0] = 1 - t;
+                dw[k][0] = -du/dx;
+                offset[k][1] = o1;
+                mask[k][1] = 0;
+                w[k][1] = t;
+                dw[k][1] = du/dx;
+            }
+            else if (tableID->smoothness == CONSTANT_SEGMENTS) {
+                nTerm[k] = 1;
+                offset[k][0] = t < 1 ? o0 : o1;
+                mask[k][0] = 0;
+                w[k][0] = 1.;
+                dw[k][0] = 0.;
+            }
+            else if (NULL != tableID->slopes) {
+                /* Cubic Hermite basis functions */
+                const double h00_dt = 6*t*(t - 1);
+                nTerm[k] = 4;
+                offset[k][0] = o0;
+                mask[k][0] = 0;
+                w[k][0] = (2*t - 3)*t*t + 1;
+                dw[k][0] = h00_dt*du/dx;
+                offset[k][1] = o1;
+                mask[k][1] = 0;
+                w[k][1] = (3 - 2*t)*t*t;
+                dw[k][1] = -h00_dt*du/dx;
+                offset[k][2] = o0;
+                mask[k][2] = bit;
+                w[k][2] = ((t - 2)*t + 1)*t*dx;
+                dw[k][2] = ((3*t - 4)*t + 1)*du;
+                offset[k][3] = o1;
+                mask[k][3] = bit;
+                w[k][3] = (t - 1)*t*t*dx;
+                dw[k][3] = (3*t - 2)*t*du;
+            }
+            else {
+                ModelicaError("Unknown smoothness kind\n");
+                return y;
+            }
+        }
+    }
+
+    /* Sum over all combinations of the terms of the dimensions, where only
+       the partial sums and products of the dimensions with changed terms
+       are updated */
+    offsetSum[0] = 0;
+    maskSum[0] = 0;
+    wProd[0] = 1.;
+    dwProd[0] = 0.;
+    for (k = 0; k < nDim; k++) {
+        term[k] = 0;
+    }
+    k = 0;
+    do {
+        const double* data;
+        size_t j;
+        for (j = k; j < nDim; j++) {
+            const size_t l = term[j];
+            offsetSum[j + 1] = offsetSum[j] + offset[j][l];
+            maskSum[j + 1] = maskSum[j] | mask[j][l];
+            dwProd[j + 1] = dwProd[j]*w[j][l] + wProd[j]*dw[j][l];
+            wProd[j + 1] = wProd[j]*w[j][l];
+        }
+        data = 0 == maskSum[nDim] ? values :
+            &tableID->slopes[(maskSum[nDim] - 1)*tableID->nValue];
+        y += wProd[nDim]*data[offsetSum[nDim]];
+        dy += dwProd[nDim]*data[offsetSum[nDim]];
+
+        /* Next combination */
+        k = nDim;
+        while (k > 0 && ++term[k - 1] == nTerm[k - 1]) {
+            term[k - 1] = 0;
+            k--;
+        }
+    } while (k-- > 0);
+
+    if (NULL != der_y) {
+        *der_y = dy;
+    }
+    return y;
+}
+
+/* ----- Internal scattered data functions ---- */
+
+static int tableScattered2DInit(_Inout_ CombiTableScattered2D* tableID,
+                                _In_z_ const char* tableName,
+                                enum CleanUp cleanUp) {
+    const double* table = tableID->table;
+    const size_t nRow = tableID->nRow;
+    const size_t nCol = tableID->nCol;
+    size_t i, k, iPoint = 0;
+    int status;
+
+    if (NULL != tableID->xy) {
+        free(tableID->xy);
+        tableID->xy = NULL;
+    }
+    if (NULL != tableID->triangles) {
+        free(tableID->triangles);
+        tableID->triangles = NULL;
+    }
+    if (NULL != tableID->hull) {
+        free(tableID->hull);
+        tableID->hull = NULL;
+    }
+    tableID->nTriangle = 0;
+    tableID->nHull = 0;
+    tableID->last = 0;
+
+    /* Bounding box */
+    for (k = 0; k < 2; k++) {
+        tableID->uMin[k] = TABLE_ROW0(k);
+        tableID->uMax[k] = TABLE_ROW0(k);
+        for (i = 1; i < nRow; i++) {
+            const double u = TABLE(i, k);
+            if (u < tableID->uMin[k]) {
+                tableID->uMin[k] = u;
+            }
+            else if (u > tableID->uMax[k]) {
+                tableID->uMax[k] = u;
+            }
+        }
+    }
+
+    if (tableID->uMax[0] > tableID->uMin[0] &&
+        tableID->uMax[1] > tableID->uMin[1]) {
+        /* Scaling of the abscissa values to the unit square, such that the
+           triangulation does not depend on the units of u1 and u2 */
+        const double scale1 = 1./(tableID->uMax[0] - tableID->uMin[0]);
+        const double scale2 = 1./(tableID->uMax[1] - tableID->uMin[1]);
+        tableID->xy = (double*)malloc(2*nRow*sizeof(double));
+        if (NULL == tableID->xy) {
+            if (DO_CLEANUP == cleanUp) {
+                ModelicaStandardTables_CombiTableScattered2D_close(tableID);
+            }
+            ModelicaError("Memory allocation error\n");
+            return 0;
+        }
+        for (i = 0; i < nRow; i++) {
+            tableID->xy[2*i] = (TABLE(i, 0) - tableID->uMin[0])*scale1;
+            tableID->xy[2*i + 1] = (TABLE(i, 1) - tableID->uMin[1])*scale2;
+        }
+
+        status = delaunayInit(tableID->xy, nRow, &tableID->triangles,
+            &tableID->nTriangle, &iPoint);
+        if (1 == status) {
+            if (DO_CLEANUP == cleanUp) {
+                ModelicaStandardTables_CombiTableScattered2D_close(tableID);
+            }
+            ModelicaError("Memory allocation error\n");
+            return 0;
+        }
+        else if (2 == status) {
+            const double u1 = TABLE(iPoint, 0);
+            const double u2 = TABLE(iPoint, 1);
+            if (DO_CLEANUP == cleanUp) {
+                ModelicaStandardTables_CombiTableScattered2D_close(tableID);
+            }
+            ModelicaFormatError("The abscissa values of table \"%s\" are not "
+                "unique because the point (u1=%lf, u2=%lf) of row %lu is "
+                "defined twice.\n", tableName, u1, u2,
+                (unsigned long)iPoint + 1);
+            return 0;
+        }
+    }
+
+    if (0 == tableID->nTriangle) {
+        if (DO_CLEANUP == cleanUp) {
+            ModelicaStandardTables_CombiTableScattered2D_close(tableID);
+        }
+        ModelicaFormatError("The abscissa values of table \"%s\" are "
+            "collinear and cannot be triangulated.\n", tableName);
+        return 0;
+    }
+
+    /* Boundary edges */
+    for (i = 0; i < tableID->nTriangle; i++) {
+        for (k = 0; k < 3; k++) {
+            if (NO_TRIANGLE == tableID->triangles[i].n[k]) {
+                tableID->nHull++;
+            }
+        }
     }
-    return spline;
-#undef TABLE_EX
+    tableID->hull = (size_t*)malloc(tableID->nHull*sizeof(size_t));
+    if (NULL == tableID->hull) {
+        if (DO_CLEANUP == cleanUp) {
+            ModelicaStandardTables_CombiTableScattered2D_close(tableID);
+        }
+        ModelicaError("Memory allocation error\n");
+        return 0;
+    }
+    tableID->nHull = 0;
+    for (i = 0; i < tableID->nTriangle; i++) {
+        for (k = 0; k < 3; k++) {
+            if (NO_TRIANGLE == tableID->triangles[i].n[k]) {
+                tableID->hull[tableID->nHull++] = 3*i + k;
+            }
+        }
+    }
+    return 1;
 }
 
-static void spline2DClose(CubicHermite2D** spline) {
-    if (NULL != spline && NULL != *spline) {
-        free(*spline);
-        *spline = NULL;
+static int delaunayInit(_In_ const double* xy, size_t nPoint,
+                        Triangle** triangles, size_t* nTriangle,
+                        size_t* iPoint) {
+    /* A triangulation of n points and the 3 vertices of the super triangle
+       has 2*n + 1 triangles */
+    const size_t maxTriangle = 2*nPoint + 1;
+    const double M = TRIANGULATION_SUPER_SIZE;
+    double* p = (double*)malloc(2*(nPoint + 3)*sizeof(double));
+    Triangle* tri = (Triangle*)malloc(maxTriangle*sizeof(Triangle));
+    size_t* stack = (size_t*)malloc(maxTriangle*sizeof(size_t));
+    size_t* cavity = (size_t*)malloc(maxTriangle*sizeof(size_t));
+    size_t* edges = (size_t*)malloc(3*(maxTriangle + 2)*sizeof(size_t));
+    char* isBad = (char*)calloc(maxTriangle, sizeof(char));
+    size_t nTri = 1;
+    size_t last = 0;
+    size_t i, j, k;
+    int status = 0;
+
+    *triangles = NULL;
+    *nTriangle = 0;
+    if (NULL == p || NULL == tri || NULL == stack || NULL == cavity ||
+        NULL == edges || NULL == isBad) {
+        free(p);
+        free(tri);
+        free(stack);
+        free(cavity);
+        free(edges);
+        free(isBad);
+        return 1;
+    }
+
+    /* Super triangle containing the unit square */
+    memcpy(p, xy, 2*nPoint*sizeof(double));
+    p[2*nPoint] = -M;
+    p[2*nPoint + 1] = -M;
+    p[2*nPoint + 2] = 2*M + 1;
+    p[2*nPoint + 3] = -M;
+    p[2*nPoint + 4] = -M;
+    p[2*nPoint + 5] = 2*M + 1;
+    for (k = 0; k < 3; k++) {
+        tri[0].v[k] = nPoint + k;
+        tri[0].n[k] = NO_TRIANGLE;
+    }
+
+    for (i = 0; i < nPoint && 0 == status; i++) {
+        const double* pi = &p[2*i];
+        size_t nStack = 0;
+        size_t nCavity = 0;
+        size_t nEdge = 0;
+        int inside = 0;
+        size_t t = locateTriangle(tri, nTri, p, last, pi[0], pi[1], &inside);
+
+        for (k = 0; k < 3; k++) {
+            const double* v = &p[2*tri[t].v[k]];
+            if (v[0] == pi[0] && v[1] == pi[1]) {
+                *iPoint = i;
+                status = 2;
+            }
+        }
+        if (0 != status) {
+            break;
+        }
+
+        /* Cavity of the triangles whose circumcircles contain the point,
+           grown from the containing triangle to keep it connected */
+        isBad[t] = 1;
+        stack[nStack++] = t;
+        while (nStack > 0) {
+            const size_t s = stack[--nStack];
+            cavity[nCavity++] = s;
+            for (k = 0; k < 3; k++) {
+                const size_t nb = tri[s].n[k];
+                if (NO_TRIANGLE != nb && 0 == isBad[nb]) {
+                    const double* a = &p[2*tri[nb].v[0]];
+                    const double* b = &p[2*tri[nb].v[1]];
+                    const double* c = &p[2*tri[nb].v[2]];
+                    const double adx = a[0] - pi[0];
+                    const double ady = a[1] - pi[1];
+                    const double bdx = b[0] - pi[0];
+                    const double bdy = b[1] - pi[1];
+                    const double cdx = c[0] - pi[0];
+                    const double cdy = c[1] - pi[1];
+                    const double det =
+                        (adx*adx + ady*ady)*(bdx*cdy - cdx*bdy) +
+                        (bdx*bdx + bdy*bdy)*(cdx*ady - adx*cdy) +
+                        (cdx*cdx + cdy*cdy)*(adx*bdy - bdx*ady);
+                    if (det > 0) {
+                        isBad[nb] = 1;
+                        stack[nStack++] = nb;
+                    }
+                }
+            }
+        }
+
+        /* Boundary edges (a, b) of the cavity and their outer neighbours */
+        for (j = 0; j < nCavity; j++) {
+            const Triangle* s = &tri[cavity[j]];
+            for (k = 0; k < 3; k++) {
+                if (NO_TRIANGLE == s->n[k] || 0 == isBad[s->n[k]]) {
+                    edges[3*nEdge] = s->v[(k + 1) % 3];
+                    edges[3*nEdge + 1] = s->v[(k + 2) % 3];
+                    edges[3*nEdge + 2] = s->n[k];
+                    nEdge++;
+                }
+            }
+        }
+        for (j = 0; j < nCavity; j++) {
+            isBad[cavity[j]] = 0;
+        }
+
+        /* Fan of new triangles (i, a, b), reusing the cavity triangles */
+        for (j = 0; j < nEdge; j++) {
+            stack[j] = j < nCavity ? cavity[j] : nTri++;
+        }
+        for (j = 0; j < nEdge; j++) {
+            Triangle* s = &tri[stack[j]];
+            const size_t a = edges[3*j];
+            const size_t b = edges[3*j + 1];
+            const size_t nb = edges[3*j + 2];
+            s->v[0] = i;
+            s->v[1] = a;
+            s->v[2] = b;
+            s->n[0] = nb;
+            s->n[1] = NO_TRIANGLE;
+            s->n[2] = NO_TRIANGLE;
+            for (k = 0; k < nEdge; k++) {
+                if (edges[3*k] == b) {
+                    s->n[1] = stack[k];
+                }
+                if (edges[3*k + 1] == a) {
+                    s->n[2] = stack[k];
+                }
+            }
+            if (NO_TRIANGLE != nb) {
+                for (k = 0; k < 3; k++) {
+                    if (tri[nb].v[k] != a && tri[nb].v[k] != b) {
+                        tri[nb].n[k] = stack[j];
+                    }
+                }
+            }
+        }
+        last = stack[0];
+    }
+
+    if (0 == status) {
+        /* Removal of the triangles with vertices of the super triangle */
+        size_t* map = stack;
+        size_t n = 0;
+        for (j = 0; j < nTri; j++) {
+            if (tri[j].v[0] < nPoint && tri[j].v[1] < nPoint &&
+                tri[j].v[2] < nPoint) {
+                map[j] = n++;
+            }
+            else {
+                map[j] = NO_TRIANGLE;
+            }
+        }
+        for (j = 0; j < nTri; j++) {
+            if (NO_TRIANGLE != map[j]) {
+                Triangle* s = &tri[map[j]];
+                *s = tri[j];
+                for (k = 0; k < 3; k++) {
+                    if (NO_TRIANGLE != s->n[k]) {
+                        s->n[k] = map[s->n[k]];
+                    }
+                }
+            }
+        }
+        if (n > 0) {
+            *triangles = tri;
+            *nTriangle = n;
+            tri = NULL;
+        }
     }
+
+    free(p);
+    free(tri);
+    free(stack);
+    free(cavity);
+    free(edges);
+    free(isBad);
+    return status;
 }
 
-static void transpose(_Inout_ double* table, size_t nRow, size_t nCol) {
-  /* Reference:
+static size_t locateTriangle(_In_ const Triangle* triangles, size_t nTriangle,
+                             _In_ const double* xy, size_t t, double x,
+                             double y, _Inout_ int* inside) {
+    double pt[2];
+    size_t step;
+    pt[0] = x;
+    pt[1] = y;
+    *inside = 0;
+    if (t >= nTriangle) {
+        t = 0;
+    }
+    /* Visibility walk, starting the edge tests at alternating edges to
+       avoid cycles */
+    for (step = 0; step <= nTriangle; step++) {
+        const Triangle* s = &triangles[t];
+        size_t k;
+        for (k = 0; k < 3; k++) {
+            const size_t e = (k + step) % 3;
+            if (orient2D(&xy[2*s->v[(e + 1) % 3]], &xy[2*s->v[(e + 2) % 3]],
+                pt) < 0) {
+                break;
+            }
+        }
+        if (3 == k) {
+            *inside = 1;
+            return t;
+        }
+        k = (k + step) % 3;
+        if (NO_TRIANGLE == s->n[k]) {
+            /* The point is beyond a boundary edge */
+            return t;
+        }
+        t = s->n[k];
+    }
 
-     Cycle-based in-place array transposition
-     (http://en.wikipedia.org/wiki/In-place_matrix_transposition#Non-square_matrices:_Following_the_cycles)
-  */
+    /* Linear search (should not be necessary) */
+    for (t = 0; t < nTriangle; t++) {
+        const Triangle* s = &triangles[t];
+        if (orient2D(&xy[2*s->v[1]], &xy[2*s->v[2]], pt) >= 0 &&
+            orient2D(&xy[2*s->v[2]], &xy[2*s->v[0]], pt) >= 0 &&
+            orient2D(&xy[2*s->v[0]], &xy[2*s->v[1]], pt) >= 0) {
+            *inside = 1;
+            return t;
+        }
+    }
+    return 0;
+}
 
-    size_t i;
-    for (i = 1; i < nRow*nCol - 1; i++) {
-        size_t x = nRow*(i % nCol) + i/nCol; /* predecessor of i in the cycle */
-        /* Continue if cycle is of length one or predecessor already was visited */
-        if (x <= i) {
-            continue;
+static double orient2D(_In_ const double* a, _In_ const double* b,
+                       _In_ const double* c) {
+    return (b[0] - a[0])*(c[1] - a[1]) - (b[1] - a[1])*(c[0] - a[0]);
+}
+
+static double tableScattered2DInterpolate(_Inout_ CombiTableScattered2D* tableID,
+                                          size_t col, double u1, double u2,
+                                          const double* der_u,
+                                          double* der_y) {
+    const double* table = tableID->table;
+    const size_t nCol = tableID->nCol;
+    const Triangle* triangles = tableID->triangles;
+    const double* xy = tableID->xy;
+    const double scale1 = 1./(tableID->uMax[0] - tableID->uMin[0]);
+    const double scale2 = 1./(tableID->uMax[1] - tableID->uMin[1]);
+    double pt[2];
+    double y = 0.;
+    int inside;
+    size_t t;
+
+    pt[0] = (u1 - tableID->uMin[0])*scale1;
+    pt[1] = (u2 - tableID->uMin[1])*scale2;
+    t = locateTriangle(triangles, tableID->nTriangle, xy, tableID->last,
+        pt[0], pt[1], &inside);
+    if (inside) {
+        tableID->last = t;
+    }
+    else {
+        /* Extrapolation from the nearest boundary edge */
+        double dMin = DBL_MAX;
+        double sMin = 0.;
+        size_t hMin = 0;
+        size_t h;
+
+        if (NO_EXTRAPOLATION == tableID->extrapolation) {
+            ModelicaFormatError("Extrapolation error: The point (u1=%lf, "
+                "u2=%lf) must be inside of the convex hull of the abscissa "
+                "values defined in the table.\n", u1, u2);
+            return y;
         }
-        /* Continue if cycle already was visited */
-        while (x > i) {
-            x = nRow*(x % nCol) + x/nCol;
+        else if (HOLD_LAST_POINT != tableID->extrapolation &&
+            LAST_TWO_POINTS != tableID->extrapolation) {
+            ModelicaError("Unknown extrapolation kind\n");
+            return y;
         }
-        if (x < i) {
-            continue;
+
+        for (h = 0; h < tableID->nHull; h++) {
+            const Triangle* s = &triangles[tableID->hull[h]/3];
+            const size_t k = tableID->hull[h] % 3;
+            const double* a = &xy[2*s->v[(k + 1) % 3]];
+            const double* b = &xy[2*s->v[(k + 2) % 3]];
+            const double ex = b[0] - a[0];
+            const double ey = b[1] - a[1];
+            double sh = ((pt[0] - a[0])*ex + (pt[1] - a[1])*ey)/(ex*ex + ey*ey);
+            double dx, dy;
+            if (sh < 0.) {
+                sh = 0.;
+            }
+            else if (sh > 1.) {
+                sh = 1.;
+            }
+            dx = pt[0] - a[0] - sh*ex;
+            dy = pt[1] - a[1] - sh*ey;
+            if (dx*dx + dy*dy < dMin) {
+                dMin = dx*dx + dy*dy;
+                sMin = sh;
+                hMin = h;
+            }
         }
-        {
-            double tmp = table[i];
-            size_t s = i; /* start index in the cycle */
-            x = nRow*(i % nCol) + i/nCol; /* predecessor of i in the cycle */
-            while (x != i) {
-                table[s] = table[x];
-                s = x;
-                x = nRow*(x % nCol) + x/nCol;
+        t = tableID->hull[hMin]/3;
+
+        if (HOLD_LAST_POINT == tableID->extrapolation) {
+            /* Value at the nearest point of the boundary */
+            const Triangle* s = &triangles[t];
+            const size_t k = tableID->hull[hMin] % 3;
+            const size_t ia = s->v[(k + 1) % 3];
+            const size_t ib = s->v[(k + 2) % 3];
+            const double ya = TABLE(ia, col);
+            const double yb = TABLE(ib, col);
+            y = ya + sMin*(yb - ya);
+            if (NULL != der_u && NULL != der_y) {
+                *der_y = 0.;
+                if (sMin > 0. && sMin < 1.) {
+                    const double ex = xy[2*ib] - xy[2*ia];
+                    const double ey = xy[2*ib + 1] - xy[2*ia + 1];
+                    *der_y = (yb - ya)*(der_u[0]*scale1*ex +
+                        der_u[1]*scale2*ey)/(ex*ex + ey*ey);
+                }
             }
-            table[s] = tmp;
+            return y;
+        }
+    }
+
+    /* Linear interpolation (or extrapolation) in triangle t by barycentric
+       coordinates */
+    {
+        const Triangle* s = &triangles[t];
+        const double* a = &xy[2*s->v[0]];
+        const double* b = &xy[2*s->v[1]];
+        const double* c = &xy[2*s->v[2]];
+        const double ya = TABLE(s->v[0], col);
+        const double yb = TABLE(s->v[1], col);
+        const double yc = TABLE(s->v[2], col);
+        const double det = orient2D(a, b, c);
+        y = (orient2D(b, c, pt)*ya + orient2D(c, a, pt)*yb +
+            orient2D(a, b, pt)*yc)/det;
+        if (NULL != der_u && NULL != der_y) {
+            /* Gradient of the linear interpolant (with respect to the scaled
+               abscissa values) */
+            const double dy_dx = ((b[1] - c[1])*ya + (c[1] - a[1])*yb +
+                (a[1] - b[1])*yc)/det;
+            const double dy_dy = ((c[0] - b[0])*ya + (a[0] - c[0])*yb +
+                (b[0] - a[0])*yc)/det;
+            *der_y = dy_dx*scale1*der_u[0] + dy_dy*scale2*der_u[1];
         }
     }
+    return y;
 }
 
 /* ----- Internal I/O functions ----- */
@@ -7464,6 +10719,564 @@ static READ_RESULT readTable(_In_z_ const char* fileName, _In_z_ const char* tab
 #endif /* #if !defined(NO_FILE_SYSTEM) */
 }
 
+/* ----- Internal asynchronous load functions ----- */
+
+#if defined(ASYNC_LOAD)
+static TableLoad* tableLoadStart(_In_z_ const char* fileName,
+                                 _In_z_ const char* tableName, int verbose,
+                                 _In_z_ const char* delimiter,
+                                 int nHeaderLines) {
+    TableLoad* load;
+    TableLoad* pending;
+    TableLoad** last;
+    const size_t lenFileName = strlen(fileName);
+    const size_t lenTableName = strlen(tableName);
+    const size_t lenKey = lenFileName + lenTableName + strlen(delimiter) + 3;
+
+    load = (TableLoad*)malloc(sizeof(TableLoad));
+    if (NULL == load) {
+        return NULL;
+    }
+    load->key = (char*)malloc(lenKey*sizeof(char));
+    if (NULL == load->key) {
+        free(load);
+        return NULL;
+    }
+    strcpy(load->key, fileName);
+    strcpy(load->key + lenFileName + 1, tableName);
+    strcpy(load->key + lenFileName + lenTableName + 2, delimiter);
+    load->lenKey = lenKey;
+    load->nHeaderLines = nHeaderLines;
+    load->state = LOAD_QUEUED;
+    load->refCount = 1;
+    load->table = NULL;
+    load->nRow = 0;
+    load->nCol = 0;
+    load->message[0] = '\0';
+    load->next = NULL;
+
+#if defined(TABLE_SHARE)
+    {
+        TableShare* file;
+        MUTEX_LOCK();
+        HASH_FIND_STR(tableShare, load->key, file);
+        MUTEX_UNLOCK();
+        if (NULL != file) {
+            /* Share hit -> Read from table share */
+            free(load->key);
+            free(load);
+            return NULL;
+        }
+    }
+#endif
+
+    if (verbose == 1) {
+        /* Print info message, that table / file is loading */
+        ModelicaFormatMessage("... loading \"%s\" from \"%s\"\n",
+            tableName, fileName);
+    }
+
+    LOAD_LOCK();
+    last = &tableLoads;
+    for (pending = tableLoads; NULL != pending; pending = pending->next) {
+#if defined(TABLE_SHARE)
+        if (pending->lenKey == lenKey &&
+            pending->nHeaderLines == nHeaderLines &&
+            0 == memcmp(pending->key, load->key, lenKey)) {
+            /* Join pending load of same table file */
+            pending->refCount++;
+            LOAD_UNLOCK();
+            free(load->key);
+            free(load);
+            return pending;
+        }
+#endif
+        last = &pending->next;
+    }
+    *last = load;
+    if (nLoadThreads < MAX_TABLE_LOAD_THREADS) {
+        size_t i = 0;
+        while (THREAD_RUNNING == loadThreadStates[i]) {
+            i++;
+        }
+        if (THREAD_FINISHED == loadThreadStates[i]) {
+            tableLoadJoin(i);
+        }
+        if (tableLoadSpawn(i) == 1) {
+            loadThreadStates[i] = THREAD_RUNNING;
+            nLoadThreads++;
+        }
+    }
+    /* Otherwise the table file is loaded by a busy worker thread or on
+       first access */
+    LOAD_UNLOCK();
+    return load;
+}
+
+static int tableLoadFinish(_Inout_ TableLoad* load, _Inout_ char** key,
+                           _Inout_ double** table, _Inout_ size_t* nRow,
+                           _Inout_ size_t* nCol) {
+    char message[TABLE_LOAD_MESSAGE_SIZE];
+#if defined(TABLE_SHARE)
+    TableShare* file = NULL;
+#endif
+
+    LOAD_LOCK();
+    for (;;) {
+        if (LOAD_QUEUED == load->state) {
+            /* Not yet started by a worker thread */
+            tableLoadRun(load);
+        }
+        else if (LOAD_RUNNING == load->state) {
+            LOAD_WAIT();
+        }
+        else if (NULL != load->table || '\0' != load->message[0]) {
+            break;
+        }
+        else {
+#if defined(TABLE_SHARE)
+            /* Table already taken by another table object */
+            MUTEX_LOCK();
+            HASH_FIND_STR(tableShare, load->key, file);
+            if (NULL != file) {
+                /* Share hit -> Increment table reference counter */
+                file->refCount++;
+            }
+            MUTEX_UNLOCK();
+            if (NULL != file) {
+                break;
+            }
+#endif
+            /* Table share already released -> Load again */
+            load->state = LOAD_QUEUED;
+        }
+    }
+    strcpy(message, load->message);
+#if defined(TABLE_SHARE)
+    if (NULL != load->table) {
+        MUTEX_LOCK();
+        HASH_FIND_STR(tableShare, load->key, file);
+        if (NULL != file) {
+            /* Share hit -> Increment table reference counter */
+            ModelicaIO_freeRealTable(load->table);
+            file->refCount++;
+        }
+        else {
+            /* Share miss -> Insert new table */
+            const size_t lenKey = key_strlen(load->key);
+            char* keyFile = (char*)malloc((lenKey + 1)*sizeof(char));
+            file = (TableShare*)malloc(sizeof(TableShare));
+            if (NULL != keyFile && NULL != file) {
+                memcpy(keyFile, load->key, (lenKey + 1)*sizeof(char));
+                file->key = keyFile;
+                file->refCount = 1;
+                file->nRow = load->nRow;
+                file->nCol = load->nCol;
+                file->table = load->table;
+                HASH_ADD_KEYPTR(hh, tableShare, keyFile, lenKey, file);
+                if (NULL == file->hh.tbl) {
+                    free(keyFile);
+                    free(file);
+                    file = NULL;
+                }
+            }
+            else {
+                free(keyFile);
+                free(file);
+                file = NULL;
+            }
+            if (NULL == file) {
+                ModelicaIO_freeRealTable(load->table);
+                strcpy(message, "Memory allocation error\n");
+            }
+        }
+        MUTEX_UNLOCK();
+        load->table = NULL;
+    }
+    if (NULL != file) {
+        free(*key);
+        *key = file->key;
+        *table = file->table;
+        *nRow = file->nRow;
+        *nCol = file->nCol;
+    }
+#else
+    *table = load->table;
+    *nRow = load->nRow;
+    *nCol = load->nCol;
+    load->table = NULL;
+#endif
+    LOAD_UNLOCK();
+    tableLoadRelease(load);
+    if ('\0' != message[0]) {
+        ModelicaFormatError("%s", message);
+        return 0;
+    }
+    return 1;
+}
+
+static void tableLoadRelease(_Inout_ TableLoad* load) {
+    LOAD_LOCK();
+    if (--load->refCount == 0) {
+        TableLoad** last;
+        while (LOAD_RUNNING == load->state) {
+            LOAD_WAIT();
+        }
+        /* The load may have been joined while waiting */
+        if (load->refCount > 0) {
+            LOAD_UNLOCK();
+            return;
+        }
+        for (last = &tableLoads; *last != load; last = &(*last)->next) {
+        }
+        *last = load->next;
+        if (NULL == tableLoads) {
+            /* No thread executes code of the library once all tables are
+               closed */
+            size_t i;
+            while (NULL == tableLoads && nLoadThreads > 0) {
+                LOAD_WAIT();
+            }
+            for (i = 0; i < MAX_TABLE_LOAD_THREADS; i++) {
+                if (THREAD_FINISHED == loadThreadStates[i]) {
+                    tableLoadJoin(i);
+                }
+            }
+        }
+        LOAD_UNLOCK();
+        if (NULL != load->table) {
+            ModelicaIO_freeRealTable(load->table);
+        }
+        free(load->key);
+        free(load);
+        return;
+    }
+    LOAD_UNLOCK();
+}
+
+static void tableLoadRun(_Inout_ TableLoad* load) {
+    const char* fileName = load->key;
+    const char* tableName = fileName + strlen(fileName) + 1;
+    const char* delimiter = tableName + strlen(tableName) + 1;
+    double* table;
+    size_t nRow = 0;
+    size_t nCol = 0;
+
+    load->state = LOAD_RUNNING;
+    load->message[0] = '\0';
+    LOAD_UNLOCK();
+    table = ModelicaIO_readRealTableWithErrorReturn(fileName, tableName,
+        &nRow, &nCol, delimiter, load->nHeaderLines, load->message,
+        TABLE_LOAD_MESSAGE_SIZE);
+    LOAD_LOCK();
+    load->table = table;
+    load->nRow = nRow;
+    load->nCol = nCol;
+    load->state = LOAD_DONE;
+    LOAD_BROADCAST();
+}
+
+static void tableLoadWork(size_t i) {
+    LOAD_LOCK();
+    for (;;) {
+        TableLoad* load = tableLoads;
+        while (NULL != load && LOAD_QUEUED != load->state) {
+            load = load->next;
+        }
+        if (NULL == load) {
+            break;
+        }
+        tableLoadRun(load);
+    }
+    loadThreadStates[i] = THREAD_FINISHED;
+    nLoadThreads--;
+    LOAD_BROADCAST();
+    LOAD_UNLOCK();
+}
+
+#if defined(_POSIX_) && !defined(NO_MUTEX)
+static void* tableLoadThread(void* arg) {
+    tableLoadWork((size_t)((enum TableLoadThreadState*)arg - loadThreadStates));
+    return NULL;
+}
+
+static int tableLoadSpawn(size_t i) {
+    if (pthread_create(&loadThreads[i], NULL, tableLoadThread,
+        (void*)&loadThreadStates[i]) != 0) {
+        return 0;
+    }
+    return 1;
+}
+
+static void tableLoadJoin(size_t i) {
+    (void)pthread_join(loadThreads[i], NULL);
+    loadThreadStates[i] = THREAD_NONE;
+}
+#else
+static DWORD WINAPI tableLoadThread(LPVOID arg) {
+    tableLoadWork((size_t)((enum TableLoadThreadState*)arg - loadThreadStates));
+    return 0;
+}
+
+static int tableLoadSpawn(size_t i) {
+    loadThreads[i] = CreateThread(NULL, 0, tableLoadThread,
+        (LPVOID)&loadThreadStates[i], 0, NULL);
+    if (NULL == loadThreads[i]) {
+        return 0;
+    }
+    return 1;
+}
+
+static void tableLoadJoin(size_t i) {
+    (void)WaitForSingleObject(loadThreads[i], INFINITE);
+    (void)CloseHandle(loadThreads[i]);
+    loadThreadStates[i] = THREAD_NONE;
+}
+#endif
+#endif
+
+/* ----- Internal share functions ----- */
+
+#if defined(ARRAY_SHARE)
+static ArrayShare* arrayShareAcquire(_In_ const double* table, size_t nRow,
+                                     size_t nCol) {
+    ArrayShare* share = NULL;
+    const size_t len = nRow*nCol*sizeof(double);
+    unsigned hashv;
+
+    if (len == 0 || len > UINT_MAX) {
+        /* Key length of hash table is limited */
+        return share;
+    }
+
+    /* Hash table values and dimensions */
+    HASH_VALUE(table, (unsigned)len, hashv);
+    hashv ^= (unsigned)nRow*2654435761U;
+
+    MUTEX_LOCK();
+    HASH_FIND_BYHASHVALUE(hh, arrayShare, table, (unsigned)len, hashv, share);
+    if (NULL != share) {
+        if (share->nRow == nRow && share->nCol == nCol) {
+            /* Share hit -> Increment table reference counter */
+            share->refCount++;
+        }
+        else {
+            /* Same values, but different dimensions -> Do not share */
+            share = NULL;
+        }
+        MUTEX_UNLOCK();
+        return share;
+    }
+
+    /* Share miss -> Insert copy of table */
+    share = (ArrayShare*)malloc(sizeof(ArrayShare));
+    if (NULL == share) {
+        MUTEX_UNLOCK();
+        return share;
+    }
+    share->table = (double*)malloc(len);
+    if (NULL == share->table) {
+        free(share);
+        MUTEX_UNLOCK();
+        return NULL;
+    }
+    memcpy(share->table, table, len);
+    share->refCount = 1;
+    share->nRow = nRow;
+    share->nCol = nCol;
+    share->splines = NULL;
+    HASH_ADD_KEYPTR_BYHASHVALUE(hh, arrayShare, share->table, (unsigned)len,
+        hashv, share);
+    if (NULL == share->hh.tbl) {
+        free(share->table);
+        free(share);
+        MUTEX_UNLOCK();
+        return NULL;
+    }
+    MUTEX_UNLOCK();
+    return share;
+}
+
+static void* splineShareAcquire(_Inout_ ArrayShare* share, int nDim,
+                                enum Smoothness smoothness,
+                                const int* cols, size_t nCols) {
+    SplineShare* item;
+    void* spline;
+
+    MUTEX_LOCK();
+    for (item = share->splines; NULL != item; item = item->next) {
+        if (item->nDim == nDim && item->smoothness == smoothness &&
+            item->nCols == nCols && (0 == nCols ||
+            memcmp(item->cols, cols, nCols*sizeof(int)) == 0)) {
+            /* Share hit -> Increment spline reference counter */
+            item->refCount++;
+            MUTEX_UNLOCK();
+            return item->spline;
+        }
+    }
+    MUTEX_UNLOCK();
+
+    /* Share miss -> Calculate and insert spline coefficients */
+    if (nDim == 1) {
+        spline = (void*)spline1DInit(smoothness, (const double*)share->table,
+            share->nRow, share->nCol, 1, cols, nCols);
+    }
+    else {
+        spline = (void*)spline2DInit((const double*)share->table,
+            share->nRow, share->nCol);
+    }
+    if (NULL == spline) {
+        return spline;
+    }
+
+    item = (SplineShare*)calloc(1, sizeof(SplineShare));
+    if (NULL == item) {
+        free(spline);
+        return NULL;
+    }
+    if (nCols > 0) {
+        item->cols = (int*)malloc(nCols*sizeof(int));
+        if (NULL == item->cols) {
+            free(item);
+            free(spline);
+            return NULL;
+        }
+        memcpy(item->cols, cols, nCols*sizeof(int));
+    }
+    item->nDim = nDim;
+    item->smoothness = smoothness;
+    item->nCols = nCols;
+    item->refCount = 1;
+    item->spline = spline;
+
+    MUTEX_LOCK();
+    item->next = share->splines;
+    share->splines = item;
+    MUTEX_UNLOCK();
+    return spline;
+}
+
+static void arrayShareRelease(_Inout_ ArrayShare* share, void* spline) {
+    MUTEX_LOCK();
+    if (NULL != spline) {
+        SplineShare** pItem = &share->splines;
+        while (NULL != *pItem) {
+            SplineShare* item = *pItem;
+            if (item->spline == spline) {
+                if (--item->refCount == 0) {
+                    *pItem = item->next;
+                    free(item->spline);
+                    free(item->cols);
+                    free(item);
+                }
+                break;
+            }
+            pItem = &item->next;
+        }
+    }
+    if (--share->refCount == 0) {
+        while (NULL != share->splines) {
+            /* Should not be possible to get here */
+            SplineShare* item = share->splines;
+            share->splines = item->next;
+            free(item->spline);
+            free(item->cols);
+            free(item);
+        }
+        HASH_DEL(arrayShare, share);
+        free(share->table);
+        free(share);
+    }
+    MUTEX_UNLOCK();
+}
+#endif
+
+/* ----- Internal time event group functions ----- */
+
+static void eventGroupRelease(_Inout_ EventGroup* group) {
+    if (--group->refCount == 0) {
+        if (NULL != group->heap) {
+            free(group->heap);
+        }
+        free(group);
+    }
+}
+
+static int eventGroupAdd(_Inout_ EventGroup* group,
+                         _Inout_ CombiTimeTable* tableID) {
+    if (group->nMember == group->maxMember) {
+        const size_t maxMember = group->maxMember > 0 ?
+            2*group->maxMember : 8;
+        EventGroupMember* heap = (EventGroupMember*)realloc(group->heap,
+            maxMember*sizeof(EventGroupMember));
+        if (NULL == heap) {
+            return 0;
+        }
+        group->heap = heap;
+        group->maxMember = maxMember;
+    }
+    /* The next time event of the new member is yet unknown */
+    group->heap[group->nMember].nextTimeEvent = -DBL_MAX;
+    group->heap[group->nMember].tableID = tableID;
+    tableID->group = group;
+    tableID->groupIndex = group->nMember;
+    group->nMember++;
+    eventGroupSiftUp(group, tableID->groupIndex);
+    return 1;
+}
+
+static void eventGroupRemove(_Inout_ EventGroup* group,
+                             _Inout_ CombiTimeTable* tableID) {
+    const size_t i = tableID->groupIndex;
+    group->nMember--;
+    if (i < group->nMember) {
+        /* Replace by last member */
+        group->heap[i] = group->heap[group->nMember];
+        group->heap[i].tableID->groupIndex = i;
+        eventGroupSiftUp(group, i);
+        eventGroupSiftDown(group, group->heap[i].tableID->groupIndex);
+    }
+    tableID->group = NULL;
+    tableID->groupIndex = 0;
+}
+
+static void eventGroupSiftUp(_Inout_ EventGroup* group, size_t i) {
+    EventGroupMember* heap = group->heap;
+    const EventGroupMember member = heap[i];
+    while (i > 0) {
+        const size_t parent = (i - 1)/2;
+        if (heap[parent].nextTimeEvent <= member.nextTimeEvent) {
+            break;
+        }
+        heap[i] = heap[parent];
+        heap[i].tableID->groupIndex = i;
+        i = parent;
+    }
+    heap[i] = member;
+    member.tableID->groupIndex = i;
+}
+
+static void eventGroupSiftDown(_Inout_ EventGroup* group, size_t i) {
+    EventGroupMember* heap = group->heap;
+    const size_t n = group->nMember;
+    const EventGroupMember member = heap[i];
+    while (2*i + 1 < n) {
+        size_t child = 2*i + 1;
+        if (child + 1 < n &&
+            heap[child + 1].nextTimeEvent < heap[child].nextTimeEvent) {
+            child++;
+        }
+        if (member.nextTimeEvent <= heap[child].nextTimeEvent) {
+            break;
+        }
+        heap[i] = heap[child];
+        heap[i].tableID->groupIndex = i;
+        i = child;
+    }
+    heap[i] = member;
+    member.tableID->groupIndex = i;
+}
+
 #if defined(__clang__)
 #pragma clang diagnostic pop
 #endif
@@ -39,6 +39,18 @@
                            arrays are stored in a global hash table in order to
                            avoid superfluous file input access and to decrease the
                            utilized memory (tickets #1110 and #1550).
+                           If NO_TABLE_COPY is not defined either then table arrays
+                           passed to _init functions are also shared if equal by
+                           content (dimensions and values), together with their
+                           cubic Hermite spline coefficients.
+   TABLE_ASYNC_LOAD      : If NO_FILE_SYSTEM is not defined then tables of
+                           CombiTimeTable, CombiTable1D and CombiTable2D are
+                           loaded from file by a bounded pool of worker threads,
+                           such that the files of multiple tables are read in
+                           parallel at initialization. A table is validated on
+                           its first access, which waits for its load to finish.
+                           Requires thread-local storage and POSIX threads or
+                           Windows (Vista or later).
    DEBUG_TIME_EVENTS     : Trace time events of CombiTimeTable
    DUMMY_FUNCTION_USERTAB: Use a dummy function "usertab"
 
@@ -266,6 +278,33 @@ MODELICA_EXPORT double ModelicaStandardTables_CombiTimeTable_getDer2Value(void*
      <- RETURN: Second derivative of ordinate value
   */
 
+MODELICA_EXPORT double ModelicaStandardTables_CombiTimeTable_getIntegralValue(void* tableID,
+                                                             int icol,
+                                                             double t0,
+                                                             double t1);
+  /* Integral of interpolated values in table
+
+     -> tableID: Pointer to table defined with ModelicaStandardTables_CombiTimeTable_init
+     -> icol: Index (1-based) of column to interpolate
+     -> t0: Lower abscissa value (time) of integral
+     -> t1: Upper abscissa value (time) of integral
+     <- RETURN: Integral of ordinate value from t0 to t1 (being zero
+                before start time and negative if t1 < t0)
+  */
+
+MODELICA_EXPORT void ModelicaStandardTables_CombiTimeTable_resample(void* tableID,
+                                                   _In_ const double* t,
+                                                   size_t n, double* y);
+  /* Interpolate all columns in table at a sequence of abscissa values
+
+     -> tableID: Pointer to table defined with ModelicaStandardTables_CombiTimeTable_init
+     -> t: Abscissa values (time), preferably in increasing order
+     -> n: Number of abscissa values
+     <- y: Ordinate values (n rows, one column per interpolated column of
+           the table, stored row-wise). At discontinuities the value after
+           the time event is returned.
+  */
+
 MODELICA_EXPORT double ModelicaStandardTables_CombiTimeTable_nextTimeEvent(void* tableID, double t);
   /* Return next time event in table
 
@@ -278,6 +317,36 @@ MODELICA_EXPORT double ModelicaStandardTables_CombiTimeTable_read(void* tableID,
                                                   int verbose);
   /* Empty function, kept only for backward compatibility */
 
+MODELICA_EXPORT void ModelicaStandardTables_CombiTimeTable_joinGroup(void* tableID,
+                                                     void* groupID);
+  /* Add table to a time event group (and remove it from its previous group).
+     The table leaves the group when it is closed.
+
+     -> tableID: Pointer to table defined with ModelicaStandardTables_CombiTimeTable_init
+     -> groupID: Pointer to group defined with ModelicaStandardTables_group_init
+  */
+
+MODELICA_EXPORT void* ModelicaStandardTables_group_init(void);
+  /* Create a time event group. A group and its member tables must belong to
+     the same model instance; they are not synchronized between threads.
+
+     <- RETURN: Pointer to internal memory of group structure
+  */
+
+MODELICA_EXPORT void ModelicaStandardTables_group_close(void* groupID);
+  /* Close time event group, the group is freed when it has no members left */
+
+MODELICA_EXPORT double ModelicaStandardTables_group_nextTimeEvent(void* groupID, double t);
+  /* Return next time event of all tables of a time event group. Only the
+     tables with a next time event <= t are advanced, hence the costs per
+     call are logarithmic in the number of tables of the group.
+
+     -> groupID: Pointer to group defined with ModelicaStandardTables_group_init
+     -> t: Abscissa value (time)
+     <- RETURN: Next abscissa value > t that triggers a time event in any
+                table of the group
+  */
+
 MODELICA_EXPORT void* ModelicaStandardTables_CombiTable1D_init(_In_z_ const char* tableName,
                                                _In_z_ const char* fileName,
                                                _In_ const double* table, size_t nRow,
@@ -384,6 +453,33 @@ MODELICA_EXPORT double ModelicaStandardTables_CombiTable1D_getDer2Value(void* ta
      <- RETURN: Second derivative of ordinate value
   */
 
+MODELICA_EXPORT double ModelicaStandardTables_CombiTable1D_getInverseValue(void* tableID,
+                                                           int icol, double y);
+  /* Inverse interpolation in table
+
+     -> tableID: Pointer to table defined with ModelicaStandardTables_CombiTable1D_init
+     -> icol: Index (1-based) of column to interpolate
+     -> y: Ordinate value
+     <- RETURN: Abscissa value u, such that the interpolated value of
+                column icol at u is y. The values of the column must be
+                strictly monotonic. If the interpolation itself is not
+                monotonic (possible for Akima splines) one of the abscissa
+                values is returned. Ordinate values out of the range of
+                the column are only supported for linear extrapolation.
+  */
+
+MODELICA_EXPORT void ModelicaStandardTables_CombiTable1D_resample(void* tableID,
+                                                 _In_ const double* u,
+                                                 size_t n, double* y);
+  /* Interpolate all columns in table at a sequence of abscissa values
+
+     -> tableID: Pointer to table defined with ModelicaStandardTables_CombiTable1D_init
+     -> u: Abscissa values, preferably in increasing order
+     -> n: Number of abscissa values
+     <- y: Ordinate values (n rows, one column per interpolated column of
+           the table, stored row-wise)
+  */
+
 MODELICA_EXPORT double ModelicaStandardTables_CombiTable1D_read(void* tableID, int force,
                                                 int verbose);
   /* Empty function, kept only for backward compatibility */
@@ -492,8 +588,189 @@ MODELICA_EXPORT double ModelicaStandardTables_CombiTable2D_getDer2Value(void* ta
      <- RETURN: Second derivative of interpolated value
   */
 
+MODELICA_EXPORT void ModelicaStandardTables_CombiTable2D_resample(void* tableID,
+                                                 _In_ const double* u1,
+                                                 size_t n1,
+                                                 _In_ const double* u2,
+                                                 size_t n2, double* y);
+  /* Interpolate in table on the grid of the abscissa values u1 and u2
+
+     -> tableID: Pointer to table defined with ModelicaStandardTables_CombiTable2D_init
+     -> u1: Values of first independent variable, preferably in increasing order
+     -> n1: Number of values of first independent variable
+     -> u2: Values of second independent variable, preferably in increasing order
+     -> n2: Number of values of second independent variable
+     <- y: Interpolated values at (u1[i], u2[j]) (n1 rows, n2 columns, stored
+           row-wise)
+  */
+
 MODELICA_EXPORT double ModelicaStandardTables_CombiTable2D_read(void* tableID, int force,
                                                 int verbose);
   /* Empty function, kept only for backward compatibility */
 
+MODELICA_EXPORT void* ModelicaStandardTables_CombiTableND_init(_In_z_ const char* fileName,
+                                               _In_z_ const char* tableName,
+                                               _In_ const double* table, size_t nTable,
+                                               _In_ const int* dims, size_t nDim,
+                                               int smoothness, int extrapolation,
+                                               int verbose,
+                                               _In_z_ const char* delimiter,
+                                               int nHeaderLines) MODELICA_NONNULLATTR;
+  /* Initialize N-dim. gridded table defined by vector, where the grids
+     of all dimensions are followed by the table values (row-wise storage,
+     that is the index of the last dimension varies fastest).
+       table[1:dims[1]                       ]: Grid of first dimension
+            [...                             ]: ...
+            [... :sum(dims)                  ]: Grid of last dimension
+            [sum(dims)+1:sum(dims)+prod(dims)]: Table values
+
+     -> fileName: Name of file
+     -> tableName: Name of table
+     -> table: If tableName="NoName" or has only blanks AND
+               fileName ="NoName" or has only blanks, then
+               this pointer points to the vector in the Modelica
+               environment that holds the grids and table values.
+               Otherwise the matrix read from file is interpreted
+               as that vector (row-wise storage).
+     -> nTable: Number of elements of table (= sum(dims) + prod(dims))
+     -> dims: Number of grid points per dimension
+     -> nDim: Number of dimensions
+     -> smoothness: Interpolation type
+                    = 1: multilinear
+                    = 2: continuous first derivative (by separable Akima splines)
+                    = 3: constant
+                    = 4: monotonicity-preserving, continuous first derivative
+                         (by separable Fritsch-Butland splines)
+                    = 5: monotonicity-preserving, continuous first derivative
+                         (by separable Steffen splines)
+                    = 6: continuous first derivative (by separable modified
+                         Akima splines)
+     -> extrapolation: Extrapolation type
+                       = 1: hold first/last value
+                       = 2: linear
+                       = 3: periodic
+                       = 4: no
+     -> verbose: Print message that file is loading
+     -> delimiter: Column delimiter character (CSV file only)
+     -> nHeaderLines: Number of header lines to ignore (CSV file only)
+     <- RETURN: Pointer to internal memory of table structure
+  */
+
+MODELICA_EXPORT void ModelicaStandardTables_CombiTableND_close(void* tableID);
+  /* Close table and free allocated memory */
+
+MODELICA_EXPORT void ModelicaStandardTables_CombiTableND_minimumAbscissa(void* tableID,
+                                                         _Inout_ double* uMin);
+  /* Get minimum abscissa defined in table (= first grid value per dimension) */
+
+MODELICA_EXPORT void ModelicaStandardTables_CombiTableND_maximumAbscissa(void* tableID,
+                                                         _Inout_ double* uMax);
+  /* Get maximum abscissa defined in table (= last grid value per dimension) */
+
+MODELICA_EXPORT double ModelicaStandardTables_CombiTableND_getValue(void* tableID,
+                                                    _In_ const double* u,
+                                                    size_t nu);
+  /* Interpolate in table
+
+     -> tableID: Pointer to table defined with ModelicaStandardTables_CombiTableND_init
+     -> u: Values of independent variables
+     -> nu: Number of independent variables (= nDim)
+     <- RETURN : Interpolated value
+  */
+
+MODELICA_EXPORT double ModelicaStandardTables_CombiTableND_getDerValue(void* tableID,
+                                                       _In_ const double* u,
+                                                       _In_ const double* der_u,
+                                                       size_t nu);
+  /* Interpolated derivative in table
+
+     -> tableID: Pointer to table defined with ModelicaStandardTables_CombiTableND_init
+     -> u: Values of independent variables
+     -> der_u: Derivative values of independent variables
+     -> nu: Number of independent variables (= nDim)
+     <- RETURN: Derivative of interpolated value
+  */
+
+MODELICA_EXPORT double ModelicaStandardTables_CombiTableND_read(void* tableID, int force,
+                                                int verbose);
+  /* Read table from file (again, if force is set) */
+
+MODELICA_EXPORT void* ModelicaStandardTables_CombiTableScattered2D_init(_In_z_ const char* fileName,
+                                                        _In_z_ const char* tableName,
+                                                        _In_ const double* table, size_t nRow,
+                                                        size_t nColumn, int smoothness,
+                                                        int extrapolation, int verbose,
+                                                        _In_z_ const char* delimiter,
+                                                        int nHeaderLines) MODELICA_NONNULLATTR;
+  /* Initialize 2-dim. table of scattered data points defined by matrix,
+     where every row holds one data point (u1, u2) and its values:
+       table[i,1]: u1 of point i
+       table[i,2]: u2 of point i
+       table[i,3:nColumn]: Values y[1:nColumn-2] at point i
+     The abscissa values are triangulated (Delaunay triangulation) and
+     the values are interpolated linearly within the triangles.
+
+     -> fileName: Name of file
+     -> tableName: Name of table
+     -> table: If tableName="NoName" or has only blanks AND
+               fileName ="NoName" or has only blanks, then
+               this pointer points to a 2-dim. array (row-wise storage)
+               in the Modelica environment that holds this matrix.
+     -> nRow: Number of rows of table (= number of data points)
+     -> nColumn: Number of columns of table
+     -> smoothness: Interpolation type
+                    = 1: linear (the only supported type)
+     -> extrapolation: Extrapolation type
+                       = 1: hold value at nearest point of convex hull
+                       = 2: linear (of nearest boundary triangle)
+                       = 4: no
+     -> verbose: Print message that file is loading
+     -> delimiter: Column delimiter character (CSV file only)
+     -> nHeaderLines: Number of header lines to ignore (CSV file only)
+     <- RETURN: Pointer to internal memory of table structure
+  */
+
+MODELICA_EXPORT void ModelicaStandardTables_CombiTableScattered2D_close(void* tableID);
+  /* Close table and free allocated memory */
+
+MODELICA_EXPORT void ModelicaStandardTables_CombiTableScattered2D_minimumAbscissa(void* tableID,
+                                                                  _Inout_ double* uMin);
+  /* Get minimum abscissa defined in table (= lower left corner of bounding box) */
+
+MODELICA_EXPORT void ModelicaStandardTables_CombiTableScattered2D_maximumAbscissa(void* tableID,
+                                                                  _Inout_ double* uMax);
+  /* Get maximum abscissa defined in table (= upper right corner of bounding box) */
+
+MODELICA_EXPORT double ModelicaStandardTables_CombiTableScattered2D_getValue(void* tableID,
+                                                             int icol, double u1,
+                                                             double u2);
+  /* Interpolate in table
+
+     -> tableID: Pointer to table defined with ModelicaStandardTables_CombiTableScattered2D_init
+     -> icol: Index (1..nColumn-2) of value column to be interpolated
+     -> u1: Value of first independent variable
+     -> u2: Value of second independent variable
+     <- RETURN : Interpolated value
+  */
+
+MODELICA_EXPORT double ModelicaStandardTables_CombiTableScattered2D_getDerValue(void* tableID,
+                                                                int icol, double u1,
+                                                                double u2,
+                                                                double der_u1,
+                                                                double der_u2);
+  /* Interpolated derivative in table
+
+     -> tableID: Pointer to table defined with ModelicaStandardTables_CombiTableScattered2D_init
+     -> icol: Index (1..nColumn-2) of value column to be interpolated
+     -> u1: Value of first independent variable
+     -> u2: Value of second independent variable
+     -> der_u1: Derivative value of first independent variable
+     -> der_u2: Derivative value of second independent variable
+     <- RETURN: Derivative of interpolated value
+  */
+
+MODELICA_EXPORT double ModelicaStandardTables_CombiTableScattered2D_read(void* tableID, int force,
+                                                         int verbose);
+  /* Read table from file (again, if force is set) */
+
 #endif
@@ -24,6 +24,23 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+/* Conversions to READ_TYPE, vectorized for widening to double */
+#if READ_TYPE_TYPE == READ_TYPE_DOUBLE
+#define READ_DATA_FROM_SINGLE Mat_floatToDouble
+#define READ_DATA_FROM_INT32 Mat_int32ToDouble
+#define READ_DATA_FROM_INT16 Mat_int16ToDouble
+#define READ_DATA_FROM_UINT16 Mat_uint16ToDouble
+#define READ_DATA_FROM_INT8 Mat_int8ToDouble
+#define READ_DATA_FROM_UINT8 Mat_uint8ToDouble
+#else
+#define READ_DATA_FROM_SINGLE READ_DATA_CAST
+#define READ_DATA_FROM_INT32 READ_DATA_CAST
+#define READ_DATA_FROM_INT16 READ_DATA_CAST
+#define READ_DATA_FROM_UINT16 READ_DATA_CAST
+#define READ_DATA_FROM_INT8 READ_DATA_CAST
+#define READ_DATA_FROM_UINT8 READ_DATA_CAST
+#endif
+
 #define READ_TYPE_DOUBLE_DATA CAT(READ_TYPED_FUNC1, Double)
 #define READ_TYPE_SINGLE_DATA CAT(READ_TYPED_FUNC1, Single)
 #define READ_TYPE_INT32_DATA CAT(READ_TYPED_FUNC1, Int32)
@@ -44,18 +61,15 @@ READ_TYPE_DOUBLE_DATA(mat_t *mat, READ_TYPE *data, size_t len)
 {
     size_t readcount;
 #if READ_TYPE_TYPE == READ_TYPE_DOUBLE
-    readcount = fread(data, sizeof(double), len, (FILE*)mat->fp);
+    readcount = Mat_fread(data, sizeof(double), len, mat);
     if ( readcount == len && mat->byteswap ) {
-        size_t i;
-        for ( i = 0; i < len; i++ ) {
-            (void)Mat_doubleSwap(data + i);
-        }
+        Mat_SwapArray(data, sizeof(double), len);
     }
 #else
     size_t i;
     const size_t data_size = sizeof(double);
     double v[READ_BLOCK_SIZE/sizeof(double)];
-    READ_DATA(READ_TYPE, Mat_doubleSwap);
+    READ_DATA(READ_DATA_CAST);
 #endif
     return readcount;
 }
@@ -65,18 +79,15 @@ READ_TYPE_SINGLE_DATA(mat_t *mat, READ_TYPE *data, size_t len)
 {
     size_t readcount;
 #if READ_TYPE_TYPE == READ_TYPE_SINGLE
-    readcount = fread(data, sizeof(float), len, (FILE*)mat->fp);
+    readcount = Mat_fread(data, sizeof(float), len, mat);
     if ( readcount == len && mat->byteswap ) {
-        size_t i;
-        for ( i = 0; i < len; i++ ) {
-            (void)Mat_floatSwap(data + i);
-        }
+        Mat_SwapArray(data, sizeof(float), len);
     }
 #else
     size_t i;
     const size_t data_size = sizeof(float);
     float v[READ_BLOCK_SIZE/sizeof(float)];
-    READ_DATA(READ_TYPE, Mat_floatSwap);
+    READ_DATA(READ_DATA_FROM_SINGLE);
 #endif
     return readcount;
 }
@@ -86,18 +97,15 @@ READ_TYPE_INT32_DATA(mat_t *mat, READ_TYPE *data, size_t len)
 {
     size_t readcount;
 #if READ_TYPE_TYPE == READ_TYPE_INT32
-    readcount = fread(data, sizeof(mat_int32_t), len, (FILE*)mat->fp);
+    readcount = Mat_fread(data, sizeof(mat_int32_t), len, mat);
     if ( readcount == len && mat->byteswap ) {
-        size_t i;
-        for ( i = 0; i < len; i++ ) {
-            (void)Mat_int32Swap(data + i);
-        }
+        Mat_SwapArray(data, sizeof(mat_int32_t), len);
     }
 #else
     size_t i;
     const size_t data_size = sizeof(mat_int32_t);
     mat_int32_t v[READ_BLOCK_SIZE/sizeof(mat_int32_t)];
-    READ_DATA(READ_TYPE, Mat_int32Swap);
+    READ_DATA(READ_DATA_FROM_INT32);
 #endif
     return readcount;
 }
@@ -107,18 +115,15 @@ READ_TYPE_UINT32_DATA(mat_t *mat, READ_TYPE *data, size_t len)
 {
     size_t readcount;
 #if READ_TYPE_TYPE == READ_TYPE_UINT32
-    readcount = fread(data, sizeof(mat_uint32_t), len, (FILE*)mat->fp);
+    readcount = Mat_fread(data, sizeof(mat_uint32_t), len, mat);
     if ( readcount == len && mat->byteswap ) {
-        size_t i;
-        for ( i = 0; i < len; i++ ) {
-            (void)Mat_uint32Swap(data + i);
-        }
+        Mat_SwapArray(data, sizeof(mat_uint32_t), len);
     }
 #else
     size_t i;
     const size_t data_size = sizeof(mat_uint32_t);
     mat_uint32_t v[READ_BLOCK_SIZE/sizeof(mat_uint32_t)];
-    READ_DATA(READ_TYPE, Mat_uint32Swap);
+    READ_DATA(READ_DATA_CAST);
 #endif
     return readcount;
 }
@@ -128,18 +133,15 @@ READ_TYPE_INT16_DATA(mat_t *mat, READ_TYPE *data, size_t len)
 {
     size_t readcount;
 #if READ_TYPE_TYPE == READ_TYPE_INT16
-    readcount = fread(data, sizeof(mat_int16_t), len, (FILE*)mat->fp);
+    readcount = Mat_fread(data, sizeof(mat_int16_t), len, mat);
     if ( readcount == len && mat->byteswap ) {
-        size_t i;
-        for ( i = 0; i < len; i++ ) {
-            (void)Mat_int16Swap(data + i);
-        }
+        Mat_SwapArray(data, sizeof(mat_int16_t), len);
     }
 #else
     size_t i;
     const size_t data_size = sizeof(mat_int16_t);
     mat_int16_t v[READ_BLOCK_SIZE/sizeof(mat_int16_t)];
-    READ_DATA(READ_TYPE, Mat_int16Swap);
+    READ_DATA(READ_DATA_FROM_INT16);
 #endif
     return readcount;
 }
@@ -149,18 +151,15 @@ READ_TYPE_UINT16_DATA(mat_t *mat, READ_TYPE *data, size_t len)
 {
     size_t readcount;
 #if READ_TYPE_TYPE == READ_TYPE_UINT16
-    readcount = fread(data, sizeof(mat_uint16_t), len, (FILE*)mat->fp);
+    readcount = Mat_fread(data, sizeof(mat_uint16_t), len, mat);
     if ( readcount == len && mat->byteswap ) {
-        size_t i;
-        for ( i = 0; i < len; i++ ) {
-            (void)Mat_uint16Swap(data + i);
-        }
+        Mat_SwapArray(data, sizeof(mat_uint16_t), len);
     }
 #else
     size_t i;
     const size_t data_size = sizeof(mat_uint16_t);
     mat_uint16_t v[READ_BLOCK_SIZE/sizeof(mat_uint16_t)];
-    READ_DATA(READ_TYPE, Mat_uint16Swap);
+    READ_DATA(READ_DATA_FROM_UINT16);
 #endif
     return readcount;
 }
@@ -170,12 +169,12 @@ READ_TYPE_INT8_DATA(mat_t *mat, READ_TYPE *data, size_t len)
 {
     size_t readcount;
 #if READ_TYPE_TYPE == READ_TYPE_INT8
-    readcount = fread(data, sizeof(mat_int8_t), len, (FILE*)mat->fp);
+    readcount = Mat_fread(data, sizeof(mat_int8_t), len, mat);
 #else
     size_t i;
     const size_t data_size = sizeof(mat_int8_t);
     mat_int8_t v[READ_BLOCK_SIZE/sizeof(mat_int8_t)];
-    READ_DATA_NOSWAP(READ_TYPE);
+    READ_DATA(READ_DATA_FROM_INT8);
 #endif
     return readcount;
 }
@@ -185,12 +184,12 @@ READ_TYPE_UINT8_DATA(mat_t *mat, READ_TYPE *data, size_t len)
 {
     size_t readcount;
 #if READ_TYPE_TYPE == READ_TYPE_UINT8
-    readcount = fread(data, sizeof(mat_uint8_t), len, (FILE*)mat->fp);
+    readcount = Mat_fread(data, sizeof(mat_uint8_t), len, mat);
 #else
     size_t i;
     const size_t data_size = sizeof(mat_uint8_t);
     mat_uint8_t v[READ_BLOCK_SIZE/sizeof(mat_uint8_t)];
-    READ_DATA_NOSWAP(READ_TYPE);
+    READ_DATA(READ_DATA_FROM_UINT8);
 #endif
     return readcount;
 }
@@ -201,18 +200,15 @@ READ_TYPE_INT64_DATA(mat_t *mat, READ_TYPE *data, size_t len)
 {
     size_t readcount;
 #if READ_TYPE_TYPE == READ_TYPE_INT64
-    readcount = fread(data, sizeof(mat_int64_t), len, (FILE*)mat->fp);
+    readcount = Mat_fread(data, sizeof(mat_int64_t), len, mat);
     if ( readcount == len && mat->byteswap ) {
-        size_t i;
-        for ( i = 0; i < len; i++ ) {
-            (void)Mat_int64Swap(data + i);
-        }
+        Mat_SwapArray(data, sizeof(mat_int64_t), len);
     }
 #else
     size_t i;
     const size_t data_size = sizeof(mat_int64_t);
     mat_int64_t v[READ_BLOCK_SIZE/sizeof(mat_int64_t)];
-    READ_DATA(READ_TYPE, Mat_int64Swap);
+    READ_DATA(READ_DATA_CAST);
 #endif
     return readcount;
 }
@@ -224,18 +220,15 @@ READ_TYPE_UINT64_DATA(mat_t *mat, READ_TYPE *data, size_t len)
 {
     size_t readcount;
 #if READ_TYPE_TYPE == READ_TYPE_UINT64
-    readcount = fread(data, sizeof(mat_uint64_t), len, (FILE*)mat->fp);
+    readcount = Mat_fread(data, sizeof(mat_uint64_t), len, mat);
     if ( readcount == len && mat->byteswap ) {
-        size_t i;
-        for ( i = 0; i < len; i++ ) {
-            (void)Mat_uint64Swap(data + i);
-        }
+        Mat_SwapArray(data, sizeof(mat_uint64_t), len);
     }
 #else
     size_t i;
     const size_t data_size = sizeof(mat_uint64_t);
     mat_uint64_t v[READ_BLOCK_SIZE/sizeof(mat_uint64_t)];
-    READ_DATA(READ_TYPE, Mat_uint64Swap);
+    READ_DATA(READ_DATA_CAST);
 #endif
     return readcount;
 }
@@ -342,16 +335,13 @@ READ_TYPE_DOUBLE_DATA(mat_t *mat, z_streamp z, READ_TYPE *data, mat_uint32_t len
 #if READ_TYPE_TYPE == READ_TYPE_DOUBLE
     InflateData(mat, z, data, len*sizeof(double));
     if ( mat->byteswap ) {
-        mat_uint32_t i;
-        for ( i = 0; i < len; i++ ) {
-            (void)Mat_doubleSwap(data + i);
-        }
+        Mat_SwapArray(data, sizeof(double), len);
     }
 #else
     mat_uint32_t i;
     const size_t data_size = sizeof(double);
     double v[READ_BLOCK_SIZE/sizeof(double)];
-    READ_COMPRESSED_DATA(READ_TYPE, Mat_doubleSwap);
+    READ_COMPRESSED_DATA(READ_DATA_CAST);
 #endif
 }
 
@@ -361,16 +351,13 @@ READ_TYPE_SINGLE_DATA(mat_t *mat, z_streamp z, READ_TYPE *data, mat_uint32_t len
 #if READ_TYPE_TYPE == READ_TYPE_SINGLE
     InflateData(mat, z, data, len*sizeof(float));
     if ( mat->byteswap ) {
-        mat_uint32_t i;
-        for ( i = 0; i < len; i++ ) {
-            (void)Mat_floatSwap(data + i);
-        }
+        Mat_SwapArray(data, sizeof(float), len);
     }
 #else
     mat_uint32_t i;
     const size_t data_size = sizeof(float);
     float v[READ_BLOCK_SIZE/sizeof(float)];
-    READ_COMPRESSED_DATA(READ_TYPE, Mat_floatSwap);
+    READ_COMPRESSED_DATA(READ_DATA_FROM_SINGLE);
 #endif
 }
 
@@ -381,16 +368,13 @@ READ_TYPE_INT64_DATA(mat_t *mat, z_streamp z, READ_TYPE *data, mat_uint32_t len)
 #if READ_TYPE_TYPE == READ_TYPE_INT64
     InflateData(mat, z, data, len*sizeof(mat_int64_t));
     if ( mat->byteswap ) {
-        mat_uint32_t i;
-        for ( i = 0; i < len; i++ ) {
-            (void)Mat_int64Swap(data + i);
-        }
+        Mat_SwapArray(data, sizeof(mat_int64_t), len);
     }
 #else
     mat_uint32_t i;
     const size_t data_size = sizeof(mat_int64_t);
     mat_int64_t v[READ_BLOCK_SIZE/sizeof(mat_int64_t)];
-    READ_COMPRESSED_DATA(READ_TYPE, Mat_int64Swap);
+    READ_COMPRESSED_DATA(READ_DATA_CAST);
 #endif
 }
 #endif /* HAVE_MATIO_INT64_T */
@@ -402,16 +386,13 @@ READ_TYPE_UINT64_DATA(mat_t *mat, z_streamp z, READ_TYPE *data, mat_uint32_t len
 #if READ_TYPE_TYPE == READ_TYPE_UINT64
     InflateData(mat, z, data, len*sizeof(mat_uint64_t));
     if ( mat->byteswap ) {
-        mat_uint32_t i;
-        for ( i = 0; i < len; i++ ) {
-            (void)Mat_uint64Swap(data + i);
-        }
+        Mat_SwapArray(data, sizeof(mat_uint64_t), len);
     }
 #else
     mat_uint32_t i;
     const size_t data_size = sizeof(mat_uint64_t);
     mat_uint64_t v[READ_BLOCK_SIZE/sizeof(mat_uint64_t)];
-    READ_COMPRESSED_DATA(READ_TYPE, Mat_uint64Swap);
+    READ_COMPRESSED_DATA(READ_DATA_CAST);
 #endif
 }
 #endif /* HAVE_MATIO_UINT64_T */
@@ -422,16 +403,13 @@ READ_TYPE_INT32_DATA(mat_t *mat, z_streamp z, READ_TYPE *data, mat_uint32_t len)
 #if READ_TYPE_TYPE == READ_TYPE_INT32
     InflateData(mat, z, data, len*sizeof(mat_int32_t));
     if ( mat->byteswap ) {
-        mat_uint32_t i;
-        for ( i = 0; i < len; i++ ) {
-            (void)Mat_int32Swap(data + i);
-        }
+        Mat_SwapArray(data, sizeof(mat_int32_t), len);
     }
 #else
     mat_uint32_t i;
     const size_t data_size = sizeof(mat_int32_t);
     mat_int32_t v[READ_BLOCK_SIZE/sizeof(mat_int32_t)];
-    READ_COMPRESSED_DATA(READ_TYPE, Mat_int32Swap);
+    READ_COMPRESSED_DATA(READ_DATA_FROM_INT32);
 #endif
 }
 
@@ -441,16 +419,13 @@ READ_TYPE_UINT32_DATA(mat_t *mat, z_streamp z, READ_TYPE *data, mat_uint32_t len
 #if READ_TYPE_TYPE == READ_TYPE_UINT32
     InflateData(mat, z, data, len*sizeof(mat_uint32_t));
     if ( mat->byteswap ) {
-        mat_uint32_t i;
-        for ( i = 0; i < len; i++ ) {
-            (void)Mat_uint32Swap(data + i);
-        }
+        Mat_SwapArray(data, sizeof(mat_uint32_t), len);
     }
 #else
     mat_uint32_t i;
     const size_t data_size = sizeof(mat_uint32_t);
     mat_uint32_t v[READ_BLOCK_SIZE/sizeof(mat_uint32_t)];
-    READ_COMPRESSED_DATA(READ_TYPE, Mat_uint32Swap);
+    READ_COMPRESSED_DATA(READ_DATA_CAST);
 #endif
 }
 
@@ -460,16 +435,13 @@ READ_TYPE_INT16_DATA(mat_t *mat, z_streamp z, READ_TYPE *data, mat_uint32_t len)
 #if READ_TYPE_TYPE == READ_TYPE_INT16
     InflateData(mat, z, data, len*sizeof(mat_int16_t));
     if ( mat->byteswap ) {
-        mat_uint32_t i;
-        for ( i = 0; i < len; i++ ) {
-            (void)Mat_int16Swap(data + i);
-        }
+        Mat_SwapArray(data, sizeof(mat_int16_t), len);
     }
 #else
     mat_uint32_t i;
     const size_t data_size = sizeof(mat_int16_t);
     mat_int16_t v[READ_BLOCK_SIZE/sizeof(mat_int16_t)];
-    READ_COMPRESSED_DATA(READ_TYPE, Mat_int16Swap);
+    READ_COMPRESSED_DATA(READ_DATA_FROM_INT16);
 #endif
 }
 
@@ -479,16 +451,13 @@ READ_TYPE_UINT16_DATA(mat_t *mat, z_streamp z, READ_TYPE *data, mat_uint32_t len
 #if READ_TYPE_TYPE == READ_TYPE_UINT16
     InflateData(mat, z, data, len*sizeof(mat_uint16_t));
     if ( mat->byteswap ) {
-        mat_uint32_t i;
-        for ( i = 0; i < len; i++ ) {
-            (void)Mat_uint16Swap(data + i);
-        }
+        Mat_SwapArray(data, sizeof(mat_uint16_t), len);
     }
 #else
     mat_uint32_t i;
     const size_t data_size = sizeof(mat_uint16_t);
     mat_uint16_t v[READ_BLOCK_SIZE/sizeof(mat_uint16_t)];
-    READ_COMPRESSED_DATA(READ_TYPE, Mat_uint16Swap);
+    READ_COMPRESSED_DATA(READ_DATA_FROM_UINT16);
 #endif
 }
 
@@ -501,7 +470,7 @@ READ_TYPE_INT8_DATA(mat_t *mat, z_streamp z, READ_TYPE *data, mat_uint32_t len)
     mat_uint32_t i;
     const size_t data_size = sizeof(mat_int8_t);
     mat_int8_t v[READ_BLOCK_SIZE/sizeof(mat_int8_t)];
-    READ_COMPRESSED_DATA_NOSWAP(READ_TYPE);
+    READ_COMPRESSED_DATA(READ_DATA_FROM_INT8);
 #endif
 }
 
@@ -514,7 +483,7 @@ READ_TYPE_UINT8_DATA(mat_t *mat, z_streamp z, READ_TYPE *data, mat_uint32_t len)
     mat_uint32_t i;
     const size_t data_size = sizeof(mat_uint8_t);
     mat_uint8_t v[READ_BLOCK_SIZE/sizeof(mat_uint8_t)];
-    READ_COMPRESSED_DATA_NOSWAP(READ_TYPE);
+    READ_COMPRESSED_DATA(READ_DATA_FROM_UINT8);
 #endif
 }
 
@@ -594,3 +563,10 @@ READ_TYPED_FUNC2(mat_t *mat, z_streamp z, READ_TYPE *data, enum matio_types data
 #endif /* HAVE_MATIO_UINT64_T */
 
 #endif
+
+#undef READ_DATA_FROM_SINGLE
+#undef READ_DATA_FROM_INT32
+#undef READ_DATA_FROM_INT16
+#undef READ_DATA_FROM_UINT16
+#undef READ_DATA_FROM_INT8
+#undef READ_DATA_FROM_UINT8
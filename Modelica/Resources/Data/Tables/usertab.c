@@ -58,6 +58,8 @@ int usertab(char *tableName, int nipo, int dim[], int *colWise,
       <- dim        : Actual values of dimensions.
       <- colWise    : = 0: table stored row-wise    (row_1, row_2, ..., row_n).
                     : = 1: table stored column-wise (column_1, column_2, ...).
+                    : = 3: table stored column-wise and valid until the
+                           table object is closed (interpolated in place).
       <- table      : Pointer to value vector.
       <- RETURN: = 0: No error.
                  = 1: An error occurred. An error message is printed